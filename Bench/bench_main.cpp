@@ -0,0 +1,113 @@
+/*
+ * Host runner of the benchmark cases:
+ *   st-lib-bench [--filter <substring>] [--samples <n>] [--json <file>] [--quick]
+ * The report goes to stdout, and also to <file> when given.
+ */
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "ErrorHandler/ErrorHandler.hpp"
+#include "HALAL/Benchmarking_toolkit/Benchmark/Benchmark.hpp"
+#include "HALAL/Models/TimerDomain/TimerDomain.hpp"
+
+/* Definitions the board firmware and the test binary provide on their own */
+TIM_TypeDef* ST_LIB::TimerDomain::cmsis_timers[16] = {
+    [0] = TIM2_BASE,
+    [1] = TIM3_BASE,
+    [2] = TIM4_BASE,
+    [3] = TIM5_BASE,
+    [4] = TIM23_BASE,
+    [5] = TIM24_BASE,
+    [6] = TIM12_BASE,
+    [7] = TIM13_BASE,
+    [8] = TIM14_BASE,
+    [9] = TIM15_BASE,
+    [10] = TIM16_BASE,
+    [11] = TIM17_BASE,
+    [12] = TIM6_BASE,
+    [13] = TIM7_BASE,
+    [14] = TIM1_BASE,
+    [15] = TIM8_BASE,
+};
+
+std::string ErrorHandlerModel::line;
+std::string ErrorHandlerModel::func;
+std::string ErrorHandlerModel::file;
+
+void ErrorHandlerModel::SetMetaData(int line, const char* func, const char* file) {
+    ErrorHandlerModel::line = to_string(line);
+    ErrorHandlerModel::func = string(func);
+    ErrorHandlerModel::file = string(file);
+}
+
+/* A case hitting the error handler is broken, its figures would be meaningless */
+void ErrorHandlerModel::ErrorHandlerTrigger(string format, ...) {
+    std::fprintf(stderr, "ErrorHandler at %s:%s (%s): ", file.c_str(), line.c_str(), func.c_str());
+    va_list args;
+    va_start(args, format);
+    std::vfprintf(stderr, format.c_str(), args);
+    va_end(args);
+    std::fprintf(stderr, "\n");
+    std::exit(EXIT_FAILURE);
+}
+
+void ErrorHandlerModel::ErrorHandlerUpdate() {}
+
+namespace {
+
+void write_report(const char* text, void* context) {
+    std::fputs(text, stdout);
+    if (context != nullptr) {
+        std::fputs(text, static_cast<std::FILE*>(context));
+    }
+}
+
+int usage(const char* program) {
+    std::fprintf(
+        stderr,
+        "usage: %s [--filter <substring>] [--samples <n>] [--json <file>] [--quick]\n",
+        program
+    );
+    return EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ST_LIB::Benchmark::Options options;
+    const char* json_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && has_value) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--samples") == 0 && has_value) {
+            options.samples = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--json") == 0 && has_value) {
+            json_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            options.samples = 3;
+            options.max_batch = 64;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    std::FILE* json = nullptr;
+    if (json_path != nullptr) {
+        json = std::fopen(json_path, "w");
+        if (json == nullptr) {
+            std::fprintf(stderr, "can't open %s\n", json_path);
+            return EXIT_FAILURE;
+        }
+    }
+
+    const std::size_t measured = ST_LIB::Benchmark::run_all(&write_report, json, options);
+
+    if (json != nullptr) {
+        std::fclose(json);
+    }
+    return measured == 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
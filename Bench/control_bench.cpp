@@ -0,0 +1,231 @@
+#include "C++Utilities/RingBuffer.hpp"
+#include "Control/Blocks/FOC.hpp"
+#include "Control/Blocks/FastPID.hpp"
+#include "Control/Blocks/FilterBank.hpp"
+#include "Control/Blocks/KalmanFilter.hpp"
+#include "Control/Blocks/MatrixMultiplier.hpp"
+#include "Control/Blocks/MovingAverage.hpp"
+#include "Control/Blocks/PID.hpp"
+#include "Control/Blocks/Saturator.hpp"
+#include "Control/Blocks/StateSpace.hpp"
+#include "Control/ControlSystem.hpp"
+#include "Control/FixedPoint.hpp"
+#include "HALAL/Benchmarking_toolkit/Benchmark/Benchmark.hpp"
+
+namespace {
+
+/* Deterministic input with some movement, so branches don't settle */
+double next_sample() {
+    static uint32_t lcg = 12'345;
+    lcg = lcg * 1'664'525U + 1'013'904'223U;
+    return static_cast<double>(lcg >> 20) * 1e-3 - 2.0;
+}
+
+/* Mass on a rail sampled at 10 kHz with a second, slower mode, measured in position and speed */
+constexpr double RAIL_PERIOD = 1e-4;
+constexpr KalmanModel<4, 2, 1, double> RAIL{
+    {1.0, RAIL_PERIOD, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.999, 0.0, 0.0, 0.0, 0.0, 0.998},
+    {0.0, RAIL_PERIOD, 0.0, RAIL_PERIOD},
+    {1.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0, 1.0},
+    {1e-10, 0.0, 0.0, 0.0, 0.0, 1e-6, 0.0, 0.0, 0.0, 0.0, 1e-8, 0.0, 0.0, 0.0, 0.0, 1e-8},
+    {1e-4, 0.0, 0.0, 1e-2}
+};
+
+} // namespace
+
+ST_LIB_BENCHMARK(control_system_execute) {
+    static MovingAverage<8> filter;
+    static Saturator<double> limiter(0.0, -1.0, 1.0);
+    static auto system = ControlSystem<>::create_control_system(filter, limiter);
+    state.measure([] {
+        system.input(next_sample());
+        system.execute();
+        ST_LIB::Benchmark::do_not_optimize(limiter.output_value);
+    });
+}
+
+ST_LIB_BENCHMARK(moving_average_compute) {
+    static MovingAverage<16> average;
+    state.measure([] { ST_LIB::Benchmark::do_not_optimize(average.compute(next_sample())); });
+}
+
+ST_LIB_BENCHMARK(moving_average_compute_float) {
+    static MovingAverage<16, float> average;
+    state.measure([] {
+        ST_LIB::Benchmark::do_not_optimize(average.compute(static_cast<float>(next_sample())));
+    });
+}
+
+ST_LIB_BENCHMARK(moving_average_compute_q31) {
+    static MovingAverage<16, Q31> average;
+    state.measure([] {
+        ST_LIB::Benchmark::do_not_optimize(average.compute(Q31(next_sample() * 0.25)));
+    });
+}
+
+/* 16 channels through one MovingAverage each, the baseline of the filter bank cases */
+ST_LIB_BENCHMARK(moving_average_16ch) {
+    static std::array<MovingAverage<8, float>, 16> averages;
+    state.measure([] {
+        float input = static_cast<float>(next_sample());
+        for (auto& average : averages) {
+            ST_LIB::Benchmark::do_not_optimize(average.compute(input));
+        }
+    });
+}
+
+ST_LIB_BENCHMARK(fir_bank_16ch_8taps) {
+    static FirBank<16, 8> bank(FilterDesign::fir_moving_average<8>());
+    state.measure([] {
+        bank.input_value.fill(static_cast<float>(next_sample()));
+        bank.execute();
+        ST_LIB::Benchmark::do_not_optimize(bank.output_value);
+    });
+}
+
+ST_LIB_BENCHMARK(biquad_bank_16ch_2stages) {
+    static BiquadBank<16, 2> bank({
+        FilterDesign::lowpass(10'000.0, 500.0),
+        FilterDesign::lowpass(10'000.0, 500.0),
+    });
+    state.measure([] {
+        bank.input_value.fill(static_cast<float>(next_sample()));
+        bank.execute();
+        ST_LIB::Benchmark::do_not_optimize(bank.output_value);
+    });
+}
+
+ST_LIB_BENCHMARK(matrix_multiplier_4x4) {
+    static float a[4][4] = {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}};
+    static float b[4][4] = {};
+    static float result[4][4];
+    static MatrixMultiplier multiplier(a, b, result);
+    state.measure([] {
+        b[0][0] = static_cast<float>(next_sample());
+        multiplier.execute();
+        ST_LIB::Benchmark::do_not_optimize(result);
+    });
+}
+
+ST_LIB_BENCHMARK(matrix_product_4x4) {
+    static Matrix<4, 4> a{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    static Matrix<4, 4> b{};
+    static Matrix<4, 4> result;
+    state.measure([] {
+        b[0] = static_cast<float>(next_sample());
+        result = a * b;
+        ST_LIB::Benchmark::do_not_optimize(result);
+    });
+}
+
+ST_LIB_BENCHMARK(state_space_4x1x2) {
+    static StateSpace<4, 1, 2> system(
+        RAIL.A.cast<float>(),
+        RAIL.B.cast<float>(),
+        RAIL.H.cast<float>()
+    );
+    state.measure([] {
+        system.input(Vector<1>{static_cast<float>(next_sample())});
+        system.execute();
+        ST_LIB::Benchmark::do_not_optimize(system.output_value);
+    });
+}
+
+ST_LIB_BENCHMARK(kalman_fixed_gain_4x2) {
+    using Filter = KalmanFilter<4, 2>;
+    static constexpr Matrix<4, 2> gain = Filter::steady_state_gain(RAIL).cast<float>();
+    static Filter filter = Filter::fixed_gain(RAIL.cast<float>(), gain);
+    state.measure([] {
+        float z = static_cast<float>(next_sample());
+        filter.input(Vector<2>{z, z});
+        filter.execute();
+        ST_LIB::Benchmark::do_not_optimize(filter.output_value);
+    });
+}
+
+ST_LIB_BENCHMARK(kalman_time_varying_4x2) {
+    static KalmanFilter<4, 2> filter(RAIL.cast<float>());
+    state.measure([] {
+        float z = static_cast<float>(next_sample());
+        filter.input(Vector<2>{z, z});
+        filter.execute();
+        ST_LIB::Benchmark::do_not_optimize(filter.output_value);
+    });
+}
+
+ST_LIB_BENCHMARK(pid_execute) {
+    static PID<IntegratorType::Trapezoidal, FilterDerivatorType::None> pid(2.0, 0.5, 0.01, 1e-4);
+    state.measure([] { ST_LIB::Benchmark::do_not_optimize(pid.execute(next_sample())); });
+}
+
+ST_LIB_BENCHMARK(pid_execute_float) {
+    static BasicPID<float, IntegratorType::Trapezoidal, FilterDerivatorType::None> pid(
+        2.0,
+        0.5,
+        0.01,
+        1e-4
+    );
+    state.measure([] {
+        ST_LIB::Benchmark::do_not_optimize(pid.execute(static_cast<float>(next_sample())));
+    });
+}
+
+ST_LIB_BENCHMARK(pid_execute_q16) {
+    static BasicPID<Q16, IntegratorType::Trapezoidal, FilterDerivatorType::None> pid(
+        2.0,
+        0.5,
+        0.01,
+        1e-4
+    );
+    state.measure([] { ST_LIB::Benchmark::do_not_optimize(pid.execute(Q16(next_sample()))); });
+}
+
+ST_LIB_BENCHMARK(fast_pid_execute_float) {
+    static FastPID<float> pid(
+        {.kp = 2.0, .ki = 0.5, .kd = 0.01, .derivative_filter = 1e-3},
+        1e-4,
+        -1.0,
+        1.0
+    );
+    state.measure([] {
+        ST_LIB::Benchmark::do_not_optimize(
+            pid.execute(0.5f, static_cast<float>(next_sample()) * 0.5f)
+        );
+    });
+}
+
+ST_LIB_BENCHMARK(foc_iteration_float) {
+    static FieldOrientedControl<float, FOC::SoftwareSinCos> foc(0.45, 230.0, 1e-4, 27'500);
+    static uint32_t angle = 0;
+    foc.reference = {0.0f, 0.5f};
+    state.measure([] {
+        angle += 0x0123'4567;
+        float ia = static_cast<float>(next_sample()) * 0.2f;
+        float ib = static_cast<float>(next_sample()) * 0.2f;
+        foc.on_sample(ia, ib, static_cast<int32_t>(angle));
+        ST_LIB::Benchmark::do_not_optimize(foc.compare_counts);
+    });
+}
+
+ST_LIB_BENCHMARK(foc_iteration_q31) {
+    static FieldOrientedControl<Q31, FOC::SoftwareSinCos> foc(0.45, 230.0, 1e-4, 27'500);
+    static uint32_t angle = 0;
+    foc.reference = {Q31(0.0), Q31(0.5)};
+    state.measure([] {
+        angle += 0x0123'4567;
+        Q31 ia(next_sample() * 0.2);
+        Q31 ib(next_sample() * 0.2);
+        foc.on_sample(ia, ib, static_cast<int32_t>(angle));
+        ST_LIB::Benchmark::do_not_optimize(foc.compare_counts);
+    });
+}
+
+ST_LIB_BENCHMARK(ring_buffer_push_pop) {
+    static RingBuffer<float, 64> ring;
+    while (ring.push(0.0f)) {
+    }
+    state.measure([] {
+        ring.push_pop(static_cast<float>(next_sample()));
+        ST_LIB::Benchmark::do_not_optimize(ring.last());
+    });
+}
@@ -0,0 +1,206 @@
+#include "HALAL/Benchmarking_toolkit/Benchmark/Benchmark.hpp"
+
+/*
+ * Wrapper overhead over the mocked HAL. On the board the cost is dominated by the peripheral and
+ * depends on the domains each board declares, so these cases only run in the simulator.
+ */
+#ifdef SIM_ON
+
+#include <array>
+#include <span>
+
+#include "HALAL/Models/DMA/DMA2.hpp"
+#include "HALAL/Models/GPIO.hpp"
+#include "HALAL/Models/SPI/SPI2.hpp"
+#include "HALAL/Models/TimerDomain/TimerDomain.hpp"
+#include "HALAL/Services/ADC/NewADC.hpp"
+#include "HALAL/Services/Time/TimerWrapper.hpp"
+#include "MockedDrivers/mocked_hal_adc.hpp"
+#include "MockedDrivers/mocked_hal_dma.hpp"
+#include "MockedDrivers/mocked_hal_spi.hpp"
+
+namespace {
+
+struct SPIRequest {
+    ST_LIB::SPIDomain::SPIMode mode;
+    ST_LIB::SPIConfigTypes::SPIConfig config;
+};
+
+consteval ST_LIB::SPIConfigTypes::SPIConfig spi_config() {
+    ST_LIB::SPIConfigTypes::SPIConfig cfg{};
+    cfg.data_size = ST_LIB::SPIConfigTypes::DataSize::SIZE_8BIT;
+    cfg.nss_mode = ST_LIB::SPIConfigTypes::NSSMode::SOFTWARE;
+    cfg.direction = ST_LIB::SPIConfigTypes::Direction::FULL_DUPLEX;
+    return cfg;
+}
+
+inline constexpr SPIRequest spi_request{
+    .mode = ST_LIB::SPIDomain::SPIMode::MASTER,
+    .config = spi_config(),
+};
+
+constexpr std::array<ST_LIB::DMA_Domain::Entry, 2> dma_entries{{
+    {.instance = ST_LIB::DMA_Domain::Peripheral::spi2,
+     .stream = ST_LIB::DMA_Domain::Stream::dma1_stream0,
+     .irqn = DMA1_Stream0_IRQn,
+     .id = 0},
+    {.instance = ST_LIB::DMA_Domain::Peripheral::spi2,
+     .stream = ST_LIB::DMA_Domain::Stream::dma1_stream1,
+     .irqn = DMA1_Stream1_IRQn,
+     .id = 1},
+}};
+
+constexpr auto dma_cfg =
+    ST_LIB::DMA_Domain::build<2>(std::span<const ST_LIB::DMA_Domain::Entry, 2>{dma_entries});
+
+constexpr ST_LIB::TimerPin tim1_ch1_pwm{
+    .af = ST_LIB::TimerAF::PWM,
+    .pin = ST_LIB::PA8,
+    .channel = ST_LIB::TimerChannel::CHANNEL_1,
+};
+constexpr ST_LIB::TimerDomain::Timer tim1_pwm_decl{
+    {.request = ST_LIB::TimerRequest::Advanced_1},
+    tim1_ch1_pwm
+};
+ST_LIB::TimerDomain::Instance tim1_inst{
+    .tim = TIM1_BASE,
+    .hal_tim = 0,
+    .timer_idx = 14,
+};
+
+constexpr ST_LIB::GPIODomain::Pin pb0{ST_LIB::GPIODomain::Port::B, GPIO_PIN_0, 0};
+constexpr ST_LIB::GPIODomain::Pin pb3{ST_LIB::GPIODomain::Port::B, GPIO_PIN_3, 0};
+constexpr ST_LIB::GPIODomain::Pin pb7{ST_LIB::GPIODomain::Port::B, GPIO_PIN_7, 0};
+
+} // namespace
+
+ST_LIB_BENCHMARK(adc_read) {
+    float output = 0.0f;
+    const std::array<ST_LIB::ADCDomain::Config, 1> cfgs{{
+        {.gpio_idx = 0,
+         .peripheral = ST_LIB::ADCDomain::Peripheral::ADC_1,
+         .channel = ST_LIB::ADCDomain::Channel::CH16,
+         .resolution = ST_LIB::ADCDomain::Resolution::BITS_12,
+         .sample_time = ST_LIB::ADCDomain::SampleTime::CYCLES_8_5,
+         .prescaler = ST_LIB::ADCDomain::ClockPrescaler::DIV1,
+         .sample_rate_hz = 0,
+         .output = &output},
+    }};
+    ST_LIB::MockedHAL::adc_reset();
+    ST_LIB::ADCDomain::Init<1>::init(cfgs);
+    ST_LIB::MockedHAL::adc_set_channel_raw(ADC1, ADC_CHANNEL_16, 2048U);
+
+    auto& adc = ST_LIB::ADCDomain::Init<1>::instances[0];
+    state.measure([&adc, &output] {
+        adc.read(3.3, 1);
+        ST_LIB::Benchmark::do_not_optimize(output);
+    });
+    ST_LIB::MockedHAL::adc_reset();
+}
+
+ST_LIB_BENCHMARK(spi_send_16_bytes) {
+    ST_LIB::MockedHAL::spi_reset();
+    ST_LIB::MockedHAL::dma_reset();
+    ST_LIB::DMA_Domain::Init<2>::init(dma_cfg);
+
+    const std::array<ST_LIB::SPIDomain::Config, 1> cfgs{{
+        {.peripheral = ST_LIB::SPIDomain::SPIPeripheral::spi2,
+         .mode = spi_request.mode,
+         .sck_gpio_idx = 0,
+         .miso_gpio_idx = 1,
+         .mosi_gpio_idx = 2,
+         .nss_gpio_idx = std::nullopt,
+         .dma_rx_idx = 0,
+         .dma_tx_idx = 1,
+         .max_baudrate = 20'000'000U,
+         .config = spi_request.config},
+    }};
+    ST_LIB::SPIDomain::Init<1>::init(
+        cfgs,
+        std::span<ST_LIB::GPIODomain::Instance>{},
+        std::span<ST_LIB::DMA_Domain::Instance>(ST_LIB::DMA_Domain::Init<2>::instances)
+    );
+    ST_LIB::SPIDomain::SPIWrapper<spi_request> spi(ST_LIB::SPIDomain::Init<1>::instances[0]);
+
+    std::array<uint8_t, 16> tx{};
+    state.measure([&spi, &tx] {
+        tx[0]++;
+        ST_LIB::Benchmark::do_not_optimize(spi.send(std::span<uint8_t, 16>{tx}));
+    });
+
+    ST_LIB::SPIDomain::spi_instances[1] = nullptr;
+    ST_LIB::MockedHAL::spi_reset();
+    ST_LIB::MockedHAL::dma_reset();
+}
+
+/* PWM duty updates at a 10000 count period, the float path against the cached fixed-point one */
+ST_LIB_BENCHMARK(pwm_duty_float) {
+    ST_LIB::TimerWrapper<tim1_pwm_decl> tim1(&tim1_inst);
+    TIM1_BASE->ARR = 9999;
+    auto pwm = tim1.get_pwm<tim1_ch1_pwm>();
+    uint32_t i = 0;
+    state.measure([&pwm, &i] { pwm.set_duty_cycle(static_cast<float>(i++ % 100)); });
+}
+
+ST_LIB_BENCHMARK(pwm_duty_q15) {
+    ST_LIB::TimerWrapper<tim1_pwm_decl> tim1(&tim1_inst);
+    TIM1_BASE->ARR = 9999;
+    auto pwm = tim1.get_pwm<tim1_ch1_pwm>();
+    uint32_t i = 0;
+    state.measure([&pwm, &i] { pwm.set_duty_cycle_q15(i++ & 0x7FFFU); });
+}
+
+/* Three channels written together, as a three phase inverter does every cycle */
+ST_LIB_BENCHMARK(pwm_duty_q15_3ch) {
+    ST_LIB::TimerWrapper<tim1_pwm_decl> tim1(&tim1_inst);
+    TIM1_BASE->ARR = 9999;
+    uint32_t i = 0;
+    state.measure([&tim1, &i] {
+        const uint32_t duty = i++ & 0x7FFFU;
+        tim1.set_duty_cycles_q15(std::array<uint32_t, 3>{duty, duty >> 1, duty >> 2});
+    });
+}
+
+/* One pulse, on and off, through the HAL instance and through the compile-time fast path */
+ST_LIB_BENCHMARK(gpio_pulse_hal) {
+    ST_LIB::GPIODomain::Instance pin{GPIOB, GPIO_PIN_3};
+    state.measure([&pin] {
+        pin.turn_on();
+        pin.turn_off();
+    });
+}
+
+ST_LIB_BENCHMARK(gpio_pulse_fast) {
+    using Pin = ST_LIB::GPIODomain::FastPin<pb3>;
+    state.measure([] {
+        Pin::turn_on();
+        Pin::turn_off();
+    });
+}
+
+/* Three pins of the same port, one at a time against a single BSRR store per edge */
+ST_LIB_BENCHMARK(gpio_pulse_3_pins_hal) {
+    ST_LIB::GPIODomain::Instance pins[3] = {
+        {GPIOB, GPIO_PIN_0},
+        {GPIOB, GPIO_PIN_3},
+        {GPIOB, GPIO_PIN_7},
+    };
+    state.measure([&pins] {
+        for (auto& pin : pins) {
+            pin.turn_on();
+        }
+        for (auto& pin : pins) {
+            pin.turn_off();
+        }
+    });
+}
+
+ST_LIB_BENCHMARK(gpio_pulse_3_pins_group) {
+    using Bus = ST_LIB::GPIODomain::PinGroup<pb0, pb3, pb7>;
+    state.measure([] {
+        Bus::set();
+        Bus::clear();
+    });
+}
+
+#endif
@@ -0,0 +1,85 @@
+#include "HALAL/Benchmarking_toolkit/Benchmark/Benchmark.hpp"
+
+/* Packet and Order tables live in Packet.cpp, part of the library only with ethernet */
+#if defined(SIM_ON) || defined(STLIB_ETH)
+
+#include "HALAL/Models/Packets/Order.hpp"
+#include "HALAL/Models/Packets/Packet.hpp"
+
+#include <utility>
+
+namespace {
+
+struct Telemetry {
+    uint16_t state{3};
+    float current{12.5f};
+    double voltage{398.25};
+    uint32_t timestamp{123'456};
+    bool contactors_closed{true};
+};
+
+Telemetry telemetry;
+Telemetry parsed;
+uint32_t order_calls = 0;
+
+uint32_t order_arguments[16]{};
+
+void order_callback() { order_calls++; }
+
+/* Built in place, orders register their own address */
+template <std::size_t... I> auto make_orders(std::index_sequence<I...>) {
+    return std::array{
+        StackOrder(static_cast<uint16_t>(41'000 + I), &order_callback, &order_arguments[I])...
+    };
+}
+
+} // namespace
+
+ST_LIB_BENCHMARK(packet_build) {
+    static StackPacket packet(
+        uint16_t{40'001},
+        &telemetry.state,
+        &telemetry.current,
+        &telemetry.voltage,
+        &telemetry.timestamp,
+        &telemetry.contactors_closed
+    );
+    state.measure([] {
+        telemetry.timestamp++;
+        ST_LIB::Benchmark::do_not_optimize(*packet.build());
+    });
+}
+
+ST_LIB_BENCHMARK(packet_parse) {
+    static StackPacket source(
+        uint16_t{40'002},
+        &telemetry.state,
+        &telemetry.current,
+        &telemetry.voltage,
+        &telemetry.timestamp,
+        &telemetry.contactors_closed
+    );
+    static StackPacket destination(
+        uint16_t{40'003},
+        &parsed.state,
+        &parsed.current,
+        &parsed.voltage,
+        &parsed.timestamp,
+        &parsed.contactors_closed
+    );
+    uint8_t* data = source.build();
+    state.measure([data] {
+        destination.parse(data);
+        ST_LIB::Benchmark::do_not_optimize(parsed);
+    });
+}
+
+/* Lookup among 16 registered orders, parse and callback */
+ST_LIB_BENCHMARK(order_process_data) {
+    static auto orders = make_orders(std::make_index_sequence<16>{});
+    uint8_t* data = orders[11].build();
+    state.measure([data] { Order::process_data(nullptr, data); });
+    ST_LIB::Benchmark::do_not_optimize(order_calls);
+}
+
+#endif
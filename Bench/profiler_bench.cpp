@@ -0,0 +1,8 @@
+#include "HALAL/Benchmarking_toolkit/Benchmark/Benchmark.hpp"
+#include "HALAL/Benchmarking_toolkit/Profiler/Profiler.hpp"
+
+/* An empty zone, what instrumenting a scope adds on top of the scope itself */
+ST_LIB_BENCHMARK(profiler_zone_enter_leave) {
+    ST_LIB::Profiler::start();
+    state.measure([] { ST_LIB_PROFILE_ZONE("bench.empty"); });
+}
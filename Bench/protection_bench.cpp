@@ -0,0 +1,108 @@
+#include "HALAL/Benchmarking_toolkit/Benchmark/Benchmark.hpp"
+#include "Protections/IsrProtection.hpp"
+#include "Protections/ReportAggregator.hpp"
+#include "Protections/SlidingWindow.hpp"
+
+namespace {
+
+float phase_current = 0.0f;
+
+} // namespace
+
+/* The same three bounds as boundary_check_bounds, checked the way the ADC interrupt would */
+ST_LIB_BENCHMARK(isr_protection_check) {
+    using namespace Protections;
+    static IsrProtection<float, OUT_OF_RANGE> range("range", -150.0f, 150.0f);
+    static IsrProtection<float, BELOW> below("below", -130.0f);
+    static IsrProtection<float, ABOVE> above("above", 130.0f);
+    state.measure([] {
+        phase_current += 7.5f;
+        if (phase_current > 120.0f) {
+            phase_current = -120.0f;
+        }
+        ST_LIB::Benchmark::do_not_optimize(range.check(phase_current));
+        ST_LIB::Benchmark::do_not_optimize(below.check(phase_current));
+        ST_LIB::Benchmark::do_not_optimize(above.check(phase_current));
+    });
+}
+
+/* One check cycle of a fault storm: 32 boundaries change state and one report goes out */
+ST_LIB_BENCHMARK(protection_report_cycle) {
+    using namespace Protections;
+    struct Sink {};
+    static Sink sink;
+    static ReportAggregator<Sink> aggregator({.reports_per_second = 1'000'000'000, .burst = 1});
+    static uint64_t now = 0;
+    static bool initialized = false;
+    if (!initialized) {
+        for (int i = 0; i < 32; i++) {
+            aggregator.intern("boundary");
+        }
+        initialized = true;
+    }
+    state.measure([] {
+        now += 1'000;
+        FaultType fault_type = (now / 1'000) % 2 ? FAULT : WARNING;
+        for (uint16_t id = 0; id < 32; id++) {
+            aggregator.record(id, ABOVE, fault_type, static_cast<float>(id), now);
+        }
+        ST_LIB::Benchmark::do_not_optimize(
+            aggregator.flush(&sink, now, [](std::span<const uint8_t> packet) {
+                ST_LIB::Benchmark::do_not_optimize(packet.data());
+                return true;
+            })
+        );
+    });
+}
+
+/* A 10 s thermal window checked at 10 kHz, 100000 samples */
+ST_LIB_BENCHMARK(time_accumulation_bucket_window) {
+    static Protections::BucketWindow<float> window(100'000);
+    state.measure([] {
+        phase_current += 7.5f;
+        if (phase_current > 120.0f) {
+            phase_current = -120.0f;
+        }
+        ST_LIB::Benchmark::do_not_optimize(window.input(phase_current * phase_current));
+    });
+}
+
+ST_LIB_BENCHMARK(time_accumulation_exponential_window) {
+    static Protections::ExponentialWindow<float> window(100'000);
+    state.measure([] {
+        phase_current += 7.5f;
+        if (phase_current > 120.0f) {
+            phase_current = -120.0f;
+        }
+        ST_LIB::Benchmark::do_not_optimize(window.input(phase_current * phase_current));
+    });
+}
+
+/* Boundaries need the RTC and the order tables, only built for the board with ethernet */
+#if !defined(SIM_ON) && defined(STLIB_ETH)
+
+#include "Protections/Boundary.hpp"
+
+namespace {
+
+float measured = 0.0f;
+
+} // namespace
+
+ST_LIB_BENCHMARK(boundary_check_bounds) {
+    static Boundary<float, OUT_OF_RANGE> range(&measured, -100.0f, 100.0f);
+    static Boundary<float, BELOW> below(&measured, -50.0f);
+    static Boundary<float, ABOVE> above(&measured, 50.0f);
+    static BoundaryInterface* boundaries[] = {&range, &below, &above};
+    state.measure([] {
+        measured += 7.5f;
+        if (measured > 120.0f) {
+            measured = -120.0f;
+        }
+        for (BoundaryInterface* boundary : boundaries) {
+            ST_LIB::Benchmark::do_not_optimize(boundary->check_bounds());
+        }
+    });
+}
+
+#endif
@@ -0,0 +1,67 @@
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "C++Utilities/MPSCQueue.hpp"
+#include "C++Utilities/SPSCQueue.hpp"
+#include "C++Utilities/Snapshot.hpp"
+#include "HALAL/Benchmarking_toolkit/Benchmark/Benchmark.hpp"
+
+/* One context pushing and popping, the cost of the queue itself without any contention */
+
+ST_LIB_BENCHMARK(spsc_queue_push_pop) {
+    static SPSCQueue<uint32_t, 64> queue;
+    state.measure([] {
+        static uint32_t next = 0;
+        uint32_t value = 0;
+        queue.push(next++);
+        queue.pop(value);
+        ST_LIB::Benchmark::do_not_optimize(value);
+    });
+}
+
+ST_LIB_BENCHMARK(spsc_queue_batch_16) {
+    static SPSCQueue<uint32_t, 64> queue;
+    static std::array<uint32_t, 16> in{};
+    static std::array<uint32_t, 16> out{};
+    state.measure([] {
+        queue.push(std::span<const uint32_t>(in));
+        queue.pop(std::span<uint32_t>(out));
+        ST_LIB::Benchmark::do_not_optimize(out);
+    });
+}
+
+ST_LIB_BENCHMARK(mpsc_queue_push_pop) {
+    static MPSCQueue<uint32_t, 64> queue;
+    state.measure([] {
+        static uint32_t next = 0;
+        uint32_t value = 0;
+        queue.push(next++);
+        queue.pop(value);
+        ST_LIB::Benchmark::do_not_optimize(value);
+    });
+}
+
+/* A control cycle worth of values, what the ISR pays to publish and the main loop to read */
+struct ControlFrame {
+    std::array<float, 12> values;
+    uint32_t cycle;
+};
+
+ST_LIB_BENCHMARK(snapshot_publish) {
+    static Snapshot<ControlFrame> snapshot;
+    state.measure([] {
+        static ControlFrame frame{};
+        frame.cycle++;
+        snapshot.publish(frame);
+    });
+}
+
+ST_LIB_BENCHMARK(snapshot_read) {
+    static Snapshot<ControlFrame> snapshot;
+    snapshot.publish(ControlFrame{});
+    state.measure([] {
+        ControlFrame frame = snapshot.read();
+        ST_LIB::Benchmark::do_not_optimize(frame);
+    });
+}
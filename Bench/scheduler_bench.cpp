@@ -0,0 +1,63 @@
+#include "HALAL/Benchmarking_toolkit/Benchmark/Benchmark.hpp"
+#include "HALAL/Services/Time/Scheduler.hpp"
+
+namespace {
+
+void noop_task() {}
+
+} // namespace
+
+ST_LIB_BENCHMARK(scheduler_register_unregister) {
+    state.measure([] {
+        const uint16_t id = Scheduler::register_task(1'000, &noop_task);
+        ST_LIB::Benchmark::do_not_optimize(id);
+        Scheduler::unregister_task(id);
+    });
+}
+
+/* One timer update with 8 tasks of coprime periods, due tasks are re-sorted and run */
+ST_LIB_BENCHMARK(scheduler_fire_8_tasks) {
+    constexpr uint32_t periods[] = {3, 5, 7, 11, 13, 17, 19, 23};
+    uint16_t ids[std::size(periods)];
+    for (std::size_t i = 0; i < std::size(periods); i++) {
+        ids[i] = Scheduler::register_task(periods[i], &noop_task);
+    }
+
+    state.measure([] {
+        Scheduler::on_timer_update();
+        Scheduler::update();
+    });
+
+    for (const uint16_t id : ids) {
+        Scheduler::unregister_task(id);
+    }
+}
+
+/* Firmware time the mocked drivers simulate per host time, 1 ms of the scheduler timer with a
+ * 250 us and a 1 ms task, jumping from one instant to the next */
+#ifdef SIM_ON
+
+#include "MockedDrivers/VirtualClock.hpp"
+
+ST_LIB_BENCHMARK(virtual_clock_scheduler_1ms) {
+    using ST_LIB::MockedHAL::VirtualClock;
+    VirtualClock::reset();
+    /* Scheduler::start() derives its prescaler from a kernel clock of 2 x SystemCoreClock */
+    VirtualClock::attach_timer(TIM2_BASE, 2 * SystemCoreClock);
+    const uint16_t fast = Scheduler::register_task(250, &noop_task);
+    const uint16_t slow = Scheduler::register_task(1'000, &noop_task);
+    Scheduler::start();
+
+    state.measure([] {
+        const uint64_t until = VirtualClock::now_ns() + 1'000'000;
+        while (VirtualClock::step(until)) {
+            Scheduler::update();
+        }
+    });
+
+    Scheduler::unregister_task(fast);
+    Scheduler::unregister_task(slow);
+    VirtualClock::reset();
+}
+
+#endif
@@ -0,0 +1,124 @@
+#include "HALAL/Benchmarking_toolkit/Benchmark/Benchmark.hpp"
+
+/* ADC sensors read from the mocked HAL, only built for the simulator like the driver cases */
+#ifdef SIM_ON
+
+#include <array>
+#include <vector>
+
+#include "MockedDrivers/mocked_hal_adc.hpp"
+#include "Sensors/Common/PT100.hpp"
+#include "Sensors/LinearSensor/LinearSensor.hpp"
+#include "Sensors/LookupSensor/LookupSensor.hpp"
+#include "Sensors/NTC/NTC.hpp"
+#include "Sensors/SensorBank/SensorBank.hpp"
+
+using ST_LIB::ADCDomain;
+
+namespace {
+
+/* A board with 64 analog sensors on 20 channels: 48 linear, 8 PT100 and 8 NTC */
+constexpr std::size_t sensor_count = 64;
+constexpr std::size_t linear_count = 48;
+constexpr std::size_t pt100_count = 8;
+constexpr std::size_t ntc_count = sensor_count - linear_count - pt100_count;
+constexpr std::size_t channel_count = 20;
+
+using Instances = ADCDomain::Init<sensor_count>;
+using Bank = ST_LIB::SensorBank<linear_count, pt100_count, ntc_count>;
+
+std::array<uint16_t, channel_count> raw{};
+std::array<float, sensor_count> outputs{};
+
+uint16_t channel_of(std::size_t sensor) { return static_cast<uint16_t>(sensor % channel_count); }
+
+float slope_of(std::size_t sensor) { return 1.0f + 0.25f * static_cast<float>(sensor); }
+
+float offset_of(std::size_t sensor) { return -2.0f + 0.5f * static_cast<float>(sensor); }
+
+constexpr std::array<ADCDomain::Channel, channel_count> channels{
+    ADCDomain::Channel::CH0,  ADCDomain::Channel::CH1,  ADCDomain::Channel::CH2,
+    ADCDomain::Channel::CH3,  ADCDomain::Channel::CH4,  ADCDomain::Channel::CH5,
+    ADCDomain::Channel::CH6,  ADCDomain::Channel::CH7,  ADCDomain::Channel::CH8,
+    ADCDomain::Channel::CH9,  ADCDomain::Channel::CH10, ADCDomain::Channel::CH11,
+    ADCDomain::Channel::CH12, ADCDomain::Channel::CH13, ADCDomain::Channel::CH14,
+    ADCDomain::Channel::CH15, ADCDomain::Channel::CH16, ADCDomain::Channel::CH17,
+    ADCDomain::Channel::CH18, ADCDomain::Channel::CH19,
+};
+
+void init_adc() {
+    ST_LIB::MockedHAL::adc_reset();
+    std::array<ADCDomain::Config, sensor_count> cfgs{};
+    for (std::size_t i = 0; i < sensor_count; i++) {
+        cfgs[i] = {
+            .gpio_idx = 0,
+            .peripheral = ADCDomain::Peripheral::ADC_1,
+            .channel = channels[channel_of(i)],
+            .resolution = ADCDomain::Resolution::BITS_12,
+            .sample_time = ADCDomain::SampleTime::CYCLES_8_5,
+            .prescaler = ADCDomain::ClockPrescaler::DIV1,
+            .sample_rate_hz = 0,
+            .output = nullptr,
+        };
+    }
+    Instances::init(cfgs);
+    for (std::size_t c = 0; c < channel_count; c++) {
+        raw[c] = static_cast<uint16_t>(300 + 180 * c);
+        ST_LIB::MockedHAL::adc_set_channel_raw(ADC1, static_cast<uint32_t>(channels[c]), raw[c]);
+    }
+}
+
+} // namespace
+
+/* One pass over every sensor, each object reading its own ADC instance */
+ST_LIB_BENCHMARK(sensors_64_object_read) {
+    init_adc();
+    std::array<LinearSensor<float>, linear_count> linears{};
+    std::vector<PT100<1>> pt100s;
+    std::array<TableLookupSensor<NTC::Table>, ntc_count> ntcs{};
+    for (std::size_t i = 0; i < sensor_count; i++) {
+        auto& adc = Instances::instances[i];
+        if (i < linear_count) {
+            linears[i] = LinearSensor<float>(adc, slope_of(i), offset_of(i), &outputs[i]);
+        } else if (i < linear_count + pt100_count) {
+            pt100s.emplace_back(adc, &outputs[i]);
+        } else {
+            ntcs[i - linear_count - pt100_count] = {adc, &outputs[i]};
+        }
+    }
+
+    state.measure([&linears, &pt100s, &ntcs] {
+        for (auto& sensor : linears) {
+            sensor.read();
+        }
+        for (auto& sensor : pt100s) {
+            sensor.read();
+        }
+        for (auto& sensor : ntcs) {
+            sensor.read();
+        }
+        ST_LIB::Benchmark::do_not_optimize(outputs);
+    });
+    ST_LIB::MockedHAL::adc_reset();
+}
+
+/* The same sensors converted by kind from one block of raw samples */
+ST_LIB_BENCHMARK(sensors_64_bank_update) {
+    Bank bank;
+    for (std::size_t i = 0; i < sensor_count; i++) {
+        if (i < linear_count) {
+            bank.add_linear(channel_of(i), slope_of(i), offset_of(i), &outputs[i]);
+        } else if (i < linear_count + pt100_count) {
+            bank.add_inverse(channel_of(i), PT100<1>::k, PT100<1>::offset, &outputs[i]);
+        } else {
+            bank.add_table<NTC::Table>(channel_of(i), &outputs[i]);
+        }
+    }
+
+    state.measure([&bank] {
+        bank.update(raw);
+        ST_LIB::Benchmark::do_not_optimize(outputs);
+    });
+}
+
+#endif
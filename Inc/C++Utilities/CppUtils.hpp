@@ -1,8 +1,15 @@
 #pragma once
 
 #include "CppImports.hpp"
+#include "InlineString.hpp"
+#include "IntrusiveList.hpp"
+#include "MPSCQueue.hpp"
 #include "RingBuffer.hpp"
+#include "SPSCQueue.hpp"
+#include "Snapshot.hpp"
 #include "Stack.hpp"
+#include "StaticFlatMap.hpp"
+#include "StaticQueue.hpp"
 
 namespace chrono = std::chrono;
 namespace placeholders = std::placeholders;
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Catches heap allocations in the steady state. Built with STLIB_HEAP_GUARD, the library
+ * replaces the global operator new and STLIB::start() locks the guard once everything is set up;
+ * any allocation after that calls the handler, which by default traps so the HardFault trace
+ * points at the caller. Only operator new is covered, a direct malloc() isn't seen.
+ */
+class HeapGuard {
+public:
+    using handler_t = void (*)(std::size_t size);
+
+    static void lock() { locked = true; }
+    static void unlock() { locked = false; }
+    static bool is_locked() { return locked; }
+
+    /* Allocations attempted while locked */
+    static uint32_t blocked_allocations() { return blocked; }
+
+    /* A handler that returns lets the allocation go on, meant for tests */
+    static void set_handler(handler_t new_handler) {
+        handler = new_handler == nullptr ? trap : new_handler;
+    }
+
+    /* Called by the replaced operator new before every allocation */
+    static void check(std::size_t size) {
+        if (!locked) [[likely]] {
+            return;
+        }
+        blocked++;
+        handler(size);
+    }
+
+private:
+    [[noreturn]] static void trap(std::size_t) { __builtin_trap(); }
+
+    static inline volatile bool locked{false};
+    static inline volatile uint32_t blocked{0};
+    static inline handler_t handler{trap};
+};
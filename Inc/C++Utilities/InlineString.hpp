@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @brief String of up to Capacity characters stored inline and always null terminated, for names
+ * and short messages that would otherwise live in a heap allocated std::string. Assigning or
+ * appending more than fits truncates and reports it through the return value.
+ */
+template <size_t Capacity> class InlineString {
+public:
+    using value_type = char;
+
+    constexpr InlineString() = default;
+    constexpr InlineString(const char* text) { assign(text); }
+    constexpr InlineString(std::string_view text) { assign(text); }
+
+    /* false when text was truncated */
+    constexpr bool assign(std::string_view text) {
+        length = 0;
+        chars[0] = '\0';
+        return append(text);
+    }
+
+    constexpr bool append(std::string_view text) {
+        const size_t room = Capacity - length;
+        const size_t n = text.size() < room ? text.size() : room;
+        for (size_t i = 0; i < n; i++) {
+            chars[length + i] = text[i];
+        }
+        length += n;
+        chars[length] = '\0';
+        return n == text.size();
+    }
+
+    constexpr InlineString& operator=(const char* text) {
+        assign(text);
+        return *this;
+    }
+    constexpr InlineString& operator=(std::string_view text) {
+        assign(text);
+        return *this;
+    }
+    constexpr InlineString& operator+=(std::string_view text) {
+        append(text);
+        return *this;
+    }
+
+    constexpr void clear() {
+        length = 0;
+        chars[0] = '\0';
+    }
+
+    constexpr const char* c_str() const { return chars.data(); }
+    constexpr char* data() { return chars.data(); }
+    constexpr const char* data() const { return chars.data(); }
+    constexpr size_t size() const { return length; }
+    constexpr bool empty() const { return length == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    constexpr operator std::string_view() const { return {chars.data(), length}; }
+
+    constexpr bool operator==(std::string_view other) const {
+        return std::string_view(*this) == other;
+    }
+
+private:
+    std::array<char, Capacity + 1> chars{};
+    size_t length{0};
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+
+/* Links an object into an IntrusiveList, derive from it once per list the object can be on */
+template <typename T> class IntrusiveListNode {
+    template <typename> friend class IntrusiveList;
+
+    T* prev{nullptr};
+    T* next{nullptr};
+    bool linked{false};
+
+public:
+    bool is_linked() const { return linked; }
+};
+
+/**
+ * @brief Doubly linked list of objects that carry their own links, so adding or removing one
+ * is O(1) and never allocates: the objects live wherever their owner put them. An object is on
+ * at most one such list at a time and must be removed before it is destroyed or moved.
+ */
+template <typename T> class IntrusiveList {
+    using Node = IntrusiveListNode<T>;
+
+public:
+    class iterator {
+    public:
+        explicit iterator(T* item) : item(item) {}
+        T& operator*() const { return *item; }
+        T* operator->() const { return item; }
+        iterator& operator++() {
+            item = static_cast<Node*>(item)->next;
+            return *this;
+        }
+        bool operator==(const iterator&) const = default;
+
+    private:
+        T* item;
+    };
+
+    IntrusiveList() = default;
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    /* false if item already is on a list */
+    bool push_back(T& item) {
+        Node& node = item;
+        if (node.linked) {
+            return false;
+        }
+        node.prev = tail;
+        node.next = nullptr;
+        node.linked = true;
+        if (tail != nullptr) {
+            static_cast<Node*>(tail)->next = &item;
+        } else {
+            head = &item;
+        }
+        tail = &item;
+        count++;
+        return true;
+    }
+
+    bool push_front(T& item) {
+        Node& node = item;
+        if (node.linked) {
+            return false;
+        }
+        node.prev = nullptr;
+        node.next = head;
+        node.linked = true;
+        if (head != nullptr) {
+            static_cast<Node*>(head)->prev = &item;
+        } else {
+            tail = &item;
+        }
+        head = &item;
+        count++;
+        return true;
+    }
+
+    /* item must be on this list or on none */
+    bool remove(T& item) {
+        Node& node = item;
+        if (!node.linked) {
+            return false;
+        }
+        if (node.prev != nullptr) {
+            static_cast<Node*>(node.prev)->next = node.next;
+        } else {
+            head = node.next;
+        }
+        if (node.next != nullptr) {
+            static_cast<Node*>(node.next)->prev = node.prev;
+        } else {
+            tail = node.prev;
+        }
+        node.prev = nullptr;
+        node.next = nullptr;
+        node.linked = false;
+        count--;
+        return true;
+    }
+
+    T* pop_front() {
+        T* item = head;
+        if (item != nullptr) {
+            remove(*item);
+        }
+        return item;
+    }
+
+    T* front() const { return head; }
+    T* back() const { return tail; }
+    iterator begin() const { return iterator(head); }
+    iterator end() const { return iterator(nullptr); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    T* head{nullptr};
+    T* tail{nullptr};
+    size_t count{0};
+};
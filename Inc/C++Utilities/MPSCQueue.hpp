@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief Lock-free multiple producer / single consumer queue: interrupts of any priority (or
+ * host threads) pushing, the main loop popping. Producers take slots by a compare and swap on
+ * head and every slot carries a tag telling whether it is free for this lap or already published,
+ * so a producer preempted halfway only holds back the consumer, never the other producers.
+ * Capacity is a power of two and indices are masked on access.
+ */
+template <typename T, size_t N> class MPSCQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MPSCQueue capacity must be a power of two");
+    static constexpr size_t index_mask = N - 1;
+
+    /*
+     * The tag of the slot of position p is lap(p) while free for p, lap(p) + 1 once published and
+     * lap(p) + N = lap(p + N) once consumed, so a zeroed queue is empty and needs no constructor.
+     */
+    struct Slot {
+        std::atomic<size_t> tag{0};
+        T item{};
+    };
+
+    static constexpr size_t lap(size_t position) { return position & ~index_mask; }
+
+    std::array<Slot, N> slots{};
+    std::atomic<size_t> head{0};
+    size_t tail{0};
+
+    /* Position of count free slots claimed for this producer, false when they aren't free */
+    bool claim(size_t count, size_t& position) {
+        size_t h = head.load(std::memory_order_relaxed);
+        for (;;) {
+            /* the consumer frees in order, if the last slot is free for this lap all are */
+            const size_t last = h + count - 1;
+            const size_t tag = slots[last & index_mask].tag.load(std::memory_order_acquire);
+            const auto ahead = static_cast<std::ptrdiff_t>(tag - lap(last));
+            if (ahead < 0) {
+                return false;
+            }
+            if (ahead > 0) {
+                h = head.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (head.compare_exchange_weak(h, h + count, std::memory_order_relaxed)) {
+                position = h;
+                return true;
+            }
+        }
+    }
+
+    void publish(size_t position, const T& item) {
+        Slot& slot = slots[position & index_mask];
+        slot.item = item;
+        slot.tag.store(lap(position) + 1, std::memory_order_release);
+    }
+
+public:
+    static constexpr size_t capacity() { return N; }
+
+    // Producers side
+    bool push(const T& item) {
+        size_t position;
+        if (!claim(1, position)) {
+            return false;
+        }
+        publish(position, item);
+        return true;
+    }
+
+    /* All or nothing, the items stay together in the queue even with other producers around */
+    bool push(std::span<const T> items) {
+        if (items.empty()) {
+            return true;
+        }
+        size_t position;
+        if (items.size() > N || !claim(items.size(), position)) {
+            return false;
+        }
+        for (size_t i = 0; i < items.size(); i++) {
+            publish(position + i, items[i]);
+        }
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& item) {
+        Slot& slot = slots[tail & index_mask];
+        if (slot.tag.load(std::memory_order_acquire) != lap(tail) + 1) {
+            return false;
+        }
+        item = slot.item;
+        slot.tag.store(lap(tail) + N, std::memory_order_release);
+        tail++;
+        return true;
+    }
+
+    /* Pops up to out.size() published items, returns how many */
+    size_t pop(std::span<T> out) {
+        size_t n = 0;
+        while (n < out.size() && pop(out[n])) {
+            n++;
+        }
+        return n;
+    }
+
+    /* Consumer side, items claimed by producers, some may still be being written */
+    size_t size() const { return head.load(std::memory_order_acquire) - tail; }
+
+    bool empty() const { return size() == 0; }
+};
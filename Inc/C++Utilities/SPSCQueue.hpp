@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+/**
+ * @brief Lock-free single producer / single consumer queue, typically an interrupt pushing and
+ * the main loop popping. Head is only written by the producer and tail only by the consumer, so
+ * neither side needs to mask interrupts. The indices run freely and are masked on access, which
+ * keeps all N slots usable.
+ *
+ * Besides single items, both sides can move spans, or claim a contiguous region of the buffer
+ * and commit it once filled or consumed, e.g. by a DMA transfer. Such a buffer has to live in
+ * memory the DMA sees coherently (non-cacheable through the MPU, or cleaned/invalidated).
+ */
+template <typename T, size_t N> class SPSCQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SPSCQueue capacity must be a power of two");
+    static constexpr size_t index_mask = N - 1;
+
+    std::array<T, N> buffer{};
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+
+public:
+    static constexpr size_t capacity() { return N; }
+
+    // Producer side
+    bool push(const T& item) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        buffer[h & index_mask] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Pushes as many items as fit, in order, returns how many */
+    size_t push(std::span<const T> items) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        const size_t free_slots = N - (h - tail.load(std::memory_order_acquire));
+        const size_t n = items.size() < free_slots ? items.size() : free_slots;
+        for (size_t i = 0; i < n; i++) {
+            buffer[(h + i) & index_mask] = items[i];
+        }
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    /* Free slots from head to the end of the buffer, to be filled and then commit_write() */
+    std::span<T> claim_write() {
+        const size_t h = head.load(std::memory_order_relaxed);
+        const size_t free_slots = N - (h - tail.load(std::memory_order_acquire));
+        const size_t to_end = N - (h & index_mask);
+        return {&buffer[h & index_mask], free_slots < to_end ? free_slots : to_end};
+    }
+
+    /* Publishes the first count items of the last claim_write() */
+    void commit_write(size_t count) {
+        head.store(head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Consumer side
+    bool pop(T& item) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) {
+            return false;
+        }
+        item = buffer[t & index_mask];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Pops up to out.size() items, returns how many */
+    size_t pop(std::span<T> out) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        const size_t stored = head.load(std::memory_order_acquire) - t;
+        const size_t n = out.size() < stored ? out.size() : stored;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = buffer[(t + i) & index_mask];
+        }
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    /* Stored items from tail to the end of the buffer, to be consumed and then commit_read() */
+    std::span<T> claim_read() {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        const size_t stored = head.load(std::memory_order_acquire) - t;
+        const size_t to_end = N - (t & index_mask);
+        return {&buffer[t & index_mask], stored < to_end ? stored : to_end};
+    }
+
+    /* Frees the first count items of the last claim_read() */
+    void commit_read(size_t count) {
+        tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    size_t size() const {
+        // tail first: head can only have grown past it by the time it is read
+        const size_t t = tail.load(std::memory_order_acquire);
+        return head.load(std::memory_order_acquire) - t;
+    }
+
+    bool empty() const { return size() == 0; }
+};
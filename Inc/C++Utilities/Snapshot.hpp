@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Latest consistent copy of a struct that one writer, typically the control interrupt,
+ * publishes every cycle while the main loop reads it, e.g. to build telemetry packets. Neither
+ * side masks interrupts and the writer never waits: publish() is the copy plus two counter
+ * stores.
+ *
+ * Two buffers are kept. A publish writes the one readers are not pointed at, so a read only has
+ * to retry if two publishes start while it copies. A read preempted by a single control cycle
+ * never retries.
+ *
+ * Packets point at the fields of view() and call refresh() before building, so every field they
+ * send comes from the same control cycle.
+ */
+template <typename T> class Snapshot {
+    static_assert(std::is_trivially_copyable_v<T>, "Snapshot copies its value byte by byte");
+
+public:
+    Snapshot() = default;
+    explicit Snapshot(const T& initial) : buffers{initial, initial}, mirror(initial) {}
+
+    // Writer side, a single one
+    void publish(const T& value) {
+        const uint32_t next = published.load(std::memory_order_relaxed) + 1;
+        writing.store(next, std::memory_order_relaxed);
+        /* Readers that see any byte of the new value also see writing moved */
+        std::atomic_thread_fence(std::memory_order_release);
+        buffers[next & 1] = value;
+        published.store(next, std::memory_order_release);
+    }
+
+    // Reader side
+    /* Copies the latest value to out, false if it could have been overwritten meanwhile */
+    bool try_read(T& out) const {
+        uint32_t sequence;
+        return copy(out, sequence);
+    }
+
+    T read() const {
+        T out;
+        while (!try_read(out)) {
+        }
+        return out;
+    }
+
+    /* Publishes so far, tells a reader whether there is anything new */
+    uint32_t sequence() const { return published.load(std::memory_order_acquire); }
+
+    /* Copy owned by the reader, its fields stay put for packets to point at */
+    constexpr T& view() { return mirror; }
+    constexpr const T& view() const { return mirror; }
+
+    /* Updates view() to the latest value, returns whether it changed since the last refresh */
+    bool refresh() {
+        if (sequence() == refreshed) {
+            return false;
+        }
+        while (!copy(mirror, refreshed)) {
+        }
+        return true;
+    }
+
+private:
+    T buffers[2]{};
+    std::atomic<uint32_t> published{0};
+    std::atomic<uint32_t> writing{0};
+    T mirror{};
+    uint32_t refreshed = 0;
+
+    bool copy(T& out, uint32_t& sequence) const {
+        sequence = published.load(std::memory_order_acquire);
+        out = buffers[sequence & 1];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        /* One write started since is the one into the other buffer */
+        return writing.load(std::memory_order_relaxed) - sequence <= 1;
+    }
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief Sorted map over a fixed array, a drop-in for the std::map registries looked up at run
+ * time: find() is a binary search over contiguous entries and nothing is ever allocated. Inserting
+ * shifts the entries after the new key, so it is meant for registries filled at startup.
+ */
+template <typename Key, typename Value, size_t Capacity> class StaticFlatMap {
+public:
+    using value_type = std::pair<Key, Value>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    constexpr StaticFlatMap() = default;
+
+    constexpr iterator begin() { return entries.data(); }
+    constexpr const_iterator begin() const { return entries.data(); }
+    constexpr iterator end() { return entries.data() + size_; }
+    constexpr const_iterator end() const { return entries.data() + size_; }
+
+    constexpr iterator find(const Key& key) {
+        iterator it = lower_bound(key);
+        return it != end() && it->first == key ? it : end();
+    }
+    constexpr const_iterator find(const Key& key) const {
+        const_iterator it = lower_bound(key);
+        return it != end() && it->first == key ? it : end();
+    }
+
+    constexpr bool contains(const Key& key) const { return find(key) != end(); }
+
+    /* Inserts key or overwrites its value, false when the map is full */
+    constexpr bool insert_or_assign(const Key& key, const Value& value) {
+        iterator it = emplace(key);
+        if (it == end()) {
+            return false;
+        }
+        it->second = value;
+        return true;
+    }
+
+    /**
+     * @brief Value of key, inserted if missing. A full map hands out a scratch value instead and
+     * counts it in dropped(), check it once the registry has been filled.
+     */
+    constexpr Value& operator[](const Key& key) {
+        iterator it = emplace(key);
+        if (it == end()) {
+            dropped_++;
+            overflow = Value{};
+            return overflow;
+        }
+        return it->second;
+    }
+
+    constexpr bool erase(const Key& key) {
+        iterator it = find(key);
+        if (it == end()) {
+            return false;
+        }
+        std::move(it + 1, end(), it);
+        size_--;
+        return true;
+    }
+
+    constexpr void clear() { size_ = 0; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+    /* Keys that didn't fit through operator[] */
+    constexpr size_t dropped() const { return dropped_; }
+
+private:
+    std::array<value_type, Capacity> entries{};
+    size_t size_{0};
+    size_t dropped_{0};
+    Value overflow{};
+
+    constexpr iterator lower_bound(const Key& key) {
+        return std::lower_bound(begin(), end(), key, [](const value_type& e, const Key& k) {
+            return e.first < k;
+        });
+    }
+    constexpr const_iterator lower_bound(const Key& key) const {
+        return std::lower_bound(begin(), end(), key, [](const value_type& e, const Key& k) {
+            return e.first < k;
+        });
+    }
+
+    /* Entry of key, inserted in order if missing, end() when there is no room for it */
+    constexpr iterator emplace(const Key& key) {
+        iterator it = lower_bound(key);
+        if (it != end() && it->first == key) {
+            return it;
+        }
+        if (size_ >= Capacity) {
+            return end();
+        }
+        std::move_backward(it, end(), end() + 1);
+        *it = value_type{key, Value{}};
+        size_++;
+        return it;
+    }
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @brief FIFO over a fixed array with the std::queue interface, for queues used from a single
+ * context (for interrupt to main loop hand-off use SPSCQueue or MPSCQueue). push() returns false
+ * instead of growing, so the caller decides what to do with an item that doesn't fit.
+ */
+template <typename T, size_t Capacity> class StaticQueue {
+    static_assert(Capacity > 0, "StaticQueue needs room for at least one item");
+
+public:
+    constexpr StaticQueue() = default;
+
+    constexpr bool push(const T& item) {
+        if (full()) {
+            return false;
+        }
+        buffer[back_] = item;
+        back_ = next(back_);
+        size_++;
+        return true;
+    }
+
+    /* Drops the oldest item, false if there was none */
+    constexpr bool pop() {
+        if (empty()) {
+            return false;
+        }
+        front_ = next(front_);
+        size_--;
+        return true;
+    }
+
+    /* Oldest and newest items, only valid when not empty */
+    constexpr T& front() { return buffer[front_]; }
+    constexpr const T& front() const { return buffer[front_]; }
+    constexpr T& back() { return buffer[back_ == 0 ? Capacity - 1 : back_ - 1]; }
+    constexpr const T& back() const { return buffer[back_ == 0 ? Capacity - 1 : back_ - 1]; }
+
+    constexpr void clear() {
+        front_ = 0;
+        back_ = 0;
+        size_ = 0;
+    }
+
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr bool full() const { return size_ == Capacity; }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    std::array<T, Capacity> buffer{};
+    size_t front_{0};
+    size_t back_{0};
+    size_t size_{0};
+
+    static constexpr size_t next(size_t index) { return index + 1 == Capacity ? 0 : index + 1; }
+};
@@ -0,0 +1,238 @@
+/*
+ * Benchmark.hpp
+ *
+ * Minimal microbenchmark framework for the hot paths of the library. The same cases run on the
+ * board, timed with the DWT cycle counter, and on the simulator, timed with the host steady
+ * clock, and the results are written as JSON so they can be compared between commits.
+ *
+ * Cases are declared with ST_LIB_BENCHMARK(name) { setup; state.measure([&] { op; }); } and
+ * registered at static initialization in a fixed table, nothing is allocated.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+
+#ifdef SIM_ON
+#include <chrono>
+#else
+#include "HALAL/Benchmarking_toolkit/DataWatchpointTrace/DataWatchpointTrace.hpp"
+#endif
+
+namespace ST_LIB::Benchmark {
+
+/* Keeps the compiler from removing the computation of value or the writes before it */
+template <typename T> inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+struct Clock {
+    using count_t = uint64_t;
+
+#ifdef SIM_ON
+    static constexpr const char* unit = "ns";
+    /* a sample shorter than this is dominated by the clock itself */
+    static constexpr count_t min_sample = 20'000;
+
+    static void start() {}
+    static count_t now() {
+        return static_cast<count_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        std::chrono::steady_clock::now().time_since_epoch()
+        )
+                                        .count());
+    }
+    static count_t elapsed(count_t begin, count_t end) { return end - begin; }
+#else
+    static constexpr const char* unit = "cycles";
+    static constexpr count_t min_sample = 2'000;
+
+    /* Shares the counter with the profiler, it is never reset */
+    static void start() { DataWatchpointTrace::start_free_running(); }
+    static count_t now() { return DataWatchpointTrace::get_count(); }
+    /* CYCCNT is 32 bits, it wraps every ~7 s at 550 MHz */
+    static count_t elapsed(count_t begin, count_t end) {
+        return DataWatchpointTrace::elapsed(
+            static_cast<uint32_t>(begin),
+            static_cast<uint32_t>(end)
+        );
+    }
+#endif
+};
+
+struct Result {
+    const char* name{nullptr};
+    uint32_t batch{0};
+    uint32_t samples{0};
+    double min{0};
+    double median{0};
+    double mean{0};
+    double max{0};
+};
+
+struct Options {
+    /* only the cases whose name contains it, all of them if nullptr */
+    const char* filter{nullptr};
+    uint32_t samples{31};
+    /* upper bound of the calibrated batch, lower it for a quick smoke run */
+    uint32_t max_batch{1U << 20};
+};
+
+/**
+ * @brief Handed to every case. measure() runs op in batches long enough for the clock
+ * resolution, takes options.samples of them and keeps the per-op statistics in result.
+ */
+class State {
+public:
+    static constexpr std::size_t kMaxSamples = 64;
+
+    State(const char* name, const Options& options) : options(options) { result.name = name; }
+
+    template <typename Op> void measure(Op&& op) {
+        op();
+
+        uint32_t batch = 1;
+        while (batch < options.max_batch && time(op, batch) < Clock::min_sample) {
+            batch *= 2;
+        }
+
+        const uint32_t n = options.samples == 0 ? 1U
+                         : options.samples > kMaxSamples ? static_cast<uint32_t>(kMaxSamples)
+                                                          : options.samples;
+        std::array<double, kMaxSamples> per_op{};
+        double sum = 0;
+        for (uint32_t s = 0; s < n; s++) {
+            per_op[s] = static_cast<double>(time(op, batch)) / batch;
+            sum += per_op[s];
+        }
+        sort(per_op.data(), n);
+
+        result.batch = batch;
+        result.samples = n;
+        result.min = per_op[0];
+        result.median = per_op[n / 2];
+        result.mean = sum / n;
+        result.max = per_op[n - 1];
+    }
+
+    bool measured() const { return result.samples != 0; }
+
+    Result result;
+
+private:
+    const Options& options;
+
+    template <typename Op> static Clock::count_t time(Op& op, uint32_t batch) {
+        clobber_memory();
+        const Clock::count_t begin = Clock::now();
+        for (uint32_t i = 0; i < batch; i++) {
+            op();
+        }
+        clobber_memory();
+        return Clock::elapsed(begin, Clock::now());
+    }
+
+    static void sort(double* values, uint32_t n) {
+        for (uint32_t i = 1; i < n; i++) {
+            const double value = values[i];
+            uint32_t j = i;
+            for (; j > 0 && values[j - 1] > value; j--) {
+                values[j] = values[j - 1];
+            }
+            values[j] = value;
+        }
+    }
+};
+
+using case_t = void (*)(State& state);
+
+class Registry {
+public:
+    static constexpr std::size_t kMaxCases = 64;
+
+    struct Case {
+        const char* name;
+        case_t body;
+    };
+
+    static bool add(const char* name, case_t body) {
+        if (count >= kMaxCases) {
+            return false;
+        }
+        cases[count++] = {name, body};
+        return true;
+    }
+
+    static std::span<const Case> all() { return {cases.data(), count}; }
+
+private:
+    static inline std::array<Case, kMaxCases> cases{};
+    static inline std::size_t count{0};
+};
+
+/* Receives the JSON report piece by piece: stdout, a file, a UART... */
+using sink_t = void (*)(const char* text, void* context);
+
+/**
+ * @brief Runs the registered cases and writes
+ * {"unit": ..., "results": [{"name", "batch", "samples", "min", "median", "mean", "max"}...]}
+ * with the per-op figures in Clock::unit.
+ *
+ * @return number of cases measured.
+ */
+inline std::size_t run_all(sink_t sink, void* context = nullptr, const Options& options = {}) {
+    char line[192];
+    Clock::start();
+
+    std::snprintf(line, sizeof(line), "{\"unit\": \"%s\", \"results\": [", Clock::unit);
+    sink(line, context);
+
+    std::size_t measured = 0;
+    for (const Registry::Case& c : Registry::all()) {
+        if (options.filter != nullptr && std::strstr(c.name, options.filter) == nullptr) {
+            continue;
+        }
+        State state(c.name, options);
+        c.body(state);
+        if (!state.measured()) {
+            continue;
+        }
+        const Result& r = state.result;
+        std::snprintf(
+            line,
+            sizeof(line),
+            "%s\n  {\"name\": \"%s\", \"batch\": %lu, \"samples\": %lu, \"min\": %.2f, "
+            "\"median\": %.2f, \"mean\": %.2f, \"max\": %.2f}",
+            measured == 0 ? "" : ",",
+            r.name,
+            static_cast<unsigned long>(r.batch),
+            static_cast<unsigned long>(r.samples),
+            r.min,
+            r.median,
+            r.mean,
+            r.max
+        );
+        sink(line, context);
+        measured++;
+    }
+
+    sink("\n]}\n", context);
+    return measured;
+}
+
+} // namespace ST_LIB::Benchmark
+
+#define ST_LIB_BENCHMARK_CAT_(a, b) a##b
+#define ST_LIB_BENCHMARK_CAT(a, b) ST_LIB_BENCHMARK_CAT_(a, b)
+
+/* Declares and registers a case, the body receives ST_LIB::Benchmark::State& state */
+#define ST_LIB_BENCHMARK(case_name)                                                                \
+    static void ST_LIB_BENCHMARK_CAT(bench_, case_name)(ST_LIB::Benchmark::State & state);         \
+    [[maybe_unused]] static const bool ST_LIB_BENCHMARK_CAT(bench_registered_, case_name) =        \
+        ST_LIB::Benchmark::Registry::add(#case_name, ST_LIB_BENCHMARK_CAT(bench_, case_name));     \
+    static void ST_LIB_BENCHMARK_CAT(bench_, case_name)(ST_LIB::Benchmark::State & state)
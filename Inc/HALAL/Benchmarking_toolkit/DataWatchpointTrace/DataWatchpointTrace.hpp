@@ -22,36 +22,44 @@
 */
 /*
  To use this class you should use:
-    - start_count() -> and store in a variable the CYCCNT (this should be really close to zero)
+    - start_count() -> and store in a variable the actual CYCCNT
     - stop_count() -> and store in a variable the actual CYCCNT.
-    The difference will be the number of clock cycles done in the algorithm
+    elapsed(start, stop) will be the number of clock cycles done in the algorithm
+
+ None of them resets or stops the counter: the profiler, the benchmarks and the EXTI debounce
+ share it, so it is left free running and readings are subtracted, which stays right across the
+ 32 bit wrap.
 */
 class DataWatchpointTrace {
 public:
     static void start() {
         unlock_dwt();
-        reset_cnt();
+        start_free_running();
     }
     static unsigned int start_count() {
-        DWT->CTRL |= DWT_CTRL_CYCCNTENA; // enables the counter
-        DWT->CYCCNT = 0;
+        start_free_running();
         return DWT->CYCCNT;
     }
     static unsigned int stop_count() {
-        DWT->CTRL &= ~DWT_CTRL_CYCCNTENA; // disable the counter
-        return DWT->CYCCNT;
+        return DWT->CYCCNT; // the counter keeps running for whoever else reads it
     }
     static unsigned int get_count() {
         return DWT->CYCCNT; // returns the current value of the counter
     }
-
-private:
-    static void reset_cnt() {
+    /* Enables the counter if it isn't running, without touching its value */
+    static void start_free_running() {
+        if (is_running()) {
+            return;
+        }
         CoreDebug->DEMCR |= DEMCR_TRCENA;
-        DWT->CYCCNT = 0; // reset the counter
-        DWT->CTRL = 0;
+        unlock_dwt();
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA;
     }
+    static bool is_running() { return (DWT->CTRL & DWT_CTRL_CYCCNTENA) != 0; }
+    /* Cycles from begin to end, right as long as they are less than 2^32 apart */
+    static uint32_t elapsed(uint32_t begin, uint32_t end) { return end - begin; }
 
+private:
     static void unlock_dwt() { // unlock the dwt
         uint32_t lsr = DWT->LSR;
         if ((lsr & DWT_LSR_Present_Msk) != 0) {
@@ -0,0 +1,281 @@
+/*
+ * Profiler.hpp
+ *
+ * Scoped cycle profiler on the free running DWT cycle counter. Zones are marked with
+ * ST_LIB_PROFILE_ZONE("name") at the top of a scope and may nest, so a whole control loop call
+ * tree can be profiled: every zone keeps its count, total, self (total minus nested zones), min and
+ * max cycles, and the zone it was entered from. Nothing is allocated, zones take a slot of a fixed
+ * table when the program starts and entering/leaving one is a couple of counter reads.
+ *
+ * Interrupts may use zones too, they nest on the same stack because they return before the code
+ * they preempt, and their cycles are taken out of the self time of the zone they preempted. A
+ * same zone shouldn't be used from two priority levels, its statistics aren't updated atomically.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "HALAL/Benchmarking_toolkit/DataWatchpointTrace/DataWatchpointTrace.hpp"
+#include "HALAL/Models/Packets/Packet.hpp"
+
+#ifndef STLIB_PROFILER_MAX_ZONES
+#define STLIB_PROFILER_MAX_ZONES 32
+#endif
+
+/* Raw samples kept for offline analysis, 0 disables the ring */
+#ifndef STLIB_PROFILER_RING_SIZE
+#define STLIB_PROFILER_RING_SIZE 64
+#endif
+
+namespace ST_LIB {
+
+/* Name of a zone as a template argument, its hash identifies the zone in the reports */
+template <std::size_t N> struct ProfileZoneName {
+    char value[N]{};
+    uint32_t hash{2'166'136'261U};
+
+    consteval ProfileZoneName(const char (&name)[N]) {
+        for (std::size_t i = 0; i < N; i++) {
+            value[i] = name[i];
+            if (i + 1 < N) {
+                hash = (hash ^ static_cast<uint8_t>(name[i])) * 16'777'619U;
+            }
+        }
+    }
+};
+
+class Profiler {
+public:
+    static constexpr std::size_t kMaxZones = STLIB_PROFILER_MAX_ZONES;
+    static constexpr std::size_t kMaxDepth = 16;
+    static constexpr std::size_t kRingSize = STLIB_PROFILER_RING_SIZE;
+    static constexpr uint8_t NO_ZONE = 0xFF;
+
+    static_assert(kMaxZones < NO_ZONE, "zone ids are uint8_t");
+    static_assert((kRingSize & (kRingSize - 1)) == 0, "kRingSize must be a power of two");
+
+    struct ZoneStats {
+        uint32_t count{0};
+        uint32_t min{UINT32_MAX};
+        uint32_t max{0};
+        uint64_t total{0};
+        uint64_t self{0};
+        uint8_t parent{NO_ZONE};
+    };
+
+    struct Sample {
+        uint8_t zone;
+        uint8_t depth;
+        uint32_t start;
+        uint32_t cycles;
+    };
+
+    /* Snapshot sent by the report packet, packed so it can be copied to any buffer offset */
+    struct __attribute__((packed)) Report {
+        uint32_t timestamp;
+        uint8_t zone_count;
+        uint32_t dropped;
+        uint32_t hash[kMaxZones];
+        uint8_t parent[kMaxZones];
+        uint32_t count[kMaxZones];
+        uint32_t min[kMaxZones];
+        uint32_t max[kMaxZones];
+        uint64_t total[kMaxZones];
+        uint64_t self[kMaxZones];
+    };
+
+    /* Starts the cycle counter, if it wasn't, and clears the statistics */
+    static void start() {
+        DataWatchpointTrace::start_free_running();
+        reset();
+    }
+
+    /* Clears statistics and samples, zones stay registered. Not from inside a zone */
+    static void reset() {
+        for (ZoneStats& s : stats) {
+            s = ZoneStats{};
+        }
+        depth = 0;
+        dropped = 0;
+        samples_written = 0;
+    }
+
+    /**
+     * @brief Takes a slot for a zone, called once per zone when the program starts.
+     *
+     * @return zone id, NO_ZONE when the table is full. Such zones still nest but aren't measured.
+     */
+    static uint8_t register_zone(const char* name, uint32_t hash) {
+        for (uint8_t id = 0; id < zone_count; id++) {
+            if (hashes[id] == hash) {
+                return id;
+            }
+        }
+        if (zone_count >= kMaxZones) {
+            return NO_ZONE;
+        }
+        names[zone_count] = name;
+        hashes[zone_count] = hash;
+        return zone_count++;
+    }
+
+    static void enter(uint8_t zone) {
+        /* the level is taken before the slot is written, an interrupt in between uses the next */
+        const uint32_t level = depth;
+        depth = level + 1;
+        if (level >= kMaxDepth) [[unlikely]] {
+            dropped++;
+            return;
+        }
+        Frame& frame = stack[level];
+        frame.zone = zone;
+        frame.children = 0;
+        frame.start = DataWatchpointTrace::get_count();
+    }
+
+    static void leave() {
+        const uint32_t end = DataWatchpointTrace::get_count();
+        const uint32_t level = depth - 1;
+        if (level >= kMaxDepth) [[unlikely]] {
+            depth = level;
+            return;
+        }
+        const Frame frame = stack[level];
+        depth = level;
+
+        const uint32_t cycles = DataWatchpointTrace::elapsed(frame.start, end);
+        const uint8_t parent = level == 0 ? NO_ZONE : stack[level - 1].zone;
+        if (level != 0) {
+            stack[level - 1].children += cycles;
+        }
+        if (frame.zone >= kMaxZones) [[unlikely]] {
+            return;
+        }
+
+        ZoneStats& s = stats[frame.zone];
+        s.count++;
+        s.total += cycles;
+        s.self += cycles - frame.children;
+        s.min = cycles < s.min ? cycles : s.min;
+        s.max = cycles > s.max ? cycles : s.max;
+        s.parent = parent;
+
+        if constexpr (kRingSize != 0) {
+            ring[samples_written++ & (kRingSize - 1)] = {
+                .zone = frame.zone,
+                .depth = static_cast<uint8_t>(level),
+                .start = frame.start,
+                .cycles = cycles,
+            };
+        }
+    }
+
+    static std::size_t zones() { return zone_count; }
+    static const char* name(uint8_t zone) { return zone < zone_count ? names[zone] : nullptr; }
+    static uint32_t hash(uint8_t zone) { return zone < zone_count ? hashes[zone] : 0; }
+    static const ZoneStats& zone_stats(uint8_t zone) { return stats[zone]; }
+
+    /* Zones entered past kMaxDepth since the last reset */
+    static uint32_t dropped_zones() { return dropped; }
+
+    /**
+     * @brief Copies the last samples, oldest first, into out.
+     *
+     * @return number of samples copied.
+     */
+    static std::size_t copy_samples(std::span<Sample> out) {
+        if constexpr (kRingSize == 0) {
+            return 0;
+        } else {
+            const uint32_t written = samples_written;
+            const std::size_t available = written < kRingSize ? written : kRingSize;
+            const std::size_t n = available < out.size() ? available : out.size();
+            const uint32_t first = written - static_cast<uint32_t>(n);
+            for (std::size_t i = 0; i < n; i++) {
+                out[i] = ring[(first + i) & (kRingSize - 1)];
+            }
+            return n;
+        }
+    }
+
+    /* Fills report with the current statistics, what the report packet sends */
+    static const Report& snapshot() {
+        report.timestamp = DataWatchpointTrace::get_count();
+        report.zone_count = zone_count;
+        report.dropped = dropped;
+        for (std::size_t id = 0; id < kMaxZones; id++) {
+            const ZoneStats& s = stats[id];
+            report.hash[id] = hashes[id];
+            report.parent[id] = s.parent;
+            report.count[id] = s.count;
+            report.min[id] = s.count == 0 ? 0 : s.min;
+            report.max[id] = s.max;
+            report.total[id] = s.total;
+            report.self[id] = s.self;
+        }
+        return report;
+    }
+
+    static inline Report report{};
+
+private:
+    struct Frame {
+        uint8_t zone;
+        uint32_t start;
+        uint32_t children;
+    };
+
+    static std::array<ZoneStats, kMaxZones> stats;
+    static inline std::array<const char*, kMaxZones> names{};
+    static inline std::array<uint32_t, kMaxZones> hashes{};
+    static inline uint8_t zone_count{0};
+
+    static inline std::array<Frame, kMaxDepth> stack{};
+    static inline volatile uint32_t depth{0};
+    static inline uint32_t dropped{0};
+
+    static inline std::array<Sample, (kRingSize == 0 ? 1 : kRingSize)> ring{};
+    static inline uint32_t samples_written{0};
+};
+
+/* Out of the class, ZoneStats member initializers aren't usable inside it */
+inline std::array<Profiler::ZoneStats, Profiler::kMaxZones> Profiler::stats{};
+
+/* Measures its own lifetime as the zone Name */
+template <ProfileZoneName Name> class ProfileZone {
+public:
+    static inline const uint8_t id = Profiler::register_zone(Name.value, Name.hash);
+
+    ProfileZone() { Profiler::enter(id); }
+    ~ProfileZone() { Profiler::leave(); }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+/**
+ * @brief Packet carrying Profiler::Report, the statistics are taken when it is built. Send it
+ * periodically from a Scheduler task through a DatagramSocket, or its build()/get_size() bytes
+ * through UART. Zones are told apart by the FNV-1a hash of their name.
+ */
+class ProfilerPacket : public StackPacket<sizeof(Profiler::Report), Profiler::Report> {
+public:
+    explicit ProfilerPacket(uint16_t id)
+        : StackPacket<sizeof(Profiler::Report), Profiler::Report>(id, &Profiler::report) {}
+
+    uint8_t* build() override {
+        Profiler::snapshot();
+        return StackPacket<sizeof(Profiler::Report), Profiler::Report>::build();
+    }
+};
+
+} // namespace ST_LIB
+
+#define ST_LIB_PROFILE_CAT_(a, b) a##b
+#define ST_LIB_PROFILE_CAT(a, b) ST_LIB_PROFILE_CAT_(a, b)
+
+/* Profiles the rest of the enclosing scope as zone name, a string literal */
+#define ST_LIB_PROFILE_ZONE(name)                                                                  \
+    ST_LIB::ProfileZone<name> ST_LIB_PROFILE_CAT(stlib_profile_zone_, __LINE__) {}
@@ -22,6 +22,7 @@
 
 #include "HALAL/Services/PWM/DualPWM.hpp"
 #include "HALAL/Services/PWM/PWM.hpp"
+#include "HALAL/Services/PWM/PWMGroup.hpp"
 
 #include "HALAL/Services/Time/RTC.hpp"
 #include "HALAL/Services/Time/Scheduler.hpp"
@@ -31,12 +32,14 @@
 #include "HALAL/Services/EXTI/EXTI.hpp"
 #include "HALAL/Services/Encoder/Encoder.hpp"
 #include "HALAL/Services/Encoder/NewEncoder.hpp"
+#include "HALAL/Services/Encoder/EncoderEdgeCapture.hpp"
 #include "HALAL/Services/InputCapture/InputCapture.hpp"
 
 #include "HALAL/Services/Communication/FDCAN/FDCAN.hpp"
 #include "HALAL/Services/Communication/I2C/I2C.hpp"
 #include "HALAL/Models/SPI/SPI2.hpp"
 #include "HALAL/Services/Communication/SPI/SPI.hpp"
+#include "HALAL/Services/Communication/SPI/SPIAcquisition.hpp"
 #include "HALAL/Services/Communication/UART/UART.hpp"
 
 #include "HALAL/Services/CORDIC/CORDIC.hpp"
@@ -51,6 +54,7 @@
 #include "HALAL/Models/Concepts/Concepts.hpp"
 #include "HALAL/Models/MDMA/MDMA.hpp"
 #include "HALAL/Models/Packets/MdmaPacket.hpp"
+#include "HALAL/Models/Packets/PacketDomain.hpp"
 
 #include "HALAL/Benchmarking_toolkit/DataWatchpointTrace/DataWatchpointTrace.hpp"
 #include "HALAL/HardFault/HardfaultTrace.h"
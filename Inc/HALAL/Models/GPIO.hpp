@@ -2,6 +2,7 @@
 
 #include "hal_wrapper.h"
 #include <array>
+#include <bit>
 #include <span>
 #include <tuple>
 
@@ -259,6 +260,64 @@ struct GPIODomain {
         GPIO_PinState read() { return HAL_GPIO_ReadPin(port, pin); }
     };
 
+    /**
+     * @brief Pins of one port fixed at compile time. Every access is a single BSRR store or IDR
+     * load with a constant mask, so several pins change in one atomic write and no read-modify-
+     * write of ODR is needed. Values passed to write() and returned by read() keep the port bit
+     * positions (GPIO_PIN_x). The pins still have to be inscribed as outputs/inputs so they are
+     * configured by GPIODomain.
+     */
+    template <Port port, uint32_t mask> struct PortPins {
+        static_assert(mask != 0 && mask <= 0xFFFFU, "Invalid GPIO pin mask");
+
+        static inline GPIO_TypeDef* reg() { return port_to_reg(port); }
+
+        static inline void set() { reg()->BSRR = mask; }
+
+        static inline void clear() { reg()->BSRR = mask << 16; }
+
+        static inline void write(uint32_t value) {
+            reg()->BSRR = (value & mask) | ((~value & mask) << 16);
+        }
+
+        static inline void toggle() {
+            const uint32_t odr = reg()->ODR;
+            reg()->BSRR = ((odr & mask) << 16) | (~odr & mask);
+        }
+
+        static inline uint32_t read() { return reg()->IDR & mask; }
+    };
+
+    template <const Pin&... pins> struct PinGroupOf {
+        static_assert(sizeof...(pins) > 0, "A pin group needs at least one pin");
+        static constexpr Port port = std::get<0>(std::tie(pins...)).port;
+        static_assert(((pins.port == port) && ...), "All pins of a group must be on the same port");
+        static constexpr uint32_t mask = (pins.pin | ...);
+        static_assert(
+            std::popcount(mask) == sizeof...(pins),
+            "The same pin is repeated in a pin group"
+        );
+        using type = PortPins<port, mask>;
+    };
+
+    /* PinGroup<PB0, PB1, PB5>::set() drives the three pins high in one BSRR write */
+    template <const Pin&... pins> using PinGroup = typename PinGroupOf<pins...>::type;
+
+    template <Port port, uint32_t mask> struct FastPortPin : PortPins<port, mask> {
+        static_assert(std::popcount(mask) == 1, "A fast pin is a single pin");
+
+        static inline void turn_on() { PortPins<port, mask>::set(); }
+
+        static inline void turn_off() { PortPins<port, mask>::clear(); }
+
+        static inline GPIO_PinState read() {
+            return PortPins<port, mask>::read() ? GPIO_PIN_SET : GPIO_PIN_RESET;
+        }
+    };
+
+    /* Drop-in for Instance when the pin is known at compile time: FastPin<PA8>::turn_on() */
+    template <const Pin& pin> using FastPin = FastPortPin<pin.port, pin.pin>;
+
     template <std::size_t N> struct Init {
         static inline std::array<Instance, N> instances{};
 
@@ -9,24 +9,29 @@
 #include "HALAL/Models/Packets/Packet.hpp"
 #include "HALAL/Models/Packets/OrderProtocol.hpp"
 
+#ifndef STLIB_MAX_ORDERS
+#define STLIB_MAX_ORDERS 128
+#endif
+
 class Order : public Packet {
 public:
     string* remote_ip;
-    static map<uint16_t, Order*> orders;
+    static StaticFlatMap<uint16_t, Order*, STLIB_MAX_ORDERS> orders;
     virtual void set_callback(void (*callback)(void)) = 0;
     virtual void process() = 0;
     virtual void parse(OrderProtocol* socket, uint8_t* data) = 0;
     void store_ip_order(string& ip) { remote_ip = &ip; }
     void parse(uint8_t* data) override { parse(nullptr, data); }
     static void process_by_id(uint16_t id) {
-        if (orders.find(id) != orders.end())
-            orders[id]->process();
+        auto order = orders.find(id);
+        if (order != orders.end())
+            order->second->process();
     }
     static void process_data(OrderProtocol* socket, uint8_t* data) {
-        uint16_t id = Packet::get_id(data);
-        if (orders.contains(id)) {
-            orders[id]->parse(socket, data);
-            orders[id]->process();
+        auto order = orders.find(Packet::get_id(data));
+        if (order != orders.end()) {
+            order->second->parse(socket, data);
+            order->second->process();
         }
     }
 };
@@ -3,6 +3,11 @@
 #include "HALAL/Models/Packets/PacketValue.hpp"
 #include "HALAL/Models/DataStructures/StackTuple.hpp"
 
+/* Packets with distinct ids a board can declare, the registry is a fixed table */
+#ifndef STLIB_MAX_PACKETS
+#define STLIB_MAX_PACKETS 128
+#endif
+
 class Packet {
 public:
     size_t size;
@@ -13,13 +18,13 @@ public:
     virtual void set_pointer(size_t index, void* pointer) = 0;
     static uint16_t get_id(uint8_t* data) { return *((uint16_t*)data); }
     static void parse_data(uint8_t* data) {
-        uint16_t id = get_id(data);
-        if (packets.contains(id))
-            packets[id]->parse(data);
+        auto packet = packets.find(get_id(data));
+        if (packet != packets.end())
+            packet->second->parse(data);
     }
 
 protected:
-    static map<uint16_t, Packet*> packets;
+    static StaticFlatMap<uint16_t, Packet*, STLIB_MAX_PACKETS> packets;
 };
 
 template <size_t BufferLength, class... Types> class StackPacket : public Packet {
@@ -0,0 +1,235 @@
+/*
+ * PacketDomain.hpp
+ *
+ * Telemetry packets declared with the board instead of constructed at runtime. Each packet is a
+ * constexpr device that lives in flash, its id and layout are checked against every other packet
+ * of the board when the board is built, and its buffer is carved out of a single static arena
+ * sized at compile time. Nothing is inserted in Packet::packets and nothing goes to the heap:
+ *
+ *   float speed, current;
+ *   constexpr ST_LIB::Telemetry speed_packet{100, &speed, &current};
+ *   using MyBoard = ST_LIB::Board<..., speed_packet>;
+ *
+ *   auto& packet = MyBoard::instance_of<speed_packet>();
+ *   socket.send(packet.build());
+ *   ST_LIB::PacketDomain::parse(data, size);
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+#include "ErrorHandler/ErrorHandler.hpp"
+
+#ifndef PACKET_DOMAIN_MAX_INSTANCES
+#define PACKET_DOMAIN_MAX_INSTANCES 64
+#endif
+
+/* UDP payload of a 1500 byte Ethernet frame */
+#ifndef PACKET_DOMAIN_MAX_SIZE
+#define PACKET_DOMAIN_MAX_SIZE 1472
+#endif
+
+namespace ST_LIB {
+extern void compile_error(const char* msg);
+
+struct PacketDomain {
+    using WriteFn = void (*)(const void* device, uint8_t* data);
+    using ReadFn = void (*)(const void* device, const uint8_t* data);
+
+    struct Entry {
+        uint16_t id;
+        size_t size;
+        const void* device;
+        WriteFn write;
+        ReadFn read;
+    };
+
+    struct Config {
+        uint16_t id;
+        size_t size;
+        /* Position of the packet in the arena, after every packet declared before it */
+        size_t offset;
+        const void* device;
+        WriteFn write;
+        ReadFn read;
+        /* Index of the packet at this position of the table sorted by id */
+        uint16_t by_id;
+    };
+
+    struct Instance {
+        uint16_t id;
+        std::span<uint8_t> buffer;
+        const void* device;
+        WriteFn write;
+        ReadFn read;
+
+        /* Copies the current values after the id, the span is valid until the next build */
+        std::span<const uint8_t> build() {
+            write(device, buffer.data() + sizeof(id));
+            return buffer;
+        }
+
+        /* data starts with the id, size is checked by PacketDomain::parse */
+        void parse(const uint8_t* data) { read(device, data + sizeof(id)); }
+    };
+
+    static constexpr size_t max_instances = PACKET_DOMAIN_MAX_INSTANCES;
+    static constexpr size_t max_packet_size = PACKET_DOMAIN_MAX_SIZE;
+
+    /* Ids the protections and their notifications send with, see Boundary.hpp */
+    static constexpr std::array<uint16_t, 22> reserved_ids{
+        2,    3,    1000, 1111, 1222, 1333, 1444, 1555, 1666, 2000, 2111,
+        2222, 2333, 2444, 2555, 2666, 3000, 3111, 3222, 3666, 4000, 4001,
+    };
+
+    template <std::size_t N>
+    static consteval std::array<Config, N> build(std::span<const Entry> entries) {
+        std::array<Config, N> cfgs{};
+        size_t offset = 0;
+        for (std::size_t i = 0; i < N; i++) {
+            const Entry& e = entries[i];
+            if (e.size > max_packet_size) {
+                compile_error("Packet larger than PACKET_DOMAIN_MAX_SIZE");
+            }
+            if (std::ranges::find(reserved_ids, e.id) != reserved_ids.end()) {
+                compile_error("Packet id is reserved for protections");
+            }
+            for (std::size_t j = 0; j < i; j++) {
+                if (entries[j].id == e.id) {
+                    compile_error("Two packets share the same id");
+                }
+            }
+            cfgs[i] = {e.id, e.size, offset, e.device, e.write, e.read, 0};
+            offset += e.size;
+        }
+        for (std::size_t i = 0; i < N; i++) {
+            std::size_t rank = 0;
+            for (std::size_t j = 0; j < N; j++) {
+                rank += entries[j].id < entries[i].id;
+            }
+            cfgs[rank].by_id = static_cast<uint16_t>(i);
+        }
+        return cfgs;
+    }
+
+    template <std::size_t N> static constexpr size_t arena_size(const std::array<Config, N>& cfgs) {
+        size_t size = 0;
+        for (const Config& cfg : cfgs) {
+            size += cfg.size;
+        }
+        return size;
+    }
+
+    /* The arena size comes from arena_size(cfgs), the configs can't be a template argument as
+     * GCC doesn't take function pointers inside one */
+    template <std::size_t N, std::size_t ArenaSize> struct Init {
+        alignas(8) static inline std::array<uint8_t, ArenaSize> arena{};
+        static inline std::array<Instance, N> instances{};
+        static inline std::array<uint16_t, N> by_id{};
+
+        static void init(const std::array<Config, N>& cfgs) {
+            for (std::size_t i = 0; i < N; i++) {
+                const Config& cfg = cfgs[i];
+                if (cfg.offset + cfg.size > ArenaSize) {
+                    ErrorHandler("Packet arena smaller than its packets");
+                    return;
+                }
+                instances[i] = {
+                    cfg.id,
+                    std::span<uint8_t>(arena.data() + cfg.offset, cfg.size),
+                    cfg.device,
+                    cfg.write,
+                    cfg.read,
+                };
+                std::memcpy(instances[i].buffer.data(), &cfg.id, sizeof(cfg.id));
+                by_id[i] = cfg.by_id;
+            }
+            lookup = &find;
+        }
+
+        static Instance* find(uint16_t id) {
+            auto it = std::ranges::lower_bound(by_id, id, {}, [](uint16_t i) {
+                return instances[i].id;
+            });
+            if (it == by_id.end() || instances[*it].id != id) {
+                return nullptr;
+            }
+            return &instances[*it];
+        }
+    };
+
+    /**
+     * @brief Hands a received packet to the board packet with its id. Returns false if the board
+     * declares no such packet or data is shorter than its layout.
+     */
+    static bool parse(const uint8_t* data, size_t size) {
+        uint16_t id;
+        if (lookup == nullptr || size < sizeof(id)) {
+            return false;
+        }
+        std::memcpy(&id, data, sizeof(id));
+        Instance* instance = lookup(id);
+        if (instance == nullptr || size < instance->buffer.size()) {
+            return false;
+        }
+        instance->parse(data);
+        return true;
+    }
+
+    static inline Instance* (*lookup)(uint16_t id) = nullptr;
+};
+
+template <class Device> void packet_write(const void* device, uint8_t* data) {
+    std::apply(
+        [&](auto*... values) {
+            ((std::memcpy(data, values, sizeof(*values)), data += sizeof(*values)), ...);
+        },
+        static_cast<const Device*>(device)->values
+    );
+}
+
+template <class Device> void packet_read(const void* device, const uint8_t* data) {
+    std::apply(
+        [&](auto*... values) {
+            ((std::memcpy(values, data, sizeof(*values)), data += sizeof(*values)), ...);
+        },
+        static_cast<const Device*>(device)->values
+    );
+}
+
+/**
+ * @brief A packet of the board: an id and the variables it carries, sent in declaration order
+ * without padding. Declare it constexpr, the values must be trivially copyable variables with
+ * static storage.
+ */
+template <class... Types> struct Telemetry {
+    static_assert(
+        (std::is_trivially_copyable_v<Types> && ...),
+        "Telemetry values are copied byte by byte"
+    );
+
+    using domain = PacketDomain;
+
+    static constexpr size_t size = sizeof(uint16_t) + (sizeof(Types) + ... + 0);
+
+    uint16_t id;
+    std::tuple<Types*...> values;
+
+    consteval Telemetry(uint16_t id, Types*... values) : id(id), values(values...) {}
+
+    template <class Ctx> consteval void inscribe(Ctx& ctx) const {
+        ctx.template add<PacketDomain>(
+            {id, size, this, &packet_write<Telemetry>, &packet_read<Telemetry>},
+            this
+        );
+    }
+};
+
+} // namespace ST_LIB
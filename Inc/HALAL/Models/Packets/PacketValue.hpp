@@ -95,6 +95,25 @@ public:
     void copy_to(uint8_t* data) override { memcpy(data, src->data(), get_size()); }
 };
 
+/* Same wire format as string, the characters and the terminating null */
+template <size_t Capacity> class PacketValue<InlineString<Capacity>> : public PacketValue<> {
+public:
+    using value_type = InlineString<Capacity>;
+    InlineString<Capacity>* src = nullptr;
+    PacketValue() = default;
+    PacketValue(InlineString<Capacity>* src) : src(src) {}
+    ~PacketValue() = default;
+    void* get_pointer() override { return src->data(); }
+
+    void set_pointer(void* pointer) { src = (InlineString<Capacity>*)pointer; }
+
+    size_t get_size() override { return src->size() + 1; }
+    void parse(uint8_t* data) override {
+        src->assign(std::string_view(reinterpret_cast<const char*>(data)));
+    }
+    void copy_to(uint8_t* data) override { memcpy(data, src->c_str(), get_size()); }
+};
+
 template <class Type, size_t N> class PacketValue<Type (&)[N]> : public PacketValue<> {
 public:
     using value_type = Type;
@@ -502,6 +502,29 @@ struct SPIDomain {
      */
     template <std::size_t N> struct Init;                             // Forward declaration
     template <auto& device_request, bool IsMaster> struct SPIWrapper; // Forward declaration
+
+    /**
+     * @brief Completion callback of a queued transaction. Runs in the SPI interrupt, after the
+     * next queued transaction has already been started.
+     */
+    using TransactionCallback = void (*)(void* context, bool success);
+
+    /**
+     * @brief A DMA transfer waiting in the per-peripheral queue. Higher priority transactions are
+     * started first, transactions with the same priority keep their enqueue order.
+     */
+    struct Transaction {
+        const uint8_t* tx_data = nullptr; // nullptr for receive only
+        uint8_t* rx_data = nullptr;       // nullptr for transmit only
+        uint16_t frames = 0;
+        GPIODomain::Instance* nss = nullptr; // Optional software NSS, held low while active
+        TransactionCallback callback = nullptr;
+        void* context = nullptr;
+        uint8_t priority = 0;
+    };
+
+    static constexpr std::size_t transaction_queue_capacity = 8;
+
     struct Instance {
         template <std::size_t> friend struct Init;
         template <auto&, bool> friend struct SPIWrapper;
@@ -524,6 +547,86 @@ struct SPIDomain {
         volatile uint32_t error_count = 0;
         volatile bool was_aborted = false;
 
+        IRQn_Type irqn = SPI1_IRQn;
+        std::array<Transaction, transaction_queue_capacity> queue{};
+        volatile std::size_t queue_count = 0;
+        Transaction active_transaction{};
+        volatile bool transaction_active = false;
+
+        // Queue helpers below must run with the SPI interrupt masked or from the interrupt itself
+
+        bool push_transaction(const Transaction& transaction) {
+            std::size_t pos = queue_count;
+            if (pos >= transaction_queue_capacity) [[unlikely]] {
+                return false;
+            }
+            while (pos > 0 && queue[pos - 1].priority < transaction.priority) {
+                queue[pos] = queue[pos - 1];
+                pos--;
+            }
+            queue[pos] = transaction;
+            queue_count = queue_count + 1;
+            return true;
+        }
+
+        void start_next_transaction() {
+            while (queue_count > 0) {
+                const std::size_t count = queue_count;
+                active_transaction = queue[0];
+                for (std::size_t i = 1; i < count; i++) {
+                    queue[i - 1] = queue[i];
+                }
+                queue_count = count - 1;
+
+                auto& t = active_transaction;
+                if (t.nss != nullptr) {
+                    t.nss->turn_off();
+                }
+                transaction_active = true;
+
+                HAL_StatusTypeDef status;
+                if (t.tx_data != nullptr && t.rx_data != nullptr) {
+                    status = HAL_SPI_TransmitReceive_DMA(
+                        &hspi,
+                        const_cast<uint8_t*>(t.tx_data),
+                        t.rx_data,
+                        t.frames
+                    );
+                } else if (t.tx_data != nullptr) {
+                    status = HAL_SPI_Transmit_DMA(&hspi, const_cast<uint8_t*>(t.tx_data), t.frames);
+                } else {
+                    status = HAL_SPI_Receive_DMA(&hspi, t.rx_data, t.frames);
+                }
+                if (status == HAL_OK) [[likely]] {
+                    return;
+                }
+
+                // Could not start it, report the failure and try the next one
+                uint32_t newErrorCount = error_count + 1;
+                error_count = newErrorCount;
+                transaction_active = false;
+                if (t.nss != nullptr) {
+                    t.nss->turn_on();
+                }
+                if (t.callback != nullptr) {
+                    t.callback(t.context, false);
+                }
+            }
+        }
+
+        void complete_transaction(bool success) {
+            const Transaction done = active_transaction;
+            transaction_active = false;
+            if (done.nss != nullptr) {
+                done.nss->turn_on();
+            }
+            // Chain the next transfer before running user code to keep the bus gap minimal
+            start_next_transaction();
+            if (done.callback != nullptr) {
+                done.callback(done.context, success);
+            }
+        }
+
         bool recover() {
             // Abort any ongoing SPI operation
             HAL_SPI_Abort(&hspi);
@@ -986,6 +1089,126 @@ struct SPIDomain {
             return check_error_code(error_code);
         }
 
+        /**
+         * @brief Queues a DMA transaction. It starts right away if the queue is idle, otherwise it
+         * is started from the completion interrupt of the previous one. Returns false if the queue
+         * is full. Do not mix with the single shot *_DMA calls while the queue is busy.
+         */
+        bool enqueue(const Transaction& transaction) {
+            if (transaction.frames == 0 ||
+                (transaction.tx_data == nullptr && transaction.rx_data == nullptr)) {
+                ErrorHandler("SPI transaction without data");
+                return false;
+            }
+            HAL_NVIC_DisableIRQ(spi_instance.irqn);
+            bool queued = spi_instance.push_transaction(transaction);
+            if (queued && !spi_instance.transaction_active) {
+                spi_instance.start_next_transaction();
+            }
+            HAL_NVIC_EnableIRQ(spi_instance.irqn);
+            return queued;
+        }
+
+        /**
+         * @brief Queues a full duplex DMA transaction, see enqueue().
+         */
+        template <typename E1, size_t S1, typename E2, size_t S2>
+        bool queue_transceive_DMA(
+            span<E1, S1> tx_data,
+            span<E2, S2> rx_data,
+            TransactionCallback callback = nullptr,
+            void* context = nullptr,
+            uint8_t priority = 0,
+            GPIODomain::Instance* nss = nullptr
+        ) {
+            auto size = std::min(tx_data.size_bytes(), rx_data.size_bytes());
+            if (size % frame_size != 0) {
+                ErrorHandler(
+                    "SPI transaction size (%d) not aligned to frame size (%d)",
+                    size,
+                    frame_size
+                );
+                return false;
+            }
+            return enqueue(
+                {.tx_data = reinterpret_cast<const uint8_t*>(tx_data.data()),
+                 .rx_data = reinterpret_cast<uint8_t*>(rx_data.data()),
+                 .frames = static_cast<uint16_t>(size / frame_size),
+                 .nss = nss,
+                 .callback = callback,
+                 .context = context,
+                 .priority = priority}
+            );
+        }
+
+        /**
+         * @brief Queues a transmit only DMA transaction, see enqueue().
+         */
+        template <typename E, size_t S>
+        bool queue_send_DMA(
+            span<E, S> data,
+            TransactionCallback callback = nullptr,
+            void* context = nullptr,
+            uint8_t priority = 0,
+            GPIODomain::Instance* nss = nullptr
+        ) {
+            if (data.size_bytes() % frame_size != 0) {
+                ErrorHandler(
+                    "SPI data size (%d) not aligned to frame size (%d)",
+                    data.size_bytes(),
+                    frame_size
+                );
+                return false;
+            }
+            return enqueue(
+                {.tx_data = reinterpret_cast<const uint8_t*>(data.data()),
+                 .frames = static_cast<uint16_t>(data.size_bytes() / frame_size),
+                 .nss = nss,
+                 .callback = callback,
+                 .context = context,
+                 .priority = priority}
+            );
+        }
+
+        /**
+         * @brief Queues a receive only DMA transaction, see enqueue().
+         */
+        template <typename E, size_t S>
+        bool queue_receive_DMA(
+            span<E, S> data,
+            TransactionCallback callback = nullptr,
+            void* context = nullptr,
+            uint8_t priority = 0,
+            GPIODomain::Instance* nss = nullptr
+        ) {
+            if (data.size_bytes() % frame_size != 0) {
+                ErrorHandler(
+                    "SPI data size (%d) not aligned to frame size (%d)",
+                    data.size_bytes(),
+                    frame_size
+                );
+                return false;
+            }
+            return enqueue(
+                {.rx_data = reinterpret_cast<uint8_t*>(data.data()),
+                 .frames = static_cast<uint16_t>(data.size_bytes() / frame_size),
+                 .nss = nss,
+                 .callback = callback,
+                 .context = context,
+                 .priority = priority}
+            );
+        }
+
+        /**
+         * @brief Number of transactions waiting behind the active one.
+         */
+        std::size_t queued_transactions() const { return spi_instance.queue_count; }
+
+        /**
+         * @brief True while a queued transaction is on the bus.
+         */
+        bool transaction_in_progress() const { return spi_instance.transaction_active; }
+
     private:
         Instance& spi_instance;
         bool check_error_code(HAL_StatusTypeDef error_code) {
@@ -1479,21 +1702,27 @@ struct SPIDomain {
 
                 // Enable NVIC
                 if (peripheral == SPIPeripheral::spi1) {
+                    instances[i].irqn = SPI1_IRQn;
                     HAL_NVIC_SetPriority(SPI1_IRQn, 1, 0);
                     HAL_NVIC_EnableIRQ(SPI1_IRQn);
                 } else if (peripheral == SPIPeripheral::spi2) {
+                    instances[i].irqn = SPI2_IRQn;
                     HAL_NVIC_SetPriority(SPI2_IRQn, 1, 0);
                     HAL_NVIC_EnableIRQ(SPI2_IRQn);
                 } else if (peripheral == SPIPeripheral::spi3) {
+                    instances[i].irqn = SPI3_IRQn;
                     HAL_NVIC_SetPriority(SPI3_IRQn, 1, 0);
                     HAL_NVIC_EnableIRQ(SPI3_IRQn);
                 } else if (peripheral == SPIPeripheral::spi4) {
+                    instances[i].irqn = SPI4_IRQn;
                     HAL_NVIC_SetPriority(SPI4_IRQn, 1, 0);
                     HAL_NVIC_EnableIRQ(SPI4_IRQn);
                 } else if (peripheral == SPIPeripheral::spi5) {
+                    instances[i].irqn = SPI5_IRQn;
                     HAL_NVIC_SetPriority(SPI5_IRQn, 1, 0);
                     HAL_NVIC_EnableIRQ(SPI5_IRQn);
                 } else if (peripheral == SPIPeripheral::spi6) {
+                    instances[i].irqn = SPI6_IRQn;
                     HAL_NVIC_SetPriority(SPI6_IRQn, 1, 0);
                     HAL_NVIC_EnableIRQ(SPI6_IRQn);
                 }
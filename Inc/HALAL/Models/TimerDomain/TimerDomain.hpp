@@ -301,6 +301,33 @@ TimerXList
             TIM8_UP_TIM13_IRQn
         };
 
+        /* Internal trigger connections (RM0468, TIMx internal trigger connection tables):
+           {slave timer, timer on ITR0, ITR1, ITR2, ITR3} */
+        static constexpr uint8_t internal_triggers[][5] = {
+            {1, 15, 2, 3, 4},
+            {8, 1, 2, 4, 5},
+            {2, 1, 8, 3, 4},
+            {3, 1, 2, 15, 4},
+            {4, 1, 2, 3, 8},
+            {5, 1, 8, 3, 4},
+        };
+
+        /* ITR input of the slave timer driven by the TRGO of the master timer, or -1 if the two
+           aren't connected. Timers are given by number (TimerRequest value) */
+        static consteval int8_t get_internal_trigger(uint8_t slave, uint8_t master) {
+            for (const auto& row : internal_triggers) {
+                if (row[0] != slave) {
+                    continue;
+                }
+                for (int8_t itr = 0; itr < 4; itr++) {
+                    if (row[itr + 1] == master) {
+                        return itr;
+                    }
+                }
+            }
+            return -1;
+        }
+
         static inline void rcc_enable_timer(TIM_TypeDef* tim) {
 #define X(n, b)                                                                                    \
     else if (tim == TIM##n) {                                                                      \
@@ -17,6 +17,10 @@
 
 #define PBUF_POOL_MEMORY_DESC_POSITION 8
 
+#ifndef STLIB_SOCKET_QUEUE_LEN
+#define STLIB_SOCKET_QUEUE_LEN PBUF_POOL_SIZE
+#endif
+
 /**
  * @brief class that handles a single point to point server client connection,
  * emulating the server side.
@@ -134,7 +138,10 @@ public:
 
         struct pbuf* packet = pbuf_alloc(PBUF_TRANSPORT, order.get_size(), PBUF_POOL);
         pbuf_take(packet, order_buffer, order.get_size());
-        tx_packet_buffer.push(packet);
+        if (!tx_packet_buffer.push(packet)) {
+            pbuf_free(packet);
+            return false;
+        }
         send();
         return true;
     }
@@ -165,8 +172,8 @@ public:
 
 private:
     struct tcp_pcb* server_control_block = nullptr;
-    queue<struct pbuf*> tx_packet_buffer;
-    queue<struct pbuf*> rx_packet_buffer;
+    StaticQueue<struct pbuf*, STLIB_SOCKET_QUEUE_LEN> tx_packet_buffer;
+    StaticQueue<struct pbuf*, STLIB_SOCKET_QUEUE_LEN> rx_packet_buffer;
     struct tcp_pcb* client_control_block;
 
     /**
@@ -15,12 +15,17 @@
 
 #define PBUF_POOL_MEMORY_DESC_POSITION 8
 
+/* Every queued pbuf comes from the pool, so the queues never need to hold more than it has */
+#ifndef STLIB_SOCKET_QUEUE_LEN
+#define STLIB_SOCKET_QUEUE_LEN PBUF_POOL_SIZE
+#endif
+
 class Socket : public OrderProtocol {
 private:
     tcp_pcb* connection_control_block;
     tcp_pcb* socket_control_block;
-    queue<struct pbuf*> tx_packet_buffer;
-    queue<struct pbuf*> rx_packet_buffer;
+    StaticQueue<struct pbuf*, STLIB_SOCKET_QUEUE_LEN> tx_packet_buffer;
+    StaticQueue<struct pbuf*, STLIB_SOCKET_QUEUE_LEN> rx_packet_buffer;
     void process_data();
     static err_t connect_callback(void* arg, struct tcp_pcb* client_control_block, err_t error);
     static err_t receive_callback(
@@ -121,7 +126,10 @@ public:
 
         struct pbuf* packet = pbuf_alloc(PBUF_TRANSPORT, order.get_size(), PBUF_POOL);
         pbuf_take(packet, order_buffer, order.get_size());
-        tx_packet_buffer.push(packet);
+        if (!tx_packet_buffer.push(packet)) {
+            pbuf_free(packet);
+            return false;
+        }
         send();
         return true;
     }
@@ -13,7 +13,6 @@
 
 #ifdef HAL_FDCAN_MODULE_ENABLED
 
-using std::queue;
 using std::unordered_map;
 using std::vector;
 
@@ -72,8 +71,8 @@ private:
         DLC dlc;
         FDCAN_TxHeaderTypeDef tx_header;
         uint32_t rx_location;
-        queue<FDCAN::Packet> rx_queue;
-        uint8_t rx_queue_max_size = 64;
+        static constexpr uint8_t rx_queue_max_size = 64;
+        StaticQueue<FDCAN::Packet, rx_queue_max_size> rx_queue;
         vector<uint8_t> tx_data;
         uint8_t fdcan_number;
         bool start = false;
@@ -0,0 +1,188 @@
+/*
+ * SPIAcquisition.hpp
+ *
+ * Timer triggered SPI sampling. The timer update interrupt enqueues a pre-built DMA
+ * transaction on the SPI queue, so the sampling instant is set by the timer and not by the
+ * main loop or the Scheduler. Results land in a double buffer and a callback is fired from the
+ * SPI completion interrupt with the timestamp of the trigger.
+ */
+#pragma once
+
+#include "HALAL/Models/SPI/SPI2.hpp"
+#include "HALAL/Services/Time/TimerWrapper.hpp"
+
+namespace ST_LIB {
+
+/**
+ * @brief Everything the DMA of an SPIAcquisition touches: the command it sends and the double
+ * buffered results. Request it as a non-cached MPUDomain::Buffer, the DMA can't reach DTCM where
+ * plain globals live and needs no cache maintenance there:
+ *
+ *   constexpr MPUDomain::Buffer<SPIAcquisitionBuffer<Frame, Command>> acq_buffer{};
+ */
+template <typename Rx, typename Tx = Rx> struct SPIAcquisitionBuffer {
+    Rx slots[2];
+    Tx command;
+};
+
+template <auto& spi_request, typename Tx, typename Rx>
+    requires(std::is_trivially_copyable_v<Tx> && std::is_trivially_copyable_v<Rx>)
+class SPIAcquisition {
+public:
+    using SPI = SPIDomain::SPIWrapper<spi_request>;
+
+    /**
+     * @brief Called from the SPI completion interrupt. timestamp_us is the trigger instant
+     * measured on the acquisition timer since start(), sequence counts completed samples.
+     */
+    using SampleReadyCallback =
+        void (*)(void* context, const Rx& sample, uint64_t timestamp_us, uint32_t sequence);
+
+    static_assert(sizeof(Tx) == sizeof(Rx), "SPI acquisition command and frame sizes must match");
+    static_assert(
+        sizeof(Rx) % SPI::frame_size == 0,
+        "SPI acquisition frame not aligned to the SPI frame size"
+    );
+
+    // Acquisition transfers go ahead of any other queued transaction
+    static constexpr uint8_t acquisition_priority = 0xFF;
+
+    using Buffer = SPIAcquisitionBuffer<Rx, Tx>;
+
+    /* command is copied into buffer, where the DMA reads it from on every trigger */
+    SPIAcquisition(
+        SPI& spi,
+        Buffer& buffer,
+        const Tx& command,
+        GPIODomain::Instance* nss = nullptr
+    )
+        : spi{spi}, buffer{buffer}, nss{nss} {
+        buffer.command = command;
+    }
+
+    /**
+     * @brief Starts sampling on every update event of the timer. period is written to ARR, so
+     * the sampling period is (period + 1) * (PSC + 1) timer clock cycles.
+     */
+    template <const TimerDomain::Timer& dev>
+    void start(
+        TimerWrapper<dev>& timer,
+        uint32_t period,
+        SampleReadyCallback callback = nullptr,
+        void* context = nullptr
+    ) {
+        sample_ready = callback;
+        callback_context = context;
+        trigger_count = 0;
+        sequence = 0;
+        overruns = 0;
+        failures = 0;
+        in_flight = false;
+
+        const uint64_t ticks = (static_cast<uint64_t>(period) + 1) * (timer.get_prescaler() + 1);
+        period_ns = ticks * 1'000'000'000ULL / timer.get_clock_frequency();
+
+        if constexpr (TimerWrapper<dev>::is_32bit_instance) {
+            timer.configure32bit(&on_trigger, this, period);
+        } else {
+            timer.configure16bit(&on_trigger, this, static_cast<uint16_t>(period));
+        }
+        timer.enable_update_interrupt();
+        timer.enable_nvic();
+    }
+
+    template <const TimerDomain::Timer& dev> void stop(TimerWrapper<dev>& timer) {
+        timer.disable_update_interrupt();
+        timer.counter_disable();
+    }
+
+    /**
+     * @brief Last completed sample. The next transfer goes to the other slot, but once it
+     * completes the trigger after it writes this one, so a reader has about one sampling period.
+     * Copy it out in the SampleReadyCallback when that is not enough.
+     */
+    const Rx& latest() const { return buffer.slots[ready_slot]; }
+
+    uint32_t get_sequence() const { return sequence; }
+    uint64_t get_period_ns() const { return period_ns; }
+
+    /**
+     * @brief Triggers dropped because the previous transfer was still running or the SPI queue
+     * was full.
+     */
+    uint32_t get_overruns() const { return overruns; }
+
+    /**
+     * @brief Transfers that failed on the bus, their slot is discarded.
+     */
+    uint32_t get_failures() const { return failures; }
+
+private:
+    SPI& spi;
+    Buffer& buffer;
+    GPIODomain::Instance* nss;
+
+    SampleReadyCallback sample_ready = nullptr;
+    void* callback_context = nullptr;
+
+    uint64_t period_ns = 0;
+    uint64_t trigger_count = 0;
+    uint64_t pending_timestamp_us = 0;
+    volatile uint32_t sequence = 0;
+    volatile uint32_t overruns = 0;
+    volatile uint32_t failures = 0;
+    volatile uint8_t ready_slot = 0;
+    uint8_t write_slot = 1;
+    volatile bool in_flight = false;
+
+    static void on_trigger(void* raw) {
+        auto* self = static_cast<SPIAcquisition*>(raw);
+        const uint64_t trigger = ++self->trigger_count;
+
+        if (self->in_flight) [[unlikely]] {
+            self->overruns = self->overruns + 1;
+            return;
+        }
+
+        self->write_slot = self->ready_slot ^ 1;
+        self->pending_timestamp_us = trigger * self->period_ns / 1000;
+        self->in_flight = true;
+
+        const bool queued = self->spi.enqueue(
+            {.tx_data = reinterpret_cast<const uint8_t*>(&self->buffer.command),
+             .rx_data = reinterpret_cast<uint8_t*>(&self->buffer.slots[self->write_slot]),
+             .frames = static_cast<uint16_t>(sizeof(Rx) / SPI::frame_size),
+             .nss = self->nss,
+             .callback = &on_complete,
+             .context = self,
+             .priority = acquisition_priority}
+        );
+        if (!queued) [[unlikely]] {
+            self->in_flight = false;
+            self->overruns = self->overruns + 1;
+        }
+    }
+
+    static void on_complete(void* raw, bool success) {
+        auto* self = static_cast<SPIAcquisition*>(raw);
+        self->in_flight = false;
+        if (!success) [[unlikely]] {
+            self->failures = self->failures + 1;
+            return;
+        }
+
+        self->ready_slot = self->write_slot;
+        const uint32_t seq = self->sequence + 1;
+        self->sequence = seq;
+        if (self->sample_ready != nullptr) {
+            self->sample_ready(
+                self->callback_context,
+                self->buffer.slots[self->ready_slot],
+                self->pending_timestamp_us,
+                seq
+            );
+        }
+    }
+};
+
+} // namespace ST_LIB
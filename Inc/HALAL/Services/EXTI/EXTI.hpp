@@ -7,8 +7,10 @@
 
 #ifndef EXTI_HPP
 #define EXTI_HPP
+#include "C++Utilities/SPSCQueue.hpp"
 #include "HALAL/Models/GPIO.hpp"
 #include "HALAL/Models/Pin.hpp"
+#include "HALAL/Services/EXTI/EXTILine.hpp"
 
 extern "C" void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
 
@@ -30,26 +32,66 @@ struct EXTIDomain {
         BOTH_EDGES = static_cast<uint8_t>(ST_LIB::GPIODomain::OperationMode::EXTI_RISING_FALLING)
     };
 
+    using Edge = EXTILine::Edge;
+    using Event = EXTILine::Event;
+    using EventHandler = EXTILine::EventHandler;
+
+    static constexpr std::size_t event_queue_capacity = 64;
+
     struct Entry {
         std::size_t pin_idx;
         uint16_t pin_mask;
         void (*action)();
+        EventHandler event_handler;
+        uint32_t debounce_us;
+        Trigger trigger;
     };
 
     struct Device {
         using domain = EXTIDomain;
         ST_LIB::GPIODomain::GPIO pin;
-        void (*action)();
+        void (*action)() = nullptr;
+        EventHandler event_handler = nullptr;
+        uint32_t debounce_us = 0;
+        Trigger trigger;
+
+        /* action runs inside the interrupt. Edges closer than debounce_us to the last accepted
+           one are ignored */
+        consteval Device(
+            ST_LIB::GPIODomain::Pin pin,
+            Trigger trigger,
+            void (*action)(),
+            uint32_t debounce_us = 0
+        )
+            : pin(pin,
+                  static_cast<ST_LIB::GPIODomain::OperationMode>(trigger),
+                  ST_LIB::GPIODomain::Pull::None,
+                  ST_LIB::GPIODomain::Speed::Low),
+              action(action), debounce_us(debounce_us), trigger(trigger) {
+#ifndef HAL_EXTI_MODULE_ENABLED
+            ST_LIB::compile_error("EXTI module not enabled in HAL");
+#endif
+        }
 
-        consteval Device(ST_LIB::GPIODomain::Pin pin, Trigger trigger, void (*action)())
+        /* Event capture: the interrupt only queues a timestamped Event, handler runs later from
+           EXTIDomain::process_events() in the main loop */
+        consteval Device(
+            ST_LIB::GPIODomain::Pin pin,
+            Trigger trigger,
+            EventHandler handler,
+            uint32_t debounce_us = 0
+        )
             : pin(pin,
                   static_cast<ST_LIB::GPIODomain::OperationMode>(trigger),
                   ST_LIB::GPIODomain::Pull::None,
                   ST_LIB::GPIODomain::Speed::Low),
-              action(action) {
+              event_handler(handler), debounce_us(debounce_us), trigger(trigger) {
 #ifndef HAL_EXTI_MODULE_ENABLED
             ST_LIB::compile_error("EXTI module not enabled in HAL");
 #endif
+            if (handler == nullptr) {
+                ST_LIB::compile_error("EXTI event capture needs an event handler");
+            }
         }
 
         template <class Ctx> consteval std::size_t inscribe(Ctx& ctx) const {
@@ -57,6 +99,9 @@ struct EXTIDomain {
             e.pin_idx = pin.inscribe(ctx);
             e.pin_mask = pin.e.pin;
             e.action = action;
+            e.event_handler = event_handler;
+            e.debounce_us = debounce_us;
+            e.trigger = trigger;
             return ctx.template add<EXTIDomain>(e, this);
         }
     };
@@ -67,6 +112,9 @@ struct EXTIDomain {
         std::size_t pin_idx;
         uint8_t interrupt_num;
         void (*action)();
+        EventHandler event_handler;
+        uint32_t debounce_us;
+        Trigger trigger;
     };
 
     template <std::size_t N>
@@ -94,6 +142,9 @@ struct EXTIDomain {
             used_lines_mask |= line_mask;
             cfgs[i].interrupt_num = pin_num;
             cfgs[i].action = e.action;
+            cfgs[i].event_handler = e.event_handler;
+            cfgs[i].debounce_us = e.debounce_us;
+            cfgs[i].trigger = e.trigger;
         }
 
         return cfgs;
@@ -102,32 +153,100 @@ struct EXTIDomain {
     template <std::size_t N> struct Init;
 
     struct Instance {
-        friend void ::HAL_GPIO_EXTI_Callback(uint16_t);
+        friend struct EXTIDomain;
         template <std::size_t> friend struct Init;
-        void turn_off() { is_on = false; }
-        void turn_on() { is_on = true; }
+        void turn_off() { line.is_on = false; }
+        void turn_on() { line.is_on = true; }
         GPIO_PinState read() { return gpio->read(); }
 
     private:
-        bool is_on = false;
-        void (*action)() = nullptr;
+        EXTILine line;
         GPIODomain::Instance* gpio = nullptr;
     };
 
     static Instance* g_instances[EXTIDomain::max_instances];
+    static SPSCQueue<Event, event_queue_capacity> events;
+    static uint32_t dropped_events;
+
+    /**
+     * @brief Handles one EXTI line, called from the interrupt with the pending bit already
+     * cleared. Applies the debounce window and either runs the action or queues an Event.
+     */
+    static inline void handle_line(uint8_t line, uint32_t timestamp) {
+        Instance* exti = g_instances[line];
+        if (exti == nullptr) {
+            return;
+        }
+        auto pin_high = [exti] { return exti->gpio->read() == GPIO_PIN_SET; };
+        exti->line.handle(line, timestamp, pin_high, events, dropped_events);
+    }
+
+    /**
+     * @brief Dispatches every pending line of the group, highest line first, with one CLZ per
+     * line instead of testing each pin mask.
+     */
+    static inline void dispatch_pending(uint32_t lines) {
+        const uint32_t timestamp = timestamp_now();
+        EXTILine::for_each_pending(__HAL_GPIO_EXTI_GET_IT(lines), [timestamp](uint8_t line) {
+            __HAL_GPIO_EXTI_CLEAR_IT(1UL << line);
+            handle_line(line, timestamp);
+        });
+    }
+
+    /**
+     * @brief Runs the handlers of queued events, call it from the main loop. Returns the number
+     * of events processed.
+     */
+    static std::size_t process_events(std::size_t max_events = event_queue_capacity) {
+        std::size_t processed = 0;
+        Event event;
+        while (processed < max_events && events.pop(event)) {
+            Instance* exti = g_instances[event.line];
+            if (exti != nullptr && exti->line.event_handler != nullptr) {
+                exti->line.event_handler(event);
+            }
+            processed++;
+        }
+        return processed;
+    }
+
+    static inline uint32_t get_dropped_events() { return dropped_events; }
+
+    /* The debounce needs CYCCNT running, a counter someone stopped is started again */
+    static inline uint32_t timestamp_now() {
+        if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) [[unlikely]] {
+            enable_timestamps();
+        }
+        return DWT->CYCCNT;
+    }
+
+    static inline void enable_timestamps() {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
 
     template <std::size_t N> struct Init {
         static inline std::array<Instance, N> instances{};
 
         static void
         init(std::span<const Config, N> cfgs, std::span<GPIODomain::Instance> gpio_instances) {
+            if constexpr (N > 0) {
+                enable_timestamps();
+            }
             for (std::size_t i = 0; i < N; i++) {
                 const auto& cfg = cfgs[i];
                 auto& inst = instances[i];
 
                 uint8_t id = cfg.interrupt_num;
                 g_instances[id] = &inst;
-                inst.action = cfg.action;
+                inst.line = EXTILine{
+                    .action = cfg.action,
+                    .event_handler = cfg.event_handler,
+                    .debounce_cycles = cfg.debounce_us * (SystemCoreClock / 1'000'000),
+                    .both_edges = cfg.trigger == Trigger::BOTH_EDGES,
+                    .single_edge = cfg.trigger == Trigger::FALLING_EDGE ? Edge::FALLING
+                                                                         : Edge::RISING,
+                };
                 inst.gpio = &gpio_instances[cfg.pin_idx];
 
                 IRQn_Type irq_n;
@@ -0,0 +1,104 @@
+/*
+ * EXTILine.hpp
+ *
+ * What the EXTI interrupt does with one of its lines, without touching the HAL so it runs on the
+ * host: the debounce window, the edge an event records and the order pending lines go in.
+ * EXTIDomain feeds it the pending register, the DWT cycle counter and the pin.
+ */
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+namespace ST_LIB {
+
+struct EXTILine {
+    enum class Edge : uint8_t { FALLING, RISING };
+
+    /**
+     * @brief Edge recorded by the interrupt in event capture mode. timestamp is the DWT cycle
+     * counter (SystemCoreClock) at the start of the interrupt.
+     */
+    struct Event {
+        uint32_t timestamp;
+        uint8_t line;
+        Edge edge;
+    };
+
+    using EventHandler = void (*)(const Event&);
+
+    bool is_on = false;
+    void (*action)() = nullptr;
+    EventHandler event_handler = nullptr;
+    /* 0 takes every edge */
+    uint32_t debounce_cycles = 0;
+    uint32_t last_accepted = 0;
+    bool has_accepted = false;
+    /* With a single edge trigger the edge is known, with both the pin is read */
+    bool both_edges = true;
+    Edge single_edge = Edge::RISING;
+
+    /* True when timestamp is out of the debounce window of the last edge taken, which it then
+       becomes. The subtraction keeps it right across the 32 bit wrap */
+    constexpr bool debounce(uint32_t timestamp) {
+        if (debounce_cycles == 0) {
+            return true;
+        }
+        if (has_accepted && timestamp - last_accepted < debounce_cycles) {
+            return false;
+        }
+        last_accepted = timestamp;
+        has_accepted = true;
+        return true;
+    }
+
+    /* By the time the pin is read a pulse shorter than the interrupt latency may have ended */
+    template <class PinHigh> constexpr Edge edge(PinHigh&& pin_high) const {
+        if (!both_edges) {
+            return single_edge;
+        }
+        return pin_high() ? Edge::RISING : Edge::FALLING;
+    }
+
+    /**
+     * @brief Handles an edge on line number, called from the interrupt with the pending bit
+     * already cleared. Runs the action or queues an Event, counting it in dropped when events is
+     * full.
+     */
+    template <class PinHigh, class Queue>
+    void handle(
+        uint8_t number,
+        uint32_t timestamp,
+        PinHigh&& pin_high,
+        Queue& events,
+        uint32_t& dropped
+    ) {
+        if (!is_on || !debounce(timestamp)) {
+            return;
+        }
+        if (event_handler != nullptr) {
+            const Event event{
+                .timestamp = timestamp,
+                .line = number,
+                .edge = edge(pin_high),
+            };
+            if (!events.push(event)) {
+                dropped++;
+            }
+        } else if (action != nullptr) {
+            action();
+        }
+    }
+
+    /* Calls handle(line) for every bit set in pending, highest line first, one CLZ per line */
+    template <class Handle>
+    static constexpr void for_each_pending(uint32_t pending, Handle&& handle) {
+        while (pending != 0) {
+            const uint8_t line = static_cast<uint8_t>(31 - std::countl_zero(pending));
+            pending &= ~(1UL << line);
+            handle(line);
+        }
+    }
+};
+
+} // namespace ST_LIB
@@ -0,0 +1,85 @@
+/*
+ * EncoderEdgeCapture.hpp
+ *
+ * Hardware timestamping of quadrature encoder edges. The encoder timer captures its counter on
+ * every rising edge of channel 1 and pulses TRGO when it does (MMS = compare pulse). A free running
+ * 32 bit timer takes that TRGO through its ITR input and captures its own counter on TRC, so for
+ * every encoder edge the pair (encoder count, clock ticks) is latched by hardware, without any
+ * interrupt latency in the timestamp.
+ */
+#pragma once
+
+#include "HALAL/Models/TimerDomain/TimerDomain.hpp"
+#ifdef HAL_TIM_MODULE_ENABLED
+#include "HALAL/Services/Time/TimerWrapper.hpp"
+
+namespace ST_LIB {
+
+template <const TimerDomain::Timer& encoder_dev, const TimerDomain::Timer& clock_dev>
+class EncoderEdgeCapture {
+    static_assert(
+        TimerWrapper<clock_dev>::is_32bit_instance,
+        "Encoder edge timestamps need a 32 bit clock timer"
+    );
+
+    static constexpr int8_t itr = TimerDomain::get_internal_trigger(
+        static_cast<uint8_t>(clock_dev.e.request),
+        static_cast<uint8_t>(encoder_dev.e.request)
+    );
+    static_assert(itr >= 0, "Clock timer has no internal trigger connected to the encoder timer");
+
+    inline static TIM_TypeDef* encoder_tim = nullptr;
+    inline static TIM_TypeDef* clock_tim = nullptr;
+    inline static uint32_t clock_frequency = 0;
+
+public:
+    struct Edge {
+        uint32_t count; /* encoder counter at the edge */
+        uint32_t ticks; /* clock timer counter at the edge */
+    };
+
+    static void init(TimerWrapper<encoder_dev>* encoder, TimerWrapper<clock_dev>* clock) {
+        encoder_tim = encoder->instance->tim;
+        clock_tim = clock->instance->tim;
+
+        /* encoder: capture CNT on TI1 and pulse TRGO on every capture (MMS = 011) */
+        SET_BIT(encoder_tim->CCER, TIM_CCER_CC1E);
+        MODIFY_REG(encoder_tim->CR2, TIM_CR2_MMS, TIM_CR2_MMS_0 | TIM_CR2_MMS_1);
+
+        /* clock: free running at the timer clock, IC1 mapped on TRC = ITRx */
+        CLEAR_BIT(clock_tim->CR1, TIM_CR1_CEN);
+        clock_tim->PSC = 0;
+        clock_tim->ARR = UINT32_MAX;
+        MODIFY_REG(clock_tim->SMCR, TIM_SMCR_TS | TIM_SMCR_SMS, (uint32_t)itr << TIM_SMCR_TS_Pos);
+        MODIFY_REG(clock_tim->CCMR1, TIM_CCMR1_CC1S, TIM_CCMR1_CC1S_0 | TIM_CCMR1_CC1S_1);
+        SET_BIT(clock_tim->CCER, TIM_CCER_CC1E);
+        clock_tim->EGR = TIM_EGR_UG;
+        SET_BIT(clock_tim->CR1, TIM_CR1_CEN);
+
+        clock_frequency = clock->get_clock_frequency();
+    }
+
+    /**
+     * @brief Last captured edge. Both captures are read again if the clock capture changed
+     * while reading, so the pair always belongs to the same edge.
+     */
+    static inline Edge read_last_edge() {
+        uint32_t ticks = clock_tim->CCR1;
+        while (true) {
+            const uint32_t count = encoder_tim->CCR1;
+            const uint32_t check = clock_tim->CCR1;
+            if (check == ticks) {
+                return {count, ticks};
+            }
+            ticks = check;
+        }
+    }
+
+    static inline uint32_t now() { return clock_tim->CNT; }
+
+    static inline uint32_t get_clock_frequency() { return clock_frequency; }
+};
+
+} // namespace ST_LIB
+
+#endif // HAL_TIM_MODULE_ENABLED
@@ -96,6 +96,7 @@ public:
 
         timer->template config_output_compare_channel<pin.channel>(&sConfigOC);
         timer->template set_output_compare_preload_enable<pin.channel>();
+        timer->refresh_period_cache();
     }
 
     inline void turn_on() {
@@ -238,18 +239,37 @@ public:
         if (duty_cycle > 100.0f) [[unlikely]] {
             duty_cycle = 100.0f;
         }
-        if constexpr (timer->is_32bit_instance) {
-            uint32_t raw_duty =
-                (uint32_t)((float)(timer->instance->tim->ARR + 1) * (duty_cycle / 100.0f));
-            timer->template set_capture_compare<pin.channel>(raw_duty);
-        } else {
-            uint16_t raw_duty =
-                (uint16_t)((float)(timer->instance->tim->ARR + 1) * (duty_cycle / 100.0f));
-            timer->template set_capture_compare<pin.channel>(raw_duty);
-        }
+        timer->template set_capture_compare<pin.channel>(timer->percent_to_counts(duty_cycle));
         *(this->duty_cycle) = duty_cycle;
     }
 
+    /* Fast paths for control loops: integer only, on the period cached by the timer */
+
+    /* duty in timer counts, clamped to ARR + 1 */
+    inline void set_duty_cycle_counts(uint32_t counts) {
+        if (counts > timer->period_counts) [[unlikely]] {
+            counts = timer->period_counts;
+        }
+        timer->template set_capture_compare<pin.channel>(counts);
+        *(this->duty_cycle) = timer->counts_to_percent(counts);
+    }
+
+    /* duty in Q15, 1 << 15 = 100% */
+    inline void set_duty_cycle_q15(uint32_t duty_q15) {
+        if (duty_q15 > timer->DUTY_Q15_ONE) [[unlikely]] {
+            duty_q15 = timer->DUTY_Q15_ONE;
+        }
+        set_duty_cycle_counts(timer->q15_to_counts(duty_q15));
+    }
+
+    /* duty in Q31, 1 << 31 = 100% */
+    inline void set_duty_cycle_q31(uint32_t duty_q31) {
+        if (duty_q31 > timer->DUTY_Q31_ONE) [[unlikely]] {
+            duty_q31 = timer->DUTY_Q31_ONE;
+        }
+        set_duty_cycle_counts(timer->q31_to_counts(duty_q31));
+    }
+
     template <ST_LIB::PWM_Frequency_Mode mode = DEFAULT_PWM_FREQUENCY_MODE>
     inline void set_timer_frequency(uint32_t frequency) {
         timer->template set_pwm_frequency<mode>(frequency);
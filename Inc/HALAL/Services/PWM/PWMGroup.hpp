@@ -0,0 +1,167 @@
+/*
+ * PWMGroup.hpp
+ *
+ * Timers that drive the same converter (the legs of an inverter, interleaved phases) declared as
+ * one group. The first timer is the master: its counter enable is routed to TRGO and every slave
+ * is put in trigger mode on the matching ITR input, so the whole group starts on the same timer
+ * clock edge. Phase offsets are preloaded in the slave counters before the start and are then
+ * kept by the counters themselves. A frequency change restarts the group from the master so the
+ * offsets are preloaded again for the new period.
+ */
+#pragma once
+
+#include "HALAL/Models/TimerDomain/TimerDomain.hpp"
+#ifdef HAL_TIM_MODULE_ENABLED
+#include "HALAL/Services/Time/TimerWrapper.hpp"
+
+#include <array>
+#include <tuple>
+
+namespace ST_LIB {
+
+template <const TimerDomain::Timer& master, const TimerDomain::Timer&... slaves> class PWMGroup {
+    static_assert(sizeof...(slaves) > 0, "A PWM group needs at least one slave timer");
+
+    static consteval uint8_t timer_number(const TimerDomain::Timer& tim) {
+        if (tim.e.request == TimerRequest::AnyGeneralPurpose ||
+            tim.e.request == TimerRequest::Any32bit) {
+            ST_LIB::compile_error("PWM group timers must request a specific timer");
+        }
+        return static_cast<uint8_t>(tim.e.request);
+    }
+
+    static consteval uint8_t get_itr(const TimerDomain::Timer& slave) {
+        const uint8_t slave_number = timer_number(slave);
+        const uint8_t master_number = timer_number(master);
+        if (slave_number == master_number) {
+            ST_LIB::compile_error("The master timer can't also be a slave of its own group");
+        }
+        const int8_t itr = TimerDomain::get_internal_trigger(slave_number, master_number);
+        if (itr < 0) {
+            ST_LIB::compile_error("Slave timer has no internal trigger connected to the master");
+        }
+        return static_cast<uint8_t>(itr);
+    }
+
+    /* MMS = 001: counter enable is used as trigger output */
+    static constexpr uint32_t master_mode_enable = TIM_CR2_MMS_0;
+    /* SMS = 0110: trigger mode, the counter starts on the rising edge of TRGI */
+    static constexpr uint32_t slave_mode_trigger = TIM_SMCR_SMS_1 | TIM_SMCR_SMS_2;
+
+public:
+    static constexpr std::size_t slave_count = sizeof...(slaves);
+    static constexpr std::size_t timer_count = slave_count + 1;
+    static constexpr std::array<uint8_t, slave_count> slave_itrs = {get_itr(slaves)...};
+
+    PWMGroup(TimerWrapper<master>& master_timer, TimerWrapper<slaves>&... slave_timers)
+        : wrappers{&master_timer, &slave_timers...},
+          timers{master_timer.instance->tim, slave_timers.instance->tim...} {
+        for (TIM_TypeDef* tim : timers) {
+            CLEAR_BIT(tim->CR1, TIM_CR1_CEN);
+            SET_BIT(tim->CR1, TIM_CR1_ARPE);
+        }
+
+        MODIFY_REG(timers[0]->CR2, TIM_CR2_MMS, master_mode_enable);
+        for (std::size_t i = 0; i < slave_count; i++) {
+            MODIFY_REG(
+                timers[i + 1]->SMCR,
+                TIM_SMCR_TS | TIM_SMCR_SMS,
+                ((uint32_t)slave_itrs[i] << TIM_SMCR_TS_Pos) | slave_mode_trigger
+            );
+        }
+    }
+
+    /**
+     * @brief Delay of a slave with respect to the master, in degrees of the PWM period. It is
+     * applied by start(). In center aligned mode only delays in [180, 360) can be preloaded,
+     * since the counter can only be started counting up.
+     */
+    void set_phase(std::size_t slave, float degrees) {
+        if (slave >= slave_count) {
+            ErrorHandler("PWM group has no slave %u", (unsigned)slave);
+            return;
+        }
+        while (degrees >= 360.0f)
+            degrees -= 360.0f;
+        while (degrees < 0.0f)
+            degrees += 360.0f;
+        phases[slave] = degrees;
+    }
+
+    float get_phase(std::size_t slave) const { return phases[slave]; }
+
+    /**
+     * @brief Loads the preloaded registers of every timer, sets the slave counters to their
+     * phase offset and enables the master, which starts the slaves through TRGO.
+     */
+    void start() {
+        for (TIM_TypeDef* tim : timers) {
+            CLEAR_BIT(tim->CR1, TIM_CR1_CEN);
+            tim->EGR = TIM_EGR_UG;
+        }
+        for (std::size_t i = 0; i < slave_count; i++) {
+            timers[i + 1]->CNT = phase_to_counter(timers[i + 1], phases[i]);
+        }
+        SET_BIT(timers[0]->CR1, TIM_CR1_CEN);
+    }
+
+    void stop() {
+        CLEAR_BIT(timers[0]->CR1, TIM_CR1_CEN);
+        for (std::size_t i = 0; i < slave_count; i++) {
+            CLEAR_BIT(timers[i + 1]->CR1, TIM_CR1_CEN);
+        }
+    }
+
+    /**
+     * @brief Changes the PWM frequency of the whole group keeping the phases in degrees. The
+     * slave offsets are counts of the old period and a slave can only be resynchronised by its
+     * trigger to a zero count, so the group is stopped, ARR and the rescaled CCRs are written to
+     * every timer and, if it was running, start() latches them and preloads the offsets for the
+     * new period. It is not glitch free: the PWM period in progress is cut short and the group
+     * restarts from the beginning of a period.
+     */
+    template <ST_LIB::PWM_Frequency_Mode mode = DEFAULT_PWM_FREQUENCY_MODE>
+    void set_frequency(uint32_t frequency) {
+        const bool running = READ_BIT(timers[0]->CR1, TIM_CR1_CEN) != 0;
+        stop();
+        std::apply(
+            [frequency](auto*... wrapper) {
+                (wrapper->template set_pwm_frequency<mode>(frequency), ...);
+            },
+            wrappers
+        );
+        if (running) {
+            start();
+        }
+    }
+
+    TIM_TypeDef* get_cmsis_handle(std::size_t idx) { return timers[idx]; }
+
+private:
+    std::tuple<TimerWrapper<master>*, TimerWrapper<slaves>*...> wrappers;
+    std::array<TIM_TypeDef*, timer_count> timers;
+    std::array<float, slave_count> phases{};
+
+    static uint32_t phase_to_counter(TIM_TypeDef* tim, float delay_degrees) {
+        if (delay_degrees == 0.0f) {
+            return 0;
+        }
+        const float lead = 360.0f - delay_degrees;
+        const uint32_t period = tim->ARR + 1;
+
+        if ((tim->CR1 & TIM_CR1_CMS) == 0) {
+            return (uint32_t)(lead * (float)period / 360.0f) % period;
+        }
+
+        /* center aligned: one PWM period is ARR counts up and ARR counts down */
+        if (lead > 180.0f) {
+            ErrorHandler("Center aligned PWM group phase must be a delay in [180, 360) degrees");
+            return 0;
+        }
+        return (uint32_t)(lead * (float)tim->ARR / 180.0f);
+    }
+};
+
+} // namespace ST_LIB
+
+#endif // HAL_TIM_MODULE_ENABLED
@@ -0,0 +1,181 @@
+/*
+ * AlarmTable.hpp
+ *
+ * Fixed capacity storage for the periodic alarms of Time. Slots are tracked with bitmaps like
+ * the Scheduler tasks, the callbacks are kept inline in the slots and the tick dispatch only
+ * visits the active ones, so nothing is allocated and the interrupt time is bounded by the
+ * number of registered alarms.
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T> inline constexpr bool is_std_function = false;
+template <typename R, typename... Args>
+inline constexpr bool is_std_function<std::function<R(Args...)>> = true;
+
+/**
+ * @brief Function pointer plus context. Lambdas and functors are copied into the inline storage
+ * and the context points to that copy, so registering one never goes to the heap. std::function
+ * is rejected, copying it may allocate its target. The callback lives in its slot, it is neither
+ * copied nor moved.
+ */
+class AlarmCallback {
+public:
+    using function_t = void (*)(void*);
+    static constexpr std::size_t inline_size = 32;
+
+    AlarmCallback() = default;
+    AlarmCallback(const AlarmCallback&) = delete;
+    AlarmCallback& operator=(const AlarmCallback&) = delete;
+    ~AlarmCallback() { reset(); }
+
+    void emplace(function_t func, void* ctx) {
+        reset();
+        function = func;
+        context = ctx;
+    }
+
+    template <typename F> void emplace(F&& func) {
+        using Fn = std::decay_t<F>;
+        static_assert(std::is_invocable_v<Fn&>, "Alarm callbacks take no arguments");
+        static_assert(
+            !is_std_function<Fn>,
+            "std::function may allocate, pass the lambda itself or a function and a context pointer"
+        );
+        static_assert(
+            sizeof(Fn) <= inline_size && alignof(Fn) <= alignof(std::max_align_t),
+            "Alarm callback captures too much, pass a function and a context pointer instead"
+        );
+        reset();
+        context = ::new (static_cast<void*>(storage)) Fn(std::forward<F>(func));
+        function = [](void* ctx) { (*static_cast<Fn*>(ctx))(); };
+        if constexpr (!std::is_trivially_destructible_v<Fn>) {
+            destroy = [](void* ctx) { static_cast<Fn*>(ctx)->~Fn(); };
+        }
+    }
+
+    void reset() {
+        if (destroy != nullptr) {
+            destroy(context);
+        }
+        function = nullptr;
+        context = nullptr;
+        destroy = nullptr;
+    }
+
+    explicit operator bool() const { return function != nullptr; }
+
+    void operator()() const { function(context); }
+
+private:
+    function_t function{nullptr};
+    void* context{nullptr};
+    function_t destroy{nullptr};
+    alignas(std::max_align_t) std::byte storage[inline_size];
+};
+
+/**
+ * @brief Alarms fired every period ticks of a timer. add() and remove() run with the timer
+ * interrupt masked, on_tick() runs in the interrupt. Alarms removed from inside a callback are
+ * released when the dispatch ends.
+ */
+template <std::size_t N> class AlarmTable {
+    static_assert(N > 0 && N <= 32, "AlarmTable capacity must be between 1 and 32");
+
+    struct Alarm {
+        uint64_t next_tick{0};
+        uint32_t period{0};
+        bool one_shot{false};
+        AlarmCallback callback;
+    };
+
+    std::array<Alarm, N> alarms{};
+    uint32_t used_bitmap{0};
+    uint32_t active_bitmap{0};
+    uint32_t release_bitmap{0};
+    uint64_t tick{0};
+    bool dispatching{false};
+
+    void release(uint8_t id) {
+        alarms[id].callback.reset();
+        used_bitmap &= ~(1U << id);
+    }
+
+public:
+    static constexpr uint8_t INVALID_ID = 0xFF;
+
+    static constexpr std::size_t capacity() { return N; }
+
+    /* The tick in progress when registering is not counted, the alarm first fires on the
+       period-th full tick after it */
+    template <typename... Callback>
+    uint8_t add(uint32_t period, bool one_shot, Callback&&... callback) {
+        const uint32_t free_bitmap = ~used_bitmap & (N == 32 ? UINT32_MAX : (1U << N) - 1);
+        if (free_bitmap == 0) {
+            return INVALID_ID;
+        }
+        const uint8_t id = static_cast<uint8_t>(std::countr_zero(free_bitmap));
+        Alarm& alarm = alarms[id];
+        alarm.callback.emplace(std::forward<Callback>(callback)...);
+        alarm.period = period == 0 ? 1 : period;
+        alarm.next_tick = tick + alarm.period;
+        alarm.one_shot = one_shot;
+        used_bitmap |= 1U << id;
+        active_bitmap |= 1U << id;
+        return id;
+    }
+
+    bool remove(uint8_t id) {
+        if (id >= N || (active_bitmap & (1U << id)) == 0) {
+            return false;
+        }
+        active_bitmap &= ~(1U << id);
+        if (dispatching) {
+            release_bitmap |= 1U << id;
+        } else {
+            release(id);
+        }
+        return true;
+    }
+
+    void on_tick() {
+        dispatching = true;
+        uint32_t pending = active_bitmap;
+        while (pending != 0) {
+            const uint8_t id = static_cast<uint8_t>(std::countr_zero(pending));
+            pending &= pending - 1;
+            Alarm& alarm = alarms[id];
+            /* an earlier callback may have removed this one */
+            if ((active_bitmap & (1U << id)) == 0 || alarm.next_tick != tick) {
+                continue;
+            }
+            alarm.next_tick += alarm.period;
+            alarm.callback();
+            if (alarm.one_shot) {
+                remove(id);
+            }
+        }
+        dispatching = false;
+        tick++;
+
+        while (release_bitmap != 0) {
+            const uint8_t id = static_cast<uint8_t>(std::countr_zero(release_bitmap));
+            release_bitmap &= release_bitmap - 1;
+            release(id);
+        }
+    }
+
+    bool contains(uint8_t id) const { return id < N && (active_bitmap & (1U << id)) != 0; }
+
+    std::size_t size() const { return std::popcount(active_bitmap); }
+
+    uint64_t get_tick() const { return tick; }
+};
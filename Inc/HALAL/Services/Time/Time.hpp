@@ -14,6 +14,7 @@
 #ifdef HAL_TIM_MODULE_ENABLED
 
 #include "C++Utilities/CppUtils.hpp"
+#include "HALAL/Services/Time/AlarmTable.hpp"
 #include "HALAL/Services/Time/RTC.hpp"
 // HIGH RESOLUTION TIMERS
 extern TIM_HandleTypeDef htim2; // Used for the global timer (3,36nS step)
@@ -25,39 +26,40 @@ extern TIM_HandleTypeDef htim24; // Used for the high precision alarms (50uS)
 // LOW RESOLUTION TIMERS
 extern TIM_HandleTypeDef htim7; // Used for the low precision alarms (1mS)
 
+#ifndef TIME_LOW_PRECISION_ALARMS
+#define TIME_LOW_PRECISION_ALARMS 32
+#endif
+
+#ifndef TIME_MID_PRECISION_ALARMS
+#define TIME_MID_PRECISION_ALARMS 16
+#endif
+
+/* Alarms live in fixed tables (see AlarmTable.hpp), callbacks are stored inline in their slot,
+ * so nothing is allocated once Time::start() has run. Lambdas can capture up to
+ * AlarmCallback::inline_size bytes, bigger state goes through the function + context overloads.
+ * Ids are slot indexes, 255 means the registration failed. */
 class Time {
 
 private:
-    static uint8_t high_precision_ids;
-    static uint8_t low_precision_ids;
-    static uint8_t mid_precision_ids;
-
-    struct Alarm {
-        uint32_t period;
-        TIM_HandleTypeDef* tim;
-        function<void()> alarm;
-        uint64_t offset;
-        bool is_on = false;
+    struct HighPrecisionAlarm {
+        TIM_HandleTypeDef* tim{nullptr};
+        AlarmCallback alarm;
     };
 
     static constexpr uint32_t HIGH_PRECISION_MAX_ARR = 4294967295;
     static constexpr uint32_t MID_PRECISION_MAX_ARR = 4294967295;
     static constexpr uint32_t mid_precision_step_in_us = 50;
+    static constexpr uint8_t timer32_count = 4;
     static uint64_t global_tick;
-    static uint64_t low_precision_tick;
-    static uint64_t mid_precision_tick;
     static bool mid_precision_registered;
 
-    static unordered_map<TIM_HandleTypeDef*, TIM_TypeDef*> timer32_by_timer32handler_map;
-    static unordered_map<TIM_HandleTypeDef*, IRQn_Type> timer32interrupt_by_timer32handler_map;
-
-    static unordered_map<uint8_t, Alarm> high_precision_alarms_by_id;
-    static unordered_map<TIM_HandleTypeDef*, Alarm> high_precision_alarms_by_timer;
-    static unordered_map<uint8_t, Alarm> low_precision_alarms_by_id;
-    static unordered_map<uint8_t, Alarm> mid_precision_alarms_by_id;
-
-    static stack<uint8_t> low_precision_erasable_ids;
-    static stack<uint8_t> mid_precision_erasable_ids;
+    /* Indexed by timer32 slot (TIM2, TIM5, TIM23, TIM24), so the interrupt finds its alarm
+     * without searching */
+    static std::array<HighPrecisionAlarm, timer32_count> high_precision_alarms;
+    static uint8_t high_precision_bitmap;
+    static uint8_t available_high_precision_bitmap;
+    static AlarmTable<TIME_LOW_PRECISION_ALARMS> low_precision_alarms;
+    static AlarmTable<TIME_MID_PRECISION_ALARMS> mid_precision_alarms;
 
     static void stop_timer(TIM_HandleTypeDef* htim);
     static void start_timer(TIM_HandleTypeDef* htim, uint32_t prescaler, uint32_t period);
@@ -71,12 +73,22 @@ private:
     static void ConfigTimer(TIM_HandleTypeDef* tim, uint32_t period_in_us);
     static bool is_valid_timer(TIM_HandleTypeDef* tim);
     static void hal_enable_timer(TIM_HandleTypeDef* tim);
+    static int8_t get_timer32_index(TIM_HandleTypeDef* tim);
+
+    static uint8_t acquire_high_precision_timer();
+    static uint8_t start_high_precision_alarm(uint8_t index, uint32_t period_in_us);
+    static bool prepare_mid_precision_alarm();
+    static void disable_mid_precision_irq();
+    static void enable_mid_precision_irq();
+    static uint8_t check_alarm_id(uint8_t id, const char* kind);
 
 public:
+    static constexpr uint8_t INVALID_ID = 0xFF;
+
     static TIM_HandleTypeDef* global_timer;
 
+    /* 32 bit timers reserved for high precision alarms, set before Time::start() */
     static set<TIM_HandleTypeDef*> high_precision_timers;
-    static stack<TIM_HandleTypeDef*> available_high_precision_timers;
 
     static TIM_HandleTypeDef* low_precision_timer;
     static TIM_HandleTypeDef* mid_precision_timer;
@@ -101,10 +113,30 @@ public:
      *
      * @param period_in_us period in microseconds until timeout.
      * @param func function to be executed on timeout.
-     * @return optional<uint8_t> Returns id of the alarm if succesful, nullopt if it is able
-     * to register the timer correctly (probably because there aren't any timer available).
+     * @return uint8_t Returns id of the alarm if succesful, INVALID_ID if there aren't any
+     * timers available.
      */
-    static uint8_t register_high_precision_alarm(uint32_t period_in_us, function<void()> func);
+    template <typename F>
+    static uint8_t register_high_precision_alarm(uint32_t period_in_us, F&& func) {
+        const uint8_t index = acquire_high_precision_timer();
+        if (index == INVALID_ID) {
+            return INVALID_ID;
+        }
+        high_precision_alarms[index].alarm.emplace(std::forward<F>(func));
+        return start_high_precision_alarm(index, period_in_us);
+    }
+    static uint8_t register_high_precision_alarm(
+        uint32_t period_in_us,
+        AlarmCallback::function_t func,
+        void* context
+    ) {
+        const uint8_t index = acquire_high_precision_timer();
+        if (index == INVALID_ID) {
+            return INVALID_ID;
+        }
+        high_precision_alarms[index].alarm.emplace(func, context);
+        return start_high_precision_alarm(index, period_in_us);
+    }
 
     static bool unregister_high_precision_alarm(uint8_t id);
 
@@ -116,20 +148,30 @@ public:
      * @param func function to be executed on timeout.
      * @return uint8_t Returns id of the alarm.
      */
-    static uint8_t register_low_precision_alarm(uint32_t period_in_ms, function<void()> func);
-    static uint8_t register_low_precision_alarm(uint32_t period_in_ms, void (*func)());
+    template <typename... Callback>
+    static uint8_t register_low_precision_alarm(uint32_t period_in_ms, Callback&&... func) {
+        NVIC_DisableIRQ(TIM7_IRQn);
+        const uint8_t id =
+            low_precision_alarms.add(period_in_ms, false, std::forward<Callback>(func)...);
+        NVIC_EnableIRQ(TIM7_IRQn);
+        return check_alarm_id(id, "low precision alarm");
+    }
     static bool unregister_low_precision_alarm(uint8_t id);
 
-    /**
-     * @brief Registers a low_precision_alarm, executes an action ONLY ONE TIME
-     * and unregisters the alarm.
-     *
-     * @param milliseconds time until the action is executed.
-     * @param func function to be executed on timeout.
-     * @return void
-     */
-
-    static uint8_t register_mid_precision_alarm(uint32_t period_in_us, function<void()> func);
+    template <typename... Callback>
+    static uint8_t register_mid_precision_alarm(uint32_t period_in_us, Callback&&... func) {
+        if (not prepare_mid_precision_alarm()) {
+            return INVALID_ID;
+        }
+        disable_mid_precision_irq();
+        const uint8_t id = mid_precision_alarms.add(
+            period_in_us / mid_precision_step_in_us,
+            false,
+            std::forward<Callback>(func)...
+        );
+        enable_mid_precision_irq();
+        return check_alarm_id(id, "mid precision alarm");
+    }
     static bool unregister_mid_precision_alarm(uint8_t id);
 
     /**
@@ -139,7 +181,17 @@ public:
      * @param callback the function to be executed
      * @return uint8_t the id of the order, if it didnot succeed it will return 255
      */
-    static uint8_t set_timeout(int milliseconds, function<void()> callback);
+    template <typename... Callback>
+    static uint8_t set_timeout(int milliseconds, Callback&&... callback) {
+        NVIC_DisableIRQ(TIM7_IRQn);
+        const uint8_t id = low_precision_alarms.add(
+            static_cast<uint32_t>(milliseconds),
+            true,
+            std::forward<Callback>(callback)...
+        );
+        NVIC_EnableIRQ(TIM7_IRQn);
+        return check_alarm_id(id, "timeout");
+    }
 
     /**
      * @brief Cancels a timeout by derigstering the alarm bound to it
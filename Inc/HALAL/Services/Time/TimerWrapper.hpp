@@ -33,6 +33,17 @@ template <const TimerDomain::Timer& dev> struct TimerWrapper {
     float pwm_channel_duties[MAX_pwm_channel_duties] = {0.0f, 0.0f, 0.0f, 0.0f};
     uint32_t pwm_frequency = 0;
 
+    /* ARR + 1 and the scales derived from it, cached so the duty update paths never read ARR or
+       divide. Refreshed whenever the period is changed through this wrapper, call
+       refresh_period_cache() after writing ARR by hand */
+    uint32_t period_counts = 0;
+    float counts_per_percent = 0.0f;
+    float percent_per_count = 0.0f;
+
+    /* Fixed point duty formats, full scale is 100% */
+    static constexpr uint32_t DUTY_Q15_ONE = 1U << 15;
+    static constexpr uint32_t DUTY_Q31_ONE = 1U << 31;
+
     enum CountingMode : uint8_t {
         UP = 0,
         DOWN = 1,
@@ -332,6 +343,7 @@ template <const TimerDomain::Timer& dev> struct TimerWrapper {
         );
 
         instance->tim->ARR = period;
+        refresh_period_cache();
         TimerDomain::callbacks[instance->timer_idx] = callback;
         TimerDomain::callback_data[instance->timer_idx] = callback_data;
         this->counter_enable();
@@ -339,6 +351,7 @@ template <const TimerDomain::Timer& dev> struct TimerWrapper {
 
     inline void configure16bit(void (*callback)(void*), void* callback_data, uint16_t period) {
         instance->tim->ARR = period;
+        refresh_period_cache();
         TimerDomain::callbacks[instance->timer_idx] = callback;
         TimerDomain::callback_data[instance->timer_idx] = callback_data;
         this->counter_enable();
@@ -388,50 +401,71 @@ template <const TimerDomain::Timer& dev> struct TimerWrapper {
                 (uint32_t)((float)get_clock_frequency() / psc_plus_1_mul_freq - 0.5f);
         }
 
-        if (pwm_channel_duties[0] != 0.0f) {
-            if constexpr (this->is_32bit_instance) {
-                uint32_t raw_duty =
-                    (uint32_t)((float)(instance->tim->ARR + 1) * (pwm_channel_duties[0] / 100.0f));
-                instance->tim->CCR1 = raw_duty;
-            } else {
-                uint16_t raw_duty =
-                    (uint16_t)((float)(instance->tim->ARR + 1) * (pwm_channel_duties[0] / 100.0f));
-                instance->tim->CCR1 = raw_duty;
+        refresh_period_cache();
+        for (int i = 0; i < MAX_pwm_channel_duties; i++) {
+            if (pwm_channel_duties[i] != 0.0f) {
+                set_capture_compare_by_index(i, percent_to_counts(pwm_channel_duties[i]));
             }
         }
-        if (pwm_channel_duties[1] != 0.0f) {
-            if constexpr (this->is_32bit_instance) {
-                uint32_t raw_duty =
-                    (uint32_t)((float)(instance->tim->ARR + 1) * (pwm_channel_duties[1] / 100.0f));
-                instance->tim->CCR2 = raw_duty;
-            } else {
-                uint16_t raw_duty =
-                    (uint16_t)((float)(instance->tim->ARR + 1) * (pwm_channel_duties[1] / 100.0f));
-                instance->tim->CCR2 = raw_duty;
-            }
+    }
+
+    inline void refresh_period_cache() {
+        period_counts = instance->tim->ARR + 1;
+        counts_per_percent = (float)period_counts * 0.01f;
+        percent_per_count = 100.0f / (float)period_counts;
+    }
+
+    /* Duty conversions on the cached period, no clamping */
+    inline uint32_t percent_to_counts(float duty) const {
+        return (uint32_t)(duty * counts_per_percent);
+    }
+    inline uint32_t q15_to_counts(uint32_t duty_q15) const {
+        return (uint32_t)(((uint64_t)period_counts * duty_q15) >> 15);
+    }
+    inline uint32_t q31_to_counts(uint32_t duty_q31) const {
+        return (uint32_t)(((uint64_t)period_counts * duty_q31) >> 31);
+    }
+    inline float counts_to_percent(uint32_t counts) const {
+        return (float)counts * percent_per_count;
+    }
+
+    /* Writes CCR1..CCRN so that all of them take effect on the same update event. Update events
+       are held off (UDIS) while the preloaded registers are written, so the counter can never
+       reload in between and output a mix of old and new duties. The channels need output compare
+       preload enabled, which get_pwm() / get_dual_pwm() already do. Counts are clamped to the
+       period and the stored duties are kept in sync for set_pwm_frequency() */
+    template <std::size_t N>
+    inline void set_capture_compares(const std::array<uint32_t, N>& counts) {
+        static_assert(N > 0 && N <= MAX_pwm_channel_duties, "Only CCR1..CCR4 can be burst written");
+
+        std::array<uint32_t, N> clamped;
+        for (std::size_t i = 0; i < N; i++) {
+            clamped[i] = counts[i] > period_counts ? period_counts : counts[i];
         }
-        if (pwm_channel_duties[2] != 0.0f) {
-            if constexpr (this->is_32bit_instance) {
-                uint32_t raw_duty =
-                    (uint32_t)((float)(instance->tim->ARR + 1) * (pwm_channel_duties[2] / 100.0f));
-                instance->tim->CCR3 = raw_duty;
-            } else {
-                uint16_t raw_duty =
-                    (uint16_t)((float)(instance->tim->ARR + 1) * (pwm_channel_duties[2] / 100.0f));
-                instance->tim->CCR3 = raw_duty;
-            }
+
+        SET_BIT(instance->tim->CR1, TIM_CR1_UDIS);
+        instance->tim->CCR1 = clamped[0];
+        if constexpr (N > 1)
+            instance->tim->CCR2 = clamped[1];
+        if constexpr (N > 2)
+            instance->tim->CCR3 = clamped[2];
+        if constexpr (N > 3)
+            instance->tim->CCR4 = clamped[3];
+        CLEAR_BIT(instance->tim->CR1, TIM_CR1_UDIS);
+
+        for (std::size_t i = 0; i < N; i++) {
+            pwm_channel_duties[i] = counts_to_percent(clamped[i]);
         }
-        if (pwm_channel_duties[3] != 0.0f) {
-            if constexpr (this->is_32bit_instance) {
-                uint32_t raw_duty =
-                    (uint32_t)((float)(instance->tim->ARR + 1) * (pwm_channel_duties[3] / 100.0f));
-                instance->tim->CCR4 = raw_duty;
-            } else {
-                uint16_t raw_duty =
-                    (uint16_t)((float)(instance->tim->ARR + 1) * (pwm_channel_duties[3] / 100.0f));
-                instance->tim->CCR4 = raw_duty;
-            }
+    }
+
+    /* Same as set_capture_compares() with Q15 duties (1 << 15 = 100%) */
+    template <std::size_t N>
+    inline void set_duty_cycles_q15(const std::array<uint32_t, N>& duties_q15) {
+        std::array<uint32_t, N> counts;
+        for (std::size_t i = 0; i < N; i++) {
+            counts[i] = q15_to_counts(duties_q15[i] > DUTY_Q15_ONE ? DUTY_Q15_ONE : duties_q15[i]);
         }
+        set_capture_compares(counts);
     }
 
     template <ST_LIB::TimerChannel ch>
@@ -621,6 +655,25 @@ template <const TimerDomain::Timer& dev> struct TimerWrapper {
             ST_LIB::compile_error("Unknown timer channel, there are only 6 channels [1..6]");
     }
 
+    inline void set_capture_compare_by_index(int idx, uint32_t val) {
+        switch (idx) {
+        case 0:
+            instance->tim->CCR1 = val;
+            break;
+        case 1:
+            instance->tim->CCR2 = val;
+            break;
+        case 2:
+            instance->tim->CCR3 = val;
+            break;
+        case 3:
+            instance->tim->CCR4 = val;
+            break;
+        default:
+            break;
+        }
+    }
+
     inline bool are_all_channels_free() {
         return ((instance->tim->CCER & TIM_CCER_CCxE_MASK) == 0) &&
                ((instance->tim->CCER & TIM_CCER_CCxNE_MASK) == 0);
@@ -6,6 +6,10 @@
 
 #include "MockedDrivers/Register.hpp"
 
+#ifndef __NVIC_PRIO_BITS
+#define __NVIC_PRIO_BITS 4U
+#endif
+
 enum class NVICReg {
     Reg_ISER,
     Reg_ICER,
@@ -55,4 +59,47 @@ void NVIC_EnableIRQ(IRQn_Type IRQn);
 uint32_t NVIC_GetEnableIRQ(IRQn_Type IRQn);
 
 void NVIC_DisableIRQ(IRQn_Type IRQn);
+
+/*
+ * Pending an enabled interrupt runs its handler right away when its priority is above the one
+ * being executed, as the core would. Handlers come from the vector table below.
+ */
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+
+uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn);
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+
+uint32_t NVIC_GetActive(IRQn_Type IRQn);
+
+/* Preemption priority, lower runs first, __NVIC_PRIO_BITS wide as in CMSIS */
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+
+uint32_t NVIC_GetPriority(IRQn_Type IRQn);
+
+/* Host vector table, the handler address is a uintptr_t instead of the 32 bit CMSIS one */
+void NVIC_SetVector(IRQn_Type IRQn, uintptr_t vector);
+
+uintptr_t NVIC_GetVector(IRQn_Type IRQn);
 }
+
+namespace ST_LIB::MockedHAL {
+
+/* Clears enables, pendings, priorities and vectors */
+void nvic_reset();
+
+/*
+ * Runs the pending enabled interrupts above the current execution priority, highest priority
+ * first and lowest IRQ number on ties. Interrupts pended by a handler preempt it when they
+ * have a higher priority and wait for it to return otherwise.
+ */
+void nvic_dispatch_pending();
+
+/*
+ * While held, pending an interrupt only marks it. Used by the virtual clock so that all the
+ * events of a same instant are raised before any handler runs.
+ */
+void nvic_hold_dispatch();
+void nvic_release_dispatch();
+
+} // namespace ST_LIB::MockedHAL
@@ -0,0 +1,79 @@
+/*
+ * VirtualClock.hpp
+ *
+ * Discrete event clock for the host simulation. Mocked peripherals register the instants at
+ * which something happens (a timer update, a DMA transfer completing, an ADC conversion ending)
+ * and the clock jumps straight from one to the next instead of counting every tick. The
+ * interrupts raised at each instant are dispatched through the mocked NVIC in priority order,
+ * so seconds of firmware time run in milliseconds and whole-board tests become practical.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MockedDrivers/NVIC.hpp"
+#include "MockedDrivers/mocked_ll_tim.hpp"
+
+namespace ST_LIB::MockedHAL {
+
+class VirtualClock {
+public:
+    using event_t = void (*)(void* context);
+
+    static constexpr std::size_t kMaxEvents = 64;
+    static constexpr std::size_t kMaxTimers = 16;
+    static constexpr uint8_t INVALID_ID = 0xFF;
+    static constexpr uint64_t NEVER = UINT64_MAX;
+
+    /* Back to time 0, without events nor timers. The NVIC is reset on its own, nvic_reset() */
+    static void reset();
+
+    static uint64_t now_ns();
+
+    /**
+     * @brief Calls event(context) at at_ns, before the interrupts of that instant are
+     * dispatched. Events of a same instant run in the order they were scheduled, events in the
+     * past run on the next step.
+     *
+     * @return id for cancel(), INVALID_ID when the queue is full.
+     */
+    static uint8_t schedule_at(uint64_t at_ns, event_t event, void* context = nullptr);
+    static uint8_t schedule_in(uint64_t delay_ns, event_t event, void* context = nullptr);
+
+    /* Pends irqn at at_ns */
+    static uint8_t schedule_irq_at(uint64_t at_ns, IRQn_Type irqn);
+
+    static bool cancel(uint8_t id);
+
+    /**
+     * @brief Clocks tim at kernel_clock_hz from now on. Its next update is worked out from CNT,
+     * PSC, ARR and RCR whenever the clock moves, so firmware can reprogram it at any point, and
+     * a TIM_EGR_UG write is served as soon as the code that wrote it returns to the clock. The
+     * update interrupt is raised when DIER.UIE is set. Sets the timer IRQ handler as its vector
+     * when it has none.
+     */
+    static bool attach_timer(TIM_TypeDef* tim, uint32_t kernel_clock_hz);
+    static void detach_timer(TIM_TypeDef* tim);
+
+    /* Instant of the next event or timer update, NEVER when there is none */
+    static uint64_t next_event_ns();
+
+    /**
+     * @brief Jumps to the next instant with something to do, if it is not after limit_ns, and
+     * processes it: timers and events first, then the interrupts they raised.
+     *
+     * @return false when there is nothing until limit_ns, the clock is then moved to limit_ns
+     * unless it is NEVER.
+     */
+    static bool step(uint64_t limit_ns = NEVER);
+
+    /* Steps up to at_ns and leaves the clock there, returns the number of instants processed */
+    static std::size_t run_until(uint64_t at_ns);
+    static std::size_t run_for(uint64_t duration_ns);
+
+    /* True while an instant is processed, the clock can't be moved from a handler */
+    static bool busy();
+};
+
+} // namespace ST_LIB::MockedHAL
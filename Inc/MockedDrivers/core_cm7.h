@@ -1,3 +1,35 @@
 #pragma once
 
+#include <stdint.h>
+
 #include "MockedDrivers/compiler_specific.hpp"
+
+/*
+ * Debug blocks of the core used by DataWatchpointTrace. Nothing clocks CYCCNT in the simulator,
+ * tests write it to stand for the cycles elapsed.
+ */
+typedef struct {
+    volatile uint32_t CTRL;   /*!< Offset: 0x000 (R/W)  Control Register */
+    volatile uint32_t CYCCNT; /*!< Offset: 0x004 (R/W)  Cycle Count Register */
+    volatile uint32_t CPICNT;
+    volatile uint32_t EXCCNT;
+    volatile uint32_t SLEEPCNT;
+    volatile uint32_t LSUCNT;
+    volatile uint32_t FOLDCNT;
+    volatile uint32_t PCSR;
+    volatile uint32_t LAR; /*!< Lock Access Register */
+    volatile uint32_t LSR; /*!< Lock Status Register */
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DHCSR;
+    volatile uint32_t DCRSR;
+    volatile uint32_t DCRDR;
+    volatile uint32_t DEMCR; /*!< Debug Exception and Monitor Control Register */
+} CoreDebug_Type;
+
+#define ITM_LSR_Present_Msk (1UL << 0)
+#define ITM_LSR_Access_Msk (1UL << 1)
+
+extern DWT_Type* DWT;
+extern CoreDebug_Type* CoreDebug;
@@ -12,6 +12,17 @@ void adc_set_channel_raw(ADC_TypeDef* adc, uint32_t channel, uint32_t raw_value)
 
 void adc_set_poll_timeout(ADC_TypeDef* adc, bool enabled);
 
+/*
+ * Time a conversion takes on the VirtualClock. Conversions start with HAL_ADC_Start and end on
+ * a clock event; HAL_ADC_PollForConversion runs the clock up to the end of the one in flight,
+ * or of a new one when the last result was already read, so the interrupts due meanwhile
+ * preempt the polling code. After HAL_ADC_Start_IT the end of conversion pends ADC_IRQn
+ * (ADC3_IRQn for ADC3), whose HAL_ADC_IRQHandler calls HAL_ADC_ConvCpltCallback, and the next
+ * conversion starts right away in continuous mode. 0 by default, polled conversions are then
+ * immediate, as they are when polling from a handler.
+ */
+void adc_set_conversion_time_ns(ADC_TypeDef* adc, uint64_t conversion_time_ns);
+
 uint32_t adc_get_last_channel(ADC_TypeDef* adc);
 
 bool adc_is_running(ADC_TypeDef* adc);
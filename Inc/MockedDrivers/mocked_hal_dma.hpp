@@ -24,4 +24,11 @@ uint32_t dma_get_last_start_src();
 uint32_t dma_get_last_start_dst();
 uint32_t dma_get_last_start_length();
 
+/*
+ * With a transfer time, every HAL_DMA_Start_IT completes on the VirtualClock that long after it
+ * and pends the stream interrupt, whose HAL_DMA_IRQHandler calls XferCpltCallback. 0, the
+ * default, leaves transfers pending forever.
+ */
+void dma_set_transfer_time_ns(uint64_t transfer_time_ns);
+
 } // namespace ST_LIB::MockedHAL
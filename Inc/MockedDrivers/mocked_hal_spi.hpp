@@ -30,6 +30,33 @@ std::size_t spi_get_call_count(SPIOperation op);
 std::size_t spi_get_last_size_words();
 const uint8_t* spi_get_last_tx_data();
 std::size_t spi_get_last_tx_size_bytes();
+// Address handed to the HAL, i.e. where the DMA would read the transmitted bytes from
+const uint8_t* spi_get_last_tx_source();
 SPI_HandleTypeDef* spi_get_last_handle();
 
+/*
+ * Bus timing simulation on the VirtualClock. A DMA transfer ends on a clock event, its transfer
+ * time at the bit rate after it started, which dispatches the HAL completion callback, so anything
+ * started from the callback begins at the same instant. spi_complete_dma() runs the clock up to
+ * the end of the pending transfer; time spent elsewhere (e.g. waiting for the main loop to start
+ * the next transfer) is VirtualClock::run_for().
+ */
+struct SPIBusStats {
+    std::size_t transfers = 0;
+    std::size_t bytes = 0;
+    uint64_t first_start_ns = 0;
+    uint64_t last_end_ns = 0;
+    uint64_t total_gap_ns = 0; // Idle time between the end of a transfer and the next start
+    uint64_t max_gap_ns = 0;
+};
+
+void spi_set_bit_rate(uint32_t bits_per_second);
+bool spi_dma_pending();
+bool spi_complete_dma();
+std::size_t spi_run_dma_until_idle(std::size_t max_transfers);
+
+const SPIBusStats& spi_get_bus_stats();
+double spi_get_sustained_throughput_bytes_per_s();
+double spi_get_mean_gap_ns();
+
 } // namespace ST_LIB::MockedHAL
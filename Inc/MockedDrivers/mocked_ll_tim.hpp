@@ -158,6 +158,9 @@ struct TIM_TypeDef {
     }
 
     void inc_cnt_and_check(uint32_t val);
+
+    /* Counter overflow, returns true when it set UIF */
+    bool rollover();
 };
 static_assert(sizeof(TimerRegister<Reg_CNT>) == sizeof(uint32_t));
 void simulate_ticks(TIM_TypeDef* tim);
@@ -49,6 +49,8 @@ enum {
     TIM17_IRQn = 70,
     TIM23_IRQn = 71,
     TIM24_IRQn = 72,
+    ADC_IRQn = 18,
+    ADC3_IRQn = 127,
 };
 
 typedef struct {
@@ -373,6 +375,7 @@ typedef struct __DMA_HandleTypeDef {
     DMA_Stream_TypeDef* Instance;
     DMA_InitTypeDef Init;
     void* Parent;
+    void (*XferCpltCallback)(struct __DMA_HandleTypeDef* hdma);
 } DMA_HandleTypeDef;
 
 #define DMA_REQUEST_MEM2MEM 0x000U
@@ -720,8 +723,14 @@ typedef struct {
 #define TIM_CR1_CMS_0 (1U << 5)
 #define TIM_CR1_CMS_1 (1U << 6)
 #define TIM_CR1_CMS (TIM_CR1_CMS_0 | TIM_CR1_CMS_1)
+#define TIM_CR1_ARPE (1U << 7)
 #define TIM_CR1_CKD (3U << 8)
 
+#define TIM_CR2_MMS_Pos 4U
+#define TIM_CR2_MMS_0 (1U << 4)
+#define TIM_CR2_MMS_1 (1U << 5)
+#define TIM_CR2_MMS (7U << 4)
+
 #define TIM_CR2_OIS1 (1U << 8)
 #define TIM_CR2_OIS1N (1U << 9)
 #define TIM_CR2_OIS2 (1U << 10)
@@ -732,7 +741,11 @@ typedef struct {
 #define TIM_CR2_OIS5 (1U << 16)
 #define TIM_CR2_OIS6 (1U << 18)
 
+#define TIM_SMCR_SMS_1 (1U << 1)
+#define TIM_SMCR_SMS_2 (1U << 2)
 #define TIM_SMCR_SMS (7U << 0)
+#define TIM_SMCR_TS_Pos 4U
+#define TIM_SMCR_TS ((7U << 4) | (3U << 20))
 #define TIM_SMCR_ECE (1U << 14)
 
 #define TIM_DIER_UIE (1U << 0)
@@ -742,6 +755,8 @@ typedef struct {
 #define TIM_SR_TIF (1U << 6)
 #define TIM_SR_BIF (1U << 7)
 
+#define TIM_CCMR1_CC1S_0 (1U << 0)
+#define TIM_CCMR1_CC1S_1 (1U << 1)
 #define TIM_CCMR1_CC1S (3U << 0)
 #define TIM_CCMR1_OC1PE (1U << 3)
 #define TIM_CCMR1_OC1M (7U << 4)
@@ -800,6 +815,9 @@ HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef* hadc);
 HAL_StatusTypeDef HAL_ADC_DeInit(ADC_HandleTypeDef* hadc);
 HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef* hadc, ADC_ChannelConfTypeDef* sConfig);
 HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef* hadc);
+HAL_StatusTypeDef HAL_ADC_Start_IT(ADC_HandleTypeDef* hadc);
+void HAL_ADC_IRQHandler(ADC_HandleTypeDef* hadc);
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc);
 HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef* hadc, uint32_t Timeout);
 uint32_t HAL_ADC_GetValue(const ADC_HandleTypeDef* hadc);
 HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef* hadc);
@@ -829,11 +847,15 @@ HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(
     uint16_t Size
 );
 void HAL_SPI_IRQHandler(SPI_HandleTypeDef* hspi);
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi);
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi);
 
 void HAL_SYSCFG_AnalogSwitchConfig(uint32_t SYSCFG_AnalogSwitch, uint32_t SYSCFG_SwitchState);
 
 void NVIC_EnableIRQ(IRQn_Type IRQn);
 void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
 
 HAL_StatusTypeDef MockedHAL_DMA_Init_Impl(DMA_HandleTypeDef* hdma);
 HAL_StatusTypeDef MockedHAL_DMA_Start_IT_Impl(
@@ -847,9 +869,8 @@ void MockedHAL_DMA_IRQHandler_Impl(DMA_HandleTypeDef* hdma);
 static inline uint32_t HAL_RCC_GetPCLK1Freq(void) { return SystemCoreClock; }
 static inline uint32_t HAL_RCC_GetPCLK2Freq(void) { return SystemCoreClock; }
 static inline void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority, uint32_t subpriority) {
-    (void)IRQn;
-    (void)priority;
     (void)subpriority;
+    NVIC_SetPriority(IRQn, priority);
 }
 static inline void HAL_NVIC_EnableIRQ(IRQn_Type IRQn) { NVIC_EnableIRQ(IRQn); }
 static inline void HAL_NVIC_DisableIRQ(IRQn_Type IRQn) { NVIC_DisableIRQ(IRQn); }
@@ -94,7 +94,9 @@ using DomainsCtx = BuildCtx<
     SdDomain,
     EthernetDomain,
     ADCDomain,
-    EXTIDomain /* PWMDomain, ...*/>;
+    EXTIDomain,
+    PacketDomain,
+    ProtectionDomain /* PWMDomain, ...*/>;
 
 template <auto&... devs> struct Board {
     static consteval auto build_ctx() {
@@ -122,6 +124,8 @@ template <auto&... devs> struct Board {
         constexpr std::size_t ethN = domain_size<EthernetDomain>();
         constexpr std::size_t adcN = domain_size<ADCDomain>();
         constexpr std::size_t extiN = domain_size<EXTIDomain>();
+        constexpr std::size_t packetN = domain_size<PacketDomain>();
+        constexpr std::size_t protectionN = domain_size<ProtectionDomain>();
         // ...
 
         struct ConfigBundle {
@@ -137,6 +141,8 @@ template <auto&... devs> struct Board {
             std::array<EthernetDomain::Config, ethN> eth_cfgs;
             std::array<ADCDomain::Config, adcN> adc_cfgs;
             std::array<EXTIDomain::Config, extiN> exti_cfgs;
+            std::array<PacketDomain::Config, packetN> packet_cfgs;
+            std::array<ProtectionDomain::Config, protectionN> protection_cfgs;
             // ...
         };
 
@@ -158,6 +164,10 @@ template <auto&... devs> struct Board {
             .eth_cfgs = EthernetDomain::template build<ethN>(ctx.template span<EthernetDomain>()),
             .adc_cfgs = ADCDomain::template build<adcN>(ctx.template span<ADCDomain>()),
             .exti_cfgs = EXTIDomain::template build<extiN>(ctx.template span<EXTIDomain>()),
+            .packet_cfgs = PacketDomain::template build<packetN>(ctx.template span<PacketDomain>()),
+            .protection_cfgs =
+                ProtectionDomain::template build<protectionN>(ctx.template span<ProtectionDomain>()
+                ),
             // ...
         };
     }
@@ -177,6 +187,8 @@ template <auto&... devs> struct Board {
         constexpr std::size_t ethN = domain_size<EthernetDomain>();
         constexpr std::size_t adcN = domain_size<ADCDomain>();
         constexpr std::size_t extiN = domain_size<EXTIDomain>();
+        constexpr std::size_t packetN = domain_size<PacketDomain>();
+        constexpr std::size_t protectionN = domain_size<ProtectionDomain>();
         // ...
 
 #ifdef HAL_IWDG_MODULE_ENABLED
@@ -209,7 +221,11 @@ template <auto&... devs> struct Board {
         EthernetDomain::Init<ethN>::init(cfg.eth_cfgs, DigitalOutputDomain::Init<doutN>::instances);
         ADCDomain::Init<adcN>::init(cfg.adc_cfgs, GPIODomain::Init<gpioN>::instances);
         EXTIDomain::Init<extiN>::init(cfg.exti_cfgs,
-                                      GPIODomain::Init<gpioN>::instances); // ...
+                                      GPIODomain::Init<gpioN>::instances);
+        PacketDomain::Init<packetN, PacketDomain::arena_size(cfg.packet_cfgs)>::init(
+            cfg.packet_cfgs
+        );
+        ProtectionDomain::Init<protectionN>::init(cfg.protection_cfgs); // ...
     }
 
     template <typename Domain, auto& Target, std::size_t I = 0>
@@ -234,6 +250,8 @@ template <auto&... devs> struct Board {
 
         if constexpr (std::is_same_v<Domain, MPUDomain>) {
             return Domain::template Init<N, cfg.mpu_cfgs>::instances[idx];
+        } else if constexpr (std::is_same_v<Domain, PacketDomain>) {
+            return Domain::template Init<N, Domain::arena_size(cfg.packet_cfgs)>::instances[idx];
         } else {
             return Domain::template Init<N>::instances[idx];
         }
@@ -1,105 +1,85 @@
 #pragma once
 
 #include "../ControlBlock.hpp"
+#include "../FixedPoint.hpp"
 
 enum FilterDerivatorType { None, ForwardEuler, BackwardEuler, Trapezoidal, Moving_Average };
 
-template <int N> class BDFDerivator : public ControlBlock<double, double> {
+/**
+ * @brief Backward differentiation over the last N samples. The coefficients are copied and
+ * folded with 1 / (i * period * order) into one weight per tap, so execute() is a dot product.
+ */
+template <int N, ControlNumeric T = double> class BDFDerivator : public ControlBlock<T, T> {
 public:
     double period;
     static constexpr int order = N - 1;
-    double buffer[N + 1] = {0.0};
-    double (&ks)[order];
+    T buffer[N + 1] = {};
+    double ks[order];
+    T weights[order];
     int index = 0;
     uint64_t counter = 0;
 
 public:
-    BDFDerivator(double period, double (&ks)[order]) : period(period), ks(ks) {
-        this->output_value = 0.0;
-    }
-    BDFDerivator(double period, double (&&ks)[order]) : period(period), ks(move(ks)) {
-        this->output_value = 0.0;
+    BDFDerivator(double period, const double (&ks)[order]) : period(period) {
+        for (int i = 1; i <= order; i++) {
+            this->ks[i - 1] = ks[i - 1];
+            weights[i - 1] = static_cast<T>(ks[i - 1] / (i * period * order));
+        }
+        this->output_value = T{};
     }
     void execute() override {
-        if (counter++ < order) {
-            buffer[index] = input_value;
-            index++;
-            index %= (N + 1);
-            output_value = 0.0;
+        buffer[index] = this->input_value;
+        if (counter < order) {
+            counter++;
+            index = (index + 1) % (N + 1);
+            this->output_value = T{};
             return;
         }
-        buffer[index] = input_value;
-        output_value = 0.0;
+        T derivative{};
         for (int i = 1; i <= order; i++) {
-            output_value += ks[i - 1] *
-                            (buffer[index] - buffer[((index - i) % (N + 1) + (N + 1)) % (N + 1)]) /
-                            i;
+            derivative += weights[i - 1] * (buffer[index] - buffer[(index - i + N + 1) % (N + 1)]);
         }
-        output_value /= (period * order);
-        index++;
-        index %= (N + 1);
-        counter--;
+        this->output_value = derivative;
+        index = (index + 1) % (N + 1);
     }
 
     void reset() {
-        output_value = 0;
-        counter = 0.0;
-        for (double& e : buffer) {
-            e = 0.0;
+        this->output_value = T{};
+        counter = 0;
+        index = 0;
+        for (T& e : buffer) {
+            e = T{};
         }
     }
 };
 
-class SimpleDerivator : public ControlBlock<double, double> {
+/* First difference divided by the period, the division is done as a product by 1 / period */
+template <ControlNumeric T> class BasicSimpleDerivator : public ControlBlock<T, T> {
 public:
     double period;
+    T inverse_period;
     static constexpr int N = 2;
-    double buffer[N] = {0.0};
+    T buffer[N] = {};
     int index = 0;
 
 public:
-    SimpleDerivator(double period) : ControlBlock<double, double>(0.0), period(period) {
-        output_value = 0.0;
+    BasicSimpleDerivator(double period)
+        : ControlBlock<T, T>(T{}), period(period), inverse_period(static_cast<T>(1.0 / period)) {
+        this->output_value = T{};
     }
     void execute() override {
-        buffer[index] = input_value;
-        output_value = (buffer[index] - buffer[((index - 1) % (N) + (N)) % (N)]) / period;
-        index++;
-        index %= N;
-        return;
+        buffer[index] = this->input_value;
+        this->output_value = (buffer[index] - buffer[index ^ 1]) * inverse_period;
+        index ^= 1;
     }
     void reset() {
-        output_value = 0;
+        this->output_value = T{};
         index = 0;
-        for (int i = 0; i < N; i++) {
-            buffer[i] = 0.0;
+        for (T& e : buffer) {
+            e = T{};
         }
     }
 };
 
-class SimpleFloatDerivator : public ControlBlock<float, float> {
-public:
-    float period;
-    static constexpr int N = 2;
-    float buffer[N] = {0.0};
-    int index = 0;
-
-public:
-    SimpleFloatDerivator(float period) : ControlBlock<float, float>(0.0), period(period) {
-        output_value = 0.0;
-    }
-    void execute() override {
-        buffer[index] = input_value;
-        output_value = (buffer[index] - buffer[((index - 1) % (N) + (N)) % (N)]) / period;
-        index++;
-        index %= N;
-        return;
-    }
-    void reset() {
-        output_value = 0;
-        index = 0;
-        for (int i = 0; i < N; i++) {
-            buffer[i] = 0.0;
-        }
-    }
-};
+using SimpleDerivator = BasicSimpleDerivator<double>;
+using SimpleFloatDerivator = BasicSimpleDerivator<float>;
@@ -0,0 +1,394 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "../ControlBlock.hpp"
+#include "../FixedPoint.hpp"
+
+#if !defined(SIM_ON)
+#include "HALAL/Services/CORDIC/CORDIC.hpp"
+#endif
+
+/**
+ * @brief Building blocks of field oriented control. Every quantity is per unit: currents relative
+ * to a base current chosen for the drive, voltages relative to Vdc / sqrt(3), the largest phase
+ * amplitude SVPWM reaches without overmodulation, and electrical angles in the CORDIC convention,
+ * [-pi, pi) over the whole int32 range. With those units every constant in the chain is below one,
+ * so the same code runs in float and in Q31.
+ */
+namespace FOC {
+
+template <ControlNumeric T> struct AlphaBeta {
+    T alpha{};
+    T beta{};
+};
+
+template <ControlNumeric T> struct DQ {
+    T d{};
+    T q{};
+};
+
+template <ControlNumeric T> struct Rotation {
+    T cos{};
+    T sin{};
+};
+
+template <ControlNumeric T> inline constexpr T HALF = T(0.5);
+template <ControlNumeric T> inline constexpr T INV_SQRT3 = T(0.57735026918962576451);
+template <ControlNumeric T> inline constexpr T SQRT3_2 = T(0.86602540378443864676);
+
+/* Amplitude invariant Clarke transform from two phase currents, ic = -ia - ib */
+template <ControlNumeric T> constexpr AlphaBeta<T> clarke(T ia, T ib) {
+    /* beta = (ia + 2 ib) / sqrt(3), split so that no constant reaches one */
+    T ib_scaled = ib * INV_SQRT3<T>;
+    return {ia, ia * INV_SQRT3<T> + ib_scaled + ib_scaled};
+}
+
+template <ControlNumeric T> constexpr DQ<T> park(const AlphaBeta<T>& in, const Rotation<T>& r) {
+    return {in.alpha * r.cos + in.beta * r.sin, in.beta * r.cos - in.alpha * r.sin};
+}
+
+template <ControlNumeric T>
+constexpr AlphaBeta<T> inverse_park(const DQ<T>& in, const Rotation<T>& r) {
+    return {in.d * r.cos - in.q * r.sin, in.d * r.sin + in.q * r.cos};
+}
+
+/**
+ * @brief Duties in [0, 1] of the three legs for a voltage vector, by min-max zero sequence
+ * injection, which places the same vectors as sector based SVPWM. A vector of magnitude one
+ * takes the legs exactly from 0 to 1, longer ones saturate.
+ */
+template <ControlNumeric T> constexpr std::array<T, 3> svpwm(const AlphaBeta<T>& v) {
+    T half_alpha = v.alpha * HALF<T>;
+    T beta = v.beta * SQRT3_2<T>;
+    T a = v.alpha;
+    T b = beta - half_alpha;
+    T c = -half_alpha - beta;
+
+    T max = a > b ? a : b;
+    max = max > c ? max : c;
+    T min = a < b ? a : b;
+    min = min < c ? min : c;
+    T offset = max * HALF<T> + min * HALF<T>;
+    return {HALF<T> + (a - offset) * INV_SQRT3<T>,
+            HALF<T> + (b - offset) * INV_SQRT3<T>,
+            HALF<T> + (c - offset) * INV_SQRT3<T>};
+}
+
+/* Compare value for a duty in [0, 1] on a timer counting period_counts */
+template <ControlNumeric T> constexpr uint32_t duty_to_counts(T duty, uint32_t period_counts) {
+    if constexpr (std::floating_point<T>) {
+        T counts = duty * static_cast<T>(period_counts) + T(0.5);
+        return counts > T(0) ? static_cast<uint32_t>(counts) : 0;
+    } else {
+        if (duty.raw <= 0) {
+            return 0;
+        }
+        uint64_t counts = static_cast<uint64_t>(period_counts) * static_cast<uint64_t>(duty.raw);
+        return static_cast<uint32_t>(
+            (counts + (uint64_t{1} << (T::frac_bits - 1))) >> T::frac_bits
+        );
+    }
+}
+
+/* Bitwise integer square root, floor(sqrt(value)) */
+constexpr uint64_t isqrt(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = uint64_t{1} << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+/* Square root, zero for negative values. The fixed point version never leaves the integers */
+template <ControlNumeric T> inline T square_root(T x) {
+    if constexpr (std::floating_point<T>) {
+        return x > T(0) ? std::sqrt(x) : T(0);
+    } else {
+        if (x.raw <= 0) {
+            return T{};
+        }
+        /* sqrt(raw * 2^F) = sqrt(x) * 2^F */
+        uint64_t scaled = static_cast<uint64_t>(x.raw) << T::frac_bits;
+        return T::from_raw(static_cast<typename T::storage_type>(isqrt(scaled)));
+    }
+}
+
+/**
+ * @brief Constant factor applied to a T. Floating point keeps the value, fixed point keeps a
+ * mantissa inside the range of T and a saturating left shift, so a proportional gain of 5 still
+ * works on Q31 signals.
+ */
+template <ControlNumeric T> class Gain {
+public:
+    constexpr Gain() = default;
+    constexpr Gain(double value) {
+        if constexpr (std::floating_point<T>) {
+            factor = static_cast<T>(value);
+        } else {
+            constexpr double limit = static_cast<double>(T::raw_max) * T::resolution();
+            while ((value < 0.0 ? -value : value) >= limit && shift < 30) {
+                value *= 0.5;
+                shift++;
+            }
+            factor = T(value);
+        }
+    }
+
+    constexpr double value() const {
+        if constexpr (std::floating_point<T>) {
+            return factor;
+        } else {
+            return static_cast<double>(factor) * static_cast<double>(int64_t{1} << shift);
+        }
+    }
+
+    friend constexpr T operator*(const Gain& gain, T x) {
+        if constexpr (std::floating_point<T>) {
+            return gain.factor * x;
+        } else {
+            T product = gain.factor * x;
+            if (gain.shift == 0) {
+                return product;
+            }
+            int64_t shifted = static_cast<int64_t>(product.raw) * (int64_t{1} << gain.shift);
+            if (shifted > T::raw_max) {
+                return T::max();
+            }
+            if (shifted < T::raw_min) {
+                return T::min();
+            }
+            return T::from_raw(static_cast<typename T::storage_type>(shifted));
+        }
+    }
+
+private:
+    T factor{};
+    int shift{0};
+};
+
+/**
+ * @brief Phase current in per unit from a raw ADC conversion, (raw - offset) * gain with the gain
+ * in per unit per count. Fixed point types take the difference as a fraction of 2^17 first, so
+ * any 16 bit reading fits.
+ */
+template <ControlNumeric T> class CurrentSense {
+public:
+    uint32_t offset{0};
+
+    constexpr CurrentSense() = default;
+    constexpr CurrentSense(uint32_t offset, double per_unit_per_count)
+        : offset(offset),
+          gain(std::floating_point<T> ? per_unit_per_count : per_unit_per_count * COUNT_SCALE) {}
+
+    constexpr T operator()(uint32_t raw) const {
+        int32_t difference = static_cast<int32_t>(raw) - static_cast<int32_t>(offset);
+        if constexpr (std::floating_point<T>) {
+            return gain * static_cast<T>(difference);
+        } else {
+            int64_t value = difference;
+            if constexpr (T::frac_bits >= 17) {
+                value <<= T::frac_bits - 17;
+            } else {
+                value >>= 17 - T::frac_bits;
+            }
+            return gain * T::from_raw(static_cast<typename T::storage_type>(value));
+        }
+    }
+
+private:
+    static constexpr double COUNT_SCALE = 131072.0;
+    Gain<T> gain{};
+};
+
+/**
+ * @brief PI with anti-windup for one current axis. The integrator is clamped to the output limit
+ * and holds whenever the output saturates in the direction it is integrating, so it recovers as
+ * soon as the error changes sign.
+ */
+template <ControlNumeric T> class CurrentPI {
+public:
+    Gain<T> kp{};
+    Gain<T> ki_period{};
+    T integral{};
+
+    constexpr CurrentPI() = default;
+    constexpr CurrentPI(double kp, double ki, double period) : kp(kp), ki_period(ki * period) {}
+
+    constexpr T execute(T error, T limit) {
+        T next = integral + ki_period * error;
+        next = next > limit ? limit : next;
+        next = next < -limit ? -limit : next;
+        T output = kp * error + next;
+        if (output > limit) {
+            output = limit;
+            next = next > integral ? integral : next;
+        } else if (output < -limit) {
+            output = -limit;
+            next = next < integral ? integral : next;
+        }
+        integral = next;
+        return output;
+    }
+
+    constexpr void reset() { integral = T{}; }
+};
+
+/* Software sin/cos, used by the simulator and wherever the CORDIC is not available */
+struct SoftwareSinCos {
+    template <ControlNumeric T> static Rotation<T> compute(int32_t angle) {
+        constexpr float TO_RADIANS = 3.14159265358979323846f / 2147483648.0f;
+        float radians = static_cast<float>(angle) * TO_RADIANS;
+        return {T(std::cos(radians)), T(std::sin(radians))};
+    }
+};
+
+#ifdef HAL_CORDIC_MODULE_ENABLED
+/**
+ * @brief sin/cos through the CORDIC in a single write and two reads, RotationComputer::start() must
+ * have enabled its clock. Results come in Q31 and are converted without going through float when T
+ * is fixed point.
+ */
+struct CordicSinCos {
+    template <ControlNumeric T> static Rotation<T> compute(int32_t angle) {
+        int32_t cos = 0;
+        int32_t sin = 0;
+        RotationComputer::cos_and_sin(&angle, &cos, &sin, 1);
+        return {from_q31<T>(cos), from_q31<T>(sin)};
+    }
+
+private:
+    template <ControlNumeric T> static T from_q31(int32_t value) {
+        if constexpr (std::floating_point<T>) {
+            return static_cast<T>(value) * T(1.0 / 2147483648.0);
+        } else {
+            return T::from_raw(
+                static_cast<typename T::storage_type>(value >> (31 - T::frac_bits))
+            );
+        }
+    }
+};
+
+using DefaultSinCos = CordicSinCos;
+#else
+using DefaultSinCos = SoftwareSinCos;
+#endif
+
+/* Phase currents of two legs and the electrical angle they were sampled at */
+template <ControlNumeric T> struct Sample {
+    T ia{};
+    T ib{};
+    int32_t angle{0};
+};
+
+} // namespace FOC
+
+/**
+ * @brief Current loop of a field oriented drive: Clarke, Park, a PI per axis with anti-windup,
+ * voltage limiting, inverse Park, SVPWM and the compare values of the three legs, all in T with no
+ * conversion in between. input_value holds the sampled currents and angle, execute() leaves the
+ * duties in output_value and the matching compare values in compare_counts.
+ *
+ * The d axis has priority on the voltage: vd is limited to max_voltage and vq to what remains of
+ * the circle, sqrt(max_voltage^2 - vd^2), so the commanded vector never leaves the linear range of
+ * SVPWM. on_sample() is the entry for the ADC end of sequence interrupt, it converts the raw
+ * conversions, runs the loop and writes the compare registers of the timer in one go:
+ *
+ *     void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef*) {
+ *         foc.on_sample(timer, ADC1->DR, ADC2->DR, encoder_angle());
+ *     }
+ */
+template <ControlNumeric T = float, class SinCos = FOC::DefaultSinCos>
+class FieldOrientedControl final : public ControlBlock<FOC::Sample<T>, std::array<T, 3>> {
+public:
+    FOC::DQ<T> reference{};
+    FOC::DQ<T> current{};
+    FOC::DQ<T> voltage{};
+    std::array<uint32_t, 3> compare_counts{};
+    FOC::CurrentPI<T> d_axis;
+    FOC::CurrentPI<T> q_axis;
+    FOC::CurrentSense<T> sense_a;
+    FOC::CurrentSense<T> sense_b;
+
+    /**
+     * @param kp proportional gain in per unit voltage per per unit current
+     * @param ki integral gain in per unit voltage per per unit current and second
+     * @param period control period in seconds
+     * @param period_counts counts of the PWM period, the compare value of a 100% duty
+     * @param max_voltage radius of the voltage circle, at most 1
+     */
+    constexpr FieldOrientedControl(
+        double kp,
+        double ki,
+        double period,
+        uint32_t period_counts = 0,
+        double max_voltage = 1.0
+    )
+        : d_axis(kp, ki, period), q_axis(kp, ki, period), period_counts(period_counts),
+          max_voltage(T(max_voltage)), max_voltage_squared(T(max_voltage * max_voltage)) {
+        this->input_value = {};
+        this->output_value = {FOC::HALF<T>, FOC::HALF<T>, FOC::HALF<T>};
+        compare_counts.fill(FOC::duty_to_counts(FOC::HALF<T>, period_counts));
+    }
+
+    void execute() override {
+        const FOC::Sample<T>& sample = this->input_value;
+        FOC::Rotation<T> rotation = SinCos::template compute<T>(sample.angle);
+        current = FOC::park(FOC::clarke(sample.ia, sample.ib), rotation);
+
+        voltage.d = d_axis.execute(reference.d - current.d, max_voltage);
+        T q_limit = FOC::square_root(max_voltage_squared - voltage.d * voltage.d);
+        voltage.q = q_axis.execute(reference.q - current.q, q_limit);
+
+        this->output_value = FOC::svpwm(FOC::inverse_park(voltage, rotation));
+        for (size_t leg = 0; leg < 3; leg++) {
+            compare_counts[leg] = FOC::duty_to_counts(this->output_value[leg], period_counts);
+        }
+    }
+
+    void on_sample(T ia, T ib, int32_t angle) {
+        this->input_value = {ia, ib, angle};
+        execute();
+    }
+
+    /* Raw conversions through sense_a and sense_b, compare values burst written to the timer */
+    template <class Timer>
+    void on_sample(Timer& timer, uint32_t raw_a, uint32_t raw_b, int32_t angle) {
+        on_sample(sense_a(raw_a), sense_b(raw_b), angle);
+        timer.set_capture_compares(compare_counts);
+    }
+
+    void set_period_counts(uint32_t counts) { period_counts = counts; }
+    uint32_t get_period_counts() const { return period_counts; }
+
+    void set_max_voltage(double value) {
+        max_voltage = T(value);
+        max_voltage_squared = T(value * value);
+    }
+
+    void reset() {
+        d_axis.reset();
+        q_axis.reset();
+        current = {};
+        voltage = {};
+        this->output_value = {FOC::HALF<T>, FOC::HALF<T>, FOC::HALF<T>};
+        compare_counts.fill(FOC::duty_to_counts(FOC::HALF<T>, period_counts));
+    }
+
+private:
+    uint32_t period_counts;
+    T max_voltage;
+    T max_voltage_squared;
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cmath>
+
+#include "../ControlBlock.hpp"
+#include "../FixedPoint.hpp"
+
+enum class AntiWindup { ConditionalIntegration, BackCalculation };
+
+/* Gains of FastPID, in the units of the signals and seconds */
+struct PIDGains {
+    double kp = 0.0;
+    double ki = 0.0;
+    double kd = 0.0;
+    /* Time constant of the first order filter on the derivative, 0 leaves a plain difference */
+    double derivative_filter = 0.0;
+    /* Share of the setpoint seen by the proportional (b) and derivative (c) terms */
+    double setpoint_weight = 1.0;
+    double derivative_setpoint_weight = 0.0;
+    /* Back calculation gain in 1/s, 0 picks 1 / sqrt(Ti * Td), or 1 / Ti without derivative */
+    double tracking = 0.0;
+};
+
+/**
+ * @brief PID with output limits for fast loops. execute() takes the setpoint r and the measurement
+ * y and computes
+ *
+ *     u = kp (b r - y) + I + D,    D = filtered kd d(c r - y)/dt
+ *
+ * With the default c = 0 the derivative only sees the measurement, so setpoint steps don't kick
+ * the output. Every coefficient is folded when the gains are set, a step is a handful of multiply
+ * adds and a clamp.
+ *
+ * The integrator knows about the limits. BackCalculation bleeds the part of u that was clipped
+ * back into I with the tracking gain, ConditionalIntegration stops integrating while the output is
+ * saturated and the error pushes further into the limit. Gain changes are bumpless: the
+ * proportional jump they would cause is absorbed by the integrator, so gains can be tuned while
+ * the loop runs.
+ */
+template <ControlNumeric T = float, AntiWindup Method = AntiWindup::BackCalculation>
+class FastPID {
+public:
+    T output_value{};
+    T integral{};
+    /* Filtered rate of change of c r - y, the derivative term is kd times it */
+    T rate{};
+
+    FastPID(const PIDGains& gains, double period, double output_min, double output_max)
+        : period(period), output_min(static_cast<T>(output_min)),
+          output_max(static_cast<T>(output_max)) {
+        fold(gains);
+    }
+
+    T execute(T setpoint, T measurement) {
+        T derivative_input = c * setpoint - measurement;
+        if (first_execution) {
+            first_execution = false;
+            previous_derivative_input = derivative_input;
+        }
+        rate = rate_pole * rate + rate_gain * (derivative_input - previous_derivative_input);
+        previous_derivative_input = derivative_input;
+
+        T error = setpoint - measurement;
+        T unsaturated = kp_b * setpoint - kp * measurement + kd * rate + integral;
+        /* Selects rather than branches, the loop sits on the limits for long stretches */
+        T output = unsaturated > output_max ? output_max : unsaturated;
+        output = output < output_min ? output_min : output;
+
+        if constexpr (Method == AntiWindup::BackCalculation) {
+            integral += ki_period * error + tracking_period * (output - unsaturated);
+        } else {
+            bool winding_up = (unsaturated > output_max && error > T{}) ||
+                              (unsaturated < output_min && error < T{});
+            if (!winding_up) {
+                integral += ki_period * error;
+            }
+        }
+
+        last_setpoint = setpoint;
+        last_measurement = measurement;
+        output_value = output;
+        return output;
+    }
+
+    /* Bumpless, the integrator takes over the jump of the proportional and derivative terms */
+    void set_gains(const PIDGains& new_gains) {
+        T previous_terms = kp_b * last_setpoint - kp * last_measurement + kd * rate;
+        fold(new_gains);
+        integral += previous_terms - (kp_b * last_setpoint - kp * last_measurement + kd * rate);
+        previous_derivative_input = c * last_setpoint - last_measurement;
+    }
+
+    void set_kp(double kp) {
+        PIDGains changed = configured;
+        changed.kp = kp;
+        set_gains(changed);
+    }
+    void set_ki(double ki) {
+        PIDGains changed = configured;
+        changed.ki = ki;
+        set_gains(changed);
+    }
+    void set_kd(double kd) {
+        PIDGains changed = configured;
+        changed.kd = kd;
+        set_gains(changed);
+    }
+
+    void set_limits(double output_min, double output_max) {
+        this->output_min = static_cast<T>(output_min);
+        this->output_max = static_cast<T>(output_max);
+    }
+
+    const PIDGains& gains() const { return configured; }
+
+    /* Restarts the loop from initial_output, e.g. the last manual command */
+    void reset(T initial_output = T{}) {
+        integral = initial_output;
+        rate = T{};
+        output_value = initial_output;
+        first_execution = true;
+    }
+
+private:
+    double period;
+    PIDGains configured{};
+    T output_min;
+    T output_max;
+
+    T kp{};
+    T kp_b{};
+    T kd{};
+    T c{};
+    T ki_period{};
+    T tracking_period{};
+    T rate_pole{};
+    T rate_gain{};
+
+    T previous_derivative_input{};
+    T last_setpoint{};
+    T last_measurement{};
+    bool first_execution = true;
+
+    void fold(const PIDGains& gains) {
+        configured = gains;
+        kp = static_cast<T>(gains.kp);
+        kp_b = static_cast<T>(gains.kp * gains.setpoint_weight);
+        kd = static_cast<T>(gains.kd);
+        c = static_cast<T>(gains.derivative_setpoint_weight);
+        ki_period = static_cast<T>(gains.ki * period);
+
+        /* Backward Euler on the filter, stable for any time constant */
+        double filter = gains.derivative_filter > 0.0 ? gains.derivative_filter : 0.0;
+        rate_pole = static_cast<T>(filter / (filter + period));
+        rate_gain = static_cast<T>(1.0 / (filter + period));
+
+        double tracking = gains.tracking;
+        if (tracking <= 0.0 && gains.kp > 0.0 && gains.ki > 0.0) {
+            double ti = gains.kp / gains.ki;
+            double td = gains.kd / gains.kp;
+            tracking = td > 0.0 ? 1.0 / std::sqrt(ti * td) : 1.0 / ti;
+        } else if (tracking <= 0.0) {
+            tracking = gains.ki > 0.0 ? 1.0 / period : 0.0;
+        }
+        /* More than one period per step would overshoot the clipped amount */
+        tracking_period = static_cast<T>(tracking * period < 1.0 ? tracking * period : 1.0);
+    }
+};
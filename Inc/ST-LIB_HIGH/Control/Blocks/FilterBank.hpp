@@ -0,0 +1,300 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "../ControlBlock.hpp"
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#define STLIB_FILTER_BANK_SSE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define STLIB_FILTER_BANK_NEON 1
+#endif
+
+extern void compile_error(const char* msg);
+
+struct BiquadCoefficients {
+    float b0, b1, b2;
+    float a1, a2;
+};
+
+/* Filter design, evaluated by the compiler so only the float coefficients reach the binary */
+namespace FilterDesign {
+
+namespace detail {
+
+inline constexpr double pi = 3.14159265358979323846;
+
+consteval double sin(double x) {
+    double turns = x / (2 * pi);
+    x -= 2 * pi * static_cast<double>(static_cast<long long>(turns + (turns < 0 ? -0.5 : 0.5)));
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 30; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+consteval double cos(double x) { return sin(x + pi / 2); }
+
+/* Bilinear transform prewarping, K = tan(pi * cutoff / sample_rate) */
+consteval double prewarp(double sample_rate, double cutoff) {
+    if (cutoff <= 0.0 || cutoff >= sample_rate / 2) {
+        compile_error("Filter cutoff must be between 0 and half the sample rate");
+    }
+    double w = pi * cutoff / sample_rate;
+    return sin(w) / cos(w);
+}
+
+} // namespace detail
+
+inline constexpr double butterworth_q = 0.7071067811865476;
+
+/* Second order Butterworth for the default q */
+consteval BiquadCoefficients lowpass(double sample_rate, double cutoff, double q = butterworth_q) {
+    double k = detail::prewarp(sample_rate, cutoff);
+    double norm = 1.0 / (1.0 + k / q + k * k);
+    double b0 = k * k * norm;
+    return {
+        static_cast<float>(b0),
+        static_cast<float>(2.0 * b0),
+        static_cast<float>(b0),
+        static_cast<float>(2.0 * (k * k - 1.0) * norm),
+        static_cast<float>((1.0 - k / q + k * k) * norm)
+    };
+}
+
+consteval BiquadCoefficients highpass(double sample_rate, double cutoff, double q = butterworth_q) {
+    double k = detail::prewarp(sample_rate, cutoff);
+    double norm = 1.0 / (1.0 + k / q + k * k);
+    return {
+        static_cast<float>(norm),
+        static_cast<float>(-2.0 * norm),
+        static_cast<float>(norm),
+        static_cast<float>(2.0 * (k * k - 1.0) * norm),
+        static_cast<float>((1.0 - k / q + k * k) * norm)
+    };
+}
+
+/* Unity gain at center */
+consteval BiquadCoefficients bandpass(double sample_rate, double center, double q) {
+    double k = detail::prewarp(sample_rate, center);
+    double norm = 1.0 / (1.0 + k / q + k * k);
+    return {
+        static_cast<float>(k / q * norm),
+        0.0f,
+        static_cast<float>(-k / q * norm),
+        static_cast<float>(2.0 * (k * k - 1.0) * norm),
+        static_cast<float>((1.0 - k / q + k * k) * norm)
+    };
+}
+
+/* Hamming windowed sinc normalized to unity gain at DC */
+template <size_t Taps>
+consteval std::array<float, Taps> fir_lowpass(double sample_rate, double cutoff) {
+    if (cutoff <= 0.0 || cutoff >= sample_rate / 2) {
+        compile_error("Filter cutoff must be between 0 and half the sample rate");
+    }
+    std::array<double, Taps> taps{};
+    double fc = cutoff / sample_rate;
+    double sum = 0.0;
+    for (size_t n = 0; n < Taps; n++) {
+        double m = static_cast<double>(n) - (Taps - 1) / 2.0;
+        double sinc = m == 0.0 ? 2 * fc : detail::sin(2 * detail::pi * fc * m) / (detail::pi * m);
+        double window =
+            Taps == 1 ? 1.0 : 0.54 - 0.46 * detail::cos(2 * detail::pi * n / (Taps - 1));
+        taps[n] = sinc * window;
+        sum += taps[n];
+    }
+    std::array<float, Taps> result{};
+    for (size_t n = 0; n < Taps; n++) {
+        result[n] = static_cast<float>(taps[n] / sum);
+    }
+    return result;
+}
+
+/* The FIR equivalent of MovingAverage<Taps> */
+template <size_t Taps> consteval std::array<float, Taps> fir_moving_average() {
+    std::array<float, Taps> result{};
+    result.fill(static_cast<float>(1.0 / Taps));
+    return result;
+}
+
+} // namespace FilterDesign
+
+/* One value per channel, the kernels are written once against this interface */
+namespace FilterBankLanes {
+
+struct Scalar {
+    static constexpr size_t width = 1;
+    float v;
+    static Scalar load(const float* p) { return {*p}; }
+    static Scalar splat(float x) { return {x}; }
+    void store(float* p) const { *p = v; }
+    friend Scalar operator+(Scalar a, Scalar b) { return {a.v + b.v}; }
+    friend Scalar operator-(Scalar a, Scalar b) { return {a.v - b.v}; }
+    friend Scalar operator*(Scalar a, Scalar b) { return {a.v * b.v}; }
+};
+
+#if defined(STLIB_FILTER_BANK_SSE)
+struct Vector {
+    static constexpr size_t width = 4;
+    __m128 v;
+    static Vector load(const float* p) { return {_mm_loadu_ps(p)}; }
+    static Vector splat(float x) { return {_mm_set1_ps(x)}; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+    friend Vector operator+(Vector a, Vector b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend Vector operator-(Vector a, Vector b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend Vector operator*(Vector a, Vector b) { return {_mm_mul_ps(a.v, b.v)}; }
+};
+#elif defined(STLIB_FILTER_BANK_NEON)
+struct Vector {
+    static constexpr size_t width = 4;
+    float32x4_t v;
+    static Vector load(const float* p) { return {vld1q_f32(p)}; }
+    static Vector splat(float x) { return {vdupq_n_f32(x)}; }
+    void store(float* p) const { vst1q_f32(p, v); }
+    friend Vector operator+(Vector a, Vector b) { return {vaddq_f32(a.v, b.v)}; }
+    friend Vector operator-(Vector a, Vector b) { return {vsubq_f32(a.v, b.v)}; }
+    friend Vector operator*(Vector a, Vector b) { return {vmulq_f32(a.v, b.v)}; }
+};
+#else
+/* The Cortex-M7 FPU has no vector unit, independent channels keep both issue slots busy */
+using Vector = Scalar;
+#endif
+
+} // namespace FilterBankLanes
+
+/**
+ * @brief Channels independent signals filtered by the same cascade of Stages biquads in Direct
+ * Form II Transposed. The state is stored stage by stage with the channels contiguous, so every
+ * stage is a loop over channels with no dependency between iterations: SSE/NEON on the host,
+ * back to back FPU instructions on the board.
+ *
+ * execute() and execute_scalar() do the same operations in the same order on every channel, their
+ * outputs are identical bit for bit.
+ */
+template <size_t Channels, size_t Stages>
+class BiquadBank : public ControlBlock<std::array<float, Channels>, std::array<float, Channels>> {
+    static_assert(Channels > 0 && Stages > 0);
+
+public:
+    static constexpr bool vectorized = FilterBankLanes::Vector::width > 1;
+
+    std::array<BiquadCoefficients, Stages> coefficients;
+
+    constexpr BiquadBank(const std::array<BiquadCoefficients, Stages>& coefficients)
+        : coefficients(coefficients) {
+        this->input_value = {};
+        this->output_value = {};
+    }
+
+    void execute() override { run<FilterBankLanes::Vector>(); }
+    void execute_scalar() { run<FilterBankLanes::Scalar>(); }
+
+    void reset() {
+        for (size_t stage = 0; stage < Stages; stage++) {
+            z1[stage].fill(0.0f);
+            z2[stage].fill(0.0f);
+        }
+        this->output_value = {};
+    }
+
+private:
+    alignas(16) std::array<std::array<float, Channels>, Stages> z1{};
+    alignas(16) std::array<std::array<float, Channels>, Stages> z2{};
+
+    template <typename Lane> void run() {
+        const float* x = this->input_value.data();
+        float* y = this->output_value.data();
+        for (size_t stage = 0; stage < Stages; stage++) {
+            size_t channel = step<Lane>(stage, x, y, 0);
+            if constexpr (Channels % Lane::width != 0) {
+                step<FilterBankLanes::Scalar>(stage, x, y, channel);
+            }
+            x = y;
+        }
+    }
+
+    /* Runs the stage from first to the last whole Lane, returns where it stopped */
+    template <typename Lane> size_t step(size_t stage, const float* x, float* y, size_t first) {
+        const BiquadCoefficients& c = coefficients[stage];
+        const Lane b0 = Lane::splat(c.b0), b1 = Lane::splat(c.b1), b2 = Lane::splat(c.b2);
+        const Lane a1 = Lane::splat(c.a1), a2 = Lane::splat(c.a2);
+        float* s1 = z1[stage].data();
+        float* s2 = z2[stage].data();
+        size_t channel = first;
+        for (; channel + Lane::width <= Channels; channel += Lane::width) {
+            Lane in = Lane::load(x + channel);
+            Lane out = b0 * in + Lane::load(s1 + channel);
+            (b1 * in - a1 * out + Lane::load(s2 + channel)).store(s1 + channel);
+            (b2 * in - a2 * out).store(s2 + channel);
+            out.store(y + channel);
+        }
+        return channel;
+    }
+};
+
+/**
+ * @brief Channels independent signals filtered by the same Taps coefficients FIR, with the same
+ * layout and guarantees as BiquadBank. FilterDesign::fir_moving_average<N>() replaces one
+ * MovingAverage<N> per channel.
+ */
+template <size_t Channels, size_t Taps>
+class FirBank : public ControlBlock<std::array<float, Channels>, std::array<float, Channels>> {
+    static_assert(Channels > 0 && Taps > 0);
+
+public:
+    static constexpr bool vectorized = FilterBankLanes::Vector::width > 1;
+
+    std::array<float, Taps> taps;
+
+    constexpr FirBank(const std::array<float, Taps>& taps) : taps(taps) {
+        this->input_value = {};
+        this->output_value = {};
+    }
+
+    void execute() override { run<FilterBankLanes::Vector>(); }
+    void execute_scalar() { run<FilterBankLanes::Scalar>(); }
+
+    void reset() {
+        for (auto& sample : history) {
+            sample.fill(0.0f);
+        }
+        newest = 0;
+        this->output_value = {};
+    }
+
+private:
+    /* history[newest] is the last input, older ones follow it circularly */
+    alignas(16) std::array<std::array<float, Channels>, Taps> history{};
+    size_t newest = 0;
+
+    template <typename Lane> void run() {
+        newest = newest == 0 ? Taps - 1 : newest - 1;
+        history[newest] = this->input_value;
+        size_t channel = step<Lane>(0);
+        if constexpr (Channels % Lane::width != 0) {
+            step<FilterBankLanes::Scalar>(channel);
+        }
+    }
+
+    template <typename Lane> size_t step(size_t first) {
+        float* y = this->output_value.data();
+        size_t channel = first;
+        for (; channel + Lane::width <= Channels; channel += Lane::width) {
+            Lane acc = Lane::splat(taps[0]) * Lane::load(history[newest].data() + channel);
+            size_t sample = newest;
+            for (size_t tap = 1; tap < Taps; tap++) {
+                sample = sample + 1 == Taps ? 0 : sample + 1;
+                acc = acc + Lane::splat(taps[tap]) * Lane::load(history[sample].data() + channel);
+            }
+            acc.store(y + channel);
+        }
+        return channel;
+    }
+};
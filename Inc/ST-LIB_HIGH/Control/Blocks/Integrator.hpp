@@ -1,172 +1,65 @@
 #pragma once
-#include "../ControlBlock.hpp"
 
-#pragma once
+#include "../ControlBlock.hpp"
+#include "../FixedPoint.hpp"
 
 enum class IntegratorType { ForwardEuler, BackwardEuler, Trapezoidal };
 
-template <IntegratorType T> class Integrator;
-
-template <IntegratorType T> class FloatIntegrator;
-
-template <> class Integrator<IntegratorType::Trapezoidal> : public ControlBlock<double, double> {
+/**
+ * @brief Discrete integrator of the input times ki. T is the number type of the signals: double,
+ * float or a saturating FixedPoint such as Q31, in which case the integral clamps at the ends of
+ * the range instead of wrapping. ki * period is folded into a single gain, change ki through
+ * set_ki() so it is folded again.
+ */
+template <IntegratorType Method, ControlNumeric T = double>
+class Integrator : public ControlBlock<T, T> {
 public:
     static constexpr int N = 2;
     double period;
-    double buffer[N] = {0.0};
-    int index = 0;
-    double integral = 0.0;
     double ki;
+    T gain{};
+    T buffer[N] = {};
+    int index = 0;
+    T integral{};
     bool first_execution = true;
 
     Integrator() = default;
     Integrator(double period, double ki)
-        : ControlBlock<double, double>(0.0), period(period), ki(ki) {
-        output_value = 0.0;
+        : ControlBlock<T, T>(T{}), period(period), ki(ki), gain(static_cast<T>(ki * period)) {
+        this->output_value = T{};
     }
     void execute() override {
-        buffer[index] = input_value;
+        buffer[index] = this->input_value;
         if (first_execution) {
             first_execution = false;
-            index++;
-            index %= N;
-            output_value = 0.0;
+            index ^= 1;
+            this->output_value = T{};
             return;
         }
-        integral += ki * period * (buffer[index] + buffer[((index - 1) % (N) + (N)) % (N)]) / 2.0;
-        output_value = integral;
-        index++;
-        index %= N;
-        return;
-    }
-    void reset() {
-        output_value = 0;
-        first_execution = true;
-        integral = 0.0;
-        index = 0;
-        for (int i = 0; i < N; i++) {
-            buffer[i] = 0.0;
+        const T& previous = buffer[index ^ 1];
+        if constexpr (Method == IntegratorType::Trapezoidal) {
+            integral += gain * (buffer[index] + previous) / 2;
+        } else if constexpr (Method == IntegratorType::ForwardEuler) {
+            integral += gain * previous;
+        } else {
+            integral += gain * buffer[index];
         }
+        this->output_value = integral;
+        index ^= 1;
     }
-};
-
-template <> class FloatIntegrator<IntegratorType::Trapezoidal> : public ControlBlock<float, float> {
-public:
-    static constexpr int N = 2;
-    float period;
-    float buffer[N] = {0.0};
-    int index = 0;
-    float integral = 0.0;
-    float ki;
-    bool first_execution = true;
-
-    FloatIntegrator() = default;
-    FloatIntegrator(float period, float ki)
-        : ControlBlock<float, float>(0.0), period(period), ki(ki) {
-        output_value = 0.0;
-    }
-    void execute() override {
-        buffer[index] = input_value;
-        if (first_execution) {
-            first_execution = false;
-            index++;
-            index %= N;
-            output_value = 0.0;
-            return;
-        }
-        integral += ki * period * (buffer[index] + buffer[((index - 1) % (N) + (N)) % (N)]) / 2.0;
-        output_value = integral;
-        index++;
-        index %= N;
-        return;
+    void set_ki(double ki) {
+        this->ki = ki;
+        gain = static_cast<T>(ki * period);
     }
     void reset() {
-        output_value = 0;
+        this->output_value = T{};
         first_execution = true;
-        integral = 0.0;
+        integral = T{};
         index = 0;
-        for (int i = 0; i < N; i++) {
-            buffer[i] = 0.0;
+        for (T& e : buffer) {
+            e = T{};
         }
     }
 };
 
-template <> class Integrator<IntegratorType::ForwardEuler> : public ControlBlock<double, double> {
-public:
-    static constexpr int N = 2;
-    double period;
-    double buffer[N] = {0.0};
-    int index = 0;
-    double integral = 0.0;
-    double ki;
-    bool first_execution = true;
-
-public:
-    Integrator(double period, double ki)
-        : ControlBlock<double, double>(0.0), period(period), ki(ki) {
-        this->output_value = 0.0;
-    }
-    void execute() override {
-        buffer[index] = input_value;
-        if (first_execution) {
-            first_execution = false;
-            index++;
-            index %= N;
-            output_value = 0.0;
-            return;
-        }
-        integral += ki * period * buffer[((index - 1) % (N) + (N)) % (N)];
-        output_value = integral;
-        index++;
-        index %= N;
-        return;
-    }
-    void reset() {
-        first_execution = true;
-        integral = 0.0;
-        index = 0;
-        for (int i = 0; i < N; i++) {
-            buffer[i] = 0.0;
-        }
-    }
-};
-
-template <> class Integrator<IntegratorType::BackwardEuler> : public ControlBlock<double, double> {
-public:
-    static constexpr int N = 2;
-    double period;
-    double buffer[N] = {0.0};
-    int index = 0;
-    double integral = 0.0;
-    double ki;
-    bool first_execution = true;
-
-public:
-    Integrator(double period, double ki)
-        : ControlBlock<double, double>(0.0), period(period), ki(ki) {
-        output_value = 0.0;
-    }
-    void execute() override {
-        buffer[index] = input_value;
-        if (first_execution) {
-            first_execution = false;
-            index++;
-            index %= N;
-            output_value = 0.0;
-            return;
-        }
-        integral += ki * period * buffer[index];
-        output_value = integral;
-        index++;
-        index %= N;
-        return;
-    }
-    void reset() {
-        first_execution = true;
-        integral = 0.0;
-        index = 0;
-        for (int i = 0; i < N; i++) {
-            buffer[i] = 0.0;
-        }
-    }
-};
+template <IntegratorType Method> using FloatIntegrator = Integrator<Method, float>;
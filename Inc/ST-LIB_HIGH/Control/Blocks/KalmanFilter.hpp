@@ -0,0 +1,134 @@
+#pragma once
+
+#include "../ControlBlock.hpp"
+#include "../Matrix.hpp"
+
+/* x[k+1] = A x[k] + B u[k] + w, z[k] = H x[k] + v, with cov(w) = Q and cov(v) = R */
+template <size_t NX, size_t NZ, size_t NU = 1, typename T = float> struct KalmanModel {
+    Matrix<NX, NX, T> A;
+    Matrix<NX, NU, T> B;
+    Matrix<NZ, NX, T> H;
+    Matrix<NX, NX, T> Q;
+    Matrix<NZ, NZ, T> R;
+
+    template <typename U> constexpr KalmanModel<NX, NZ, NU, U> cast() const {
+        return {A.template cast<U>(),
+                B.template cast<U>(),
+                H.template cast<U>(),
+                Q.template cast<U>(),
+                R.template cast<U>()};
+    }
+};
+
+/**
+ * @brief Discrete Kalman filter estimating NX states from NZ measurements. input_value is the
+ * measurement z and control the input u, execute() predicts, corrects and writes the estimate to
+ * output_value.
+ *
+ * Made with fixed_gain(), the filter runs with that gain, which is the steady state filter: the
+ * prediction and the correction are folded into x = F x + G u + K z, three matrix-vector
+ * products per step. The gain comes from steady_state_gain(), evaluated at compile time.
+ * Built without one, the covariance is propagated every step and the gain is recomputed, which
+ * costs an NZ x NZ inversion.
+ */
+template <size_t NX, size_t NZ, size_t NU = 1, typename T = float>
+class KalmanFilter : public ControlBlock<Vector<NZ, T>, Vector<NX, T>> {
+public:
+    using Model = KalmanModel<NX, NZ, NU, T>;
+
+    Model model;
+    Vector<NU, T> control{};
+
+    /* Time varying filter, covariance starts at initial_covariance */
+    constexpr KalmanFilter(
+        const Model& model,
+        const Matrix<NX, NX, T>& initial_covariance = Matrix<NX, NX, T>::identity()
+    )
+        : model(model), steady_state(false), initial_covariance(initial_covariance),
+          covariance_(initial_covariance) {
+        this->input_value = {};
+        this->output_value = {};
+    }
+
+    /* Steady state filter with a precomputed gain */
+    static constexpr KalmanFilter fixed_gain(const Model& model, const Matrix<NX, NZ, T>& gain) {
+        KalmanFilter filter(model, Matrix<NX, NX, T>{});
+        filter.steady_state = true;
+        filter.gain_ = gain;
+        const Matrix<NX, NX, T> I_KH = Matrix<NX, NX, T>::identity() - gain * model.H;
+        filter.F = I_KH * model.A;
+        filter.G = I_KH * model.B;
+        return filter;
+    }
+
+    void execute() override {
+        if (steady_state) {
+            estimate = F * estimate + G * control + gain_ * this->input_value;
+        } else {
+            predict();
+            correct();
+        }
+        this->output_value = estimate;
+    }
+
+    void reset(const Vector<NX, T>& initial_estimate = {}) {
+        estimate = initial_estimate;
+        covariance_ = initial_covariance;
+        this->output_value = initial_estimate;
+    }
+
+    const Vector<NX, T>& state() const { return estimate; }
+    const Matrix<NX, NZ, T>& gain() const { return gain_; }
+    /* Only propagated by the time varying filter */
+    const Matrix<NX, NX, T>& covariance() const { return covariance_; }
+
+    /**
+     * @brief Gain the time varying filter converges to, from the steady state prediction
+     * covariance (the Riccati equation of the dual system). Evaluated at compile time, in double:
+     *
+     *     static constexpr auto K = Filter::steady_state_gain(model).cast<float>();
+     */
+    template <typename U>
+    static consteval Matrix<NX, NZ, U> steady_state_gain(const KalmanModel<NX, NZ, NU, U>& model) {
+        Matrix<NX, NX, U> P =
+            solve_dare(model.A.transpose(), model.H.transpose(), model.Q, model.R);
+        return kalman_gain(model, P);
+    }
+
+private:
+    bool steady_state;
+    Matrix<NX, NX, T> initial_covariance{};
+    Matrix<NX, NX, T> covariance_{};
+    Matrix<NX, NZ, T> gain_{};
+    Matrix<NX, NX, T> F{};
+    Matrix<NX, NU, T> G{};
+    Vector<NX, T> estimate{};
+
+    template <typename U>
+    static constexpr Matrix<NX, NZ, U>
+    kalman_gain(const KalmanModel<NX, NZ, NU, U>& model, const Matrix<NX, NX, U>& P) {
+        Matrix<NX, NZ, U> PHt = P * model.H.transpose();
+        Matrix<NZ, NZ, U> S = model.H * PHt + model.R;
+        std::optional<Matrix<NZ, NZ, U>> s_inverse = S.inverse();
+        if (!s_inverse) {
+            if consteval {
+                compile_error("Kalman gain needs an invertible innovation covariance H P H' + R");
+            }
+            /* At runtime a singular innovation covariance means the measurement carries no
+             * information, the estimate is left to the prediction */
+            return {};
+        }
+        return PHt * *s_inverse;
+    }
+
+    void predict() {
+        estimate = model.A * estimate + model.B * control;
+        covariance_ = model.A * covariance_ * model.A.transpose() + model.Q;
+    }
+
+    void correct() {
+        gain_ = kalman_gain(model, covariance_);
+        estimate += gain_ * (this->input_value - model.H * estimate);
+        covariance_ = (Matrix<NX, NX, T>::identity() - gain_ * model.H) * covariance_;
+    }
+};
@@ -1,28 +1,29 @@
 #pragma once
 
 #include "../ControlBlock.hpp"
+#include "../FixedPoint.hpp"
 #include "ErrorHandler/ErrorHandler.hpp"
-template <int N> class MeanCalculator : public ControlBlock<double, double> {
+template <int N, ControlNumeric T = double> class MeanCalculator : public ControlBlock<T, T> {
 public:
     int index = 0;
-    double mean = 0.0;
+    T mean{};
 
 public:
-    MeanCalculator() : ControlBlock<double, double>(0.0) { output_value = 0.0; }
+    MeanCalculator() : ControlBlock<T, T>(T{}) { this->output_value = T{}; }
     void execute() override {
-        mean += input_value / N;
+        mean += this->input_value / N;
         index++;
         if (index > N)
             ErrorHandler("MeanCalculator is receiving just 0");
         if (index == N)
-            output_value = mean;
+            this->output_value = mean;
         else
-            output_value = 0.0;
+            this->output_value = T{};
         return;
     }
     void reset() {
-        mean = 0.0;
+        mean = T{};
         index = 0;
-        output_value = 0.0;
+        this->output_value = T{};
     }
 };
@@ -5,36 +5,42 @@
 #include <cstdio>
 
 #include "../ControlSystem.hpp"
+#include "../FixedPoint.hpp"
 #include "HALAL/Models/Concepts/Concepts.hpp"
 
-template <size_t N> class MovingAverage : public ControlBlock<double, double> {
+/**
+ * @brief Mean of the last N inputs, output_value stays at zero until N inputs have been seen. T
+ * is the number type of the signals, each input is divided by N before accumulating so a
+ * FixedPoint accumulator never goes out of range.
+ */
+template <size_t N, ControlNumeric T = double> class MovingAverage : public ControlBlock<T, T> {
 private:
-    double buffer[N] = {0.0};
+    T buffer[N] = {};
     uint32_t first = 0, last = -1;
     uint32_t counter = 0;
-    double accumulator = 0.0;
+    T accumulator{};
 
 public:
-    MovingAverage() : ControlBlock<double, double>() { output_value = 0.0; }
+    MovingAverage() : ControlBlock<T, T>() { this->output_value = T{}; }
 
     void execute() override {
         if (counter < N) {
             last++;
-            buffer[last] = input_value;
-            accumulator += input_value / N;
+            buffer[last] = this->input_value;
+            accumulator += this->input_value / N;
             counter++;
             return;
         }
         accumulator -= buffer[first] / N;
         first = (first + 1) % N;
         last = (last + 1) % N;
-        buffer[last] = input_value;
+        buffer[last] = this->input_value;
         accumulator += buffer[last] / N;
-        output_value = accumulator;
+        this->output_value = accumulator;
         return;
     }
 
-    double compute(double input_v) {
+    T compute(T input_v) {
         this->input(input_v);
         execute();
         return this->output_value;
@@ -44,58 +50,15 @@ public:
         first = 0;
         last = -1;
         counter = 0;
-        accumulator = 0;
-        output_value = 0;
-        for (double& e : buffer) {
-            e = 0;
+        accumulator = T{};
+        this->output_value = T{};
+        for (T& e : buffer) {
+            e = T{};
         }
     }
 };
 
-template <size_t N> class FloatMovingAverage : public ControlBlock<float, float> {
-private:
-    float buffer[N] = {0.0};
-    uint32_t first = 0, last = -1;
-    uint32_t counter = 0;
-    float accumulator = 0.0;
-
-public:
-    FloatMovingAverage() : ControlBlock<float, float>() { output_value = 0.0; }
-
-    void execute() override {
-        if (counter < N) {
-            last++;
-            buffer[last] = input_value;
-            accumulator += input_value / N;
-            counter++;
-            return;
-        }
-        accumulator -= buffer[first] / N;
-        first = (first + 1) % N;
-        last = (last + 1) % N;
-        buffer[last] = input_value;
-        accumulator += buffer[last] / N;
-        output_value = accumulator;
-        return;
-    }
-
-    float compute(float input_v) {
-        this->input(input_v);
-        execute();
-        return this->output_value;
-    }
-
-    void reset() {
-        first = 0;
-        last = -1;
-        counter = 0;
-        accumulator = 0;
-        output_value = 0;
-        for (float& e : buffer) {
-            e = 0;
-        }
-    }
-};
+template <size_t N> using FloatMovingAverage = MovingAverage<N, float>;
 
 /**
  * @brief version of moving average for integers. Shifts the values by DecimalBitCount before adding
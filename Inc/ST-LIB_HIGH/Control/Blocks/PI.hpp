@@ -3,24 +3,25 @@
 #include "../ControlBlock.hpp"
 #include "Integrator.hpp"
 
-template <IntegratorType IntegratorMethod> class PI : public ControlBlock<double, double> {
+template <IntegratorType IntegratorMethod, ControlNumeric T = double>
+class PI : public ControlBlock<T, T> {
 public:
-    double kp;
-    double error;
-    Integrator<IntegratorMethod> integrator;
+    T kp{};
+    T error{};
+    Integrator<IntegratorMethod, T> integrator;
 
 public:
     PI() = default;
-    PI(double kp, double ki, double period) : kp(kp), integrator(period, ki) {}
+    PI(double kp, double ki, double period) : kp(static_cast<T>(kp)), integrator(period, ki) {}
     void execute() override {
         integrator.input(this->input_value);
         integrator.execute();
         error = this->input_value;
         this->output_value = kp * error + integrator.output_value;
     }
-    void set_kp(double kp) { this->kp = kp; }
+    void set_kp(double kp) { this->kp = static_cast<T>(kp); }
     void set_ki(double ki) {
-        integrator.ki = ki;
+        integrator.set_ki(ki);
         integrator.reset();
     }
     void reset() { integrator.reset(); }
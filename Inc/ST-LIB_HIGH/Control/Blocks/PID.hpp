@@ -1,24 +1,39 @@
 #include "../ControlSystem.hpp"
 #include "Integrator.hpp"
 #include "Derivator.hpp"
+#include "MovingAverage.hpp"
 
 #pragma once
 
+/**
+ * @brief PID over the number type T (double, float or a FixedPoint such as Q16). The gains are
+ * given as double and converted once, PID<...> keeps the double version of the controller.
+ */
+template <
+    ControlNumeric T,
+    IntegratorType IntegratorMethod,
+    FilterDerivatorType FilterDerivate,
+    size_t... N>
+class BasicPID;
+
 template <IntegratorType IntegratorMethod, FilterDerivatorType FilterDerivate, size_t... N>
-class PID;
+using PID = BasicPID<double, IntegratorMethod, FilterDerivate, N...>;
 
-template <IntegratorType IntegratorMethod> class PID<IntegratorMethod, FilterDerivatorType::None> {
+template <ControlNumeric T, IntegratorType IntegratorMethod>
+class BasicPID<T, IntegratorMethod, FilterDerivatorType::None> {
 public:
-    double kp, ki, kd;
-    double error = 0;
-    SimpleDerivator derivator;
-    Integrator<IntegratorMethod> integrator;
-    double output_value = 0.0;
+    T kp, kd;
+    double ki;
+    T error{};
+    BasicSimpleDerivator<T> derivator;
+    Integrator<IntegratorMethod, T> integrator;
+    T output_value{};
 
 public:
-    PID(double kp, double ki, double kd, double period)
-        : kp(kp), ki(ki), kd(kd), derivator(period), integrator(period, ki) {}
-    double execute(double input_value) {
+    BasicPID(double kp, double ki, double kd, double period)
+        : kp(static_cast<T>(kp)), kd(static_cast<T>(kd)), ki(ki), derivator(period),
+          integrator(period, ki) {}
+    T execute(T input_value) {
         derivator.input(input_value);
         derivator.execute();
         integrator.input(input_value);
@@ -28,15 +43,16 @@ public:
         return output_value;
     }
     void set_kp(double kp) {
-        this->kp = kp;
+        this->kp = static_cast<T>(kp);
         reset();
     }
     void set_ki(double ki) {
         this->ki = ki;
+        integrator.set_ki(ki);
         reset();
     }
     void set_kd(double kd) {
-        this->kd = kd;
+        this->kd = static_cast<T>(kd);
         reset();
     }
     void reset() {
@@ -45,39 +61,42 @@ public:
     }
 };
 
-template <IntegratorType IntegratorMethod, size_t N>
-class PID<IntegratorMethod, FilterDerivatorType::Moving_Average, N>
-    : public ControlBlock<double, double> {
+template <ControlNumeric T, IntegratorType IntegratorMethod, size_t N>
+class BasicPID<T, IntegratorMethod, FilterDerivatorType::Moving_Average, N>
+    : public ControlBlock<T, T> {
 public:
-    double kp, ki, kd;
-    double error = 0;
-    SimpleDerivator derivator;
-    Integrator<IntegratorMethod> integrator;
-    MovingAverage<N> filter_derivative;
+    T kp, kd;
+    double ki;
+    T error{};
+    BasicSimpleDerivator<T> derivator;
+    Integrator<IntegratorMethod, T> integrator;
+    MovingAverage<N, T> filter_derivative;
 
 public:
-    PID(double kp, double ki, double kd, double period)
-        : kp(kp), ki(ki), kd(kd), derivator(period), integrator(period, ki) {}
+    BasicPID(double kp, double ki, double kd, double period)
+        : kp(static_cast<T>(kp)), kd(static_cast<T>(kd)), ki(ki), derivator(period),
+          integrator(period, ki) {}
     void execute() override {
-        derivator.input(input_value);
+        derivator.input(this->input_value);
         derivator.execute();
-        integrator.input(input_value);
+        integrator.input(this->input_value);
         integrator.execute();
-        error = input_value;
+        error = this->input_value;
         filter_derivative.input(kd * derivator.output_value);
         filter_derivative.execute();
         this->output_value = kp * error + integrator.output_value + filter_derivative.output_value;
     }
     void set_kp(double kp) {
-        this->kp = kp;
+        this->kp = static_cast<T>(kp);
         reset();
     }
     void set_ki(double ki) {
         this->ki = ki;
+        integrator.set_ki(ki);
         reset();
     }
     void set_kd(double kd) {
-        this->kd = kd;
+        this->kd = static_cast<T>(kd);
         reset();
     }
     void reset() {
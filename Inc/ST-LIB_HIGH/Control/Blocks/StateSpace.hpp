@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../ControlBlock.hpp"
+#include "../Matrix.hpp"
+
+/**
+ * @brief Discrete linear system x[k+1] = A x[k] + B u[k], y[k] = C x[k] + D u[k]. Each execute()
+ * takes u from input_value, writes y to output_value and then advances the state. The matrices
+ * are public so they can be retuned, no derived quantity is cached from them.
+ */
+template <size_t NX, size_t NU, size_t NY, typename T = float>
+class StateSpace : public ControlBlock<Vector<NU, T>, Vector<NY, T>> {
+public:
+    Matrix<NX, NX, T> A;
+    Matrix<NX, NU, T> B;
+    Matrix<NY, NX, T> C;
+    Matrix<NY, NU, T> D;
+    Vector<NX, T> state{};
+
+    constexpr StateSpace(
+        const Matrix<NX, NX, T>& A,
+        const Matrix<NX, NU, T>& B,
+        const Matrix<NY, NX, T>& C,
+        const Matrix<NY, NU, T>& D = {}
+    )
+        : A(A), B(B), C(C), D(D) {
+        this->input_value = {};
+        this->output_value = {};
+    }
+
+    void execute() override {
+        this->output_value = C * state + D * this->input_value;
+        state = A * state + B * this->input_value;
+    }
+
+    void reset(const Vector<NX, T>& initial_state = {}) {
+        state = initial_state;
+        this->output_value = {};
+    }
+};
+
+/**
+ * @brief Steady state LQR gain K of the discrete system (A, B) with costs Q and R, for the law
+ * u = -K x. Evaluated at compile time, in double:
+ *
+ *     static constexpr auto K = lqr_gain(A, B, Q, R).cast<float>();
+ */
+template <size_t NX, size_t NU, typename T>
+consteval Matrix<NU, NX, T> lqr_gain(
+    const Matrix<NX, NX, T>& A,
+    const Matrix<NX, NU, T>& B,
+    const Matrix<NX, NX, T>& Q,
+    const Matrix<NU, NU, T>& R
+) {
+    Matrix<NX, NX, T> P = solve_dare(A, B, Q, R);
+    Matrix<NU, NU, T> S = R + B.transpose() * P * B;
+    std::optional<Matrix<NU, NU, T>> s_inverse = S.inverse();
+    if (!s_inverse) {
+        compile_error("LQR gain needs an invertible R + B' P B");
+    }
+    return *s_inverse * B.transpose() * P * A;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if !defined(SIM_ON) && defined(__ARM_FEATURE_DSP)
+#include "stm32h7xx.h"
+#define STLIB_FIXED_POINT_DSP 1
+#endif
+
+/**
+ * @brief Signed fixed point number with FracBits fractional bits in Storage, every operation
+ * saturates at the ends of the range instead of wrapping around. On the Cortex-M7 the 16 and 32
+ * bit additions go through the DSP instructions (__QADD, __QSUB, __SSAT), the host build uses
+ * portable equivalents with the same results.
+ *
+ * Conversions to and from floating point are explicit, they are meant for configuration and for
+ * looking at the values, not for the hot path.
+ */
+template <std::signed_integral Storage, int FracBits> class FixedPoint {
+    static_assert(sizeof(Storage) == 2 || sizeof(Storage) == 4, "16 or 32 bit storage only");
+    static_assert(FracBits > 0 && FracBits < std::numeric_limits<Storage>::digits + 1);
+
+    using Wide = std::conditional_t<sizeof(Storage) == 2, int32_t, int64_t>;
+
+public:
+    using storage_type = Storage;
+    static constexpr int frac_bits = FracBits;
+    static constexpr Storage raw_max = std::numeric_limits<Storage>::max();
+    static constexpr Storage raw_min = std::numeric_limits<Storage>::min();
+
+    Storage raw{0};
+
+    constexpr FixedPoint() = default;
+    constexpr explicit FixedPoint(double value) : raw(from_double(value)) {}
+    constexpr explicit FixedPoint(float value) : raw(from_double(value)) {}
+
+    static constexpr FixedPoint from_raw(Storage raw) {
+        FixedPoint value;
+        value.raw = raw;
+        return value;
+    }
+    static constexpr FixedPoint max() { return from_raw(raw_max); }
+    static constexpr FixedPoint min() { return from_raw(raw_min); }
+    /* Distance between two consecutive values */
+    static constexpr double resolution() { return 1.0 / scale; }
+
+    constexpr explicit operator double() const { return raw / scale; }
+    constexpr explicit operator float() const { return static_cast<float>(raw / scale); }
+
+    constexpr auto operator<=>(const FixedPoint&) const = default;
+
+    friend constexpr FixedPoint operator+(FixedPoint a, FixedPoint b) {
+        return from_raw(add(a.raw, b.raw));
+    }
+    friend constexpr FixedPoint operator-(FixedPoint a, FixedPoint b) {
+        return from_raw(sub(a.raw, b.raw));
+    }
+    friend constexpr FixedPoint operator-(FixedPoint a) { return from_raw(sub(0, a.raw)); }
+
+    /* Rounded to nearest */
+    friend constexpr FixedPoint operator*(FixedPoint a, FixedPoint b) {
+        Wide product = static_cast<Wide>(a.raw) * b.raw;
+        return from_raw(saturate((product + (Wide{1} << (FracBits - 1))) >> FracBits));
+    }
+    /* Division by zero saturates towards the sign of the dividend */
+    friend constexpr FixedPoint operator/(FixedPoint a, FixedPoint b) {
+        if (b.raw == 0) {
+            return a.raw < 0 ? min() : max();
+        }
+        return from_raw(saturate((static_cast<Wide>(a.raw) << FracBits) / b.raw));
+    }
+    template <std::integral Divisor>
+    friend constexpr FixedPoint operator/(FixedPoint a, Divisor divisor) {
+        return from_raw(saturate(static_cast<Wide>(a.raw) / static_cast<Wide>(divisor)));
+    }
+
+    constexpr FixedPoint& operator+=(FixedPoint other) { return *this = *this + other; }
+    constexpr FixedPoint& operator-=(FixedPoint other) { return *this = *this - other; }
+    constexpr FixedPoint& operator*=(FixedPoint other) { return *this = *this * other; }
+    constexpr FixedPoint& operator/=(FixedPoint other) { return *this = *this / other; }
+    template <std::integral Divisor> constexpr FixedPoint& operator/=(Divisor divisor) {
+        return *this = *this / divisor;
+    }
+
+private:
+    static constexpr double scale = static_cast<double>(Wide{1} << FracBits);
+
+    static constexpr Storage from_double(double value) {
+        double scaled = value * scale;
+        if (scaled >= static_cast<double>(raw_max)) {
+            return raw_max;
+        }
+        if (scaled <= static_cast<double>(raw_min)) {
+            return raw_min;
+        }
+        return static_cast<Storage>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+    }
+
+    static constexpr Storage saturate(Wide value) {
+        if (value > raw_max) {
+            return raw_max;
+        }
+        if (value < raw_min) {
+            return raw_min;
+        }
+        return static_cast<Storage>(value);
+    }
+
+    static constexpr Storage add(Storage a, Storage b) {
+#ifdef STLIB_FIXED_POINT_DSP
+        if !consteval {
+            if constexpr (sizeof(Storage) == 4) {
+                return static_cast<Storage>(__QADD(a, b));
+            } else {
+                return static_cast<Storage>(__SSAT(static_cast<int32_t>(a) + b, 16));
+            }
+        }
+#endif
+        return saturate(static_cast<Wide>(a) + b);
+    }
+
+    static constexpr Storage sub(Storage a, Storage b) {
+#ifdef STLIB_FIXED_POINT_DSP
+        if !consteval {
+            if constexpr (sizeof(Storage) == 4) {
+                return static_cast<Storage>(__QSUB(a, b));
+            } else {
+                return static_cast<Storage>(__SSAT(static_cast<int32_t>(a) - b, 16));
+            }
+        }
+#endif
+        return saturate(static_cast<Wide>(a) - b);
+    }
+};
+
+/* Range [-1, 1) */
+using Q15 = FixedPoint<int16_t, 15>;
+using Q31 = FixedPoint<int32_t, 31>;
+/* Range [-32768, 32768), for gains and rates that don't fit in Q15/Q31 */
+using Q16 = FixedPoint<int32_t, 16>;
+
+template <typename T> struct is_fixed_point : std::false_type {};
+template <std::signed_integral Storage, int FracBits>
+struct is_fixed_point<FixedPoint<Storage, FracBits>> : std::true_type {};
+
+/* Number types the control blocks can be instantiated with */
+template <typename T>
+concept ControlNumeric = std::floating_point<T> || is_fixed_point<T>::value;
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+extern void compile_error(const char* msg);
+
+/**
+ * @brief Fixed size matrix stored row major by value. The dimensions are part of the type, so a
+ * product of mismatched matrices doesn't compile, and every kernel is a fold over index
+ * sequences: the compiler sees a straight line of multiply-adds with no loop counters or
+ * bounds, which is what small state-space updates at 10 kHz want. Everything is constexpr so
+ * gains can be designed at compile time.
+ *
+ * The sums are accumulated in index order, ((a0 * b0 + a1 * b1) + a2 * b2) ..., the same as a
+ * plain triple loop.
+ */
+template <size_t Rows, size_t Cols, typename T = float> struct Matrix {
+    static_assert(Rows > 0 && Cols > 0);
+
+    using value_type = T;
+    static constexpr size_t rows = Rows;
+    static constexpr size_t cols = Cols;
+
+    std::array<T, Rows * Cols> data{};
+
+    constexpr T& operator()(size_t row, size_t col) { return data[row * Cols + col]; }
+    constexpr const T& operator()(size_t row, size_t col) const { return data[row * Cols + col]; }
+    /* Flat access, handy for vectors */
+    constexpr T& operator[](size_t i) { return data[i]; }
+    constexpr const T& operator[](size_t i) const { return data[i]; }
+
+    static constexpr Matrix zero() { return {}; }
+    static constexpr Matrix identity()
+        requires(Rows == Cols)
+    {
+        Matrix result;
+        for (size_t i = 0; i < Rows; i++) {
+            result(i, i) = T(1);
+        }
+        return result;
+    }
+
+    constexpr Matrix<Cols, Rows, T> transpose() const {
+        Matrix<Cols, Rows, T> result;
+        for (size_t row = 0; row < Rows; row++) {
+            for (size_t col = 0; col < Cols; col++) {
+                result(col, row) = (*this)(row, col);
+            }
+        }
+        return result;
+    }
+
+    template <typename U> constexpr Matrix<Rows, Cols, U> cast() const {
+        Matrix<Rows, Cols, U> result;
+        for (size_t i = 0; i < Rows * Cols; i++) {
+            result.data[i] = static_cast<U>(data[i]);
+        }
+        return result;
+    }
+
+    /* Gauss-Jordan with partial pivoting, nullopt for a singular matrix */
+    constexpr std::optional<Matrix> inverse() const
+        requires(Rows == Cols)
+    {
+        Matrix left = *this;
+        Matrix right = identity();
+        for (size_t col = 0; col < Rows; col++) {
+            size_t pivot = col;
+            for (size_t row = col + 1; row < Rows; row++) {
+                if (magnitude(left(row, col)) > magnitude(left(pivot, col))) {
+                    pivot = row;
+                }
+            }
+            if (left(pivot, col) == T(0)) {
+                return std::nullopt;
+            }
+            for (size_t k = 0; k < Rows; k++) {
+                std::swap(left(col, k), left(pivot, k));
+                std::swap(right(col, k), right(pivot, k));
+            }
+            T scale = T(1) / left(col, col);
+            for (size_t k = 0; k < Rows; k++) {
+                left(col, k) *= scale;
+                right(col, k) *= scale;
+            }
+            for (size_t row = 0; row < Rows; row++) {
+                T factor = left(row, col);
+                if (row == col || factor == T(0)) {
+                    continue;
+                }
+                for (size_t k = 0; k < Rows; k++) {
+                    left(row, k) -= factor * left(col, k);
+                    right(row, k) -= factor * right(col, k);
+                }
+            }
+        }
+        return right;
+    }
+
+    /* Largest absolute difference between two matrices, for convergence checks */
+    constexpr T max_difference(const Matrix& other) const {
+        T result = T(0);
+        for (size_t i = 0; i < Rows * Cols; i++) {
+            T difference = magnitude(data[i] - other.data[i]);
+            result = difference > result ? difference : result;
+        }
+        return result;
+    }
+
+    constexpr bool operator==(const Matrix&) const = default;
+
+    friend constexpr Matrix operator+(const Matrix& a, const Matrix& b) {
+        return elementwise(a, b, [](T x, T y) { return x + y; });
+    }
+    friend constexpr Matrix operator-(const Matrix& a, const Matrix& b) {
+        return elementwise(a, b, [](T x, T y) { return x - y; });
+    }
+    friend constexpr Matrix operator-(const Matrix& a) {
+        return elementwise(a, a, [](T x, T) { return -x; });
+    }
+    friend constexpr Matrix operator*(T scale, const Matrix& a) {
+        return elementwise(a, a, [scale](T x, T) { return scale * x; });
+    }
+
+    template <size_t Other>
+    friend constexpr Matrix<Rows, Other, T>
+    operator*(const Matrix& a, const Matrix<Cols, Other, T>& b) {
+        Matrix<Rows, Other, T> result;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((result.data[I] = dot<I / Other, I % Other>(a, b, std::make_index_sequence<Cols>{})),
+             ...);
+        }(std::make_index_sequence<Rows * Other>{});
+        return result;
+    }
+
+    constexpr Matrix& operator+=(const Matrix& other) { return *this = *this + other; }
+    constexpr Matrix& operator-=(const Matrix& other) { return *this = *this - other; }
+
+private:
+    static constexpr T magnitude(T x) { return x < T(0) ? -x : x; }
+
+    template <typename Op>
+    static constexpr Matrix elementwise(const Matrix& a, const Matrix& b, Op op) {
+        Matrix result;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((result.data[I] = op(a.data[I], b.data[I])), ...);
+        }(std::make_index_sequence<Rows * Cols>{});
+        return result;
+    }
+
+    template <size_t Row, size_t Col, size_t Other, size_t... K>
+    static constexpr T
+    dot(const Matrix& a, const Matrix<Cols, Other, T>& b, std::index_sequence<K...>) {
+        return (... + (a.data[Row * Cols + K] * b.data[K * Other + Col]));
+    }
+};
+
+template <size_t N, typename T = float> using Vector = Matrix<N, 1, T>;
+
+/**
+ * @brief Stabilizing solution P of the discrete algebraic Riccati equation
+ *
+ *     P = A' P A - A' P B (R + B' P B)^-1 B' P A + Q
+ *
+ * by the structure preserving doubling algorithm, which converges quadratically: a few tens of
+ * iterations where iterating the equation itself takes thousands for a system sampled much
+ * faster than its dynamics. Runs at compile time, a singular step or running out of iterations
+ * fails the build instead of handing back a meaningless P.
+ */
+template <size_t NX, size_t NU, typename T>
+consteval Matrix<NX, NX, T> solve_dare(
+    const Matrix<NX, NX, T>& A,
+    const Matrix<NX, NU, T>& B,
+    const Matrix<NX, NX, T>& Q,
+    const Matrix<NU, NU, T>& R,
+    T tolerance = T(1e-12),
+    size_t max_iterations = 64
+) {
+    using Square = Matrix<NX, NX, T>;
+    std::optional<Matrix<NU, NU, T>> r_inverse = R.inverse();
+    if (!r_inverse) {
+        compile_error("Riccati equation needs an invertible R");
+    }
+    Square a = A;
+    Square g = B * *r_inverse * B.transpose();
+    Square h = Q;
+    for (size_t i = 0; i < max_iterations; i++) {
+        std::optional<Square> w_inverse = (Square::identity() + g * h).inverse();
+        if (!w_inverse) {
+            compile_error("Riccati doubling step is singular, check that (A, B) is stabilizable");
+        }
+        const Square& w = *w_inverse;
+        Square next_a = a * w * a;
+        Square next_g = g + a * w * g * a.transpose();
+        Square next_h = h + a.transpose() * h * w * a;
+        T scale = T(1) + next_h.max_difference(Square{});
+        bool converged = next_h.max_difference(h) <= tolerance * scale;
+        a = next_a;
+        g = next_g;
+        h = next_h;
+        if (converged) {
+            return h;
+        }
+    }
+    compile_error("Riccati equation did not converge within max_iterations");
+    return h;
+}
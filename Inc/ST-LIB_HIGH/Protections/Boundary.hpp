@@ -1,30 +1,16 @@
 #pragma once
 #define PROTECTIONTYPE_LENGTH 8
 #include "C++Utilities/CppUtils.hpp"
-#include "Control/Blocks/MeanCalculator.hpp"
 #include "ErrorHandler/ErrorHandler.hpp"
 #include "HALAL/Models/Packets/Order.hpp"
 #include "HALAL/Services/InfoWarning/InfoWarning.hpp"
 #include "HALAL/Services/Time/RTC.hpp"
+#include "ProtectionTypes.hpp"
+#include "SlidingWindow.hpp"
 
 using type_id_t = void (*)();
 template <typename> void type_id() {}
 
-namespace Protections {
-enum FaultType : uint8_t { FAULT = 0, WARNING, OK };
-}
-
-enum ProtectionType : uint8_t {
-    BELOW = 0,
-    ABOVE,
-    OUT_OF_RANGE,
-    EQUALS,
-    NOT_EQUALS,
-    ERROR_HANDLER,
-    TIME_ACCUMULATION,
-    INFO_WARNING
-};
-
 struct BoundaryInterface {
 public:
     virtual Protections::FaultType check_bounds() = 0;
@@ -43,7 +29,10 @@ public:
     virtual void update_warning_message([[maybe_unused]] const char* warn_message) {}
     static const char* get_error_handler_string() { return ErrorHandlerModel::description.c_str(); }
     static const char* get_warning_string() { return InfoWarning::description.c_str(); }
+    // value sent in the protection reports, the one that was last checked
+    virtual float reported_value() const { return 0.0f; }
     uint8_t boundary_type_id{};
+    uint16_t report_id{0xFFFF};
     // used to send messages only on raising/failing edges
     bool warning_already_triggered{false};
     bool warning_is_up{false};
@@ -54,15 +43,21 @@ protected:
     static int get_error_handler_string_size() { return ErrorHandlerModel::description.size(); }
     static int get_warning_string_size() { return InfoWarning::description.size(); }
 
-    // this will store the name of the variable
-    string name;
     // max variable name
     static constexpr uint8_t NAME_MAX_LEN = 40;
+    // this will store the name of the variable, inline so the messages can point to it
+    InlineString<NAME_MAX_LEN> name;
     uint8_t format_id{255};
     uint8_t string_len{0};
 };
 
-template <class Type, ProtectionType Protector> struct Boundary;
+/* Window only applies to TIME_ACCUMULATION, every other boundary leaves it void */
+template <class Type, ProtectionType Protector, class Window = void> struct Boundary;
+
+/* A boundary that can be bound to a Type* source, what a Protection is made of */
+template <class Bound, class Type>
+concept BoundaryOf =
+    std::derived_from<Bound, BoundaryInterface> && std::constructible_from<Bound, Type*, Bound>;
 
 template <class Type> struct Boundary<Type, BELOW> : public BoundaryInterface {
     static constexpr ProtectionType Protector = BELOW;
@@ -86,9 +81,6 @@ template <class Type> struct Boundary<Type, BELOW> : public BoundaryInterface {
         // (ProtectionType::BELOW)
         boundary_type_id = Protector;
         format_id = BoundaryInterface::format_look_up.at(type_id<Type>);
-        // we have to preallocate space, otherwise the might get moved around,
-        // invalidating the pointer, better safe than sorry
-        name.reserve(NAME_MAX_LEN);
         if (this->has_warning_level) {
             warning_threshold = boundary.warning_threshold;
             warn_message = new HeapOrder(
@@ -157,6 +149,7 @@ template <class Type> struct Boundary<Type, BELOW> : public BoundaryInterface {
     }
 
     Boundary(Type* src, Type boundary) : src(src), boundary(boundary) {}
+    float reported_value() const override { return static_cast<float>(frozen_value); }
     Protections::FaultType check_bounds() override {
         frozen_value = *src;
         if (*src < boundary) {
@@ -190,9 +183,6 @@ template <class Type> struct Boundary<Type, ABOVE> : public BoundaryInterface {
         // (ProtectionType::BELOW)
         boundary_type_id = Protector;
         format_id = BoundaryInterface::format_look_up.at(type_id<Type>);
-        // we have to preallocate space, otherwise the might get moved around,
-        // invalidating the pointer, better safe than sorry
-        name.reserve(NAME_MAX_LEN);
         if (this->has_warning_level) {
             warning_threshold = boundary.warning_threshold;
             warn_message = new HeapOrder(
@@ -261,6 +251,7 @@ template <class Type> struct Boundary<Type, ABOVE> : public BoundaryInterface {
         );
     }
     Boundary(Type* src, Type boundary) : src(src), boundary(boundary) {}
+    float reported_value() const override { return static_cast<float>(frozen_value); }
     Protections::FaultType check_bounds() override {
         frozen_value = *src;
         if (*src > boundary)
@@ -283,7 +274,6 @@ template <class Type> struct Boundary<Type, EQUALS> : public BoundaryInterface {
         : src(src), boundary(boundary.boundary) {
         boundary_type_id = Protector;
         format_id = BoundaryInterface::format_look_up.at(type_id<Type>);
-        name.reserve(NAME_MAX_LEN);
         fault_message = new HeapOrder(
             uint16_t{1333},
             &format_id,
@@ -316,7 +306,9 @@ template <class Type> struct Boundary<Type, EQUALS> : public BoundaryInterface {
         );
     }
     Boundary(Type* src, Type boundary) : src(src), boundary(boundary) {}
+    float reported_value() const override { return static_cast<float>(frozen_value); }
     Protections::FaultType check_bounds() override {
+        frozen_value = *src;
         if (*src == boundary)
             return Protections::FAULT;
         return Protections::OK;
@@ -334,7 +326,6 @@ template <class Type> struct Boundary<Type, NOT_EQUALS> : public BoundaryInterfa
         : src(src), boundary(boundary.boundary) {
         boundary_type_id = Protector;
         format_id = BoundaryInterface::format_look_up.at(type_id<Type>);
-        name.reserve(NAME_MAX_LEN);
         fault_message = new HeapOrder(
             uint16_t{1444},
             &format_id,
@@ -367,6 +358,7 @@ template <class Type> struct Boundary<Type, NOT_EQUALS> : public BoundaryInterfa
         );
     }
     Boundary(Type* src, Type boundary) : src(src), boundary(boundary) {}
+    float reported_value() const override { return static_cast<float>(frozen_value); }
     Protections::FaultType check_bounds() override {
         frozen_value = *src;
         if (*src != boundary)
@@ -401,7 +393,6 @@ template <class Type> struct Boundary<Type, OUT_OF_RANGE> : public BoundaryInter
           upper_boundary(boundary.upper_boundary) {
         boundary_type_id = Protector;
         format_id = BoundaryInterface::format_look_up.at(type_id<Type>);
-        name.reserve(NAME_MAX_LEN);
         if (boundary.has_warning_level) {
             lower_warning = boundary.lower_warning;
             upper_warning = boundary.upper_warning;
@@ -476,6 +467,7 @@ template <class Type> struct Boundary<Type, OUT_OF_RANGE> : public BoundaryInter
     }
     Boundary(Type* src, Type lower_boundary, Type upper_boundary)
         : src(src), lower_boundary(lower_boundary), upper_boundary(upper_boundary) {}
+    float reported_value() const override { return static_cast<float>(frozen_value); }
     Protections::FaultType check_bounds() override {
         frozen_value = *src;
         if (*src < lower_boundary || *src > upper_boundary)
@@ -610,19 +602,27 @@ private:
     static constexpr uint16_t WARNING_HANDLER_MSG_MAX_LEN = 255;
 };
 
-template <typename Type>
+/**
+ * Faults when the mean of |value| over the last time_limit seconds goes over bound, with
+ * check_accumulation called at frequency. Window is the sliding window engine from
+ * SlidingWindow.hpp, BucketWindow<Type> when void, so memory and time per check don't grow with
+ * the window length
+ */
+template <typename Type, class Window>
     requires(std::is_floating_point_v<Type>)
-struct Boundary<Type, TIME_ACCUMULATION> : public BoundaryInterface {
+struct Boundary<Type, TIME_ACCUMULATION, Window> : public BoundaryInterface {
     static constexpr ProtectionType Protector = TIME_ACCUMULATION;
+    using Engine =
+        std::conditional_t<std::is_void_v<Window>, Protections::BucketWindow<Type>, Window>;
     Boundary(
         Type bound,
         float time_limit,
         float frequency,
-        Boundary<Type, Protector>*& external_pointer
+        Boundary*& external_pointer
     )
         : real_still_good(new Protections::FaultType{Protections::OK}), bound(bound),
-          time_limit(time_limit), frequency(frequency), moving_order(frequency * time_limit / 100),
-          external_pointer(&external_pointer) {
+          time_limit(time_limit), frequency(frequency), external_pointer(&external_pointer),
+          window(window_samples(time_limit, frequency)) {
         external_pointer = this;
     };
     Boundary(
@@ -630,23 +630,23 @@ struct Boundary<Type, TIME_ACCUMULATION> : public BoundaryInterface {
         Type bound,
         float time_limit,
         float frequency,
-        Boundary<Type, Protector>*& external_pointer
+        Boundary*& external_pointer
     )
         : real_still_good(new Protections::FaultType{Protections::OK}), bound(bound),
-          time_limit(time_limit), frequency(frequency), moving_order(frequency * time_limit / 100),
-          external_pointer(&external_pointer) {
+          time_limit(time_limit), frequency(frequency), external_pointer(&external_pointer),
+          window(window_samples(time_limit, frequency)) {
         external_pointer = this;
         has_warning_level = true;
         this->warning_threshold = warning_threshold;
     };
-    Boundary(Type* src, Boundary<Type, Protector> boundary)
+    Boundary(Type* src, Boundary boundary)
         : real_still_good(boundary.real_still_good), src(src), bound(boundary.bound),
           time_limit(boundary.time_limit), frequency(boundary.frequency),
-          moving_order(frequency * time_limit / 100), external_pointer(boundary.external_pointer) {
+          external_pointer(boundary.external_pointer),
+          window(window_samples(time_limit, frequency)) {
         *external_pointer = this;
         boundary_type_id = Protector;
         format_id = BoundaryInterface::format_look_up.at(type_id<Type>);
-        name.reserve(NAME_MAX_LEN);
         if (boundary.has_warning_level) {
             warning_threshold = boundary.warning_threshold;
             warn_message = new HeapOrder(
@@ -706,61 +706,49 @@ struct Boundary<Type, TIME_ACCUMULATION> : public BoundaryInterface {
     }
     Boundary(Type* src, Type bound, float time_limit, float frequency)
         : real_still_good(new Protections::FaultType{Protections::OK}), src(src), bound(bound),
-          time_limit(time_limit), frequency(frequency), moving_order(frequency * time_limit / 100),
-          external_pointer(nullptr) {}
+          time_limit(time_limit), frequency(frequency), external_pointer(nullptr),
+          window(window_samples(time_limit, frequency)) {}
     bool has_warning_level{false};
     Type warning_threshold;
     uint8_t format_id{};
+    Protections::FaultType* real_still_good = nullptr;
     Type* src = nullptr;
     Type bound;
     float time_limit;
     float frequency;
-    Protections::FaultType* real_still_good = nullptr;
     Protections::FaultType still_good = Protections::OK;
-    Boundary<Type, Protector>** external_pointer;
+    Boundary** external_pointer;
 
-    MeanCalculator<100> mean_calculator;
-    vector<Type> mean_moving_average;
-    uint16_t moving_order = 0;
-    uint16_t moving_last = -1;
-    uint16_t moving_first = 0;
-    uint16_t moving_counter = 0;
+    Engine window;
+    // mean over the window, and its value when the boundary last warned or faulted
     Type accumulator{};
+    Type frozen_value{};
 
     Protections::FaultType check_accumulation(Type value) {
         if (still_good == Protections::FAULT)
             return Protections::FAULT;
-        mean_calculator.input(abs(value));
-        mean_calculator.execute();
-        if (mean_calculator.output_value == 0) {
-            return Protections::OK;
-        }
-        mean_calculator.reset();
-        if (moving_counter < moving_order) {
-            moving_last++;
-            mean_moving_average[moving_last] = mean_calculator.output_value;
-            accumulator += mean_calculator.output_value / moving_order;
-            moving_counter++;
-            return Protections::OK;
-        }
-        accumulator -= mean_moving_average[moving_first] / moving_order;
-        moving_first = (moving_first + 1) % moving_order;
-        moving_last = (moving_last + 1) % moving_counter;
-        mean_moving_average[moving_last] = mean_calculator.output_value;
-        accumulator += mean_moving_average[moving_last] / moving_order;
+        accumulator = window.input(std::abs(value));
         // we check by decreasing order.
         if (accumulator > bound) {
+            frozen_value = accumulator;
             *real_still_good = Protections::FAULT;
             still_good = Protections::FAULT;
             return Protections::FAULT;
         } else if (has_warning_level && accumulator > warning_threshold) {
+            frozen_value = accumulator;
             return Protections::WARNING;
         }
         return Protections::OK;
     }
 
+    float reported_value() const override { return static_cast<float>(accumulator); }
     Protections::FaultType check_bounds() override {
         still_good = *real_still_good;
         return still_good;
     }
+
+private:
+    static size_t window_samples(float time_limit, float frequency) {
+        return static_cast<size_t>(std::lround(time_limit * frequency));
+    }
 };
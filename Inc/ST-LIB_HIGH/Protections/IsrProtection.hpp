@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "C++Utilities/IntrusiveList.hpp"
+#include "ProtectionTypes.hpp"
+#include "hal_wrapper.h"
+
+namespace Protections {
+
+class IsrProtectionBase;
+
+/**
+ * @brief Fault flag shared by every IsrProtection. Tripping it from an interrupt is a few plain
+ * stores, no locks and no read-modify-write: the main output of every break timer is disabled
+ * first, then the fault is latched. The main loop picks the fault up with take_pending() and does
+ * the slow part (state machine, notifications) there.
+ *
+ * The latch stays set until clear() is called, so anything that drives the power stage can check
+ * is_latched() before turning it back on.
+ */
+class FaultLatch {
+public:
+    static constexpr size_t MAX_BREAK_OUTPUTS = 4;
+
+    /* Timers whose outputs are cut off as soon as a protection trips, false if there is no room */
+    static bool add_break_output(TIM_TypeDef* timer) {
+        if (break_output_count == MAX_BREAK_OUTPUTS) {
+            return false;
+        }
+        break_outputs[break_output_count++] = timer;
+        return true;
+    }
+
+    static void trip() {
+        /* A software break clears MOE in hardware, one store instead of a read-modify-write of
+         * BDTR that an interrupt of the timer owner could interleave with */
+        for (size_t i = 0; i < break_output_count; i++) {
+            break_outputs[i]->EGR = TIM_EGR_BG;
+        }
+        latched.store(true, std::memory_order_release);
+        pending.store(true, std::memory_order_release);
+    }
+
+    static bool is_latched() { return latched.load(std::memory_order_acquire); }
+
+    /* Main loop only, true once for every batch of trips since the last call */
+    static bool take_pending() {
+        if (!pending.load(std::memory_order_acquire)) {
+            return false;
+        }
+        /* A trip landing after this store is seen on the next call */
+        pending.store(false, std::memory_order_relaxed);
+        return true;
+    }
+
+    /* Calls report once for each protection that tripped since it was last cleared */
+    template <typename Callback> static void for_each_unreported(Callback&& report);
+
+    /* Re-arms the latch and every protection, the break outputs are left for their owner to
+     * turn back on */
+    static void clear();
+
+    static IntrusiveList<IsrProtectionBase>& protections() { return registry; }
+
+private:
+    static inline std::atomic<bool> latched{false};
+    static inline std::atomic<bool> pending{false};
+    static inline std::array<TIM_TypeDef*, MAX_BREAK_OUTPUTS> break_outputs{};
+    static inline size_t break_output_count = 0;
+    static inline IntrusiveList<IsrProtectionBase> registry;
+};
+
+/* The part of an IsrProtection the main loop needs, independent of the checked type */
+class IsrProtectionBase : public IntrusiveListNode<IsrProtectionBase> {
+    friend class FaultLatch;
+
+public:
+    /* Enough for describe() with a short name, longer descriptions are truncated */
+    static constexpr size_t DESCRIPTION_SIZE = 96;
+
+    const char* const name;
+
+    explicit IsrProtectionBase(const char* name) : name(name) {
+        FaultLatch::protections().push_back(*this);
+    }
+    IsrProtectionBase(const IsrProtectionBase&) = delete;
+    IsrProtectionBase& operator=(const IsrProtectionBase&) = delete;
+    virtual ~IsrProtectionBase() { FaultLatch::protections().remove(*this); }
+
+    bool is_tripped() const { return tripped.load(std::memory_order_acquire); }
+
+    /* Name, bound and the value that tripped it, for the fault notification. Written into text
+     * and truncated to fit, nothing is allocated */
+    virtual std::string_view describe(std::span<char> text) const = 0;
+
+protected:
+    std::atomic<bool> tripped{false};
+
+private:
+    bool reported = false;
+};
+
+template <typename Callback> void FaultLatch::for_each_unreported(Callback&& report) {
+    for (IsrProtectionBase& protection : registry) {
+        if (!protection.reported && protection.is_tripped()) {
+            protection.reported = true;
+            report(protection);
+        }
+    }
+}
+
+inline void FaultLatch::clear() {
+    for (IsrProtectionBase& protection : registry) {
+        protection.reported = false;
+        protection.tripped.store(false, std::memory_order_release);
+    }
+    pending.store(false, std::memory_order_relaxed);
+    latched.store(false, std::memory_order_release);
+}
+
+/* Same bound semantics as Boundary: BELOW faults under the bound, ABOVE over it, and so on */
+template <class Type, ProtectionType Protector>
+    requires std::is_arithmetic_v<Type>
+class IsrProtection final : public IsrProtectionBase {
+    static_assert(
+        Protector == BELOW || Protector == ABOVE || Protector == EQUALS ||
+            Protector == NOT_EQUALS || Protector == OUT_OF_RANGE,
+        "IsrProtection only supports BELOW, ABOVE, EQUALS, NOT_EQUALS and OUT_OF_RANGE"
+    );
+
+public:
+    IsrProtection(const char* name, Type bound)
+        requires(Protector != OUT_OF_RANGE)
+        : IsrProtectionBase(name), lower(bound), upper(bound) {}
+
+    IsrProtection(const char* name, Type lower, Type upper)
+        requires(Protector == OUT_OF_RANGE)
+        : IsrProtectionBase(name), lower(lower), upper(upper) {}
+
+    /**
+     * @brief Call from the interrupt that produced value, e.g. the ADC DMA completion. In bounds
+     * it is one or two compares, out of bounds it freezes the first offending value and trips the
+     * FaultLatch.
+     */
+    FaultType check(Type value) {
+        if (!violates(value)) [[likely]] {
+            return OK;
+        }
+        trip(value);
+        return FAULT;
+    }
+
+    Type frozen_value() const { return frozen; }
+
+    std::string_view describe(std::span<char> text) const override {
+        if (text.empty()) {
+            return {};
+        }
+        int length;
+        if constexpr (Protector == OUT_OF_RANGE) {
+            length = std::snprintf(
+                text.data(),
+                text.size(),
+                "%s out of range [%g, %g]: %g",
+                name,
+                static_cast<double>(lower),
+                static_cast<double>(upper),
+                static_cast<double>(frozen)
+            );
+        } else {
+            const char* relation = Protector == BELOW    ? "below"
+                                   : Protector == ABOVE  ? "above"
+                                   : Protector == EQUALS ? "equal to"
+                                                         : "not equal to";
+            length = std::snprintf(
+                text.data(),
+                text.size(),
+                "%s %s %g: %g",
+                name,
+                relation,
+                static_cast<double>(lower),
+                static_cast<double>(frozen)
+            );
+        }
+        if (length < 0) {
+            return {};
+        }
+        return {text.data(), std::min(static_cast<size_t>(length), text.size() - 1)};
+    }
+
+private:
+    Type lower;
+    Type upper;
+    Type frozen{};
+
+    bool violates(Type value) const {
+        if constexpr (Protector == BELOW) {
+            return value < lower;
+        } else if constexpr (Protector == ABOVE) {
+            return value > upper;
+        } else if constexpr (Protector == EQUALS) {
+            return value == lower;
+        } else if constexpr (Protector == NOT_EQUALS) {
+            return value != lower;
+        } else {
+            return value < lower || value > upper;
+        }
+    }
+
+    [[gnu::noinline]] void trip(Type value) {
+        /* Only the first value is kept, the main loop reads it once it sees tripped */
+        if (!tripped.load(std::memory_order_relaxed)) {
+            frozen = value;
+            tripped.store(true, std::memory_order_release);
+        }
+        FaultLatch::trip();
+    }
+};
+
+} // namespace Protections
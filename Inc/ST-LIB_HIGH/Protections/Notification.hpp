@@ -58,12 +58,16 @@ public:
         return buffer;
     }
 
-    void notify(string message) {
-        tx_message = message;
+    /* Copied into the message kept from the last notify, which only allocates if it is longer */
+    void notify(std::string_view message) {
+        tx_message.assign(message);
         tx_message_size = message.size();
         notify();
     }
 
+    /* Makes room for messages up to length, so notifying them later doesn't allocate */
+    void reserve(size_t length) { tx_message.reserve(length); }
+
     void notify() {
         if (tx_message.empty()) {
             ErrorHandler("Cannot notify empty notification");
@@ -19,16 +19,9 @@ public:
     void update_last_notify_tick(uint64_t new_tick) { last_notify_tick = new_tick; }
     vector<shared_ptr<BoundaryInterface>> warnings_triggered;
     vector<shared_ptr<BoundaryInterface>> oks_triggered;
-    template <
-        class Type,
-        ProtectionType... Protector,
-        template <class, ProtectionType>
-        class Boundaries>
-    Protection(Type* src, Boundaries<Type, Protector>... protectors) {
-        (boundaries.push_back(
-             shared_ptr<BoundaryInterface>(new Boundary<Type, Protector>(src, protectors))
-         ),
-         ...);
+    template <class Type, BoundaryOf<Type>... Boundaries>
+    Protection(Type* src, Boundaries... protectors) {
+        (boundaries.push_back(shared_ptr<BoundaryInterface>(new Boundaries(src, protectors))), ...);
     }
 
     void set_name(char* name) { this->name = name; }
@@ -0,0 +1,296 @@
+/*
+ * ProtectionDomain.hpp
+ *
+ * Protections declared with the board instead of added at runtime with add_protection. Each one
+ * is a constexpr device in flash, checked against the rest of the board when it is built, and
+ * its state lives in a static array, there are no Boundary, HeapOrder or shared_ptr objects
+ * behind it:
+ *
+ *   using ST_LIB::ProtectionDomain;
+ *   float current, voltage;
+ *   constexpr auto overcurrent = ProtectionDomain::above("current", &current, 150, 120);
+ *   constexpr auto bus = ProtectionDomain::out_of_range("bus", &voltage, 300, 450);
+ *   using MyBoard = ST_LIB::Board<..., overcurrent, bus>;
+ *
+ * The board check runs every protection and returns the worst state. Init registers the
+ * instances in board, where ProtectionManager::check_protections() runs them with the rest, and
+ * ProtectionManager::initialize() interns their names when reports are enabled.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "ProtectionTypes.hpp"
+
+#ifndef PROTECTION_DOMAIN_MAX_INSTANCES
+#define PROTECTION_DOMAIN_MAX_INSTANCES 64
+#endif
+
+namespace ST_LIB {
+extern void compile_error(const char* msg);
+
+struct ProtectionDomain {
+    using FaultType = Protections::FaultType;
+    using ReadFn = double (*)(const void* src);
+
+    struct Entry {
+        const char* name;
+        const void* src;
+        ReadFn read;
+        ProtectionType type;
+        /* BELOW and EQUALS use lower, ABOVE uses upper, OUT_OF_RANGE both */
+        double lower;
+        double upper;
+        bool has_warning;
+        double warning_lower;
+        double warning_upper;
+    };
+
+    using Config = Entry;
+
+    struct Instance {
+        Config cfg;
+        FaultType state = Protections::OK;
+        /* Value read by the last check */
+        double value = 0.0;
+        /* Id given by the ReportAggregator the names were interned in */
+        uint16_t report_id = UINT16_MAX;
+
+        FaultType check() {
+            value = cfg.read(cfg.src);
+            state = evaluate(cfg, value);
+            return state;
+        }
+    };
+
+    static constexpr size_t max_instances = PROTECTION_DOMAIN_MAX_INSTANCES;
+    /* Longest name the report name table carries */
+    static constexpr size_t max_name_length = 40;
+
+    static constexpr FaultType evaluate(const Config& cfg, double value) {
+        bool fault = false;
+        bool warning = false;
+        switch (cfg.type) {
+        case BELOW:
+            fault = value < cfg.lower;
+            warning = value < cfg.warning_lower;
+            break;
+        case ABOVE:
+            fault = value > cfg.upper;
+            warning = value > cfg.warning_upper;
+            break;
+        case OUT_OF_RANGE:
+            fault = value < cfg.lower || value > cfg.upper;
+            warning = value < cfg.warning_lower || value > cfg.warning_upper;
+            break;
+        case EQUALS:
+            fault = value == cfg.lower;
+            break;
+        case NOT_EQUALS:
+            fault = value != cfg.lower;
+            break;
+        default:
+            break;
+        }
+        if (fault) {
+            return Protections::FAULT;
+        }
+        return cfg.has_warning && warning ? Protections::WARNING : Protections::OK;
+    }
+
+    static constexpr bool warns_first(const Entry& e) {
+        switch (e.type) {
+        case BELOW:
+            return e.warning_lower > e.lower;
+        case ABOVE:
+            return e.warning_upper < e.upper;
+        case OUT_OF_RANGE:
+            return e.warning_lower > e.lower && e.warning_upper < e.upper &&
+                   e.warning_lower <= e.warning_upper;
+        default:
+            return false;
+        }
+    }
+
+    template <std::size_t N>
+    static consteval std::array<Config, N> build(std::span<const Entry> entries) {
+        std::array<Config, N> cfgs{};
+        for (std::size_t i = 0; i < N; i++) {
+            const Entry& e = entries[i];
+            std::string_view name = e.name != nullptr ? e.name : "";
+            if (name.empty() || name.size() > max_name_length) {
+                compile_error("Protection names must have between 1 and 40 characters");
+            }
+            if (e.lower > e.upper) {
+                compile_error("Protection range lower limit is above the upper limit");
+            }
+            if (e.has_warning && !warns_first(e)) {
+                compile_error("Protection warning must trip before the fault");
+            }
+            for (std::size_t j = 0; j < i; j++) {
+                if (std::string_view(entries[j].name) == name) {
+                    compile_error("Two protections share the same name");
+                }
+                if (entries[j].src == e.src && entries[j].type == e.type) {
+                    compile_error("Variable already has a protection of this type");
+                }
+            }
+            cfgs[i] = e;
+        }
+        return cfgs;
+    }
+
+    /* The instances of the board, registered by Init::init for ProtectionManager */
+    static inline std::span<Instance> board{};
+
+    /* on_change(index, instance) is called for each protection whose state changed */
+    template <class OnChange>
+    static FaultType check(std::span<Instance> instances, OnChange&& on_change) {
+        FaultType worst = Protections::OK;
+        for (std::size_t i = 0; i < instances.size(); i++) {
+            FaultType previous = instances[i].state;
+            FaultType state = instances[i].check();
+            if (state != previous) {
+                on_change(i, instances[i]);
+            }
+            worst = state < worst ? state : worst;
+        }
+        return worst;
+    }
+
+    /* Interns the names in domain order and keeps the id of each one as its report_id */
+    template <class Aggregator>
+    static void intern(std::span<Instance> instances, Aggregator& aggregator) {
+        for (Instance& instance : instances) {
+            instance.report_id = aggregator.intern(instance.cfg.name);
+        }
+    }
+
+    template <std::size_t N> struct Init {
+        static inline std::array<Instance, N> instances{};
+
+        static void init(const std::array<Config, N>& cfgs) {
+            for (std::size_t i = 0; i < N; i++) {
+                instances[i] = Instance{.cfg = cfgs[i]};
+            }
+            board = instances;
+        }
+
+        /* Checks every protection, the worst state of them all */
+        static FaultType check() {
+            return check([](std::size_t, const Instance&) {});
+        }
+
+        template <class OnChange> static FaultType check(OnChange&& on_change) {
+            return ProtectionDomain::check(instances, std::forward<OnChange>(on_change));
+        }
+
+        template <class Aggregator> static void intern(Aggregator& aggregator) {
+            ProtectionDomain::intern(instances, aggregator);
+        }
+    };
+
+    /**
+     * @brief A protection of the board on the variable at src. Declare it constexpr, src must be
+     * a variable with static storage.
+     */
+    template <class Type> struct Protection {
+        static_assert(std::is_arithmetic_v<Type>, "Board protections watch arithmetic values");
+
+        using domain = ProtectionDomain;
+
+        Entry entry;
+
+        template <class Ctx> consteval void inscribe(Ctx& ctx) const {
+            ctx.template add<ProtectionDomain>(entry, this);
+        }
+
+        static double read(const void* src) {
+            return static_cast<double>(*static_cast<const volatile Type*>(src));
+        }
+    };
+
+    /* Limits take the type of the variable, above("current", &current, 150, 120) is fine */
+    template <class Type> using Limit = std::type_identity_t<Type>;
+
+    template <class Type>
+    static consteval Protection<Type> make(
+        const char* name,
+        Type* src,
+        ProtectionType type,
+        double lower,
+        double upper,
+        bool has_warning = false,
+        double warning_lower = 0.0,
+        double warning_upper = 0.0
+    ) {
+        return {{
+            name,
+            src,
+            &Protection<Type>::read,
+            type,
+            lower,
+            upper,
+            has_warning,
+            warning_lower,
+            warning_upper,
+        }};
+    }
+
+    /* Faults when the value goes under limit, warns under warning if given */
+    template <class Type>
+    static consteval Protection<Type> below(const char* name, Type* src, Limit<Type> limit) {
+        return make(name, src, BELOW, limit, limit);
+    }
+    template <class Type>
+    static consteval Protection<Type>
+    below(const char* name, Type* src, Limit<Type> limit, Limit<Type> warning) {
+        return make(name, src, BELOW, limit, limit, true, warning, warning);
+    }
+
+    /* Faults when the value goes over limit, warns over warning if given */
+    template <class Type>
+    static consteval Protection<Type> above(const char* name, Type* src, Limit<Type> limit) {
+        return make(name, src, ABOVE, limit, limit);
+    }
+    template <class Type>
+    static consteval Protection<Type>
+    above(const char* name, Type* src, Limit<Type> limit, Limit<Type> warning) {
+        return make(name, src, ABOVE, limit, limit, true, warning, warning);
+    }
+
+    template <class Type>
+    static consteval Protection<Type>
+    out_of_range(const char* name, Type* src, Limit<Type> lower, Limit<Type> upper) {
+        return make(name, src, OUT_OF_RANGE, lower, upper);
+    }
+    template <class Type>
+    static consteval Protection<Type> out_of_range(
+        const char* name,
+        Type* src,
+        Limit<Type> lower,
+        Limit<Type> upper,
+        Limit<Type> warning_lower,
+        Limit<Type> warning_upper
+    ) {
+        return make(name, src, OUT_OF_RANGE, lower, upper, true, warning_lower, warning_upper);
+    }
+
+    template <class Type>
+    static consteval Protection<Type> equals(const char* name, Type* src, Limit<Type> value) {
+        return make(name, src, EQUALS, value, value);
+    }
+
+    template <class Type>
+    static consteval Protection<Type> not_equals(const char* name, Type* src, Limit<Type> value) {
+        return make(name, src, NOT_EQUALS, value, value);
+    }
+};
+
+} // namespace ST_LIB
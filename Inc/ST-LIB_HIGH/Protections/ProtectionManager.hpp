@@ -1,12 +1,16 @@
 #pragma once
 
 #include <cstdio>
+#include <optional>
 
 #include "C++Utilities/CppUtils.hpp"
 #include "HALAL/Models/BoardID/BoardID.hpp"
 #include "HALAL/Models/Packets/Order.hpp"
+#include "IsrProtection.hpp"
 #include "Notification.hpp"
 #include "Protection.hpp"
+#include "ProtectionReport.hpp"
+#include "ReportAggregator.hpp"
 #include "StateMachine/StateMachine.hpp"
 
 #define getname(var) #var
@@ -46,33 +50,40 @@ public:
 
     static void link_state_machine(IStateMachine& general_state_machine, state_id fault_id);
 
-    template <
-        class Type,
-        ProtectionType... Protector,
-        template <class, ProtectionType>
-        class Boundaries>
-    static Protection& _add_protection(Type* src, Boundaries<Type, Protector>... protectors) {
+    using ReportAggregator = Protections::ReportAggregator<OrderProtocol>;
+    /**
+     * @brief send the protection events of each check as one coalesced binary report per socket,
+     * within a rate budget, instead of one order per boundary and event. Call before initialize()
+     */
+    static void enable_reports(const ReportAggregator::Config& config);
+
+    template <class Type, BoundaryOf<Type>... Boundaries>
+    static Protection& _add_protection(Type* src, Boundaries... protectors) {
         low_frequency_protections.push_back(Protection(src, protectors...));
         return low_frequency_protections.back();
     }
 
-    template <
-        class Type,
-        ProtectionType... Protector,
-        template <class, ProtectionType>
-        class Boundaries>
-    static Protection&
-    _add_high_frequency_protection(Type* src, Boundaries<Type, Protector>... protectors) {
+    template <class Type, BoundaryOf<Type>... Boundaries>
+    static Protection& _add_high_frequency_protection(Type* src, Boundaries... protectors) {
         high_frequency_protections.push_back(Protection(src, protectors...));
         return high_frequency_protections.back();
     }
     /**
-     * @brief call on startup to initialize the names of the protections
+     * @brief call on startup, after the board init, to initialize the names of the protections
      */
     static void initialize();
     static void add_standard_protections();
+    /**
+     * @brief call from the main loop, also runs the protections declared with the board: a FAULT
+     * among them goes to fault and their changes are recorded in the reports, if enabled
+     */
     static void check_protections();
     static void check_high_frequency_protections();
+    /**
+     * @brief call from the main loop, goes to fault and notifies the IsrProtections that tripped
+     * since the last call
+     */
+    static void check_isr_protections();
     static void warn(string message);
     static void fault_and_propagate();
     static void propagate_fault();
@@ -96,7 +107,13 @@ private:
     static Notification warning_notification;
     static StackOrder<0> fault_order;
 
+    static std::optional<ReportAggregator> reports;
+
     static void tcp_to_fault();
+    static bool carries_text(Protection& protection);
+    static void record(Protection& protection);
+    static void check_board_protections();
+    static void flush_reports();
     static void to_fault();
     static void external_to_fault();
 };
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <span>
+
+#include "ErrorHandler/ErrorHandler.hpp"
+#include "HALAL/Models/Packets/Order.hpp"
+
+/**
+ * @brief Order view of a packet written by Protections::ReportAggregator, so it can go through
+ * OrderProtocol::send_order. It is only sent, never registered for parsing.
+ */
+class ProtectionReport : public Order {
+public:
+    explicit ProtectionReport(std::span<const uint8_t> packet) : packet(packet) {
+        size = packet.size();
+    }
+
+    void set_callback([[maybe_unused]] void (*callback)()) override {}
+    void process() override {}
+    void parse([[maybe_unused]] OrderProtocol* socket, [[maybe_unused]] uint8_t* data) override {}
+    uint8_t* build() override { return const_cast<uint8_t*>(packet.data()); }
+    size_t get_size() override { return packet.size(); }
+    uint16_t get_id() override { return Packet::get_id(build()); }
+    void set_pointer([[maybe_unused]] size_t index, [[maybe_unused]] void* pointer) override {
+        ErrorHandler("ProtectionReport does not suport this method!");
+    }
+
+private:
+    std::span<const uint8_t> packet;
+};
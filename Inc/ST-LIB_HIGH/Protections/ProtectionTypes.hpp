@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Protections {
+enum FaultType : uint8_t { FAULT = 0, WARNING, OK };
+}
+
+enum ProtectionType : uint8_t {
+    BELOW = 0,
+    ABOVE,
+    OUT_OF_RANGE,
+    EQUALS,
+    NOT_EQUALS,
+    ERROR_HANDLER,
+    TIME_ACCUMULATION,
+    INFO_WARNING
+};
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "ProtectionTypes.hpp"
+
+namespace Protections {
+
+/**
+ * @brief Turns the protection events of every check cycle into compact binary reports. Each
+ * boundary is interned once at startup and reported by its id, the names go out once per socket
+ * in name table packets.
+ *
+ * Events only mark a boundary as dirty for every socket. A repeat of the state last recorded is
+ * counted instead, unless the state is not OK and refresh_ns went by since it was last marked.
+ * flush() sends a socket one packet with what is dirty for it, faults first, as long as the
+ * socket has budget left: reports_per_second on average, burst in a row. A socket that is out of
+ * budget keeps accumulating, and its next report carries the latest state of every boundary.
+ * Nothing is allocated, every table is sized by the template arguments.
+ *
+ * MaxSinks must cover every socket that can be open at once. A socket only takes the place of one
+ * that hasn't been flushed for sink_timeout_ns, the others keep their budget and name progress;
+ * a socket that finds no place isn't reported to and is counted in overflows().
+ *
+ * Report, little endian and without padding:
+ *     uint16 report_id, uint16 sequence, uint64 timestamp, uint8 count, uint8 flags,
+ *     count x { uint16 boundary id, uint8 ProtectionType, uint8 FaultType, uint16 repeats,
+ *               float value }
+ * Name table:
+ *     uint16 names_id, uint16 first boundary id, uint8 count, count x { uint8 length, chars }
+ */
+template <typename Sink, size_t MaxBoundaries = 64, size_t MaxSinks = 4, size_t MaxEntries = 32>
+class ReportAggregator {
+public:
+    static constexpr uint16_t NO_ID = 0xFFFF;
+    static constexpr size_t HEADER_SIZE = 14;
+    static constexpr size_t ENTRY_SIZE = 10;
+    static constexpr size_t NAMES_HEADER_SIZE = 5;
+    static constexpr size_t MAX_NAME_LENGTH = 40;
+    static constexpr size_t MAX_PACKET_SIZE = HEADER_SIZE + MaxEntries * ENTRY_SIZE;
+    /* Set in flags when some dirty boundaries didn't fit and wait for the next report */
+    static constexpr uint8_t MORE_PENDING = 1;
+
+    static_assert(MaxBoundaries < NO_ID, "Boundary ids must fit in 16 bits");
+    static_assert(MaxEntries > 0 && MaxEntries <= 255, "The entry count is a single byte");
+    static_assert(
+        MAX_PACKET_SIZE >= NAMES_HEADER_SIZE + 1 + MAX_NAME_LENGTH,
+        "A report must be able to carry at least one name"
+    );
+
+    struct Config {
+        uint16_t report_id = 4000;
+        uint16_t names_id = 4001;
+        uint32_t reports_per_second = 10;
+        uint32_t burst = 3;
+        /* Period at which a boundary that stays in fault or warning is reported again */
+        uint64_t refresh_ns = 2'000'000'000;
+        /* A socket not flushed for this long is taken as closed, a new one can have its place */
+        uint64_t sink_timeout_ns = 5'000'000'000;
+    };
+
+    explicit ReportAggregator(const Config& config) : config(config) {}
+
+    /* One id per boundary, even if several share a name. NO_ID once the table is full */
+    uint16_t intern(const char* name) {
+        if (boundary_count == MaxBoundaries) {
+            return NO_ID;
+        }
+        slots[boundary_count].name = name;
+        return static_cast<uint16_t>(boundary_count++);
+    }
+
+    const char* name(uint16_t id) const { return id < boundary_count ? slots[id].name : nullptr; }
+    size_t size() const { return boundary_count; }
+
+    void record(uint16_t id, ProtectionType type, FaultType state, float value, uint64_t now) {
+        if (id >= boundary_count) {
+            return;
+        }
+        Slot& slot = slots[id];
+        slot.value = value;
+        bool changed = state != slot.state || type != slot.type;
+        bool refresh = state != OK && now - slot.marked_at >= config.refresh_ns;
+        if (changed) {
+            slot.repeats = 1;
+        } else if (slot.repeats < UINT16_MAX) {
+            slot.repeats++;
+        }
+        if (!changed && !refresh) {
+            return;
+        }
+        slot.state = state;
+        slot.type = type;
+        slot.marked_at = now;
+        for (size_t i = 0; i < sink_count; i++) {
+            sinks[i].dirty.set(id);
+        }
+    }
+
+    /**
+     * @brief Sends sink its next packet if it has one and the budget allows it. send takes the
+     * packet as a std::span<const uint8_t> and returns false if it couldn't be sent, in which case
+     * the packet is neither charged nor lost.
+     */
+    template <typename Send> bool flush(Sink* sink, uint64_t now, Send&& send) {
+        SinkState* found = find_or_add(sink, now);
+        if (found == nullptr) {
+            return false;
+        }
+        SinkState& state = *found;
+        bool names_pending = state.next_name < boundary_count;
+        if (!names_pending && state.dirty.none()) {
+            return false;
+        }
+        if (!has_budget(state, now)) {
+            return false;
+        }
+
+        size_t size;
+        size_t next_name = state.next_name;
+        std::bitset<MaxBoundaries> sent;
+        if (names_pending) {
+            size = write_names(next_name);
+        } else {
+            size = write_report(state, now, sent);
+        }
+        if (!send(std::span<const uint8_t>(buffer.data(), size))) {
+            return false;
+        }
+
+        state.next_name = next_name;
+        state.dirty &= ~sent;
+        if (!names_pending) {
+            state.sequence++;
+        }
+        charge(state, now);
+        return true;
+    }
+
+    /* Boundaries waiting to be reported to sink */
+    size_t pending(Sink* sink) const {
+        for (size_t i = 0; i < sink_count; i++) {
+            if (sinks[i].sink == sink) {
+                return sinks[i].dirty.count();
+            }
+        }
+        return 0;
+    }
+
+    /* Flushes refused because every sink was taken by a live socket */
+    uint32_t overflows() const { return overflow_count; }
+
+    void forget(Sink* sink) {
+        for (size_t i = 0; i < sink_count; i++) {
+            if (sinks[i].sink == sink) {
+                sinks[i] = sinks[--sink_count];
+                return;
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        const char* name = nullptr;
+        float value = 0.0f;
+        uint64_t marked_at = 0;
+        uint16_t repeats = 0;
+        ProtectionType type = BELOW;
+        FaultType state = OK;
+    };
+
+    struct SinkState {
+        Sink* sink = nullptr;
+        std::bitset<MaxBoundaries> dirty;
+        size_t next_name = 0;
+        uint16_t sequence = 0;
+        /* Theoretical arrival time of the next packet, the budget is a GCRA on it */
+        uint64_t allowed_at = 0;
+        uint64_t last_flush = 0;
+    };
+
+    Config config;
+    std::array<Slot, MaxBoundaries> slots{};
+    size_t boundary_count = 0;
+    std::array<SinkState, MaxSinks> sinks{};
+    size_t sink_count = 0;
+    uint32_t overflow_count = 0;
+    std::array<uint8_t, MAX_PACKET_SIZE> buffer{};
+
+    SinkState* find_or_add(Sink* sink, uint64_t now) {
+        size_t oldest = 0;
+        for (size_t i = 0; i < sink_count; i++) {
+            if (sinks[i].sink == sink) {
+                sinks[i].last_flush = now;
+                return &sinks[i];
+            }
+            if (sinks[i].last_flush < sinks[oldest].last_flush) {
+                oldest = i;
+            }
+        }
+        if (sink_count == MaxSinks && now - sinks[oldest].last_flush < config.sink_timeout_ns) {
+            /* Every sink is a live socket, taking one would reset its budget and names */
+            overflow_count++;
+            return nullptr;
+        }
+        SinkState& state = sink_count < MaxSinks ? sinks[sink_count++] : sinks[oldest];
+        state = SinkState{};
+        state.sink = sink;
+        state.last_flush = now;
+        /* A new socket starts with the state of everything that isn't OK */
+        for (size_t id = 0; id < boundary_count; id++) {
+            state.dirty[id] = slots[id].state != OK;
+        }
+        return &state;
+    }
+
+    uint64_t interval() const {
+        return config.reports_per_second == 0 ? UINT64_MAX
+                                              : 1'000'000'000ULL / config.reports_per_second;
+    }
+
+    bool has_budget(const SinkState& state, uint64_t now) const {
+        if (config.reports_per_second == 0) {
+            return false;
+        }
+        uint64_t window = interval() * (config.burst > 0 ? config.burst - 1 : 0);
+        return state.allowed_at <= window || now >= state.allowed_at - window;
+    }
+
+    void charge(SinkState& state, uint64_t now) {
+        state.allowed_at = (state.allowed_at > now ? state.allowed_at : now) + interval();
+    }
+
+    template <typename Value> static uint8_t* put(uint8_t* data, Value value) {
+        std::memcpy(data, &value, sizeof(value));
+        return data + sizeof(value);
+    }
+
+    size_t write_names(size_t& next_name) {
+        uint8_t* data = put(buffer.data(), config.names_id);
+        data = put(data, static_cast<uint16_t>(next_name));
+        uint8_t* count = data++;
+        *count = 0;
+        while (next_name < boundary_count && *count < 255) {
+            const char* name = slots[next_name].name != nullptr ? slots[next_name].name : "";
+            size_t length = strnlen(name, MAX_NAME_LENGTH);
+            if (static_cast<size_t>(data - buffer.data()) + 1 + length > buffer.size()) {
+                break;
+            }
+            data = put(data, static_cast<uint8_t>(length));
+            std::memcpy(data, name, length);
+            data += length;
+            (*count)++;
+            next_name++;
+        }
+        return data - buffer.data();
+    }
+
+    size_t write_report(const SinkState& state, uint64_t now, std::bitset<MaxBoundaries>& sent) {
+        uint8_t* data = put(buffer.data(), config.report_id);
+        data = put(data, state.sequence);
+        data = put(data, now);
+        uint8_t* count = data++;
+        uint8_t* flags = data++;
+        *count = 0;
+        /* Faults first, so they make it into the packet even in a storm of warnings */
+        for (FaultType priority : {FAULT, WARNING, OK}) {
+            for (size_t id = 0; id < boundary_count && *count < MaxEntries; id++) {
+                if (!state.dirty[id] || slots[id].state != priority) {
+                    continue;
+                }
+                const Slot& slot = slots[id];
+                data = put(data, static_cast<uint16_t>(id));
+                data = put(data, static_cast<uint8_t>(slot.type));
+                data = put(data, static_cast<uint8_t>(slot.state));
+                data = put(data, slot.repeats);
+                data = put(data, slot.value);
+                sent.set(id);
+                (*count)++;
+            }
+        }
+        *flags = (state.dirty & ~sent).any() ? MORE_PENDING : 0;
+        return data - buffer.data();
+    }
+};
+
+} // namespace Protections
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace Protections {
+
+/**
+ * @brief Mean of the last samples() inputs, kept as Buckets partial sums instead of the samples
+ * themselves. The oldest bucket is phased out as the newest one fills, so the mean is off by at
+ * most (max - min) / Buckets of the input range, whatever the window length. An input is an add
+ * and a compare, plus Buckets adds each time a bucket is full.
+ *
+ * Samples before the first input count as zero, so a large value can trip a limit before a
+ * whole window went by.
+ */
+template <typename T, size_t Buckets = 32> class BucketWindow {
+    static_assert(std::is_floating_point_v<T>, "BucketWindow works on floating point values");
+    static_assert(Buckets >= 2, "BucketWindow needs at least two buckets");
+
+public:
+    explicit BucketWindow(size_t window_samples)
+        : bucket_size(window_samples > Buckets ? (window_samples + Buckets - 1) / Buckets : 1),
+          inverse_bucket_size(T{1} / static_cast<T>(bucket_size)),
+          inverse_window(T{1} / static_cast<T>(bucket_size * Buckets)) {}
+
+    T input(T value) {
+        current += value;
+        if (++filled == bucket_size) {
+            oldest = (oldest + 1) % Buckets;
+            sums[newest()] = current;
+            current = T{};
+            filled = 0;
+            /* Summed again rather than updated, rounding can't drift over long runs */
+            full = T{};
+            for (T sum : sums) {
+                full += sum;
+            }
+        }
+        return mean();
+    }
+
+    T mean() const {
+        T phased_out = sums[oldest] * static_cast<T>(filled) * inverse_bucket_size;
+        return (full - phased_out + current) * inverse_window;
+    }
+
+    size_t samples() const { return bucket_size * Buckets; }
+
+    void reset() {
+        sums.fill(T{});
+        full = T{};
+        current = T{};
+        filled = 0;
+    }
+
+private:
+    size_t bucket_size;
+    T inverse_bucket_size;
+    T inverse_window;
+    std::array<T, Buckets> sums{};
+    T full{};
+    T current{};
+    size_t filled = 0;
+    size_t oldest = 0;
+
+    size_t newest() const { return (oldest + Buckets - 1) % Buckets; }
+};
+
+/**
+ * @brief Exponentially weighted mean with a time constant of window_samples inputs, the thermal
+ * model of a first order body. A single multiply add per input and one value of state. A step
+ * reaches 63% of its height after one window where BucketWindow reaches all of it, for a value
+ * well above the limit both trip after limit / value windows.
+ */
+template <typename T> class ExponentialWindow {
+    static_assert(std::is_floating_point_v<T>, "ExponentialWindow works on floating point values");
+
+public:
+    explicit ExponentialWindow(size_t window_samples)
+        : window(window_samples > 0 ? window_samples : 1),
+          alpha(static_cast<T>(-std::expm1(-1.0 / static_cast<double>(window)))) {}
+
+    T input(T value) {
+        average += alpha * (value - average);
+        return average;
+    }
+
+    T mean() const { return average; }
+    size_t samples() const { return window; }
+    void reset() { average = T{}; }
+
+private:
+    size_t window;
+    T alpha;
+    T average{};
+};
+
+} // namespace Protections
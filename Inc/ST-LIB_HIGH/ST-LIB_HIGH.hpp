@@ -9,6 +9,7 @@
 
 // #include "Protections/Protection.hpp"
 // #include "Protections/ProtectionManager.hpp"
+#include "Protections/ProtectionDomain.hpp"
 #include "Control/ControlBlock.hpp"
 #include "Control/FeedbackControlBlock.hpp"
 #include "Control/SplitterBlock.hpp"
@@ -18,9 +19,14 @@
 #include "Control/Blocks/MovingAverage.hpp"
 #include "Control/Blocks/PI.hpp"
 #include "Control/Blocks/PID.hpp"
+#include "Control/Blocks/FastPID.hpp"
 #include "Control/Blocks/Saturator.hpp"
 #include "Control/Blocks/MatrixMultiplier.hpp"
 #include "Control/Blocks/MeanCalculator.hpp"
+#include "Control/Blocks/FilterBank.hpp"
+#include "Control/Blocks/StateSpace.hpp"
+#include "Control/Blocks/KalmanFilter.hpp"
+#include "Control/Blocks/FOC.hpp"
 #include "Control/ControlSystem.hpp"
 #ifdef SIM_ON
 #else
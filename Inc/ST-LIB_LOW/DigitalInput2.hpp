@@ -48,6 +48,10 @@ struct DigitalInputDomain {
         GPIO_PinState read() { return gpio_instance->read(); }
     };
 
+    /* Direct IDR access to an inscribed input, without the gpio_instance indirection */
+    template <const DigitalInput& in>
+    using FastInput = GPIODomain::FastPortPin<in.gpio.e.port, in.gpio.e.pin>;
+
     template <std::size_t N> struct Init {
         static inline std::array<Instance, N> instances{};
 
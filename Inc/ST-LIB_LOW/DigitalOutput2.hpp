@@ -57,6 +57,10 @@ struct DigitalOutputDomain {
         void toggle() { gpio_instance->toggle(); }
     };
 
+    /* Direct BSRR access to an inscribed output, without the gpio_instance indirection */
+    template <const DigitalOutput& out>
+    using FastOutput = GPIODomain::FastPortPin<out.gpio.e.port, out.gpio.e.pin>;
+
     template <std::size_t N> struct Init {
         static inline std::array<Instance, N> instances{};
 
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "C++Utilities/CppUtils.hpp"
+#include "C++Utilities/HeapGuard.hpp"
 
 #ifndef SIM_ON
 #include "HALAL/Services/Time/Time.hpp"
@@ -59,8 +60,11 @@ public:
     friend class BoundaryInterface;
 };
 
+/* The guard is released first, the metadata and the message are strings built on the heap and the
+ * board is going to fault anyway */
 #define ErrorHandler(x, ...)                                                                       \
     do {                                                                                           \
+        HeapGuard::unlock();                                                                       \
         ErrorHandlerModel::SetMetaData(__LINE__, __FUNCTION__, __FILE__);                          \
         ErrorHandlerModel::ErrorHandlerTrigger(x, ##__VA_ARGS__);                                  \
     } while (0)
@@ -21,8 +21,10 @@
 #include "Sensors/LookupSensor/LookupSensor.hpp"
 // #include "Sensors/EncoderSensor/EncoderSensor.hpp"
 #include "Sensors/EncoderSensor/NewEncoderSensor.hpp"
+#include "Sensors/EncoderSensor/EncoderCaptureSensor.hpp"
 #include "Sensors/PWMSensor/PWMSensor.hpp"
 #include "Sensors/NTC/NTC.hpp"
+#include "Sensors/SensorBank/SensorBank.hpp"
 
 #ifdef STLIB_ETH
 #include "Communication/Server/Server.hpp"
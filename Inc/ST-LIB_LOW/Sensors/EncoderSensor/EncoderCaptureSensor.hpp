@@ -0,0 +1,161 @@
+/*
+ * EncoderCaptureSensor.hpp
+ *
+ * Encoder sensor that blends two speed estimates. At low speed the speed comes from the period
+ * between hardware timestamped edges (EncoderEdgeCapture), which has no quantization from the
+ * sampling period. At high speed, where several counts land in every sample, the counter
+ * difference per sample is used. In between both are blended linearly so there is no step when
+ * crossing over. Everything runs in float with the reciprocals computed once in the constructor.
+ */
+#pragma once
+
+#include "HALAL/Services/Encoder/EncoderEdgeCapture.hpp"
+#include "HALAL/Services/Encoder/NewEncoder.hpp"
+
+namespace ST_LIB {
+
+template <typename EncoderType, typename CaptureType> struct EncoderCaptureSensor {
+    enum Direction : uint8_t { FORWARD = 0, BACKWARDS = 1 };
+
+    struct Config {
+        float counter_distance_m;
+        float sample_time_s;
+        /* speed, in counts per sample, below which only the edge period is used */
+        float blend_low_counts = 2.0f;
+        /* speed, in counts per sample, above which only the counter difference is used */
+        float blend_high_counts = 8.0f;
+        /* time without edges after which the speed is considered zero */
+        float standstill_time_s = 0.1f;
+    };
+
+private:
+    constexpr static uint32_t START_COUNTER{UINT32_MAX / 2};
+
+    EncoderType& encoder;
+
+    const float counter_distance_m;
+    const float blend_low_counts;
+    const float standstill_time_s;
+    /* counter difference per sample to m/s */
+    float diff_speed_k;
+    float counts_per_speed;
+    /* edge counts / clock ticks to m/s */
+    float period_speed_k;
+    float inv_sample_time;
+    float inv_blend_span;
+    uint32_t standstill_ticks;
+
+    uint32_t last_counter{START_COUNTER};
+    typename CaptureType::Edge last_edge{};
+    bool has_edge{false};
+    uint32_t last_edge_ticks{0};
+    uint32_t last_edge_counts{0};
+    float period_speed{0.0f};
+    float last_speed{0.0f};
+
+    Direction* direction;
+    float* position;
+    float* speed;
+    float* acceleration;
+
+public:
+    EncoderCaptureSensor(
+        EncoderType& enc,
+        const Config& config,
+        Direction* direction,
+        float* position,
+        float* speed,
+        float* acceleration
+    )
+        : encoder(enc), counter_distance_m(config.counter_distance_m),
+          blend_low_counts(config.blend_low_counts), standstill_time_s(config.standstill_time_s),
+          direction(direction), position(position), speed(speed), acceleration(acceleration) {
+        inv_sample_time = 1.0f / config.sample_time_s;
+        diff_speed_k = config.counter_distance_m * inv_sample_time;
+        counts_per_speed = 1.0f / diff_speed_k;
+        inv_blend_span = 1.0f / (config.blend_high_counts - config.blend_low_counts);
+        update_clock();
+    }
+
+    void turn_on() { encoder.turn_on(); }
+    void turn_off() { encoder.turn_off(); }
+
+    void reset() {
+        encoder.reset();
+        last_counter = START_COUNTER;
+        has_edge = false;
+        period_speed = 0.0f;
+        last_speed = 0.0f;
+    }
+
+    /**
+     * @brief Recomputes the constants that depend on the capture clock, call it if the clock
+     * timer is initialised after the sensor is built.
+     */
+    void update_clock() {
+        const float clock_hz = (float)CaptureType::get_clock_frequency();
+        period_speed_k = counter_distance_m * clock_hz;
+        standstill_ticks = (uint32_t)(standstill_time_s * clock_hz);
+    }
+
+    // must be called on equally spaced time periods
+    void read() {
+        const uint32_t counter{encoder.get_counter()};
+        const int32_t sample_counts{(int32_t)(counter - last_counter)};
+        last_counter = counter;
+
+        *position = (float)(int32_t)(counter - START_COUNTER) * counter_distance_m;
+
+        update_period_speed();
+
+        /* The blend weight comes from the edge period estimate in counts per sample, the raw
+           counter difference would toggle it on every quantization step */
+        const float diff_speed = (float)sample_counts * diff_speed_k;
+        const float abs_period_speed = period_speed < 0.0f ? -period_speed : period_speed;
+        float weight = (abs_period_speed * counts_per_speed - blend_low_counts) * inv_blend_span;
+        weight = weight < 0.0f ? 0.0f : (weight > 1.0f ? 1.0f : weight);
+
+        const float new_speed = period_speed + weight * (diff_speed - period_speed);
+        *acceleration = (new_speed - last_speed) * inv_sample_time;
+        *speed = new_speed;
+        last_speed = new_speed;
+
+        *direction = encoder.get_direction() ? FORWARD : BACKWARDS;
+    }
+
+private:
+    void update_period_speed() {
+        const typename CaptureType::Edge edge = CaptureType::read_last_edge();
+
+        if (!has_edge) {
+            last_edge = edge;
+            has_edge = true;
+            return;
+        }
+
+        if (edge.ticks != last_edge.ticks) {
+            const int32_t edge_counts = (int32_t)(edge.count - last_edge.count);
+            last_edge_ticks = edge.ticks - last_edge.ticks;
+            last_edge_counts = edge_counts < 0 ? -edge_counts : edge_counts;
+            period_speed = (float)edge_counts * period_speed_k / (float)last_edge_ticks;
+            last_edge = edge;
+            return;
+        }
+
+        /* No edge since the last sample. The encoder can't be faster than one edge pitch over
+           the time elapsed since the last edge, which makes the estimate decay while stopping */
+        const uint32_t elapsed = CaptureType::now() - last_edge.ticks;
+        if (elapsed >= standstill_ticks) {
+            period_speed = 0.0f;
+        } else if (elapsed > last_edge_ticks) {
+            const float bound = (float)last_edge_counts * period_speed_k / (float)elapsed;
+            if (period_speed > bound) {
+                period_speed = bound;
+            } else if (period_speed < -bound) {
+                period_speed = -bound;
+            }
+        }
+    }
+};
+
+} // namespace ST_LIB
@@ -10,6 +10,7 @@
 #include "HALAL/Services/ADC/NewADC.hpp"
 #include "ErrorHandler/ErrorHandler.hpp"
 #include "C++Utilities/CppUtils.hpp"
+#include "Sensors/LookupSensor/SensorTable.hpp"
 
 #define REFERENCE_VOLTAGE 3.3
 
@@ -26,3 +27,29 @@ protected:
     int table_size = 0;
     double* value = nullptr;
 };
+
+/*
+ * Lookup with a table generated at compile time (ST_LIB::SensorTable), indexed by the raw code
+ * and interpolated in float instead of the nearest entry of a runtime double table.
+ */
+template <typename Table> class TableLookupSensor {
+public:
+    TableLookupSensor() = default;
+    TableLookupSensor(ST_LIB::ADCDomain::Instance& adc, float* value) : adc(&adc), value(value) {}
+    TableLookupSensor(ST_LIB::ADCDomain::Instance& adc, float& value)
+        : TableLookupSensor(adc, &value) {}
+
+    void read() {
+        if (adc == nullptr || value == nullptr) {
+            return;
+        }
+        const uint32_t raw = static_cast<uint32_t>(adc->get_raw());
+        const uint32_t max_raw =
+            ST_LIB::ADCDomain::Instance::max_raw_for_resolution(adc->resolution);
+        *value = Table::lookup(Table::code_from_raw(raw, max_raw));
+    }
+
+protected:
+    ST_LIB::ADCDomain::Instance* adc = nullptr;
+    float* value = nullptr;
+};
@@ -0,0 +1,425 @@
+/*
+ * SensorTable.hpp
+ *
+ * Lookup tables generated at compile time from a sensor model. The model is sampled at every
+ * ADC code and split greedily into the longest linear segments that stay within the requested
+ * error, so a smooth curve needs a few dozen segments instead of one entry per code. A small
+ * index addressed by the top bits of the raw code points at the segment, the lookup is a couple
+ * of loads, one multiply and one add, in float or fixed point.
+ *
+ * Models are evaluated on ratio = raw / 2^bits, the fraction of the ADC reference seen at the
+ * pin, and return the physical value. They must be structural types so they can be passed as
+ * template arguments:
+ *
+ *   constexpr ST_LIB::BetaNTC ntc{.r25_ohm = 10e3, .beta = 3976, .divider = {.fixed_ohm = 10e3}};
+ *   using NTCTable = ST_LIB::SensorTable<ntc, 12, 0.05>;
+ *   float celsius = NTCTable::lookup(raw);
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace ST_LIB {
+extern void compile_error(const char* msg);
+
+namespace sensor_math {
+constexpr double ln(double x) {
+    constexpr double ln2 = 0.693147180559945309417;
+    int exponent = 0;
+    while (x >= 2.0) {
+        x *= 0.5;
+        exponent++;
+    }
+    while (x < 1.0) {
+        x *= 2.0;
+        exponent--;
+    }
+    /* ln(x) = 2 atanh((x - 1) / (x + 1)), which converges fast for x in [1, 2) */
+    const double z = (x - 1.0) / (x + 1.0);
+    const double z2 = z * z;
+    double term = z;
+    double sum = 0.0;
+    for (int n = 1; n < 60 && term > 1e-18; n += 2) {
+        sum += term / n;
+        term *= z2;
+    }
+    return 2.0 * sum + exponent * ln2;
+}
+
+constexpr double sqrt(double x) {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+    double r = x < 1.0 ? 1.0 : x;
+    for (int i = 0; i < 100; i++) {
+        const double next = 0.5 * (r + x / r);
+        if (next == r) {
+            break;
+        }
+        r = next;
+    }
+    return r;
+}
+
+constexpr double clamp(double x, double lo, double hi) { return x < lo ? lo : (x > hi ? hi : x); }
+} // namespace sensor_math
+
+/* Resistive sensor against a fixed resistor between the ADC reference and ground */
+struct ResistiveDivider {
+    double fixed_ohm;
+    /* true when the sensor is the bottom resistor, from the ADC pin to ground */
+    bool sensor_to_ground{true};
+
+    constexpr double resistance(double ratio) const {
+        constexpr double open = std::numeric_limits<double>::infinity();
+        if (ratio <= 0.0) {
+            return sensor_to_ground ? 0.0 : open;
+        }
+        if (ratio >= 1.0) {
+            return sensor_to_ground ? open : 0.0;
+        }
+        return sensor_to_ground ? fixed_ohm * ratio / (1.0 - ratio)
+                                : fixed_ohm * (1.0 - ratio) / ratio;
+    }
+};
+
+/* NTC from its resistance at 25 ºC and beta, in ºC */
+struct BetaNTC {
+    double r25_ohm;
+    double beta;
+    ResistiveDivider divider;
+    double min_celsius{-55.0};
+    double max_celsius{150.0};
+
+    constexpr double operator()(double ratio) const {
+        const double r = divider.resistance(ratio);
+        if (r <= 0.0) {
+            return max_celsius;
+        }
+        if (r == std::numeric_limits<double>::infinity()) {
+            return min_celsius;
+        }
+        const double inv_kelvin = 1.0 / 298.15 + sensor_math::ln(r / r25_ohm) / beta;
+        if (inv_kelvin <= 0.0) {
+            return min_celsius;
+        }
+        return sensor_math::clamp(1.0 / inv_kelvin - 273.15, min_celsius, max_celsius);
+    }
+};
+
+/* NTC from its Steinhart-Hart coefficients, 1/T = a + b ln(R) + c ln(R)^3, in ºC */
+struct SteinhartHartNTC {
+    double a;
+    double b;
+    double c;
+    ResistiveDivider divider;
+    double min_celsius{-55.0};
+    double max_celsius{150.0};
+
+    constexpr double operator()(double ratio) const {
+        const double r = divider.resistance(ratio);
+        if (r <= 0.0) {
+            return max_celsius;
+        }
+        if (r == std::numeric_limits<double>::infinity()) {
+            return min_celsius;
+        }
+        const double l = sensor_math::ln(r);
+        const double inv_kelvin = a + b * l + c * l * l * l;
+        if (inv_kelvin <= 0.0) {
+            return min_celsius;
+        }
+        return sensor_math::clamp(1.0 / inv_kelvin - 273.15, min_celsius, max_celsius);
+    }
+};
+
+/* Platinum RTD (PT100, PT1000) with the Callendar-Van Dusen equation, in ºC. The defaults are
+ * the IEC 60751 coefficients */
+struct CallendarVanDusenRTD {
+    double r0_ohm;
+    ResistiveDivider divider;
+    double min_celsius{-200.0};
+    double max_celsius{850.0};
+    double a{3.9083e-3};
+    double b{-5.775e-7};
+    double c{-4.183e-12};
+
+    constexpr double resistance(double celsius) const {
+        const double t = celsius;
+        const double cubic = t < 0.0 ? c * (t - 100.0) * t * t * t : 0.0;
+        return r0_ohm * (1.0 + a * t + b * t * t + cubic);
+    }
+
+    constexpr double operator()(double ratio) const {
+        const double r = divider.resistance(ratio);
+        if (r == std::numeric_limits<double>::infinity()) {
+            return max_celsius;
+        }
+        const double disc = a * a - 4.0 * b * (1.0 - r / r0_ohm);
+        if (disc < 0.0) {
+            return max_celsius;
+        }
+        /* exact above 0 ºC, below it the c term is added with a few Newton steps */
+        double t = (-a + sensor_math::sqrt(disc)) / (2.0 * b);
+        if (r < r0_ohm) {
+            for (int i = 0; i < 8; i++) {
+                const double slope =
+                    r0_ohm * (a + 2.0 * b * t + c * (4.0 * t * t * t - 300.0 * t * t));
+                t -= (resistance(t) - r) / slope;
+            }
+        }
+        return sensor_math::clamp(t, min_celsius, max_celsius);
+    }
+};
+
+/* Arbitrary calibration, points sorted by voltage and linearly interpolated, the first and last
+ * values are held outside them */
+template <std::size_t N> struct CalibrationCurve {
+    struct Point {
+        double volts;
+        double value;
+    };
+
+    double vref;
+    std::array<Point, N> points;
+
+    constexpr double operator()(double ratio) const {
+        const double v = ratio * vref;
+        if (v <= points[0].volts) {
+            return points[0].value;
+        }
+        for (std::size_t i = 1; i < N; i++) {
+            if (points[i].volts <= points[i - 1].volts) {
+                compile_error("Calibration points must be sorted by increasing voltage");
+            }
+            if (v <= points[i].volts) {
+                const Point& p = points[i - 1];
+                const Point& q = points[i];
+                return p.value + (q.value - p.value) * (v - p.volts) / (q.volts - p.volts);
+            }
+        }
+        return points[N - 1].value;
+    }
+};
+
+/**
+ * @brief Piecewise linear table of model, indexed by the raw code of an adc_bits ADC, within
+ * max_error of the model at every code. T is float, or an integer type holding value * scale
+ * (e.g. int16_t with scale 10 for tenths of a degree), in which case the interpolation is done
+ * in fixed point and the rounding is counted in the error.
+ */
+template <
+    auto model,
+    uint8_t adc_bits = 12,
+    double max_error = 0.1,
+    typename T = float,
+    int32_t scale = 1>
+class SensorTable {
+    static_assert(adc_bits >= 8 && adc_bits <= 16, "SensorTable supports 8 to 16 bit ADCs");
+    static_assert(max_error > 0.0, "SensorTable max_error must be positive");
+    static_assert(std::is_floating_point_v<T> || std::is_integral_v<T>);
+    static_assert(scale > 0, "SensorTable scale must be positive");
+
+public:
+    static constexpr uint32_t max_raw = (1U << adc_bits) - 1;
+    using slope_t = std::conditional_t<std::is_integral_v<T>, int32_t, float>;
+
+    struct Segment {
+        uint16_t start;
+        T value;
+        slope_t slope;
+    };
+
+private:
+    static constexpr uint32_t slope_frac_bits = 16;
+    /* Above 12 bits the model is sampled, and the segments split, every 2^grid_shift codes to
+       keep the compile time bounded. The curve is smooth at that scale */
+    static constexpr uint8_t grid_shift = adc_bits > 12 ? adc_bits - 12 : 0;
+    static constexpr uint32_t last_point = max_raw >> grid_shift;
+    using Samples = std::array<double, last_point + 1>;
+
+    static constexpr T quantize(double v) {
+        if constexpr (std::is_integral_v<T>) {
+            const double scaled = v * scale;
+            if (scaled > std::numeric_limits<T>::max() || scaled < std::numeric_limits<T>::min()) {
+                compile_error("SensorTable value does not fit the fixed point type");
+            }
+            return static_cast<T>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+        } else {
+            return static_cast<T>(v);
+        }
+    }
+
+    /* start and end are sample points, the segment starts at code start << grid_shift */
+    static constexpr Segment make_segment(const Samples& y, uint32_t start, uint32_t end) {
+        const T first = quantize(y[start]);
+        const T last = quantize(y[end]);
+        const uint16_t code = static_cast<uint16_t>(start << grid_shift);
+        const uint32_t run = (end - start) << grid_shift;
+        if constexpr (std::is_integral_v<T>) {
+            const int64_t rise = (static_cast<int64_t>(last) - first) << slope_frac_bits;
+            const int64_t half = run / 2;
+            const int64_t slope = (rise + (rise < 0 ? -half : half)) / run;
+            return {code, first, static_cast<slope_t>(slope)};
+        } else {
+            return {code, first, static_cast<slope_t>((last - first) / static_cast<T>(run))};
+        }
+    }
+
+    static constexpr T interpolate(const Segment& s, uint32_t raw) {
+        const uint32_t offset = raw - s.start;
+        if constexpr (std::is_integral_v<T>) {
+            const int64_t delta = static_cast<int64_t>(s.slope) * offset;
+            return static_cast<T>(
+                s.value + ((delta + (int64_t{1} << (slope_frac_bits - 1))) >> slope_frac_bits)
+            );
+        } else {
+            return s.value + s.slope * static_cast<T>(offset);
+        }
+    }
+
+    static constexpr double to_value(T v) {
+        if constexpr (std::is_integral_v<T>) {
+            return static_cast<double>(v) / scale;
+        } else {
+            return static_cast<double>(v);
+        }
+    }
+
+    static constexpr bool fits(const Samples& y, uint32_t start, uint32_t end) {
+        const Segment s = make_segment(y, start, end);
+        for (uint32_t point = start; point <= end; point++) {
+            const double error = to_value(interpolate(s, point << grid_shift)) - y[point];
+            if (error > max_error || error < -max_error) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static consteval Samples sample() {
+        Samples y{};
+        for (uint32_t point = 0; point <= last_point; point++) {
+            y[point] = model(static_cast<double>(point << grid_shift) / (1U << adc_bits));
+        }
+        return y;
+    }
+
+    /* Longest segment from start within the bound: doubling its length until it fails, then
+       bisecting, so each segment costs about length * log(length) evaluations */
+    static consteval uint32_t segment_end(const Samples& y, uint32_t start) {
+        if (!fits(y, start, start + 1)) {
+            compile_error("SensorTable max_error is below the resolution of the table type");
+        }
+        uint32_t good = start + 1;
+        uint32_t bad = last_point + 1;
+        for (uint32_t length = 2; start + length <= last_point; length *= 2) {
+            if (!fits(y, start, start + length)) {
+                bad = start + length;
+                break;
+            }
+            good = start + length;
+        }
+        while (bad - good > 1) {
+            const uint32_t mid = good + (bad - good) / 2;
+            if (fits(y, start, mid)) {
+                good = mid;
+            } else {
+                bad = mid;
+            }
+        }
+        return good;
+    }
+
+    static consteval std::size_t count_segments() {
+        const Samples y = sample();
+        std::size_t count = 0;
+        for (uint32_t start = 0; start < last_point; start = segment_end(y, start)) {
+            count++;
+        }
+        return count;
+    }
+
+public:
+    static constexpr std::size_t size = count_segments();
+    static constexpr uint8_t index_shift =
+        adc_bits > std::bit_width(size) ? adc_bits - std::bit_width(size) : 0;
+    /* Same index type for every table, so a SensorBank can walk any of them from plain pointers */
+    using index_t = uint16_t;
+
+private:
+    /* Structure of arrays, the segment search only touches the starts */
+    struct Data {
+        std::array<uint16_t, size> starts;
+        std::array<T, size> values;
+        std::array<slope_t, size> slopes;
+        std::array<index_t, (max_raw >> index_shift) + 1> index;
+    };
+
+    static consteval Data build() {
+        const Samples y = sample();
+        Data d{};
+        std::size_t i = 0;
+        for (uint32_t start = 0; start < last_point; i++) {
+            const uint32_t end = segment_end(y, start);
+            const Segment segment = make_segment(y, start, end);
+            d.starts[i] = segment.start;
+            d.values[i] = segment.value;
+            d.slopes[i] = segment.slope;
+            start = end;
+        }
+        std::size_t seg = 0;
+        for (std::size_t k = 0; k < d.index.size(); k++) {
+            while (seg + 1 < size && d.starts[seg + 1] <= (k << index_shift)) {
+                seg++;
+            }
+            d.index[k] = static_cast<index_t>(seg);
+        }
+        return d;
+    }
+
+    static constexpr Data data = build();
+
+public:
+    static constexpr const std::array<uint16_t, size>& starts = data.starts;
+    static constexpr const std::array<T, size>& values = data.values;
+    static constexpr const std::array<slope_t, size>& slopes = data.slopes;
+    /* Segment of the code k << index_shift */
+    static constexpr const auto& index = data.index;
+    static constexpr std::size_t flash_bytes = sizeof(Data);
+
+    /* Raw value scaled by the table type, i.e. value * scale for fixed point tables */
+    static constexpr T lookup_scaled(uint32_t raw) {
+        if (raw > max_raw) {
+            raw = max_raw;
+        }
+        std::size_t seg = data.index[raw >> index_shift];
+        while (seg + 1 < size && raw >= data.starts[seg + 1]) {
+            seg++;
+        }
+        return interpolate({data.starts[seg], data.values[seg], data.slopes[seg]}, raw);
+    }
+
+    static constexpr float lookup(uint32_t raw) {
+        if constexpr (std::is_integral_v<T>) {
+            return static_cast<float>(lookup_scaled(raw)) * (1.0f / scale);
+        } else {
+            return static_cast<float>(lookup_scaled(raw));
+        }
+    }
+
+    /* Converts a code of an ADC with a different resolution to this table's codes */
+    static constexpr uint32_t code_from_raw(uint32_t raw, uint32_t adc_max_raw) {
+        if (adc_max_raw == max_raw) {
+            return raw;
+        }
+        return static_cast<uint32_t>((static_cast<uint64_t>(raw) * max_raw) / adc_max_raw);
+    }
+};
+
+} // namespace ST_LIB
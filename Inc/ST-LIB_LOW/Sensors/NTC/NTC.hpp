@@ -6,297 +6,33 @@
  */
 
 /*
-This NTC class is not generic. It is only for 10k Ohm, 1976Beta value NTCs.
+This NTC class is not generic. It is only for 10k Ohm, 3976 Beta value NTCs, with a 10k Ohm
+pull-up to the ADC reference. The temperature table is generated at compile time from the beta
+model, within 0.05 ºC of it at every 12 bit code.
 */
 #pragma once
 #include <cstdint>
 
 #include "HALAL/Services/ADC/NewADC.hpp"
+#include "Sensors/LookupSensor/SensorTable.hpp"
 
 class NTC {
 public:
+    static constexpr ST_LIB::BetaNTC model{
+        .r25_ohm = 10e3,
+        .beta = 3976.0,
+        .divider = {.fixed_ohm = 10e3},
+        .min_celsius = -90.0,
+        .max_celsius = 620.0,
+    };
+    using Table = ST_LIB::SensorTable<model, 12, 0.05>;
+
     NTC() = default;
     NTC(ST_LIB::ADCDomain::Instance& adc, float* src);
     NTC(ST_LIB::ADCDomain::Instance& adc, float& src);
     void read();
 
 private:
-    static constexpr int NTC_table[4096] = {
-        6154, 5192, 4230, 3768, 3476, 3267, 3106, 2977, 2869, 2778, 2698, 2628, 2566, 2510, 2459,
-        2412, 2370, 2330, 2293, 2259, 2227, 2197, 2169, 2142, 2116, 2092, 2069, 2047, 2026, 2006,
-        1987, 1969, 1951, 1934, 1917, 1902, 1886, 1872, 1857, 1843, 1830, 1817, 1804, 1792, 1780,
-        1769, 1757, 1746, 1736, 1725, 1715, 1705, 1695, 1686, 1676, 1667, 1659, 1650, 1641, 1633,
-        1625, 1617, 1609, 1601, 1594, 1586, 1579, 1572, 1565, 1558, 1551, 1545, 1538, 1532, 1525,
-        1519, 1513, 1507, 1501, 1495, 1490, 1484, 1478, 1473, 1467, 1462, 1457, 1451, 1446, 1441,
-        1436, 1431, 1426, 1422, 1417, 1412, 1408, 1403, 1399, 1394, 1390, 1385, 1381, 1377, 1373,
-        1368, 1364, 1360, 1356, 1352, 1348, 1344, 1341, 1337, 1333, 1329, 1326, 1322, 1318, 1315,
-        1311, 1308, 1304, 1301, 1297, 1294, 1291, 1287, 1284, 1281, 1278, 1274, 1271, 1268, 1265,
-        1262, 1259, 1256, 1253, 1250, 1247, 1244, 1241, 1238, 1235, 1232, 1230, 1227, 1224, 1221,
-        1219, 1216, 1213, 1210, 1208, 1205, 1203, 1200, 1197, 1195, 1192, 1190, 1187, 1185, 1182,
-        1180, 1178, 1175, 1173, 1170, 1168, 1166, 1163, 1161, 1159, 1157, 1154, 1152, 1150, 1148,
-        1145, 1143, 1141, 1139, 1137, 1135, 1132, 1130, 1128, 1126, 1124, 1122, 1120, 1118, 1116,
-        1114, 1112, 1110, 1108, 1106, 1104, 1102, 1100, 1098, 1096, 1094, 1093, 1091, 1089, 1087,
-        1085, 1083, 1081, 1080, 1078, 1076, 1074, 1073, 1071, 1069, 1067, 1065, 1064, 1062, 1060,
-        1059, 1057, 1055, 1054, 1052, 1050, 1049, 1047, 1045, 1044, 1042, 1040, 1039, 1037, 1036,
-        1034, 1032, 1031, 1029, 1028, 1026, 1025, 1023, 1022, 1020, 1019, 1017, 1016, 1014, 1013,
-        1011, 1010, 1008, 1007, 1005, 1004, 1002, 1001, 1000, 998,  997,  995,  994,  993,  991,
-        990,  988,  987,  986,  984,  983,  982,  980,  979,  978,  976,  975,  974,  972,  971,
-        970,  968,  967,  966,  965,  963,  962,  961,  959,  958,  957,  956,  954,  953,  952,
-        951,  950,  948,  947,  946,  945,  944,  942,  941,  940,  939,  938,  936,  935,  934,
-        933,  932,  931,  929,  928,  927,  926,  925,  924,  923,  921,  920,  919,  918,  917,
-        916,  915,  914,  913,  912,  910,  909,  908,  907,  906,  905,  904,  903,  902,  901,
-        900,  899,  898,  897,  896,  895,  894,  893,  891,  890,  889,  888,  887,  886,  885,
-        884,  883,  882,  881,  880,  879,  878,  877,  876,  876,  875,  874,  873,  872,  871,
-        870,  869,  868,  867,  866,  865,  864,  863,  862,  861,  860,  859,  858,  857,  857,
-        856,  855,  854,  853,  852,  851,  850,  849,  848,  847,  847,  846,  845,  844,  843,
-        842,  841,  840,  840,  839,  838,  837,  836,  835,  834,  833,  833,  832,  831,  830,
-        829,  828,  828,  827,  826,  825,  824,  823,  823,  822,  821,  820,  819,  818,  818,
-        817,  816,  815,  814,  814,  813,  812,  811,  810,  810,  809,  808,  807,  806,  806,
-        805,  804,  803,  802,  802,  801,  800,  799,  799,  798,  797,  796,  795,  795,  794,
-        793,  792,  792,  791,  790,  789,  789,  788,  787,  786,  786,  785,  784,  784,  783,
-        782,  781,  781,  780,  779,  778,  778,  777,  776,  776,  775,  774,  773,  773,  772,
-        771,  771,  770,  769,  768,  768,  767,  766,  766,  765,  764,  764,  763,  762,  761,
-        761,  760,  759,  759,  758,  757,  757,  756,  755,  755,  754,  753,  753,  752,  751,
-        751,  750,  749,  749,  748,  747,  747,  746,  745,  745,  744,  743,  743,  742,  741,
-        741,  740,  739,  739,  738,  738,  737,  736,  736,  735,  734,  734,  733,  732,  732,
-        731,  731,  730,  729,  729,  728,  727,  727,  726,  726,  725,  724,  724,  723,  723,
-        722,  721,  721,  720,  719,  719,  718,  718,  717,  716,  716,  715,  715,  714,  713,
-        713,  712,  712,  711,  710,  710,  709,  709,  708,  708,  707,  706,  706,  705,  705,
-        704,  703,  703,  702,  702,  701,  701,  700,  699,  699,  698,  698,  697,  697,  696,
-        695,  695,  694,  694,  693,  693,  692,  692,  691,  690,  690,  689,  689,  688,  688,
-        687,  687,  686,  685,  685,  684,  684,  683,  683,  682,  682,  681,  681,  680,  679,
-        679,  678,  678,  677,  677,  676,  676,  675,  675,  674,  674,  673,  673,  672,  671,
-        671,  670,  670,  669,  669,  668,  668,  667,  667,  666,  666,  665,  665,  664,  664,
-        663,  663,  662,  662,  661,  661,  660,  660,  659,  659,  658,  658,  657,  657,  656,
-        656,  655,  655,  654,  654,  653,  653,  652,  652,  651,  651,  650,  650,  649,  649,
-        648,  648,  647,  647,  646,  646,  645,  645,  644,  644,  643,  643,  642,  642,  641,
-        641,  640,  640,  639,  639,  638,  638,  637,  637,  636,  636,  635,  635,  635,  634,
-        634,  633,  633,  632,  632,  631,  631,  630,  630,  629,  629,  628,  628,  628,  627,
-        627,  626,  626,  625,  625,  624,  624,  623,  623,  622,  622,  622,  621,  621,  620,
-        620,  619,  619,  618,  618,  617,  617,  617,  616,  616,  615,  615,  614,  614,  613,
-        613,  613,  612,  612,  611,  611,  610,  610,  609,  609,  609,  608,  608,  607,  607,
-        606,  606,  605,  605,  605,  604,  604,  603,  603,  602,  602,  602,  601,  601,  600,
-        600,  599,  599,  599,  598,  598,  597,  597,  596,  596,  596,  595,  595,  594,  594,
-        593,  593,  593,  592,  592,  591,  591,  591,  590,  590,  589,  589,  588,  588,  588,
-        587,  587,  586,  586,  586,  585,  585,  584,  584,  583,  583,  583,  582,  582,  581,
-        581,  581,  580,  580,  579,  579,  579,  578,  578,  577,  577,  577,  576,  576,  575,
-        575,  575,  574,  574,  573,  573,  573,  572,  572,  571,  571,  571,  570,  570,  569,
-        569,  569,  568,  568,  567,  567,  567,  566,  566,  565,  565,  565,  564,  564,  563,
-        563,  563,  562,  562,  562,  561,  561,  560,  560,  560,  559,  559,  558,  558,  558,
-        557,  557,  557,  556,  556,  555,  555,  555,  554,  554,  553,  553,  553,  552,  552,
-        552,  551,  551,  550,  550,  550,  549,  549,  549,  548,  548,  547,  547,  547,  546,
-        546,  546,  545,  545,  544,  544,  544,  543,  543,  543,  542,  542,  542,  541,  541,
-        540,  540,  540,  539,  539,  539,  538,  538,  538,  537,  537,  536,  536,  536,  535,
-        535,  535,  534,  534,  534,  533,  533,  532,  532,  532,  531,  531,  531,  530,  530,
-        530,  529,  529,  529,  528,  528,  527,  527,  527,  526,  526,  526,  525,  525,  525,
-        524,  524,  524,  523,  523,  523,  522,  522,  521,  521,  521,  520,  520,  520,  519,
-        519,  519,  518,  518,  518,  517,  517,  517,  516,  516,  516,  515,  515,  515,  514,
-        514,  514,  513,  513,  513,  512,  512,  511,  511,  511,  510,  510,  510,  509,  509,
-        509,  508,  508,  508,  507,  507,  507,  506,  506,  506,  505,  505,  505,  504,  504,
-        504,  503,  503,  503,  502,  502,  502,  501,  501,  501,  500,  500,  500,  499,  499,
-        499,  498,  498,  498,  497,  497,  497,  496,  496,  496,  495,  495,  495,  494,  494,
-        494,  494,  493,  493,  493,  492,  492,  492,  491,  491,  491,  490,  490,  490,  489,
-        489,  489,  488,  488,  488,  487,  487,  487,  486,  486,  486,  485,  485,  485,  484,
-        484,  484,  484,  483,  483,  483,  482,  482,  482,  481,  481,  481,  480,  480,  480,
-        479,  479,  479,  478,  478,  478,  478,  477,  477,  477,  476,  476,  476,  475,  475,
-        475,  474,  474,  474,  473,  473,  473,  473,  472,  472,  472,  471,  471,  471,  470,
-        470,  470,  469,  469,  469,  469,  468,  468,  468,  467,  467,  467,  466,  466,  466,
-        465,  465,  465,  465,  464,  464,  464,  463,  463,  463,  462,  462,  462,  462,  461,
-        461,  461,  460,  460,  460,  459,  459,  459,  458,  458,  458,  458,  457,  457,  457,
-        456,  456,  456,  455,  455,  455,  455,  454,  454,  454,  453,  453,  453,  453,  452,
-        452,  452,  451,  451,  451,  450,  450,  450,  450,  449,  449,  449,  448,  448,  448,
-        448,  447,  447,  447,  446,  446,  446,  445,  445,  445,  445,  444,  444,  444,  443,
-        443,  443,  443,  442,  442,  442,  441,  441,  441,  441,  440,  440,  440,  439,  439,
-        439,  439,  438,  438,  438,  437,  437,  437,  436,  436,  436,  436,  435,  435,  435,
-        434,  434,  434,  434,  433,  433,  433,  433,  432,  432,  432,  431,  431,  431,  431,
-        430,  430,  430,  429,  429,  429,  429,  428,  428,  428,  427,  427,  427,  427,  426,
-        426,  426,  425,  425,  425,  425,  424,  424,  424,  423,  423,  423,  423,  422,  422,
-        422,  422,  421,  421,  421,  420,  420,  420,  420,  419,  419,  419,  419,  418,  418,
-        418,  417,  417,  417,  417,  416,  416,  416,  415,  415,  415,  415,  414,  414,  414,
-        414,  413,  413,  413,  412,  412,  412,  412,  411,  411,  411,  411,  410,  410,  410,
-        409,  409,  409,  409,  408,  408,  408,  408,  407,  407,  407,  407,  406,  406,  406,
-        405,  405,  405,  405,  404,  404,  404,  404,  403,  403,  403,  402,  402,  402,  402,
-        401,  401,  401,  401,  400,  400,  400,  400,  399,  399,  399,  398,  398,  398,  398,
-        397,  397,  397,  397,  396,  396,  396,  396,  395,  395,  395,  395,  394,  394,  394,
-        393,  393,  393,  393,  392,  392,  392,  392,  391,  391,  391,  391,  390,  390,  390,
-        390,  389,  389,  389,  388,  388,  388,  388,  387,  387,  387,  387,  386,  386,  386,
-        386,  385,  385,  385,  385,  384,  384,  384,  384,  383,  383,  383,  383,  382,  382,
-        382,  381,  381,  381,  381,  380,  380,  380,  380,  379,  379,  379,  379,  378,  378,
-        378,  378,  377,  377,  377,  377,  376,  376,  376,  376,  375,  375,  375,  375,  374,
-        374,  374,  374,  373,  373,  373,  373,  372,  372,  372,  372,  371,  371,  371,  371,
-        370,  370,  370,  370,  369,  369,  369,  369,  368,  368,  368,  367,  367,  367,  367,
-        366,  366,  366,  366,  365,  365,  365,  365,  364,  364,  364,  364,  363,  363,  363,
-        363,  362,  362,  362,  362,  361,  361,  361,  361,  361,  360,  360,  360,  360,  359,
-        359,  359,  359,  358,  358,  358,  358,  357,  357,  357,  357,  356,  356,  356,  356,
-        355,  355,  355,  355,  354,  354,  354,  354,  353,  353,  353,  353,  352,  352,  352,
-        352,  351,  351,  351,  351,  350,  350,  350,  350,  349,  349,  349,  349,  348,  348,
-        348,  348,  347,  347,  347,  347,  347,  346,  346,  346,  346,  345,  345,  345,  345,
-        344,  344,  344,  344,  343,  343,  343,  343,  342,  342,  342,  342,  341,  341,  341,
-        341,  340,  340,  340,  340,  339,  339,  339,  339,  339,  338,  338,  338,  338,  337,
-        337,  337,  337,  336,  336,  336,  336,  335,  335,  335,  335,  334,  334,  334,  334,
-        334,  333,  333,  333,  333,  332,  332,  332,  332,  331,  331,  331,  331,  330,  330,
-        330,  330,  329,  329,  329,  329,  329,  328,  328,  328,  328,  327,  327,  327,  327,
-        326,  326,  326,  326,  325,  325,  325,  325,  325,  324,  324,  324,  324,  323,  323,
-        323,  323,  322,  322,  322,  322,  321,  321,  321,  321,  321,  320,  320,  320,  320,
-        319,  319,  319,  319,  318,  318,  318,  318,  317,  317,  317,  317,  317,  316,  316,
-        316,  316,  315,  315,  315,  315,  314,  314,  314,  314,  314,  313,  313,  313,  313,
-        312,  312,  312,  312,  311,  311,  311,  311,  310,  310,  310,  310,  310,  309,  309,
-        309,  309,  308,  308,  308,  308,  307,  307,  307,  307,  307,  306,  306,  306,  306,
-        305,  305,  305,  305,  305,  304,  304,  304,  304,  303,  303,  303,  303,  302,  302,
-        302,  302,  302,  301,  301,  301,  301,  300,  300,  300,  300,  299,  299,  299,  299,
-        299,  298,  298,  298,  298,  297,  297,  297,  297,  297,  296,  296,  296,  296,  295,
-        295,  295,  295,  294,  294,  294,  294,  294,  293,  293,  293,  293,  292,  292,  292,
-        292,  292,  291,  291,  291,  291,  290,  290,  290,  290,  289,  289,  289,  289,  289,
-        288,  288,  288,  288,  287,  287,  287,  287,  287,  286,  286,  286,  286,  285,  285,
-        285,  285,  285,  284,  284,  284,  284,  283,  283,  283,  283,  283,  282,  282,  282,
-        282,  281,  281,  281,  281,  280,  280,  280,  280,  280,  279,  279,  279,  279,  278,
-        278,  278,  278,  278,  277,  277,  277,  277,  276,  276,  276,  276,  276,  275,  275,
-        275,  275,  274,  274,  274,  274,  274,  273,  273,  273,  273,  272,  272,  272,  272,
-        272,  271,  271,  271,  271,  270,  270,  270,  270,  270,  269,  269,  269,  269,  268,
-        268,  268,  268,  268,  267,  267,  267,  267,  266,  266,  266,  266,  266,  265,  265,
-        265,  265,  264,  264,  264,  264,  264,  263,  263,  263,  263,  263,  262,  262,  262,
-        262,  261,  261,  261,  261,  261,  260,  260,  260,  260,  259,  259,  259,  259,  259,
-        258,  258,  258,  258,  257,  257,  257,  257,  257,  256,  256,  256,  256,  255,  255,
-        255,  255,  255,  254,  254,  254,  254,  253,  253,  253,  253,  253,  252,  252,  252,
-        252,  252,  251,  251,  251,  251,  250,  250,  250,  250,  250,  249,  249,  249,  249,
-        248,  248,  248,  248,  248,  247,  247,  247,  247,  247,  246,  246,  246,  246,  245,
-        245,  245,  245,  245,  244,  244,  244,  244,  243,  243,  243,  243,  243,  242,  242,
-        242,  242,  242,  241,  241,  241,  241,  240,  240,  240,  240,  240,  239,  239,  239,
-        239,  238,  238,  238,  238,  238,  237,  237,  237,  237,  237,  236,  236,  236,  236,
-        235,  235,  235,  235,  235,  234,  234,  234,  234,  233,  233,  233,  233,  233,  232,
-        232,  232,  232,  232,  231,  231,  231,  231,  230,  230,  230,  230,  230,  229,  229,
-        229,  229,  229,  228,  228,  228,  228,  227,  227,  227,  227,  227,  226,  226,  226,
-        226,  226,  225,  225,  225,  225,  224,  224,  224,  224,  224,  223,  223,  223,  223,
-        222,  222,  222,  222,  222,  221,  221,  221,  221,  221,  220,  220,  220,  220,  219,
-        219,  219,  219,  219,  218,  218,  218,  218,  218,  217,  217,  217,  217,  216,  216,
-        216,  216,  216,  215,  215,  215,  215,  215,  214,  214,  214,  214,  213,  213,  213,
-        213,  213,  212,  212,  212,  212,  212,  211,  211,  211,  211,  210,  210,  210,  210,
-        210,  209,  209,  209,  209,  209,  208,  208,  208,  208,  207,  207,  207,  207,  207,
-        206,  206,  206,  206,  206,  205,  205,  205,  205,  204,  204,  204,  204,  204,  203,
-        203,  203,  203,  203,  202,  202,  202,  202,  201,  201,  201,  201,  201,  200,  200,
-        200,  200,  200,  199,  199,  199,  199,  198,  198,  198,  198,  198,  197,  197,  197,
-        197,  197,  196,  196,  196,  196,  195,  195,  195,  195,  195,  194,  194,  194,  194,
-        194,  193,  193,  193,  193,  193,  192,  192,  192,  192,  191,  191,  191,  191,  191,
-        190,  190,  190,  190,  190,  189,  189,  189,  189,  188,  188,  188,  188,  188,  187,
-        187,  187,  187,  187,  186,  186,  186,  186,  185,  185,  185,  185,  185,  184,  184,
-        184,  184,  184,  183,  183,  183,  183,  182,  182,  182,  182,  182,  181,  181,  181,
-        181,  181,  180,  180,  180,  180,  179,  179,  179,  179,  179,  178,  178,  178,  178,
-        178,  177,  177,  177,  177,  176,  176,  176,  176,  176,  175,  175,  175,  175,  175,
-        174,  174,  174,  174,  173,  173,  173,  173,  173,  172,  172,  172,  172,  172,  171,
-        171,  171,  171,  170,  170,  170,  170,  170,  169,  169,  169,  169,  169,  168,  168,
-        168,  168,  168,  167,  167,  167,  167,  166,  166,  166,  166,  166,  165,  165,  165,
-        165,  165,  164,  164,  164,  164,  163,  163,  163,  163,  163,  162,  162,  162,  162,
-        162,  161,  161,  161,  161,  160,  160,  160,  160,  160,  159,  159,  159,  159,  159,
-        158,  158,  158,  158,  157,  157,  157,  157,  157,  156,  156,  156,  156,  156,  155,
-        155,  155,  155,  154,  154,  154,  154,  154,  153,  153,  153,  153,  152,  152,  152,
-        152,  152,  151,  151,  151,  151,  151,  150,  150,  150,  150,  149,  149,  149,  149,
-        149,  148,  148,  148,  148,  148,  147,  147,  147,  147,  146,  146,  146,  146,  146,
-        145,  145,  145,  145,  145,  144,  144,  144,  144,  143,  143,  143,  143,  143,  142,
-        142,  142,  142,  142,  141,  141,  141,  141,  140,  140,  140,  140,  140,  139,  139,
-        139,  139,  138,  138,  138,  138,  138,  137,  137,  137,  137,  137,  136,  136,  136,
-        136,  135,  135,  135,  135,  135,  134,  134,  134,  134,  134,  133,  133,  133,  133,
-        132,  132,  132,  132,  132,  131,  131,  131,  131,  130,  130,  130,  130,  130,  129,
-        129,  129,  129,  129,  128,  128,  128,  128,  127,  127,  127,  127,  127,  126,  126,
-        126,  126,  125,  125,  125,  125,  125,  124,  124,  124,  124,  124,  123,  123,  123,
-        123,  122,  122,  122,  122,  122,  121,  121,  121,  121,  120,  120,  120,  120,  120,
-        119,  119,  119,  119,  118,  118,  118,  118,  118,  117,  117,  117,  117,  117,  116,
-        116,  116,  116,  115,  115,  115,  115,  115,  114,  114,  114,  114,  113,  113,  113,
-        113,  113,  112,  112,  112,  112,  111,  111,  111,  111,  111,  110,  110,  110,  110,
-        109,  109,  109,  109,  109,  108,  108,  108,  108,  107,  107,  107,  107,  107,  106,
-        106,  106,  106,  105,  105,  105,  105,  105,  104,  104,  104,  104,  104,  103,  103,
-        103,  103,  102,  102,  102,  102,  102,  101,  101,  101,  101,  100,  100,  100,  100,
-        100,  99,   99,   99,   99,   98,   98,   98,   98,   97,   97,   97,   97,   97,   96,
-        96,   96,   96,   95,   95,   95,   95,   95,   94,   94,   94,   94,   93,   93,   93,
-        93,   93,   92,   92,   92,   92,   91,   91,   91,   91,   91,   90,   90,   90,   90,
-        89,   89,   89,   89,   89,   88,   88,   88,   88,   87,   87,   87,   87,   87,   86,
-        86,   86,   86,   85,   85,   85,   85,   84,   84,   84,   84,   84,   83,   83,   83,
-        83,   82,   82,   82,   82,   82,   81,   81,   81,   81,   80,   80,   80,   80,   79,
-        79,   79,   79,   79,   78,   78,   78,   78,   77,   77,   77,   77,   77,   76,   76,
-        76,   76,   75,   75,   75,   75,   74,   74,   74,   74,   74,   73,   73,   73,   73,
-        72,   72,   72,   72,   71,   71,   71,   71,   71,   70,   70,   70,   70,   69,   69,
-        69,   69,   68,   68,   68,   68,   68,   67,   67,   67,   67,   66,   66,   66,   66,
-        65,   65,   65,   65,   65,   64,   64,   64,   64,   63,   63,   63,   63,   62,   62,
-        62,   62,   62,   61,   61,   61,   61,   60,   60,   60,   60,   59,   59,   59,   59,
-        58,   58,   58,   58,   58,   57,   57,   57,   57,   56,   56,   56,   56,   55,   55,
-        55,   55,   54,   54,   54,   54,   54,   53,   53,   53,   53,   52,   52,   52,   52,
-        51,   51,   51,   51,   50,   50,   50,   50,   50,   49,   49,   49,   49,   48,   48,
-        48,   48,   47,   47,   47,   47,   46,   46,   46,   46,   45,   45,   45,   45,   45,
-        44,   44,   44,   44,   43,   43,   43,   43,   42,   42,   42,   42,   41,   41,   41,
-        41,   40,   40,   40,   40,   39,   39,   39,   39,   39,   38,   38,   38,   38,   37,
-        37,   37,   37,   36,   36,   36,   36,   35,   35,   35,   35,   34,   34,   34,   34,
-        33,   33,   33,   33,   32,   32,   32,   32,   31,   31,   31,   31,   30,   30,   30,
-        30,   29,   29,   29,   29,   29,   28,   28,   28,   28,   27,   27,   27,   27,   26,
-        26,   26,   26,   25,   25,   25,   25,   24,   24,   24,   24,   23,   23,   23,   23,
-        22,   22,   22,   22,   21,   21,   21,   21,   20,   20,   20,   20,   19,   19,   19,
-        19,   18,   18,   18,   18,   17,   17,   17,   17,   16,   16,   16,   16,   15,   15,
-        15,   15,   14,   14,   14,   14,   13,   13,   13,   13,   12,   12,   12,   12,   11,
-        11,   11,   10,   10,   10,   10,   9,    9,    9,    9,    8,    8,    8,    8,    7,
-        7,    7,    7,    6,    6,    6,    6,    5,    5,    5,    5,    4,    4,    4,    4,
-        3,    3,    3,    3,    2,    2,    2,    1,    1,    1,    1,    0,    0,    0,    0,
-        -1,   -1,   -1,   -1,   -2,   -2,   -2,   -2,   -3,   -3,   -3,   -3,   -4,   -4,   -4,
-        -5,   -5,   -5,   -5,   -6,   -6,   -6,   -6,   -7,   -7,   -7,   -7,   -8,   -8,   -8,
-        -8,   -9,   -9,   -9,   -10,  -10,  -10,  -10,  -11,  -11,  -11,  -11,  -12,  -12,  -12,
-        -12,  -13,  -13,  -13,  -14,  -14,  -14,  -14,  -15,  -15,  -15,  -15,  -16,  -16,  -16,
-        -17,  -17,  -17,  -17,  -18,  -18,  -18,  -18,  -19,  -19,  -19,  -19,  -20,  -20,  -20,
-        -21,  -21,  -21,  -21,  -22,  -22,  -22,  -22,  -23,  -23,  -23,  -24,  -24,  -24,  -24,
-        -25,  -25,  -25,  -26,  -26,  -26,  -26,  -27,  -27,  -27,  -27,  -28,  -28,  -28,  -29,
-        -29,  -29,  -29,  -30,  -30,  -30,  -31,  -31,  -31,  -31,  -32,  -32,  -32,  -32,  -33,
-        -33,  -33,  -34,  -34,  -34,  -34,  -35,  -35,  -35,  -36,  -36,  -36,  -36,  -37,  -37,
-        -37,  -38,  -38,  -38,  -38,  -39,  -39,  -39,  -40,  -40,  -40,  -40,  -41,  -41,  -41,
-        -42,  -42,  -42,  -42,  -43,  -43,  -43,  -44,  -44,  -44,  -44,  -45,  -45,  -45,  -46,
-        -46,  -46,  -47,  -47,  -47,  -47,  -48,  -48,  -48,  -49,  -49,  -49,  -49,  -50,  -50,
-        -50,  -51,  -51,  -51,  -52,  -52,  -52,  -52,  -53,  -53,  -53,  -54,  -54,  -54,  -54,
-        -55,  -55,  -55,  -56,  -56,  -56,  -57,  -57,  -57,  -57,  -58,  -58,  -58,  -59,  -59,
-        -59,  -60,  -60,  -60,  -61,  -61,  -61,  -61,  -62,  -62,  -62,  -63,  -63,  -63,  -64,
-        -64,  -64,  -64,  -65,  -65,  -65,  -66,  -66,  -66,  -67,  -67,  -67,  -68,  -68,  -68,
-        -68,  -69,  -69,  -69,  -70,  -70,  -70,  -71,  -71,  -71,  -72,  -72,  -72,  -73,  -73,
-        -73,  -73,  -74,  -74,  -74,  -75,  -75,  -75,  -76,  -76,  -76,  -77,  -77,  -77,  -78,
-        -78,  -78,  -79,  -79,  -79,  -80,  -80,  -80,  -80,  -81,  -81,  -81,  -82,  -82,  -82,
-        -83,  -83,  -83,  -84,  -84,  -84,  -85,  -85,  -85,  -86,  -86,  -86,  -87,  -87,  -87,
-        -88,  -88,  -88,  -89,  -89,  -89,  -90,  -90,  -90,  -91,  -91,  -91,  -92,  -92,  -92,
-        -93,  -93,  -93,  -94,  -94,  -94,  -95,  -95,  -95,  -96,  -96,  -96,  -97,  -97,  -97,
-        -98,  -98,  -98,  -99,  -99,  -99,  -100, -100, -100, -101, -101, -101, -102, -102, -103,
-        -103, -103, -104, -104, -104, -105, -105, -105, -106, -106, -106, -107, -107, -107, -108,
-        -108, -108, -109, -109, -109, -110, -110, -111, -111, -111, -112, -112, -112, -113, -113,
-        -113, -114, -114, -114, -115, -115, -116, -116, -116, -117, -117, -117, -118, -118, -118,
-        -119, -119, -120, -120, -120, -121, -121, -121, -122, -122, -123, -123, -123, -124, -124,
-        -124, -125, -125, -126, -126, -126, -127, -127, -127, -128, -128, -129, -129, -129, -130,
-        -130, -130, -131, -131, -132, -132, -132, -133, -133, -133, -134, -134, -135, -135, -135,
-        -136, -136, -137, -137, -137, -138, -138, -139, -139, -139, -140, -140, -141, -141, -141,
-        -142, -142, -142, -143, -143, -144, -144, -144, -145, -145, -146, -146, -147, -147, -147,
-        -148, -148, -149, -149, -149, -150, -150, -151, -151, -151, -152, -152, -153, -153, -153,
-        -154, -154, -155, -155, -156, -156, -156, -157, -157, -158, -158, -159, -159, -159, -160,
-        -160, -161, -161, -162, -162, -162, -163, -163, -164, -164, -165, -165, -165, -166, -166,
-        -167, -167, -168, -168, -168, -169, -169, -170, -170, -171, -171, -172, -172, -172, -173,
-        -173, -174, -174, -175, -175, -176, -176, -177, -177, -177, -178, -178, -179, -179, -180,
-        -180, -181, -181, -182, -182, -183, -183, -183, -184, -184, -185, -185, -186, -186, -187,
-        -187, -188, -188, -189, -189, -190, -190, -191, -191, -192, -192, -193, -193, -194, -194,
-        -195, -195, -196, -196, -196, -197, -197, -198, -198, -199, -199, -200, -201, -201, -202,
-        -202, -203, -203, -204, -204, -205, -205, -206, -206, -207, -207, -208, -208, -209, -209,
-        -210, -210, -211, -211, -212, -212, -213, -213, -214, -215, -215, -216, -216, -217, -217,
-        -218, -218, -219, -219, -220, -221, -221, -222, -222, -223, -223, -224, -224, -225, -226,
-        -226, -227, -227, -228, -228, -229, -230, -230, -231, -231, -232, -232, -233, -234, -234,
-        -235, -235, -236, -237, -237, -238, -238, -239, -240, -240, -241, -241, -242, -243, -243,
-        -244, -244, -245, -246, -246, -247, -248, -248, -249, -249, -250, -251, -251, -252, -253,
-        -253, -254, -255, -255, -256, -256, -257, -258, -258, -259, -260, -260, -261, -262, -262,
-        -263, -264, -265, -265, -266, -267, -267, -268, -269, -269, -270, -271, -271, -272, -273,
-        -274, -274, -275, -276, -276, -277, -278, -279, -279, -280, -281, -282, -282, -283, -284,
-        -285, -285, -286, -287, -288, -288, -289, -290, -291, -291, -292, -293, -294, -295, -295,
-        -296, -297, -298, -299, -299, -300, -301, -302, -303, -303, -304, -305, -306, -307, -308,
-        -309, -309, -310, -311, -312, -313, -314, -315, -315, -316, -317, -318, -319, -320, -321,
-        -322, -323, -324, -325, -326, -326, -327, -328, -329, -330, -331, -332, -333, -334, -335,
-        -336, -337, -338, -339, -340, -341, -342, -343, -344, -345, -346, -347, -348, -349, -351,
-        -352, -353, -354, -355, -356, -357, -358, -359, -361, -362, -363, -364, -365, -366, -368,
-        -369, -370, -371, -372, -374, -375, -376, -377, -379, -380, -381, -382, -384, -385, -386,
-        -388, -389, -390, -392, -393, -394, -396, -397, -399, -400, -402, -403, -405, -406, -408,
-        -409, -411, -412, -414, -415, -417, -418, -420, -422, -423, -425, -427, -428, -430, -432,
-        -434, -436, -437, -439, -441, -443, -445, -447, -449, -451, -453, -455, -457, -459, -461,
-        -463, -465, -467, -470, -472, -474, -477, -479, -481, -484, -486, -489, -491, -494, -497,
-        -499, -502, -505, -508, -511, -514, -517, -520, -523, -527, -530, -534, -537, -541, -544,
-        -548, -552, -556, -561, -565, -569, -574, -579, -584, -589, -594, -600, -606, -612, -618,
-        -625, -632, -640, -648, -657, -666, -677, -688, -700, -714, -729, -748, -770, -797, -835,
-        -873
-    };
     float* value = nullptr;
     ST_LIB::ADCDomain::Instance* adc = nullptr;
 };
@@ -0,0 +1,317 @@
+/*
+ * SensorBank.hpp
+ *
+ * Converts all the analog sensors of a board in one pass over the latest block of raw ADC codes
+ * (e.g. the buffer a DMA fills) instead of one read() per sensor object, each sampling its ADC
+ * and chasing pointers through it. Sensors are grouped by kind of conversion in structure of
+ * arrays storage, so every kind is one straight loop over contiguous codes, gains and offsets:
+ * vectorized by the compiler on host, back to back FPU multiply-adds on the M7. Table sensors
+ * keep pointers to the segment arrays of their SensorTable in flash and are interpolated in the
+ * loop, there is no call per sensor.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "ErrorHandler/ErrorHandler.hpp"
+
+namespace ST_LIB {
+
+/**
+ * @tparam MaxFiltered linear sensors averaged over the last FilterWindow updates, as
+ * FilteredLinearSensor with a MovingAverage<FilterWindow>. The window is the same for all of them.
+ */
+template <
+    std::size_t MaxLinear,
+    std::size_t MaxInverse = 0,
+    std::size_t MaxTable = 0,
+    std::size_t MaxFiltered = 0,
+    std::size_t FilterWindow = 1>
+class SensorBank {
+    static_assert(FilterWindow > 0, "SensorBank filter window must hold at least one update");
+
+public:
+    using raw_t = uint16_t;
+
+private:
+    /* value = gain * code + offset, the volts scaling folded into the gain */
+    struct LinearKind {
+        std::array<uint16_t, MaxLinear> channel{};
+        std::array<float, MaxLinear> gain{};
+        std::array<float, MaxLinear> offset{};
+        std::array<float, MaxLinear> value{};
+        std::array<float*, MaxLinear> output{};
+        std::size_t count{0};
+    };
+
+    /* value = gain / code + offset */
+    struct InverseKind {
+        std::array<uint16_t, MaxInverse> channel{};
+        std::array<float, MaxInverse> gain{};
+        std::array<float, MaxInverse> offset{};
+        std::array<float, MaxInverse> value{};
+        std::array<float*, MaxInverse> output{};
+        std::size_t count{0};
+    };
+
+    /* value = values[seg] + slopes[seg] * (code - starts[seg]), the segments of a SensorTable */
+    struct TableKind {
+        std::array<uint16_t, MaxTable> channel{};
+        std::array<const uint16_t*, MaxTable> starts{};
+        std::array<const float*, MaxTable> values{};
+        std::array<const float*, MaxTable> slopes{};
+        std::array<const uint16_t*, MaxTable> index{};
+        std::array<uint8_t, MaxTable> index_shift{};
+        std::array<uint16_t, MaxTable> last_segment{};
+        /* Full scale codes of the table and of the ADC, equal unless the resolutions differ */
+        std::array<uint32_t, MaxTable> table_max_raw{};
+        std::array<uint32_t, MaxTable> adc_max_raw{};
+        std::array<float, MaxTable> value{};
+        std::array<float*, MaxTable> output{};
+        std::size_t count{0};
+    };
+
+    /* value = mean of the last FilterWindow values of gain * code + offset, 0 until it is full */
+    struct FilteredKind {
+        std::array<uint16_t, MaxFiltered> channel{};
+        std::array<float, MaxFiltered> gain{};
+        std::array<float, MaxFiltered> offset{};
+        /* history[update % FilterWindow][sensor], one row per update so each is a straight loop */
+        std::array<std::array<float, MaxFiltered>, FilterWindow> history{};
+        std::array<float, MaxFiltered> sum{};
+        std::array<float, MaxFiltered> value{};
+        std::array<float*, MaxFiltered> output{};
+        std::size_t count{0};
+        std::size_t row{0};
+        std::size_t seen{0};
+    };
+
+    static constexpr std::size_t scratch_size = std::max({MaxLinear, MaxInverse, MaxFiltered});
+
+    LinearKind linear;
+    InverseKind inverse;
+    TableKind table;
+    FilteredKind filtered;
+    std::array<float, scratch_size> codes{};
+    uint16_t max_channel{0};
+
+    void use_channel(uint16_t channel) {
+        if (channel > max_channel) {
+            max_channel = channel;
+        }
+    }
+
+    template <std::size_t N>
+    static void gather(
+        std::span<const raw_t> raw,
+        const std::array<uint16_t, N>& channel,
+        std::size_t count,
+        float* __restrict out
+    ) {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = static_cast<float>(raw[channel[i]]);
+        }
+    }
+
+    template <std::size_t N>
+    static void scatter(
+        const std::array<float, N>& value,
+        const std::array<float*, N>& output,
+        std::size_t count
+    ) {
+        for (std::size_t i = 0; i < count; i++) {
+            *output[i] = value[i];
+        }
+    }
+
+public:
+    SensorBank() = default;
+    /* outputs left as nullptr point inside the bank */
+    SensorBank(const SensorBank&) = delete;
+    SensorBank& operator=(const SensorBank&) = delete;
+
+    /**
+     * @brief Same conversion as LinearSensor: slope * volts + offset.
+     *
+     * @param channel index of the sensor code in the raw block given to update().
+     * @param output where the value is written on every update, nullptr to only keep it in the
+     * bank.
+     * @param max_raw full scale code of the ADC, 4095 for 12 bits.
+     */
+    bool add_linear(
+        uint16_t channel,
+        float slope,
+        float offset,
+        float* output,
+        float vref = 3.3f,
+        uint32_t max_raw = 4095
+    ) {
+        if (linear.count == MaxLinear) {
+            ErrorHandler("SensorBank has no room for more linear sensors");
+            return false;
+        }
+        const std::size_t i = linear.count++;
+        linear.channel[i] = channel;
+        linear.gain[i] = slope * vref / static_cast<float>(max_raw);
+        linear.offset[i] = offset;
+        linear.output[i] = output != nullptr ? output : &linear.value[i];
+        use_channel(channel);
+        return true;
+    }
+
+    /* Same conversion as PT100: k / volts + offset */
+    bool add_inverse(
+        uint16_t channel,
+        float k,
+        float offset,
+        float* output,
+        float vref = 3.3f,
+        uint32_t max_raw = 4095
+    ) {
+        if (inverse.count == MaxInverse) {
+            ErrorHandler("SensorBank has no room for more inverse sensors");
+            return false;
+        }
+        const std::size_t i = inverse.count++;
+        inverse.channel[i] = channel;
+        inverse.gain[i] = k * static_cast<float>(max_raw) / vref;
+        inverse.offset[i] = offset;
+        inverse.output[i] = output != nullptr ? output : &inverse.value[i];
+        use_channel(channel);
+        return true;
+    }
+
+    /* Compile time table (SensorTable), as NTC or TableLookupSensor. Float tables only */
+    template <typename Table, uint32_t adc_max_raw = Table::max_raw>
+    bool add_table(uint16_t channel, float* output) {
+        static_assert(
+            std::is_same_v<std::remove_cvref_t<decltype(Table::values[0])>, float>,
+            "SensorBank interpolates float tables, fixed point ones go through TableLookupSensor"
+        );
+        if (table.count == MaxTable) {
+            ErrorHandler("SensorBank has no room for more table sensors");
+            return false;
+        }
+        const std::size_t i = table.count++;
+        table.channel[i] = channel;
+        table.starts[i] = Table::starts.data();
+        table.values[i] = Table::values.data();
+        table.slopes[i] = Table::slopes.data();
+        table.index[i] = Table::index.data();
+        table.index_shift[i] = Table::index_shift;
+        table.last_segment[i] = static_cast<uint16_t>(Table::size - 1);
+        table.table_max_raw[i] = Table::max_raw;
+        table.adc_max_raw[i] = adc_max_raw;
+        table.output[i] = output != nullptr ? output : &table.value[i];
+        use_channel(channel);
+        return true;
+    }
+
+    /* Same conversion as FilteredLinearSensor, averaged over the last FilterWindow updates */
+    bool add_filtered_linear(
+        uint16_t channel,
+        float slope,
+        float offset,
+        float* output,
+        float vref = 3.3f,
+        uint32_t max_raw = 4095
+    ) {
+        if (filtered.count == MaxFiltered) {
+            ErrorHandler("SensorBank has no room for more filtered sensors");
+            return false;
+        }
+        const std::size_t i = filtered.count++;
+        filtered.channel[i] = channel;
+        filtered.gain[i] = slope * vref / static_cast<float>(max_raw);
+        filtered.offset[i] = offset;
+        filtered.output[i] = output != nullptr ? output : &filtered.value[i];
+        use_channel(channel);
+        return true;
+    }
+
+    /**
+     * @brief Converts every sensor from the latest codes, raw[channel] for each of them, and
+     * writes the outputs.
+     */
+    void update(std::span<const raw_t> raw) {
+        if (size() != 0 && raw.size() <= max_channel) {
+            ErrorHandler("SensorBank raw block is smaller than the channels registered");
+            return;
+        }
+
+        gather(raw, linear.channel, linear.count, codes.data());
+        for (std::size_t i = 0; i < linear.count; i++) {
+            linear.value[i] = linear.gain[i] * codes[i] + linear.offset[i];
+        }
+        scatter(linear.value, linear.output, linear.count);
+
+        gather(raw, inverse.channel, inverse.count, codes.data());
+        for (std::size_t i = 0; i < inverse.count; i++) {
+            inverse.value[i] = inverse.gain[i] / codes[i] + inverse.offset[i];
+        }
+        scatter(inverse.value, inverse.output, inverse.count);
+
+        for (std::size_t i = 0; i < table.count; i++) {
+            uint32_t code = raw[table.channel[i]];
+            if (table.adc_max_raw[i] != table.table_max_raw[i]) {
+                code = static_cast<uint32_t>(
+                    static_cast<uint64_t>(code) * table.table_max_raw[i] / table.adc_max_raw[i]
+                );
+            }
+            code = code > table.table_max_raw[i] ? table.table_max_raw[i] : code;
+            const uint16_t* starts = table.starts[i];
+            std::size_t seg = table.index[i][code >> table.index_shift[i]];
+            while (seg < table.last_segment[i] && code >= starts[seg + 1]) {
+                seg++;
+            }
+            const float offset = static_cast<float>(code - starts[seg]);
+            table.value[i] = table.values[i][seg] + table.slopes[i][seg] * offset;
+        }
+        scatter(table.value, table.output, table.count);
+
+        update_filtered(raw);
+    }
+
+    std::span<const float> linear_values() const { return {linear.value.data(), linear.count}; }
+    std::span<const float> inverse_values() const {
+        return {inverse.value.data(), inverse.count};
+    }
+    std::span<const float> table_values() const { return {table.value.data(), table.count}; }
+    std::span<const float> filtered_values() const {
+        return {filtered.value.data(), filtered.count};
+    }
+
+    std::size_t size() const {
+        return linear.count + inverse.count + table.count + filtered.count;
+    }
+
+private:
+    void update_filtered(std::span<const raw_t> raw) {
+        if (filtered.count == 0) {
+            return;
+        }
+        gather(raw, filtered.channel, filtered.count, codes.data());
+        std::array<float, MaxFiltered>& oldest = filtered.history[filtered.row];
+        /* Same as MovingAverage: the value stays at 0 while the window fills */
+        const bool full = filtered.seen == FilterWindow;
+        constexpr float scale = 1.0f / static_cast<float>(FilterWindow);
+        for (std::size_t i = 0; i < filtered.count; i++) {
+            const float sample = filtered.gain[i] * codes[i] + filtered.offset[i];
+            filtered.sum[i] += sample - oldest[i];
+            oldest[i] = sample;
+            filtered.value[i] = full ? filtered.sum[i] * scale : 0.0f;
+        }
+        filtered.row = filtered.row + 1 == FilterWindow ? 0 : filtered.row + 1;
+        if (!full) {
+            filtered.seen++;
+        }
+        scatter(filtered.value, filtered.output, filtered.count);
+    }
+};
+
+} // namespace ST_LIB
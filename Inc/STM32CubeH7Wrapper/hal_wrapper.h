@@ -55,6 +55,14 @@
 #endif
 #endif
 
+#ifndef TIM_EGR_BG
+#if defined(TIM_EGR_BG_Msk)
+#define TIM_EGR_BG TIM_EGR_BG_Msk
+#else
+#define TIM_EGR_BG (1U << 7)
+#endif
+#endif
+
 extern "C" void
 HAL_SYSCFG_AnalogSwitchConfig(uint32_t SYSCFG_AnalogSwitch, uint32_t SYSCFG_SwitchState);
 #endif
@@ -0,0 +1,49 @@
+/*
+ * HeapGuard.cpp
+ *
+ * Global operator new/delete on top of malloc/free, going through HeapGuard::check() so the
+ * steady state can be proven allocation free. Only linked with STLIB_HEAP_GUARD.
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "C++Utilities/HeapGuard.hpp"
+
+namespace {
+
+void* allocate(std::size_t size) {
+    HeapGuard::check(size);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+#if __cpp_exceptions
+        throw std::bad_alloc();
+#else
+        __builtin_trap();
+#endif
+    }
+    return memory;
+}
+
+void* allocate(std::size_t size, const std::nothrow_t&) noexcept {
+    HeapGuard::check(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept {
+    return allocate(size, tag);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return allocate(size, tag);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
@@ -1,5 +1,5 @@
 #include "HALAL/Models/Packets/Packet.hpp"
 #include "HALAL/Models/Packets/Order.hpp"
 
-map<uint16_t, Order*> Order::orders = {};
-map<uint16_t, Packet*> Packet::packets = {};
+StaticFlatMap<uint16_t, Order*, STLIB_MAX_ORDERS> Order::orders = {};
+StaticFlatMap<uint16_t, Packet*, STLIB_MAX_PACKETS> Packet::packets = {};
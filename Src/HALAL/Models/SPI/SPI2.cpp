@@ -97,6 +97,11 @@ void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi) {
         return;
     }
 
+    if (inst->transaction_active) {
+        inst->complete_transaction(true);
+        return;
+    }
+
     if (inst->operation_flag != nullptr) {
         *(inst->operation_flag) = true;
         inst->operation_flag = nullptr; // Clear pointer after setting flag
@@ -150,6 +155,10 @@ void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi) {
         );
     }
 
+    if (inst->transaction_active) {
+        inst->complete_transaction(false);
+    }
+
     (void)error_code;
     (void)inst_idx;
 }
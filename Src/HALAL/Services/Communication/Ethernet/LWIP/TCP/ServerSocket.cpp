@@ -159,7 +159,10 @@ bool ServerSocket::add_order_to_queue(Order& order) {
 
     struct pbuf* packet = pbuf_alloc(PBUF_TRANSPORT, order.get_size(), PBUF_POOL);
     pbuf_take(packet, order_buffer, order.get_size());
-    tx_packet_buffer.push(packet);
+    if (!tx_packet_buffer.push(packet)) {
+        pbuf_free(packet);
+        return false;
+    }
     return true;
 }
 
@@ -239,7 +242,9 @@ err_t ServerSocket::receive_callback(
         }
         return error;
     } else if (server_socket->state == ACCEPTED) {
-        server_socket->rx_packet_buffer.push(packet_buffer);
+        if (!server_socket->rx_packet_buffer.push(packet_buffer)) {
+            return ERR_MEM; // lwIP keeps the segment and delivers it again
+        }
         server_socket->process_data();
         return ERR_OK;
     }
@@ -193,7 +193,10 @@ bool Socket::add_order_to_queue(Order& order) {
 
     struct pbuf* packet = pbuf_alloc(PBUF_TRANSPORT, order.get_size(), PBUF_POOL);
     pbuf_take(packet, order_buffer, order.get_size());
-    Socket::tx_packet_buffer.push(packet);
+    if (!Socket::tx_packet_buffer.push(packet)) {
+        pbuf_free(packet);
+        return false;
+    }
     return true;
 }
 
@@ -243,7 +246,9 @@ err_t Socket::receive_callback(
         }
         return error;
     } else if (socket->state == CONNECTED) {
-        socket->rx_packet_buffer.push(packet_buffer);
+        if (!socket->rx_packet_buffer.push(packet_buffer)) {
+            return ERR_MEM; // lwIP keeps the segment and delivers it again
+        }
         tcp_recved(client_control_block, packet_buffer->tot_len);
         socket->process_data();
         pbuf_free(packet_buffer);
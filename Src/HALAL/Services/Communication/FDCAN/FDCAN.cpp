@@ -41,7 +41,7 @@ void FDCAN::start() {
         FDCAN::Instance* instance = inst.second;
         FDCAN::init(instance);
 
-        instance->rx_queue = queue<FDCAN::Packet>();
+        instance->rx_queue.clear();
         instance->tx_data = vector<uint8_t>();
 
         if (HAL_FDCAN_Start(instance->hfdcan) != HAL_OK) {
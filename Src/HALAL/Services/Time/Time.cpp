@@ -12,30 +12,31 @@
 
 TIM_HandleTypeDef* Time::low_precision_timer = &htim7;
 
-uint8_t Time::high_precision_ids = 0;
-uint8_t Time::low_precision_ids = 0;
-uint8_t Time::mid_precision_ids = 0;
-
 bool Time::mid_precision_registered = false;
 
-stack<TIM_HandleTypeDef*> Time::available_high_precision_timers;
-
-unordered_map<uint8_t, Time::Alarm> Time::high_precision_alarms_by_id;
-unordered_map<uint8_t, Time::Alarm> Time::low_precision_alarms_by_id;
-unordered_map<uint8_t, Time::Alarm> Time::mid_precision_alarms_by_id;
-unordered_map<TIM_HandleTypeDef*, Time::Alarm> Time::high_precision_alarms_by_timer;
-
-unordered_map<TIM_HandleTypeDef*, TIM_TypeDef*> Time::timer32_by_timer32handler_map =
-    {{&htim2, TIM2}, {&htim5, TIM5}, {&htim23, TIM23}, {&htim24, TIM24}};
-unordered_map<TIM_HandleTypeDef*, IRQn_Type> Time::timer32interrupt_by_timer32handler_map =
-    {{&htim2, TIM2_IRQn}, {&htim5, TIM5_IRQn}, {&htim23, TIM23_IRQn}, {&htim24, TIM24_IRQn}};
-
-stack<uint8_t> Time::low_precision_erasable_ids;
-stack<uint8_t> Time::mid_precision_erasable_ids;
+std::array<Time::HighPrecisionAlarm, Time::timer32_count> Time::high_precision_alarms;
+uint8_t Time::high_precision_bitmap = 0;
+uint8_t Time::available_high_precision_bitmap = 0;
+AlarmTable<TIME_LOW_PRECISION_ALARMS> Time::low_precision_alarms;
+AlarmTable<TIME_MID_PRECISION_ALARMS> Time::mid_precision_alarms;
+
+static constexpr std::array<IRQn_Type, 4> timer32_interrupts =
+    {TIM2_IRQn, TIM5_IRQn, TIM23_IRQn, TIM24_IRQn};
+
+static TIM_TypeDef* timer32_instance(int8_t index) {
+    switch (index) {
+    case 0:
+        return TIM2;
+    case 1:
+        return TIM5;
+    case 2:
+        return TIM23;
+    default:
+        return TIM24;
+    }
+}
 
 uint64_t Time::global_tick = 0;
-uint64_t Time::low_precision_tick = 0;
-uint64_t Time::mid_precision_tick = 0;
 
 void Time::init_timer(
     TIM_TypeDef* tim,
@@ -78,37 +79,42 @@ void Time::start() {
     HAL_TIM_Base_Start_IT(low_precision_timer);
 
     if (global_timer != nullptr) {
-        if (timer32_by_timer32handler_map.find(global_timer) ==
-            timer32_by_timer32handler_map.end()) {
+        const int8_t index = get_timer32_index(global_timer);
+        if (index < 0) {
             ErrorHandler("Global Timer pointer is not valid");
             global_timer = nullptr;
         } else {
             hal_enable_timer(global_timer);
             Time::init_timer(
-                timer32_by_timer32handler_map[global_timer],
+                timer32_instance(index),
                 global_timer,
                 0,
                 HIGH_PRECISION_MAX_ARR,
-                timer32interrupt_by_timer32handler_map[global_timer]
+                timer32_interrupts[index]
             );
             HAL_TIM_Base_Start_IT(global_timer);
         }
     }
-    for (auto timer : high_precision_timers) {
-        if (timer32_by_timer32handler_map.find(timer) == timer32_by_timer32handler_map.end()) {
+    for (auto it = high_precision_timers.begin(); it != high_precision_timers.end();) {
+        TIM_HandleTypeDef* timer = *it;
+        const int8_t index = get_timer32_index(timer);
+        if (index < 0) {
             ErrorHandler("Global Timer pointer is not valid");
-            high_precision_timers.erase(timer);
-        } else {
-            hal_enable_timer(timer);
-            Time::init_timer(
-                timer32_by_timer32handler_map[timer],
-                timer,
-                0,
-                HIGH_PRECISION_MAX_ARR,
-                timer32interrupt_by_timer32handler_map[timer]
-            );
-            Time::available_high_precision_timers.push(timer);
+            it = high_precision_timers.erase(it);
+            continue;
         }
+        hal_enable_timer(timer);
+        Time::init_timer(
+            timer32_instance(index),
+            timer,
+            0,
+            HIGH_PRECISION_MAX_ARR,
+            timer32_interrupts[index]
+        );
+        high_precision_alarms[index].tim = timer;
+        high_precision_bitmap |= 1U << index;
+        available_high_precision_bitmap |= 1U << index;
+        ++it;
     }
 }
 
@@ -119,6 +125,18 @@ bool Time::is_valid_timer(TIM_HandleTypeDef* tim) {
     return false;
 }
 
+int8_t Time::get_timer32_index(TIM_HandleTypeDef* tim) {
+    if (tim == &htim2)
+        return 0;
+    if (tim == &htim5)
+        return 1;
+    if (tim == &htim23)
+        return 2;
+    if (tim == &htim24)
+        return 3;
+    return -1;
+}
+
 void Time::hal_enable_timer(TIM_HandleTypeDef* tim) {
     if (tim == &htim2) {
         __HAL_RCC_TIM2_CLK_ENABLE();
@@ -152,66 +170,55 @@ void Time::start_timer(TIM_HandleTypeDef* handle, uint32_t prescaler, uint32_t a
 
 void Time::stop_timer(TIM_HandleTypeDef* handle) { HAL_TIM_Base_Stop_IT(handle); }
 
-uint8_t Time::register_high_precision_alarm(uint32_t period_in_us, function<void()> func) {
-    if (available_high_precision_timers.size() == 0) {
-        ErrorHandler("There are no available high precision timers left");
-        return 0;
+uint8_t Time::check_alarm_id(uint8_t id, const char* kind) {
+    if (id == INVALID_ID) {
+        ErrorHandler("Cannot register %s as all its slots are already occupied", kind);
     }
+    return id;
+}
 
-    TIM_HandleTypeDef* tim = Time::available_high_precision_timers.top();
-    Time::available_high_precision_timers.pop();
-
-    Time::Alarm alarm = {.period = period_in_us, .tim = tim, .alarm = [&]() {}, .is_on = true};
-
-    for (auto timer : high_precision_timers) {
-        NVIC_DisableIRQ(timer32interrupt_by_timer32handler_map[timer]);
-    }
-    Time::high_precision_alarms_by_id[high_precision_ids] = alarm;
-    Time::high_precision_alarms_by_timer[tim] = alarm;
-
-    Time::ConfigTimer(tim, period_in_us);
-
-    alarm.alarm = func;
-    Time::high_precision_alarms_by_id[high_precision_ids] = alarm;
-    Time::high_precision_alarms_by_timer[tim] = alarm;
-    for (auto timer : high_precision_timers) {
-        NVIC_EnableIRQ(timer32interrupt_by_timer32handler_map[timer]);
+uint8_t Time::acquire_high_precision_timer() {
+    if (available_high_precision_bitmap == 0) {
+        ErrorHandler("There are no available high precision timers left");
+        return INVALID_ID;
     }
+    const uint8_t index = std::countr_zero(available_high_precision_bitmap);
+    available_high_precision_bitmap &= ~(1U << index);
+    NVIC_DisableIRQ(timer32_interrupts[index]);
+    return index;
+}
 
-    return high_precision_ids++;
+uint8_t Time::start_high_precision_alarm(uint8_t index, uint32_t period_in_us) {
+    Time::ConfigTimer(high_precision_alarms[index].tim, period_in_us);
+    NVIC_EnableIRQ(timer32_interrupts[index]);
+    return index;
 }
 
 bool Time::unregister_high_precision_alarm(uint8_t id) {
-    if (not Time::high_precision_alarms_by_id.contains(id)) {
+    if (id >= timer32_count || (high_precision_bitmap & ~available_high_precision_bitmap &
+                                (1U << id)) == 0) {
         return false;
     }
 
-    for (auto timer : high_precision_timers) {
-        NVIC_DisableIRQ(timer32interrupt_by_timer32handler_map[timer]);
-    }
-    Time::Alarm& alarm = high_precision_alarms_by_id[id];
-    Time::stop_timer(alarm.tim);
-    Time::available_high_precision_timers.push(alarm.tim);
-
-    Time::high_precision_alarms_by_timer.erase(alarm.tim);
-    Time::high_precision_alarms_by_id.erase(id);
-    for (auto timer : high_precision_timers) {
-        NVIC_EnableIRQ(timer32interrupt_by_timer32handler_map[timer]);
-    }
+    NVIC_DisableIRQ(timer32_interrupts[id]);
+    Time::stop_timer(high_precision_alarms[id].tim);
+    high_precision_alarms[id].alarm.reset();
+    available_high_precision_bitmap |= 1U << id;
+    NVIC_EnableIRQ(timer32_interrupts[id]);
 
     return true;
 }
 
-uint8_t Time::register_mid_precision_alarm(uint32_t period_in_us, function<void()> func) {
+bool Time::prepare_mid_precision_alarm() {
     if (mid_precision_timer == nullptr) {
         ErrorHandler("Cannot register mid precision alarm if no timer is used for mid "
                      "precision");
-        return 0;
+        return false;
     }
-    if (mid_precision_alarms_by_id.size() == std::numeric_limits<uint8_t>::max()) {
-        ErrorHandler("Cannot register mid precision alarm as all id's are already "
-                     "occupied");
-        return 0;
+    const int8_t index = get_timer32_index(mid_precision_timer);
+    if (index < 0) {
+        ErrorHandler("Mid precision timer pointer is not valid");
+        return false;
     }
     if (std::find_if(
             TimerPeripheral::timers.begin(),
@@ -222,137 +229,51 @@ uint8_t Time::register_mid_precision_alarm(uint32_t period_in_us, function<void(
         ) != TimerPeripheral::timers.end()) {
         ErrorHandler("a timer cannot be used as mid precision timer and PWM or Input "
                      "Capture Simultaneously");
-        return 0; // TODO: put this check in high precision timers and global
-                  // timer too
+        return false; // TODO: put this check in high precision timers and global
+                      // timer too
     }
 
-    Time::Alarm alarm = {
-        .period = period_in_us / Time::mid_precision_step_in_us,
-        .tim = Time::mid_precision_timer,
-        .alarm = [&]() {},
-        .offset = Time::mid_precision_tick,
-        .is_on = true
-    };
-
-    while (mid_precision_alarms_by_id.contains(mid_precision_ids))
-        mid_precision_ids++;
-
-    NVIC_DisableIRQ(timer32interrupt_by_timer32handler_map[mid_precision_timer]);
-    Time::mid_precision_alarms_by_id[mid_precision_ids] = alarm;
-
     if (not Time::mid_precision_registered) {
         hal_enable_timer(mid_precision_timer);
         Time::init_timer(
-            timer32_by_timer32handler_map[mid_precision_timer],
+            timer32_instance(index),
             Time::mid_precision_timer,
             275,
             Time::mid_precision_step_in_us,
-            timer32interrupt_by_timer32handler_map[mid_precision_timer]
+            timer32_interrupts[index]
         );
         Time::ConfigTimer(Time::mid_precision_timer, Time::mid_precision_step_in_us);
-        NVIC_DisableIRQ(timer32interrupt_by_timer32handler_map[mid_precision_timer]);
         Time::mid_precision_registered = true;
     }
-
-    alarm.alarm = func;
-    Time::mid_precision_alarms_by_id[mid_precision_ids] = alarm;
-    NVIC_EnableIRQ(timer32interrupt_by_timer32handler_map[mid_precision_timer]);
-
-    return mid_precision_ids;
-}
-
-bool Time::unregister_mid_precision_alarm(uint8_t id) {
-    if (not Time::mid_precision_alarms_by_id.contains(id)) {
-        return false;
-    }
-
-    NVIC_DisableIRQ(timer32interrupt_by_timer32handler_map[mid_precision_timer]);
-    Time::Alarm& alarm = Time::mid_precision_alarms_by_id[id];
-    alarm.is_on = false;
-    Time::mid_precision_erasable_ids.push(id);
-    NVIC_EnableIRQ(timer32interrupt_by_timer32handler_map[mid_precision_timer]);
-
     return true;
 }
 
-uint8_t Time::register_low_precision_alarm(uint32_t period_in_ms, function<void()> func) {
-    if (low_precision_alarms_by_id.size() == std::numeric_limits<uint8_t>::max()) {
-        ErrorHandler("Cannot register low precision alarm as all id's are already "
-                     "occupied");
-        return 0;
-    }
-    Time::Alarm alarm = {
-        .period = period_in_ms,
-        .tim = low_precision_timer,
-        .alarm = func,
-        .offset = low_precision_tick,
-        .is_on = true
-    };
-
-    while (low_precision_alarms_by_id.contains(low_precision_ids))
-        low_precision_ids++;
+void Time::disable_mid_precision_irq() {
+    NVIC_DisableIRQ(timer32_interrupts[get_timer32_index(mid_precision_timer)]);
+}
 
-    NVIC_DisableIRQ(TIM7_IRQn);
-    Time::low_precision_alarms_by_id[low_precision_ids] = alarm;
-    NVIC_EnableIRQ(TIM7_IRQn);
-    return low_precision_ids++;
+void Time::enable_mid_precision_irq() {
+    NVIC_EnableIRQ(timer32_interrupts[get_timer32_index(mid_precision_timer)]);
 }
 
-uint8_t Time::register_low_precision_alarm(uint32_t period_in_ms, void (*func)()) {
-    if (low_precision_alarms_by_id.size() == std::numeric_limits<uint8_t>::max()) {
-        ErrorHandler("Cannot register low precision alarm as all id's are already "
-                     "occupied");
-        return 0;
+bool Time::unregister_mid_precision_alarm(uint8_t id) {
+    if (mid_precision_timer == nullptr || get_timer32_index(mid_precision_timer) < 0) {
+        return false;
     }
-    Time::Alarm alarm = {
-        .period = period_in_ms,
-        .tim = low_precision_timer,
-        .alarm = func,
-        .offset = low_precision_tick,
-        .is_on = true
-    };
 
-    while (low_precision_alarms_by_id.contains(low_precision_ids))
-        low_precision_ids++;
+    disable_mid_precision_irq();
+    const bool removed = Time::mid_precision_alarms.remove(id);
+    enable_mid_precision_irq();
 
-    NVIC_DisableIRQ(TIM7_IRQn);
-    Time::low_precision_alarms_by_id[low_precision_ids] = alarm;
-    NVIC_EnableIRQ(TIM7_IRQn);
-    return low_precision_ids++;
+    return removed;
 }
 
 bool Time::unregister_low_precision_alarm(uint8_t id) {
-    if (not Time::low_precision_alarms_by_id.contains(id)) {
-        return false;
-    }
-
     NVIC_DisableIRQ(TIM7_IRQn);
-    Time::Alarm& alarm = Time::low_precision_alarms_by_id[id];
-    alarm.is_on = false;
-    Time::low_precision_erasable_ids.push(id);
+    const bool removed = Time::low_precision_alarms.remove(id);
     NVIC_EnableIRQ(TIM7_IRQn);
 
-    return true;
-}
-
-uint8_t Time::set_timeout(int milliseconds, function<void()> callback) {
-    if (low_precision_alarms_by_id.size() == std::numeric_limits<uint8_t>::max()) {
-        ErrorHandler("Cannot register timeout as all low precision alarms id's are "
-                     "already occupied");
-        return 255;
-    }
-    while (low_precision_alarms_by_id.contains(low_precision_ids))
-        low_precision_ids++;
-    uint8_t id = low_precision_ids;
-    uint64_t tick_on_register = low_precision_tick;
-    Time::register_low_precision_alarm(milliseconds, [&, id, callback, tick_on_register]() {
-        if (tick_on_register == low_precision_tick) {
-            return;
-        }
-        callback();
-        Time::unregister_low_precision_alarm(id);
-    });
-    return id;
+    return removed;
 }
 
 void Time::cancel_timeout(uint8_t id) {
@@ -365,40 +286,15 @@ void Time::cancel_timeout(uint8_t id) {
 void Time::global_timer_callback() { Time::global_tick += Time::HIGH_PRECISION_MAX_ARR; }
 
 void Time::high_precision_timer_callback(TIM_HandleTypeDef* tim) {
-    Time::high_precision_alarms_by_timer[tim].alarm();
-}
-
-void Time::mid_precision_timer_callback() {
-    for (pair<const uint8_t, Time::Alarm>& pair : Time::mid_precision_alarms_by_id) {
-        Time::Alarm& alarm = pair.second;
-        if (alarm.is_on == false || alarm.offset == Time::mid_precision_tick)
-            continue;
-        if ((Time::mid_precision_tick - alarm.offset) % alarm.period == 0) {
-            alarm.alarm();
-        }
-    }
-    Time::mid_precision_tick++;
-    while (not Time::mid_precision_erasable_ids.empty()) {
-        Time::mid_precision_alarms_by_id.erase(Time::mid_precision_erasable_ids.top());
-        Time::mid_precision_erasable_ids.pop();
+    const int8_t index = get_timer32_index(tim);
+    if (index >= 0 && high_precision_alarms[index].alarm) {
+        high_precision_alarms[index].alarm();
     }
 }
 
-void Time::low_precision_timer_callback() {
-    for (auto& pair : Time::low_precision_alarms_by_id) {
-        Time::Alarm& alarm = pair.second;
-        if (alarm.is_on == false || alarm.offset == Time::low_precision_tick)
-            continue;
-        if ((Time::low_precision_tick - alarm.offset) % alarm.period == 0) {
-            alarm.alarm();
-        }
-    }
-    low_precision_tick++;
-    while (not Time::low_precision_erasable_ids.empty()) {
-        Time::low_precision_alarms_by_id.erase(Time::low_precision_erasable_ids.top());
-        Time::low_precision_erasable_ids.pop();
-    }
-}
+void Time::mid_precision_timer_callback() { Time::mid_precision_alarms.on_tick(); }
+
+void Time::low_precision_timer_callback() { Time::low_precision_alarms.on_tick(); }
 
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* tim) {
     if (tim == Time::global_timer) {
@@ -409,7 +305,7 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* tim) {
         Time::low_precision_timer_callback();
     }
 
-    else if (Time::high_precision_timers.contains(tim)) {
+    else {
         Time::high_precision_timer_callback(tim);
     }
 }
@@ -1,13 +1,56 @@
 #include "MockedDrivers/NVIC.hpp"
 
+#include <array>
+#include <cstring>
+
 NVIC_Type __NVIC;
 NVIC_Type* NVIC = &__NVIC;
 
+namespace {
+
+constexpr uint32_t kIrqCount = sizeof(NVIC_Type::IP);
+/* Priority of thread mode, below every interrupt */
+constexpr uint32_t kThreadPriority = 0x100;
+
+std::array<uintptr_t, kIrqCount> vectors{};
+uint32_t execution_priority = kThreadPriority;
+uint32_t hold_depth = 0;
+
+bool valid(IRQn_Type IRQn) { return (int32_t)(IRQn) >= 0 && (uint32_t)IRQn < kIrqCount; }
+
+uint32_t word_of(IRQn_Type IRQn) { return ((uint32_t)IRQn) >> 5UL; }
+
+uint32_t bit_of(IRQn_Type IRQn) { return 1UL << (((uint32_t)IRQn) & 0x1FUL); }
+
+/* Highest priority interrupt ready to preempt the current execution priority, -1 if none */
+int32_t next_ready() {
+    int32_t best = -1;
+    uint32_t best_priority = execution_priority;
+    for (uint32_t word = 0; word < 8U; word++) {
+        uint32_t ready = NVIC->ISPR[word] & NVIC->ISER[word] & ~NVIC->IABR[word];
+        while (ready != 0U) {
+            const uint32_t irq = (word << 5U) + (uint32_t)__builtin_ctz(ready);
+            ready &= ready - 1U;
+            if (irq >= kIrqCount || vectors[irq] == 0U) {
+                continue;
+            }
+            if (NVIC->IP[irq] < best_priority) {
+                best_priority = NVIC->IP[irq];
+                best = (int32_t)irq;
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace
+
 void NVIC_EnableIRQ(IRQn_Type IRQn) {
     if ((int32_t)(IRQn) >= 0) {
         __COMPILER_BARRIER();
-        NVIC->ISER[(((uint32_t)IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)IRQn) & 0x1FUL));
+        NVIC->ISER[word_of(IRQn)] = NVIC->ISER[word_of(IRQn)] | bit_of(IRQn);
         __COMPILER_BARRIER();
+        ST_LIB::MockedHAL::nvic_dispatch_pending();
     }
 }
 
@@ -29,3 +72,79 @@ void NVIC_DisableIRQ(IRQn_Type IRQn) {
         __ISB();
     }
 }
+
+void NVIC_SetPendingIRQ(IRQn_Type IRQn) {
+    if (valid(IRQn)) {
+        NVIC->ISPR[word_of(IRQn)] = NVIC->ISPR[word_of(IRQn)] | bit_of(IRQn);
+        ST_LIB::MockedHAL::nvic_dispatch_pending();
+    }
+}
+
+uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn) {
+    return valid(IRQn) && (NVIC->ISPR[word_of(IRQn)] & bit_of(IRQn)) != 0U ? 1U : 0U;
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn) {
+    if (valid(IRQn)) {
+        NVIC->ISPR[word_of(IRQn)] = NVIC->ISPR[word_of(IRQn)] & ~bit_of(IRQn);
+    }
+}
+
+uint32_t NVIC_GetActive(IRQn_Type IRQn) {
+    return valid(IRQn) && (NVIC->IABR[word_of(IRQn)] & bit_of(IRQn)) != 0U ? 1U : 0U;
+}
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) {
+    if (valid(IRQn)) {
+        NVIC->IP[(uint32_t)IRQn] = (uint8_t)((priority << (8U - __NVIC_PRIO_BITS)) & 0xFFUL);
+    }
+}
+
+uint32_t NVIC_GetPriority(IRQn_Type IRQn) {
+    return valid(IRQn) ? ((uint32_t)NVIC->IP[(uint32_t)IRQn] >> (8U - __NVIC_PRIO_BITS)) : 0U;
+}
+
+void NVIC_SetVector(IRQn_Type IRQn, uintptr_t vector) {
+    if (valid(IRQn)) {
+        vectors[(uint32_t)IRQn] = vector;
+    }
+}
+
+uintptr_t NVIC_GetVector(IRQn_Type IRQn) { return valid(IRQn) ? vectors[(uint32_t)IRQn] : 0U; }
+
+namespace ST_LIB::MockedHAL {
+
+void nvic_reset() {
+    std::memset((void*)NVIC, 0, sizeof(NVIC_Type));
+    vectors.fill(0U);
+    execution_priority = kThreadPriority;
+    hold_depth = 0;
+}
+
+void nvic_dispatch_pending() {
+    if (hold_depth != 0U) {
+        return;
+    }
+    for (int32_t irq = next_ready(); irq >= 0; irq = next_ready()) {
+        const auto IRQn = (IRQn_Type)irq;
+        const uint32_t preempted = execution_priority;
+        NVIC_ClearPendingIRQ(IRQn);
+        NVIC->IABR[word_of(IRQn)] = NVIC->IABR[word_of(IRQn)] | bit_of(IRQn);
+        execution_priority = NVIC->IP[irq];
+
+        reinterpret_cast<void (*)(void)>(vectors[irq])();
+
+        execution_priority = preempted;
+        NVIC->IABR[word_of(IRQn)] = NVIC->IABR[word_of(IRQn)] & ~bit_of(IRQn);
+    }
+}
+
+void nvic_hold_dispatch() { hold_depth++; }
+
+void nvic_release_dispatch() {
+    if (hold_depth != 0U && --hold_depth == 0U) {
+        nvic_dispatch_pending();
+    }
+}
+
+} // namespace ST_LIB::MockedHAL
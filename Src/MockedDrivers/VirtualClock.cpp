@@ -0,0 +1,327 @@
+#include "MockedDrivers/VirtualClock.hpp"
+
+#include <array>
+#include <bit>
+
+namespace {
+
+using ST_LIB::MockedHAL::VirtualClock;
+
+constexpr uint32_t CR1_CEN = (1U << 0);  // Counter Enable
+constexpr uint32_t CR1_URS = (1U << 2);  // Update Request Source
+constexpr uint32_t CR1_ARPE = (1U << 7); // Auto-Reload Preload Enable
+constexpr uint32_t DIER_UIE = (1U << 0); // Update Interrupt Enable
+constexpr uint32_t SR_UIF = (1U << 0);   // Update Interrupt Flag
+constexpr uint32_t EGR_UG = (1U << 0);   // Update Generation
+
+constexpr uint64_t kNsPerSecond = 1'000'000'000ULL;
+
+struct Event {
+    uint64_t at_ns{0};
+    uint64_t sequence{0};
+    VirtualClock::event_t event{nullptr};
+    void* context{nullptr};
+    IRQn_Type irqn{0};
+};
+
+/* Kernel clock ticks are counted from base_ns, so the conversion to ns never drifts */
+struct Timer {
+    TIM_TypeDef* tim{nullptr};
+    uint64_t hz{0};
+    uint64_t base_ns{0};
+    uint64_t ticks{0};
+};
+
+std::array<Event, VirtualClock::kMaxEvents> events{};
+uint64_t used_events{0};
+uint64_t next_sequence{0};
+std::array<Timer, VirtualClock::kMaxTimers> timers{};
+uint32_t used_timers{0};
+uint64_t now{0};
+bool processing{false};
+
+uint64_t ticks_at(const Timer& timer, uint64_t at_ns) {
+    return static_cast<uint64_t>(
+        static_cast<unsigned __int128>(at_ns - timer.base_ns) * timer.hz / kNsPerSecond
+    );
+}
+
+/* First instant at which the kernel tick count reaches ticks */
+uint64_t time_of(const Timer& timer, uint64_t ticks) {
+    const unsigned __int128 scaled = static_cast<unsigned __int128>(ticks) * kNsPerSecond;
+    const unsigned __int128 at = (scaled + timer.hz - 1U) / timer.hz + timer.base_ns;
+    return at >= VirtualClock::NEVER ? VirtualClock::NEVER : static_cast<uint64_t>(at);
+}
+
+uint32_t counter_limit(const TIM_TypeDef& tim) {
+    return (tim.CR1 & CR1_ARPE) ? tim.active_ARR : tim.ARR.reg;
+}
+
+/* Kernel ticks until the prescaler first moves the counter, same rule as inc_cnt_and_check */
+uint64_t ticks_to_first_count(const TIM_TypeDef& tim) {
+    return tim.internal_psc_cnt >= tim.active_PSC ? 1U : tim.active_PSC - tim.internal_psc_cnt + 1U;
+}
+
+/* Kernel ticks until the next counter overflow, NEVER if the counter is stopped */
+uint64_t ticks_to_overflow(const TIM_TypeDef& tim) {
+    if (!(tim.CR1 & CR1_CEN)) {
+        return VirtualClock::NEVER;
+    }
+    const uint32_t limit = counter_limit(tim);
+    const uint64_t counts = tim.CNT.reg > limit ? 1U : uint64_t{limit} - tim.CNT.reg + 1U;
+    return ticks_to_first_count(tim) + (counts - 1U) * (uint64_t{tim.active_PSC} + 1U);
+}
+
+void raise_update(TIM_TypeDef& tim) {
+    if (tim.DIER & DIER_UIE) {
+        NVIC_SetPendingIRQ(tim.irq_n);
+    }
+}
+
+/* Runs ticks kernel ticks through a timer, never past its next overflow */
+void advance(Timer& timer, uint64_t ticks) {
+    TIM_TypeDef& tim = *timer.tim;
+    timer.ticks += ticks;
+    if (ticks == 0 || !(tim.CR1 & CR1_CEN)) {
+        return;
+    }
+
+    const uint64_t first = ticks_to_first_count(tim);
+    if (ticks < first) {
+        tim.internal_psc_cnt += static_cast<uint32_t>(ticks);
+        return;
+    }
+    const uint64_t period = uint64_t{tim.active_PSC} + 1U;
+    const uint64_t counts = 1U + (ticks - first) / period;
+    tim.internal_psc_cnt = static_cast<uint32_t>((ticks - first) % period);
+    tim.CNT = static_cast<uint32_t>(tim.CNT.reg + counts);
+
+    if (tim.CNT.reg > counter_limit(tim) && tim.rollover()) {
+        raise_update(tim);
+    }
+}
+
+/* UG written by firmware since the last look, served at the current instant */
+bool serve_update_generation() {
+    bool served = false;
+    for (uint32_t pending = used_timers; pending != 0U; pending &= pending - 1U) {
+        TIM_TypeDef& tim = *timers[std::countr_zero(pending)].tim;
+        if (!(tim.EGR & EGR_UG)) {
+            continue;
+        }
+        tim.EGR &= ~EGR_UG;
+        tim.generate_update();
+        if (!(tim.CR1 & CR1_URS)) {
+            tim.SR |= SR_UIF;
+            raise_update(tim);
+        }
+        served = true;
+    }
+    return served;
+}
+
+/* Serves UG until handlers stop writing it, all at the current instant */
+bool settle_update_generation() {
+    bool served = false;
+    for (;;) {
+        ST_LIB::MockedHAL::nvic_hold_dispatch();
+        const bool again = serve_update_generation();
+        ST_LIB::MockedHAL::nvic_release_dispatch();
+        if (!again) {
+            return served;
+        }
+        served = true;
+    }
+}
+
+/* Earliest due event, ties in scheduling order, -1 if none is due at at_ns */
+int next_due(uint64_t at_ns) {
+    int best = -1;
+    for (uint64_t pending = used_events; pending != 0U; pending &= pending - 1U) {
+        const int id = std::countr_zero(pending);
+        const Event& e = events[id];
+        if (e.at_ns > at_ns) {
+            continue;
+        }
+        if (best < 0 || e.at_ns < events[best].at_ns ||
+            (e.at_ns == events[best].at_ns && e.sequence < events[best].sequence)) {
+            best = id;
+        }
+    }
+    return best;
+}
+
+void process_instant(uint64_t at_ns) {
+    processing = true;
+    ST_LIB::MockedHAL::nvic_hold_dispatch();
+
+    for (uint32_t pending = used_timers; pending != 0U; pending &= pending - 1U) {
+        Timer& timer = timers[std::countr_zero(pending)];
+        advance(timer, ticks_at(timer, at_ns) - timer.ticks);
+    }
+    now = at_ns;
+
+    for (int id = next_due(at_ns); id >= 0; id = next_due(at_ns)) {
+        const Event e = events[id];
+        used_events &= ~(1ULL << id);
+        if (e.event != nullptr) {
+            e.event(e.context);
+        } else {
+            NVIC_SetPendingIRQ(e.irqn);
+        }
+    }
+
+    ST_LIB::MockedHAL::nvic_release_dispatch();
+    /* Handlers reprogramming a timer with UG raise another update at the same instant */
+    settle_update_generation();
+    processing = false;
+}
+
+uint8_t add_event(uint64_t at_ns, VirtualClock::event_t event, void* context, IRQn_Type irqn) {
+    const uint64_t free_events = ~used_events;
+    if (free_events == 0U) {
+        return VirtualClock::INVALID_ID;
+    }
+    const auto id = static_cast<uint8_t>(std::countr_zero(free_events));
+    events[id] = {
+        .at_ns = at_ns < now ? now : at_ns,
+        .sequence = next_sequence++,
+        .event = event,
+        .context = context,
+        .irqn = irqn,
+    };
+    used_events |= 1ULL << id;
+    return id;
+}
+
+} // namespace
+
+namespace ST_LIB::MockedHAL {
+
+static_assert(VirtualClock::kMaxEvents == 64, "event slots are tracked in a uint64_t bitmap");
+static_assert(VirtualClock::kMaxTimers <= 32, "timer slots are tracked in a uint32_t bitmap");
+
+void VirtualClock::reset() {
+    used_events = 0;
+    next_sequence = 0;
+    used_timers = 0;
+    now = 0;
+    processing = false;
+}
+
+uint64_t VirtualClock::now_ns() { return now; }
+
+uint8_t VirtualClock::schedule_at(uint64_t at_ns, event_t event, void* context) {
+    if (event == nullptr) {
+        return INVALID_ID;
+    }
+    return add_event(at_ns, event, context, 0);
+}
+
+uint8_t VirtualClock::schedule_in(uint64_t delay_ns, event_t event, void* context) {
+    return schedule_at(now + delay_ns, event, context);
+}
+
+uint8_t VirtualClock::schedule_irq_at(uint64_t at_ns, IRQn_Type irqn) {
+    return add_event(at_ns, nullptr, nullptr, irqn);
+}
+
+bool VirtualClock::cancel(uint8_t id) {
+    if (id >= kMaxEvents || (used_events & (1ULL << id)) == 0U) {
+        return false;
+    }
+    used_events &= ~(1ULL << id);
+    return true;
+}
+
+bool VirtualClock::attach_timer(TIM_TypeDef* tim, uint32_t kernel_clock_hz) {
+    if (tim == nullptr || kernel_clock_hz == 0) {
+        return false;
+    }
+    detach_timer(tim);
+    const uint32_t free_timers = ~used_timers & ((1ULL << kMaxTimers) - 1U);
+    if (free_timers == 0U) {
+        return false;
+    }
+    const int id = std::countr_zero(free_timers);
+    timers[id] = {.tim = tim, .hz = kernel_clock_hz, .base_ns = now, .ticks = 0};
+    used_timers |= 1U << id;
+    if (NVIC_GetVector(tim->irq_n) == 0U) {
+        NVIC_SetVector(tim->irq_n, reinterpret_cast<uintptr_t>(tim->callback));
+    }
+    return true;
+}
+
+void VirtualClock::detach_timer(TIM_TypeDef* tim) {
+    for (uint32_t pending = used_timers; pending != 0U; pending &= pending - 1U) {
+        const int id = std::countr_zero(pending);
+        if (timers[id].tim == tim) {
+            used_timers &= ~(1U << id);
+        }
+    }
+}
+
+uint64_t VirtualClock::next_event_ns() {
+    uint64_t next = NEVER;
+    for (uint64_t pending = used_events; pending != 0U; pending &= pending - 1U) {
+        const Event& e = events[std::countr_zero(pending)];
+        if (e.at_ns < next) {
+            next = e.at_ns;
+        }
+    }
+    for (uint32_t pending = used_timers; pending != 0U; pending &= pending - 1U) {
+        const Timer& timer = timers[std::countr_zero(pending)];
+        const uint64_t ticks = ticks_to_overflow(*timer.tim);
+        if (ticks == NEVER) {
+            continue;
+        }
+        const uint64_t at = time_of(timer, timer.ticks + ticks);
+        if (at < next) {
+            next = at;
+        }
+    }
+    return next;
+}
+
+bool VirtualClock::step(uint64_t limit_ns) {
+    if (processing) {
+        return false;
+    }
+    /* UG written by the main loop since the last step */
+    processing = true;
+    const bool served = settle_update_generation();
+    processing = false;
+    if (served) {
+        return true;
+    }
+
+    const uint64_t next = next_event_ns();
+    if (next == NEVER || next > limit_ns) {
+        if (limit_ns != NEVER && limit_ns > now) {
+            processing = true;
+            for (uint32_t pending = used_timers; pending != 0U; pending &= pending - 1U) {
+                Timer& timer = timers[std::countr_zero(pending)];
+                advance(timer, ticks_at(timer, limit_ns) - timer.ticks);
+            }
+            now = limit_ns;
+            processing = false;
+        }
+        return false;
+    }
+    process_instant(next);
+    return true;
+}
+
+std::size_t VirtualClock::run_until(uint64_t at_ns) {
+    std::size_t instants = 0;
+    while (step(at_ns)) {
+        instants++;
+    }
+    return instants;
+}
+
+std::size_t VirtualClock::run_for(uint64_t duration_ns) { return run_until(now + duration_ns); }
+
+bool VirtualClock::busy() { return processing; }
+
+} // namespace ST_LIB::MockedHAL
@@ -0,0 +1,7 @@
+#include "MockedDrivers/core_cm7.h"
+
+static DWT_Type DWT_struct;
+static CoreDebug_Type CoreDebug_struct;
+
+DWT_Type* DWT = &DWT_struct;
+CoreDebug_Type* CoreDebug = &CoreDebug_struct;
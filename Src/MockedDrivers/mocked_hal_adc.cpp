@@ -1,8 +1,11 @@
 #include "MockedDrivers/mocked_hal_adc.hpp"
 
 #include <array>
+#include <cstdint>
 #include <unordered_map>
 
+#include "MockedDrivers/VirtualClock.hpp"
+
 ADC_HandleTypeDef hadc1{};
 ADC_HandleTypeDef hadc2{};
 ADC_HandleTypeDef hadc3{};
@@ -15,6 +18,13 @@ struct ADCPeripheralState {
     bool running = false;
     bool conversion_ready = false;
     bool force_poll_timeout = false;
+    /* Started with HAL_ADC_Start_IT, the end of conversion pends the ADC interrupt */
+    bool eoc_interrupt = false;
+    /* A conversion is on the VirtualClock, ending at conversion_end_ns */
+    bool converting = false;
+    uint64_t conversion_time_ns = 0;
+    uint64_t conversion_end_ns = 0;
+    ADC_HandleTypeDef* handle = nullptr;
     uint32_t active_channel = ADC_CHANNEL_0;
     uint32_t last_raw = 0;
     std::unordered_map<uint32_t, uint32_t> channel_raw_values{};
@@ -30,13 +40,33 @@ static std::array<ADC_TypeDef*, kAdcCount> adc_instances{ADC1, ADC2};
 
 static std::array<ADCPeripheralState, kAdcCount> adc_states{};
 
-static ADCPeripheralState& state_for(ADC_TypeDef* instance) {
+/*
+ * Bumped on every conversion started, never reset. The end of conversion event carries the
+ * value it was scheduled with, so one left on the clock by a stopped or reset ADC does nothing.
+ */
+static std::array<uint32_t, kAdcCount> conversion_seqs{};
+
+static std::size_t index_for(ADC_TypeDef* instance) {
     for (std::size_t i = 0; i < kAdcCount; ++i) {
         if (adc_instances[i] == instance) {
-            return adc_states[i];
+            return i;
         }
     }
-    return adc_states[0];
+    return 0;
+}
+
+static ADCPeripheralState& state_for(ADC_TypeDef* instance) {
+    return adc_states[index_for(instance)];
+}
+
+static IRQn_Type irq_for(std::size_t index) {
+#if STLIB_HAS_ADC3
+    if (index == 2) {
+        return ADC3_IRQn;
+    }
+#endif
+    (void)index;
+    return ADC_IRQn;
 }
 
 static uint32_t resolution_mask(uint32_t resolution) {
@@ -56,13 +86,65 @@ static uint32_t resolution_mask(uint32_t resolution) {
     }
 }
 
+static void latch_conversion(ADCPeripheralState& state, ADC_HandleTypeDef* hadc) {
+    const auto it = state.channel_raw_values.find(state.active_channel);
+    const uint32_t raw = (it == state.channel_raw_values.end()) ? 0U : it->second;
+    state.last_raw = raw & resolution_mask(hadc->Init.Resolution);
+    state.conversion_ready = true;
+    hadc->State &= ~HAL_ADC_STATE_TIMEOUT;
+    hadc->State |= HAL_ADC_STATE_REG_EOC;
+}
+
+static void cancel_conversion(std::size_t index) {
+    adc_states[index].converting = false;
+    conversion_seqs[index]++;
+}
+
+static void end_of_conversion(void* context);
+
+static void start_conversion(std::size_t index) {
+    auto& state = adc_states[index];
+    const uint32_t seq = ++conversion_seqs[index];
+    state.converting = true;
+    state.conversion_end_ns =
+        ST_LIB::MockedHAL::VirtualClock::now_ns() + state.conversion_time_ns;
+    const uintptr_t context = (static_cast<uintptr_t>(seq) << 2) | index;
+    ST_LIB::MockedHAL::VirtualClock::schedule_at(
+        state.conversion_end_ns,
+        end_of_conversion,
+        reinterpret_cast<void*>(context)
+    );
+}
+
+static void end_of_conversion(void* context) {
+    const uintptr_t value = reinterpret_cast<uintptr_t>(context);
+    const std::size_t index = value & 0x3U;
+    auto& state = adc_states[index];
+    if (!state.converting || static_cast<uint32_t>(value >> 2) != conversion_seqs[index]) {
+        return;
+    }
+    state.converting = false;
+    latch_conversion(state, state.handle);
+    if (!state.eoc_interrupt) {
+        return;
+    }
+    NVIC_SetPendingIRQ(irq_for(index));
+    if (state.handle->Init.ContinuousConvMode != DISABLE) {
+        start_conversion(index);
+    } else {
+        state.running = false;
+        state.handle->State &= ~HAL_ADC_STATE_REG_BUSY;
+    }
+}
+
 } // namespace
 
 namespace ST_LIB::MockedHAL {
 
 void adc_reset() {
-    for (auto& state : adc_states) {
-        state = {};
+    for (std::size_t i = 0; i < kAdcCount; ++i) {
+        adc_states[i] = {};
+        cancel_conversion(i);
     }
 }
 
@@ -75,6 +157,10 @@ void adc_set_poll_timeout(ADC_TypeDef* adc, bool enabled) {
     state_for(adc).force_poll_timeout = enabled;
 }
 
+void adc_set_conversion_time_ns(ADC_TypeDef* adc, uint64_t conversion_time_ns) {
+    state_for(adc).conversion_time_ns = conversion_time_ns;
+}
+
 uint32_t adc_get_last_channel(ADC_TypeDef* adc) { return state_for(adc).active_channel; }
 
 bool adc_is_running(ADC_TypeDef* adc) { return state_for(adc).running; }
@@ -103,8 +189,9 @@ extern "C" HAL_StatusTypeDef HAL_ADC_DeInit(ADC_HandleTypeDef* hadc) {
         return HAL_ERROR;
     }
 
-    auto& state = state_for(hadc->Instance);
-    state = {};
+    const std::size_t index = index_for(hadc->Instance);
+    adc_states[index] = {};
+    cancel_conversion(index);
     hadc->State = HAL_ADC_STATE_RESET;
     hadc->ErrorCode = HAL_ADC_ERROR_NONE;
     return HAL_OK;
@@ -127,12 +214,13 @@ HAL_ADC_ConfigChannel(ADC_HandleTypeDef* hadc, ADC_ChannelConfTypeDef* sConfig)
     return HAL_OK;
 }
 
-extern "C" HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef* hadc) {
+static HAL_StatusTypeDef start(ADC_HandleTypeDef* hadc, bool eoc_interrupt) {
     if (hadc == nullptr || hadc->Instance == nullptr) {
         return HAL_ERROR;
     }
 
-    auto& state = state_for(hadc->Instance);
+    const std::size_t index = index_for(hadc->Instance);
+    auto& state = adc_states[index];
     if (!state.initialized || !state.configured) {
         return HAL_ERROR;
     }
@@ -142,12 +230,23 @@ extern "C" HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef* hadc) {
 
     state.running = true;
     state.conversion_ready = false;
+    state.eoc_interrupt = eoc_interrupt;
+    state.handle = hadc;
     hadc->State |= HAL_ADC_STATE_REG_BUSY;
     hadc->State &= ~HAL_ADC_STATE_REG_EOC;
     hadc->ErrorCode = HAL_ADC_ERROR_NONE;
+    if (eoc_interrupt || state.conversion_time_ns != 0) {
+        start_conversion(index);
+    }
     return HAL_OK;
 }
 
+extern "C" HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef* hadc) { return start(hadc, false); }
+
+extern "C" HAL_StatusTypeDef HAL_ADC_Start_IT(ADC_HandleTypeDef* hadc) {
+    return start(hadc, true);
+}
+
 extern "C" HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef* hadc, uint32_t Timeout) {
     (void)Timeout;
 
@@ -155,7 +254,8 @@ extern "C" HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef* hadc,
         return HAL_ERROR;
     }
 
-    auto& state = state_for(hadc->Instance);
+    const std::size_t index = index_for(hadc->Instance);
+    auto& state = adc_states[index];
     if (!state.running) {
         return HAL_ERROR;
     }
@@ -165,13 +265,20 @@ extern "C" HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef* hadc,
         return HAL_TIMEOUT;
     }
 
-    const auto it = state.channel_raw_values.find(state.active_channel);
-    const uint32_t raw = (it == state.channel_raw_values.end()) ? 0U : it->second;
-    state.last_raw = raw & resolution_mask(hadc->Init.Resolution);
-    state.conversion_ready = true;
-
-    hadc->State &= ~HAL_ADC_STATE_TIMEOUT;
-    hadc->State |= HAL_ADC_STATE_REG_EOC;
+    // The clock can't move from a handler, the conversion is immediate there
+    if (state.conversion_time_ns == 0 || ST_LIB::MockedHAL::VirtualClock::busy()) {
+        cancel_conversion(index);
+        latch_conversion(state, hadc);
+    } else {
+        // Converting continuously, a result already read is followed by a new conversion
+        if (!state.converting && !state.conversion_ready) {
+            start_conversion(index);
+        }
+        if (state.converting) {
+            ST_LIB::MockedHAL::VirtualClock::run_until(state.conversion_end_ns);
+        }
+    }
+    state.conversion_ready = false;
     return HAL_OK;
 }
 
@@ -188,15 +295,33 @@ extern "C" HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef* hadc) {
         return HAL_ERROR;
     }
 
-    auto& state = state_for(hadc->Instance);
+    const std::size_t index = index_for(hadc->Instance);
+    auto& state = adc_states[index];
     state.running = false;
     state.conversion_ready = false;
+    cancel_conversion(index);
 
     hadc->State &= ~HAL_ADC_STATE_REG_BUSY;
     hadc->State &= ~HAL_ADC_STATE_REG_EOC;
     return HAL_OK;
 }
 
+extern "C" void HAL_ADC_IRQHandler(ADC_HandleTypeDef* hadc) {
+    if (hadc == nullptr || hadc->Instance == nullptr) {
+        return;
+    }
+    auto& state = state_for(hadc->Instance);
+    if (state.eoc_interrupt && state.conversion_ready) {
+        state.conversion_ready = false;
+        HAL_ADC_ConvCpltCallback(hadc);
+    }
+}
+
+// Same as the real HAL, the completion callback is weak
+extern "C" __attribute__((weak)) void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc) {
+    (void)hadc;
+}
+
 extern "C" uint32_t HAL_ADC_GetState(const ADC_HandleTypeDef* hadc) {
     if (hadc == nullptr) {
         return HAL_ADC_STATE_RESET;
@@ -2,8 +2,12 @@
 
 #include <array>
 
+#include "MockedDrivers/VirtualClock.hpp"
+
 namespace {
 
+constexpr std::size_t kStreamCount = 16;
+
 struct DMAState {
     HAL_StatusTypeDef init_status = HAL_OK;
     HAL_StatusTypeDef start_status = HAL_OK;
@@ -14,10 +18,40 @@ struct DMAState {
     uint32_t last_start_src = 0;
     uint32_t last_start_dst = 0;
     uint32_t last_start_length = 0;
+    uint64_t transfer_time_ns = 0;
+    std::array<bool, kStreamCount> transfer_complete{};
 };
 
 DMAState g_state{};
 
+constexpr std::array<IRQn_Type, kStreamCount> stream_irqs{
+    DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+    DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn,
+    DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+    DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn,
+};
+
+int stream_index(const DMA_Stream_TypeDef* stream) {
+    const std::array<DMA_Stream_TypeDef*, kStreamCount> streams{
+        DMA1_Stream0, DMA1_Stream1, DMA1_Stream2, DMA1_Stream3,
+        DMA1_Stream4, DMA1_Stream5, DMA1_Stream6, DMA1_Stream7,
+        DMA2_Stream0, DMA2_Stream1, DMA2_Stream2, DMA2_Stream3,
+        DMA2_Stream4, DMA2_Stream5, DMA2_Stream6, DMA2_Stream7,
+    };
+    for (std::size_t i = 0; i < kStreamCount; i++) {
+        if (streams[i] == stream) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void complete_transfer(void* context) {
+    const int stream = stream_index(static_cast<DMA_HandleTypeDef*>(context)->Instance);
+    g_state.transfer_complete[stream] = true;
+    NVIC_SetPendingIRQ(stream_irqs[stream]);
+}
+
 } // namespace
 
 namespace ST_LIB::MockedHAL {
@@ -44,6 +78,10 @@ uint32_t dma_get_last_start_dst() { return g_state.last_start_dst; }
 
 uint32_t dma_get_last_start_length() { return g_state.last_start_length; }
 
+void dma_set_transfer_time_ns(uint64_t transfer_time_ns) {
+    g_state.transfer_time_ns = transfer_time_ns;
+}
+
 } // namespace ST_LIB::MockedHAL
 
 extern "C" HAL_StatusTypeDef MockedHAL_DMA_Init_Impl(DMA_HandleTypeDef* hdma) {
@@ -69,10 +107,28 @@ extern "C" HAL_StatusTypeDef MockedHAL_DMA_Start_IT_Impl(
     if (hdma == nullptr) {
         return HAL_ERROR;
     }
+    if (g_state.start_status == HAL_OK && g_state.transfer_time_ns != 0 &&
+        stream_index(hdma->Instance) >= 0) {
+        ST_LIB::MockedHAL::VirtualClock::schedule_in(
+            g_state.transfer_time_ns,
+            complete_transfer,
+            hdma
+        );
+    }
     return g_state.start_status;
 }
 
 extern "C" void MockedHAL_DMA_IRQHandler_Impl(DMA_HandleTypeDef* hdma) {
     g_state.calls[static_cast<std::size_t>(ST_LIB::MockedHAL::DMAOperation::IRQHandler)]++;
     g_state.last_irq_handle = hdma;
+    if (hdma == nullptr) {
+        return;
+    }
+    const int stream = stream_index(hdma->Instance);
+    if (stream >= 0 && g_state.transfer_complete[stream]) {
+        g_state.transfer_complete[stream] = false;
+        if (hdma->XferCpltCallback != nullptr) {
+            hdma->XferCpltCallback(hdma);
+        }
+    }
 }
@@ -1,8 +1,12 @@
 #include "MockedDrivers/mocked_hal_spi.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <vector>
 
+#include "MockedDrivers/VirtualClock.hpp"
+
 namespace {
 
 struct SPIState {
@@ -11,12 +15,28 @@ struct SPIState {
     std::array<std::size_t, 9> calls{};
     std::vector<uint8_t> rx_pattern{};
     std::vector<uint8_t> last_tx{};
+    const uint8_t* last_tx_source = nullptr;
     std::size_t last_size_words = 0;
     SPI_HandleTypeDef* last_handle = nullptr;
+
+    uint32_t bit_rate = 1'000'000;
+    bool dma_pending = false;
+    uint32_t pending_seq = 0;
+    uint64_t pending_end_ns = 0;
+    ST_LIB::MockedHAL::SPIOperation pending_op = ST_LIB::MockedHAL::SPIOperation::TransmitDMA;
+    SPI_HandleTypeDef* pending_handle = nullptr;
+    std::size_t pending_bytes = 0;
+    ST_LIB::MockedHAL::SPIBusStats stats{};
 };
 
 SPIState g_state{};
 
+/*
+ * Bumped on every transfer started, never reset. The completion event carries the value it was
+ * scheduled with, so one left on the clock by spi_reset() does nothing.
+ */
+uint32_t g_transfer_seq = 0;
+
 void fill_rx(uint8_t* dst, std::size_t size_bytes) {
     if (dst == nullptr || size_bytes == 0) {
         return;
@@ -34,6 +54,7 @@ void fill_rx(uint8_t* dst, std::size_t size_bytes) {
 
 void store_tx(uint8_t* src, std::size_t size_bytes) {
     g_state.last_tx.assign(size_bytes, 0);
+    g_state.last_tx_source = src;
     if (src == nullptr || size_bytes == 0) {
         return;
     }
@@ -63,6 +84,65 @@ HAL_StatusTypeDef take_status() {
     return g_state.next_status;
 }
 
+void complete_transfer(void* context) {
+    const auto seq = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(context));
+    if (!g_state.dma_pending || seq != g_state.pending_seq) {
+        return;
+    }
+    g_state.dma_pending = false;
+
+    auto& stats = g_state.stats;
+    stats.transfers++;
+    stats.bytes += g_state.pending_bytes;
+    stats.last_end_ns = g_state.pending_end_ns;
+
+    SPI_HandleTypeDef* hspi = g_state.pending_handle;
+    switch (g_state.pending_op) {
+    case ST_LIB::MockedHAL::SPIOperation::TransmitDMA:
+        HAL_SPI_TxCpltCallback(hspi);
+        break;
+    case ST_LIB::MockedHAL::SPIOperation::ReceiveDMA:
+        HAL_SPI_RxCpltCallback(hspi);
+        break;
+    default:
+        HAL_SPI_TxRxCpltCallback(hspi);
+        break;
+    }
+}
+
+void start_dma(
+    SPI_HandleTypeDef* hspi,
+    ST_LIB::MockedHAL::SPIOperation op,
+    std::size_t size_bytes,
+    HAL_StatusTypeDef status
+) {
+    if (status != HAL_OK) {
+        return;
+    }
+    using ST_LIB::MockedHAL::VirtualClock;
+    const uint64_t now = VirtualClock::now_ns();
+    auto& stats = g_state.stats;
+    if (stats.transfers == 0) {
+        stats.first_start_ns = now;
+    } else {
+        const uint64_t gap = now - stats.last_end_ns;
+        stats.total_gap_ns += gap;
+        stats.max_gap_ns = std::max(stats.max_gap_ns, gap);
+    }
+    g_state.dma_pending = true;
+    g_state.pending_op = op;
+    g_state.pending_handle = hspi;
+    g_state.pending_bytes = size_bytes;
+    g_state.pending_seq = ++g_transfer_seq;
+    g_state.pending_end_ns =
+        now + static_cast<uint64_t>(size_bytes) * 8U * 1'000'000'000ULL / g_state.bit_rate;
+    VirtualClock::schedule_at(
+        g_state.pending_end_ns,
+        complete_transfer,
+        reinterpret_cast<void*>(static_cast<uintptr_t>(g_state.pending_seq))
+    );
+}
+
 } // namespace
 
 namespace ST_LIB::MockedHAL {
@@ -87,8 +167,49 @@ const uint8_t* spi_get_last_tx_data() { return g_state.last_tx.data(); }
 
 std::size_t spi_get_last_tx_size_bytes() { return g_state.last_tx.size(); }
 
+const uint8_t* spi_get_last_tx_source() { return g_state.last_tx_source; }
+
 SPI_HandleTypeDef* spi_get_last_handle() { return g_state.last_handle; }
 
+void spi_set_bit_rate(uint32_t bits_per_second) { g_state.bit_rate = bits_per_second; }
+
+bool spi_dma_pending() { return g_state.dma_pending; }
+
+bool spi_complete_dma() {
+    if (!g_state.dma_pending || VirtualClock::busy()) {
+        return false;
+    }
+    VirtualClock::run_until(g_state.pending_end_ns);
+    return true;
+}
+
+std::size_t spi_run_dma_until_idle(std::size_t max_transfers) {
+    std::size_t completed = 0;
+    while (completed < max_transfers && spi_complete_dma()) {
+        completed++;
+    }
+    return completed;
+}
+
+const SPIBusStats& spi_get_bus_stats() { return g_state.stats; }
+
+double spi_get_sustained_throughput_bytes_per_s() {
+    const auto& stats = g_state.stats;
+    if (stats.transfers == 0 || stats.last_end_ns <= stats.first_start_ns) {
+        return 0.0;
+    }
+    return static_cast<double>(stats.bytes) * 1e9 /
+           static_cast<double>(stats.last_end_ns - stats.first_start_ns);
+}
+
+double spi_get_mean_gap_ns() {
+    const auto& stats = g_state.stats;
+    if (stats.transfers < 2) {
+        return 0.0;
+    }
+    return static_cast<double>(stats.total_gap_ns) / static_cast<double>(stats.transfers - 1);
+}
+
 } // namespace ST_LIB::MockedHAL
 
 extern "C" HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef* hspi) {
@@ -165,7 +286,14 @@ HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size) {
     g_state.last_handle = hspi;
     g_state.last_size_words = Size;
     store_tx(pData, static_cast<std::size_t>(Size) * frame_bytes(hspi));
-    return take_status();
+    const auto status = take_status();
+    start_dma(
+        hspi,
+        ST_LIB::MockedHAL::SPIOperation::TransmitDMA,
+        static_cast<std::size_t>(Size) * frame_bytes(hspi),
+        status
+    );
+    return status;
 }
 
 extern "C" HAL_StatusTypeDef
@@ -174,7 +302,14 @@ HAL_SPI_Receive_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size) {
     g_state.last_handle = hspi;
     g_state.last_size_words = Size;
     fill_rx(pData, static_cast<std::size_t>(Size) * frame_bytes(hspi));
-    return take_status();
+    const auto status = take_status();
+    start_dma(
+        hspi,
+        ST_LIB::MockedHAL::SPIOperation::ReceiveDMA,
+        static_cast<std::size_t>(Size) * frame_bytes(hspi),
+        status
+    );
+    return status;
 }
 
 extern "C" HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(
@@ -189,10 +324,23 @@ extern "C" HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(
     const auto size_bytes = static_cast<std::size_t>(Size) * frame_bytes(hspi);
     store_tx(pTxData, size_bytes);
     fill_rx(pRxData, size_bytes);
-    return take_status();
+    const auto status = take_status();
+    start_dma(hspi, ST_LIB::MockedHAL::SPIOperation::TransmitReceiveDMA, size_bytes, status);
+    return status;
 }
 
 extern "C" void HAL_SPI_IRQHandler(SPI_HandleTypeDef* hspi) {
     g_state.calls[static_cast<std::size_t>(ST_LIB::MockedHAL::SPIOperation::IRQHandler)]++;
     g_state.last_handle = hspi;
 }
+
+// Same as the real HAL, the completion callbacks are weak so the mock links without SPI2.cpp
+extern "C" __attribute__((weak)) void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi) {
+    (void)hspi;
+}
+extern "C" __attribute__((weak)) void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi) {
+    (void)hspi;
+}
+extern "C" __attribute__((weak)) void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi) {
+    (void)hspi;
+}
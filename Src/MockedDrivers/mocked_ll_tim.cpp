@@ -44,13 +44,42 @@ void TIM_TypeDef::generate_update() {
     *((uint32_t*)&CNT) = 0; // Usually UEV also resets CNT unless configured otherwise
     SR &= ~(1U << 0);       // Clear UIF if needed, or set it depending on CR1
 }
-void simulate_ticks(TIM_TypeDef* tim) {
-
-    // Bit definitions for clarity
+bool TIM_TypeDef::rollover() {
     const uint32_t CR1_UDIS = (1U << 1); // Update Disable
-    const uint32_t CR1_ARPE = (1U << 7); // Auto-Reload Preload Enable
     const uint32_t SR_UIF = (1U << 0);   // Update Interrupt Flag
 
+    CNT = 0; // Rollover main counter
+
+    // 4. Repetition Counter & Update Event Logic
+    // The Update Event (UEV) is generated when the Repetition Counter underflows.
+    if (internal_rcr_cnt != 0) {
+        // No UEV yet, just decrement Repetition Counter
+        internal_rcr_cnt--;
+        return false;
+    }
+
+    // --- GENERATE UPDATE EVENT (UEV) ---
+
+    // A. Update Shadow Registers from Preload Registers
+    active_PSC = PSC;
+    active_ARR = ARR;
+    active_RCR = RCR;
+
+    // B. Reload Repetition Counter with new value
+    internal_rcr_cnt = active_RCR;
+
+    // C. Set Update Interrupt Flag (UIF)
+    // Only if UDIS (Update Disable) is NOT set
+    if (CR1 & CR1_UDIS) {
+        return false;
+    }
+    SR |= SR_UIF;
+    return true;
+}
+
+void simulate_ticks(TIM_TypeDef* tim) {
+    const uint32_t CR1_ARPE = (1U << 7); // Auto-Reload Preload Enable
+
     // Determine the current Auto-Reload limit.
     // If ARPE is set, use the buffered (shadow) value.
     // If ARPE is clear, use the immediate register value.
@@ -59,34 +88,8 @@ void simulate_ticks(TIM_TypeDef* tim) {
     // Check for Overflow
     if (tim->CNT > current_limit) {
         printf("timer overflow\n");
-        tim->CNT = 0; // Rollover main counter
-
-        // 4. Repetition Counter & Update Event Logic
-        // The Update Event (UEV) is generated when the Repetition Counter underflows.
-        if (tim->internal_rcr_cnt == 0) {
-
-            // --- GENERATE UPDATE EVENT (UEV) ---
-
-            // A. Update Shadow Registers from Preload Registers
-            tim->active_PSC = tim->PSC;
-            tim->active_ARR = tim->ARR;
-            tim->active_RCR = tim->RCR;
-
-            // B. Set Update Interrupt Flag (UIF)
-            // Only if UDIS (Update Disable) is NOT set
-            if (!(tim->CR1 & CR1_UDIS)) {
-                tim->SR |= SR_UIF;
-                if (NVIC_GetEnableIRQ(tim->irq_n)) {
-                    tim->callback();
-                }
-            }
-
-            // C. Reload Repetition Counter with new value
-            tim->internal_rcr_cnt = tim->active_RCR;
-
-        } else {
-            // No UEV yet, just decrement Repetition Counter
-            tim->internal_rcr_cnt--;
+        if (tim->rollover() && NVIC_GetEnableIRQ(tim->irq_n)) {
+            tim->callback();
         }
     }
 }
@@ -1,5 +1,7 @@
 #include "ST-LIB.hpp"
 
+#include "C++Utilities/HeapGuard.hpp"
+
 #ifdef STLIB_ETH
 
 // Con Ethernet: interfaz con MAC/IP + overload con strings
@@ -13,6 +15,9 @@ void STLIB::start(
     HALAL::start(mac, ip, subnet_mask, gateway, printf_peripheral);
     STLIB_LOW::start();
     STLIB_HIGH::start();
+#ifdef STLIB_HEAP_GUARD
+    HeapGuard::lock();
+#endif
 }
 
 void STLIB::start(
@@ -31,6 +36,9 @@ void STLIB::start(UART::Peripheral& printf_peripheral) {
     HALAL::start(printf_peripheral);
     STLIB_LOW::start();
     STLIB_HIGH::start();
+#ifdef STLIB_HEAP_GUARD
+    HeapGuard::lock();
+#endif
 }
 
 #endif // STLIB_ETH
@@ -3,6 +3,7 @@
 #include "HALAL/Services/Communication/FDCAN/FDCAN.hpp"
 
 #include "Protections/Notification.hpp"
+#include "Protections/ProtectionDomain.hpp"
 
 IStateMachine* ProtectionManager::general_state_machine = nullptr;
 Notification ProtectionManager::fault_notification = {ProtectionManager::fault_id, nullptr};
@@ -11,22 +12,36 @@ StackOrder<0> ProtectionManager::fault_order(Protections::FAULT, external_to_fau
 uint64_t ProtectionManager::last_notify = 0;
 bool ProtectionManager::external_trigger = false;
 bool ProtectionManager::test_fault = false;
+std::optional<ProtectionManager::ReportAggregator> ProtectionManager::reports;
 void* error_handler;
 void* info_warning;
 
 void ProtectionManager::initialize() {
+    if (reports) {
+        ST_LIB::ProtectionDomain::intern(ST_LIB::ProtectionDomain::board, *reports);
+    }
     for (Protection& protection : low_frequency_protections) {
         for (auto& boundary : protection.boundaries) {
             boundary->update_name(protection.get_name());
+            if (reports) {
+                boundary->report_id = reports->intern(protection.get_name());
+            }
         }
     }
     for (Protection& protection : high_frequency_protections) {
         for (auto& boundary : protection.boundaries) {
             boundary->update_name(protection.get_name());
+            if (reports) {
+                boundary->report_id = reports->intern(protection.get_name());
+            }
         }
     }
 }
 
+void ProtectionManager::enable_reports(const ReportAggregator::Config& config) {
+    reports.emplace(config);
+}
+
 void ProtectionManager::add_standard_protections() {
     add_protection(error_handler, Boundary<void, ERROR_HANDLER>(error_handler));
     add_protection(info_warning, Boundary<void, INFO_WARNING>(info_warning));
@@ -40,6 +55,8 @@ void ProtectionManager::link_state_machine(
 ) {
     ProtectionManager::general_state_machine = &general_state_machine;
     ProtectionManager::fault_state_id = fault_id;
+    /* Linked at startup, the IsrProtection descriptions are notified without allocating */
+    fault_notification.reserve(Protections::IsrProtectionBase::DESCRIPTION_SIZE);
 }
 
 void ProtectionManager::tcp_to_fault() {
@@ -65,7 +82,35 @@ void ProtectionManager::fault_and_propagate() {
     propagate_fault();
 }
 
+void ProtectionManager::check_board_protections() {
+    using ST_LIB::ProtectionDomain;
+    if (ProtectionDomain::board.empty()) {
+        return;
+    }
+    uint64_t now = Time::get_global_tick();
+    auto on_change = [now](size_t, const ProtectionDomain::Instance& protection) {
+        if (reports) {
+            reports->record(
+                protection.report_id,
+                protection.cfg.type,
+                protection.state,
+                static_cast<float>(protection.value),
+                now
+            );
+        }
+    };
+    if (ProtectionDomain::check(ProtectionDomain::board, on_change) == Protections::FAULT) {
+        ProtectionManager::to_fault();
+    }
+}
+
 void ProtectionManager::check_protections() {
+    if (general_state_machine == nullptr && !ST_LIB::ProtectionDomain::board.empty()) {
+        ErrorHandler("Protection Manager does not have General State Machine "
+                     "Linked");
+        return;
+    }
+    check_board_protections();
     for (Protection& protection : low_frequency_protections) {
         auto protection_status = protection.check_state();
 
@@ -80,6 +125,10 @@ void ProtectionManager::check_protections() {
             protection_status == Protections::FAULT) {
             ProtectionManager::to_fault();
         }
+        if (reports && !carries_text(protection)) {
+            record(protection);
+            continue;
+        }
         Global_RTC::update_rtc_data();
         if (Time::get_global_tick() >
             protection.get_last_notify_tick() + notify_delay_in_nanoseconds) {
@@ -87,6 +136,9 @@ void ProtectionManager::check_protections() {
             protection.update_last_notify_tick(Time::get_global_tick());
         }
     }
+    if (reports) {
+        flush_reports();
+    }
 }
 
 void ProtectionManager::check_high_frequency_protections() {
@@ -100,6 +152,10 @@ void ProtectionManager::check_high_frequency_protections() {
         if (protection.fault_type == Protections::FAULT) {
             ProtectionManager::to_fault();
         }
+        if (reports && !carries_text(protection)) {
+            record(protection);
+            continue;
+        }
         Global_RTC::update_rtc_data();
         if (Time::get_global_tick() >
             protection.get_last_notify_tick() + notify_delay_in_nanoseconds) {
@@ -107,6 +163,69 @@ void ProtectionManager::check_high_frequency_protections() {
             protection.update_last_notify_tick(Time::get_global_tick());
         }
     }
+    if (reports) {
+        flush_reports();
+    }
+}
+
+void ProtectionManager::check_isr_protections() {
+    if (!Protections::FaultLatch::take_pending()) {
+        return;
+    }
+    if (general_state_machine == nullptr) {
+        ErrorHandler("Protection Manager does not have General State Machine "
+                     "Linked");
+        return;
+    }
+    ProtectionManager::to_fault();
+    Protections::FaultLatch::for_each_unreported([](Protections::IsrProtectionBase& protection) {
+        std::array<char, Protections::IsrProtectionBase::DESCRIPTION_SIZE> text;
+        fault_notification.notify(protection.describe(text));
+    });
+}
+
+bool ProtectionManager::carries_text(Protection& protection) {
+    for (auto& boundary : protection.boundaries) {
+        if (boundary->boundary_type_id == ERROR_HANDLER ||
+            boundary->boundary_type_id == INFO_WARNING - 2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ProtectionManager::record(Protection& protection) {
+    uint64_t now = Time::get_global_tick();
+    auto add = [now](BoundaryInterface& boundary, Protections::FaultType state) {
+        reports->record(
+            boundary.report_id,
+            static_cast<ProtectionType>(boundary.boundary_type_id),
+            state,
+            boundary.reported_value(),
+            now
+        );
+    };
+    if (protection.fault_protection) {
+        add(*protection.fault_protection, Protections::FAULT);
+    }
+    for (auto& warning : protection.warnings_triggered) {
+        add(*warning, Protections::WARNING);
+    }
+    for (auto& ok : protection.oks_triggered) {
+        add(*ok, Protections::OK);
+    }
+    protection.oks_triggered.clear();
+    protection.warnings_triggered.clear();
+}
+
+void ProtectionManager::flush_reports() {
+    uint64_t now = Time::get_global_tick();
+    for (OrderProtocol* socket : OrderProtocol::sockets) {
+        reports->flush(socket, now, [socket](std::span<const uint8_t> packet) {
+            ProtectionReport report(packet);
+            return socket->send_order(report);
+        });
+    }
 }
 
 void ProtectionManager::warn(string message) { warning_notification.notify(message); }
@@ -7,10 +7,7 @@ void NTC::read() {
     if (adc == nullptr || value == nullptr) {
         return;
     }
-    const float raw = adc->get_raw();
-    uint16_t val = static_cast<uint16_t>(adc->get_value_from_raw(raw, 4095.0f));
-    if (val > 4095u) {
-        val = 4095u;
-    }
-    *value = static_cast<float>(NTC_table[val]) * 0.1f;
+    const uint32_t raw = static_cast<uint32_t>(adc->get_raw());
+    const uint32_t max_raw = ST_LIB::ADCDomain::Instance::max_raw_for_resolution(adc->resolution);
+    *value = Table::lookup(Table::code_from_raw(raw, max_raw));
 }
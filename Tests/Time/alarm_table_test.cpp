@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "HALAL/Services/Time/AlarmTable.hpp"
+
+namespace {
+
+int plain_calls = 0;
+void plain_alarm() { plain_calls++; }
+
+void counter_alarm(void* context) { (*static_cast<int*>(context))++; }
+
+} // namespace
+
+TEST(AlarmTable, FiresEveryPeriodStartingAfterRegistration) {
+    AlarmTable<4> table;
+    int fast = 0;
+    int slow = 0;
+    table.on_tick();
+
+    ASSERT_EQ(table.add(1, false, [&] { fast++; }), 0);
+    ASSERT_EQ(table.add(3, false, counter_alarm, &slow), 1);
+
+    // the tick already in progress when registering is not counted, as in the legacy tables
+    for (int i = 0; i < 7; i++) {
+        table.on_tick();
+    }
+    EXPECT_EQ(fast, 6);
+    EXPECT_EQ(slow, 2);
+    EXPECT_EQ(table.get_tick(), 8U);
+}
+
+TEST(AlarmTable, ReusesFreedSlotsAndRejectsWhenFull) {
+    AlarmTable<2> table;
+    plain_calls = 0;
+
+    EXPECT_EQ(table.add(1, false, plain_alarm), 0);
+    EXPECT_EQ(table.add(1, false, plain_alarm), 1);
+    EXPECT_EQ(table.add(1, false, plain_alarm), AlarmTable<2>::INVALID_ID);
+
+    EXPECT_TRUE(table.remove(0));
+    EXPECT_FALSE(table.remove(0));
+    EXPECT_FALSE(table.remove(AlarmTable<2>::INVALID_ID));
+    EXPECT_EQ(table.add(2, false, plain_alarm), 0);
+
+    for (int i = 0; i < 3; i++) {
+        table.on_tick();
+    }
+    EXPECT_EQ(plain_calls, 3);
+}
+
+TEST(AlarmTable, OneShotFiresOnceAndCanRemoveOthersWhileDispatching) {
+    AlarmTable<4> table;
+    int timeout_calls = 0;
+    int periodic_calls = 0;
+    uint8_t periodic = AlarmTable<4>::INVALID_ID;
+
+    const uint8_t timeout = table.add(2, true, [&] {
+        timeout_calls++;
+        table.remove(periodic);
+    });
+    periodic = table.add(1, false, [&] { periodic_calls++; });
+
+    for (int i = 0; i < 5; i++) {
+        table.on_tick();
+    }
+    EXPECT_EQ(timeout_calls, 1);
+    EXPECT_EQ(periodic_calls, 1);
+    EXPECT_FALSE(table.contains(timeout));
+    EXPECT_EQ(table.size(), 0U);
+}
+
+TEST(AlarmTable, ReleasesCapturedStateOnRemove) {
+    AlarmTable<2> table;
+    auto state = std::make_shared<int>(0);
+    const std::weak_ptr<int> observer = state;
+
+    const uint8_t id = table.add(1, false, [state = std::move(state)] { (*state)++; });
+    EXPECT_EQ(observer.use_count(), 1);
+
+    table.on_tick();
+    table.on_tick();
+    EXPECT_EQ(*observer.lock(), 1);
+
+    table.remove(id);
+    EXPECT_TRUE(observer.expired());
+}
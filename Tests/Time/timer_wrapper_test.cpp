@@ -3,6 +3,7 @@
 // #include <chrono>
 
 #include "HALAL/Models/TimerDomain/TimerDomain.hpp"
+#include "HALAL/Services/PWM/PWMGroup.hpp"
 #include "HALAL/Services/Time/TimerWrapper.hpp"
 
 TIM_TypeDef* ST_LIB::TimerDomain::cmsis_timers[16] = {
@@ -118,3 +119,196 @@ TEST_F(TimerWrapperTests, ConfigureTimer) {
     );                                                    /* set period */
     EXPECT_EQ(TIM1_BASE->CR1 & TIM_CR1_CEN, TIM_CR1_CEN); /* set counter enable */
 }
+
+constexpr ST_LIB::TimerPin tim1_ch1_pwm{
+    .af = ST_LIB::TimerAF::PWM,
+    .pin = ST_LIB::PA8,
+    .channel = ST_LIB::TimerChannel::CHANNEL_1,
+};
+constexpr ST_LIB::TimerDomain::Timer tim1_pwm_decl{
+    {.request = ST_LIB::TimerRequest::Advanced_1},
+    tim1_ch1_pwm
+};
+
+TEST_F(TimerWrapperTests, PWMFixedPointDutyUsesCachedPeriod) {
+    ST_LIB::TimerWrapper<tim1_pwm_decl> tim1(&tim1_inst);
+    TIM1_BASE->ARR = 999;
+    auto pwm = tim1.get_pwm<tim1_ch1_pwm>();
+    EXPECT_EQ(tim1.period_counts, 1000U);
+
+    pwm.set_duty_cycle(25.0f);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR1), 250U);
+
+    pwm.set_duty_cycle_q15(1U << 14);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR1), 500U);
+    EXPECT_FLOAT_EQ(pwm.get_duty_cycle(), 50.0f);
+
+    pwm.set_duty_cycle_q31(3U << 29);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR1), 750U);
+
+    pwm.set_duty_cycle_counts(5000);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR1), 1000U);
+    EXPECT_FLOAT_EQ(pwm.get_duty_cycle(), 100.0f);
+
+    pwm.set_duty_cycle_q15(0xFFFFU);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR1), 1000U);
+}
+
+TEST_F(TimerWrapperTests, FrequencyChangeReappliesDutiesOnNewPeriod) {
+    ST_LIB::TimerWrapper<tim1_pwm_decl> tim1(&tim1_inst);
+    TIM1_BASE->PSC = 0;
+    auto pwm = tim1.get_pwm<tim1_ch1_pwm>();
+    pwm.configure(10'000, 40.0f);
+
+    const uint32_t period = static_cast<uint32_t>(TIM1_BASE->ARR) + 1;
+    EXPECT_EQ(tim1.period_counts, period);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR1), static_cast<uint32_t>(period * 0.4f));
+}
+
+TEST_F(TimerWrapperTests, BurstCaptureCompareWriteIsUpdateEventAtomic) {
+    ST_LIB::TimerWrapper<tim1_pwm_decl> tim1(&tim1_inst);
+    TIM1_BASE->ARR = 1999;
+    tim1.refresh_period_cache();
+
+    tim1.set_capture_compares(std::array<uint32_t, 3>{100, 1000, 4000});
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR1), 100U);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR2), 1000U);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR3), 2000U);
+    EXPECT_EQ(TIM1_BASE->CR1 & TIM_CR1_UDIS, 0U);
+    EXPECT_FLOAT_EQ(tim1.pwm_channel_duties[0], 5.0f);
+    EXPECT_FLOAT_EQ(tim1.pwm_channel_duties[1], 50.0f);
+    EXPECT_FLOAT_EQ(tim1.pwm_channel_duties[2], 100.0f);
+
+    tim1.set_duty_cycles_q15(std::array<uint32_t, 3>{1U << 13, 1U << 14, 1U << 15});
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR1), 500U);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR2), 1000U);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR3), 2000U);
+}
+
+constexpr ST_LIB::TimerDomain::Timer tim8_decl{{
+    .request = ST_LIB::TimerRequest::Advanced_8,
+}};
+constexpr ST_LIB::TimerDomain::Timer tim4_decl{{
+    .request = ST_LIB::TimerRequest::GeneralPurpose_4,
+}};
+ST_LIB::TimerDomain::Instance tim8_inst{
+    .tim = TIM8_BASE,
+    .hal_tim = 0,
+    .timer_idx = 15,
+};
+ST_LIB::TimerDomain::Instance tim4_inst{
+    .tim = TIM4_BASE,
+    .hal_tim = 0,
+    .timer_idx = 2,
+};
+
+using LegGroup = ST_LIB::PWMGroup<tim1_decl, tim8_decl, tim4_decl>;
+static_assert(LegGroup::slave_itrs[0] == 0 && LegGroup::slave_itrs[1] == 0);
+static_assert(ST_LIB::PWMGroup<tim8_decl, tim4_decl>::slave_itrs[0] == 3);
+
+static void reset_group_timer(TIM_TypeDef* tim) {
+    tim->CR1 = 0;
+    tim->CR2 = 0;
+    tim->SMCR = 0;
+    tim->CNT = 0;
+    tim->PSC = 0;
+    tim->ARR = 999;
+    tim->CCR1 = 0;
+}
+
+TEST_F(TimerWrapperTests, PWMGroupLinksSlavesToMasterTrigger) {
+    for (TIM_TypeDef* tim : {TIM1_BASE, TIM8_BASE, TIM4_BASE})
+        reset_group_timer(tim);
+    ST_LIB::TimerWrapper<tim1_decl> tim1(&tim1_inst);
+    ST_LIB::TimerWrapper<tim8_decl> tim8(&tim8_inst);
+    ST_LIB::TimerWrapper<tim4_decl> tim4(&tim4_inst);
+    LegGroup group(tim1, tim8, tim4);
+
+    EXPECT_EQ(TIM1_BASE->CR2 & TIM_CR2_MMS, TIM_CR2_MMS_0);
+    EXPECT_EQ(TIM1_BASE->SMCR & TIM_SMCR_SMS, 0U);
+    for (TIM_TypeDef* tim : {TIM8_BASE, TIM4_BASE}) {
+        EXPECT_EQ(tim->SMCR & TIM_SMCR_SMS, 6U);
+        EXPECT_EQ(tim->SMCR & TIM_SMCR_TS, 0U);
+    }
+    for (TIM_TypeDef* tim : {TIM1_BASE, TIM8_BASE, TIM4_BASE}) {
+        EXPECT_EQ(tim->CR1 & TIM_CR1_ARPE, TIM_CR1_ARPE);
+        EXPECT_EQ(tim->CR1 & TIM_CR1_CEN, 0U);
+    }
+}
+
+TEST_F(TimerWrapperTests, PWMGroupStartPreloadsPhaseOffsets) {
+    for (TIM_TypeDef* tim : {TIM1_BASE, TIM8_BASE, TIM4_BASE})
+        reset_group_timer(tim);
+    ST_LIB::TimerWrapper<tim1_decl> tim1(&tim1_inst);
+    ST_LIB::TimerWrapper<tim8_decl> tim8(&tim8_inst);
+    ST_LIB::TimerWrapper<tim4_decl> tim4(&tim4_inst);
+    LegGroup group(tim1, tim8, tim4);
+
+    group.set_phase(0, 120.0f);
+    group.set_phase(1, -120.0f);
+    EXPECT_FLOAT_EQ(group.get_phase(1), 240.0f);
+    group.start();
+
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CNT), 0U);
+    EXPECT_EQ(static_cast<uint32_t>(TIM8_BASE->CNT), 666U);
+    EXPECT_EQ(static_cast<uint32_t>(TIM4_BASE->CNT), 333U);
+    // Only the master is enabled, the slaves are started by its TRGO
+    EXPECT_EQ(TIM1_BASE->CR1 & TIM_CR1_CEN, TIM_CR1_CEN);
+    EXPECT_EQ(TIM8_BASE->CR1 & TIM_CR1_CEN, 0U);
+    EXPECT_EQ(TIM4_BASE->CR1 & TIM_CR1_CEN, 0U);
+
+    group.stop();
+    EXPECT_EQ(TIM1_BASE->CR1 & TIM_CR1_CEN, 0U);
+}
+
+TEST_F(TimerWrapperTests, PWMGroupFrequencyChangeIsOneCommit) {
+    for (TIM_TypeDef* tim : {TIM1_BASE, TIM8_BASE, TIM4_BASE})
+        reset_group_timer(tim);
+    ST_LIB::TimerWrapper<tim1_decl> tim1(&tim1_inst);
+    ST_LIB::TimerWrapper<tim8_decl> tim8(&tim8_inst);
+    ST_LIB::TimerWrapper<tim4_decl> tim4(&tim4_inst);
+    tim1.pwm_channel_duties[0] = 50.0f;
+    tim8.pwm_channel_duties[0] = 25.0f;
+    tim4.pwm_channel_duties[0] = 75.0f;
+    LegGroup group(tim1, tim8, tim4);
+
+    group.set_frequency<ST_LIB::PWM_Frequency_Mode::SPEED>(20000);
+
+    const uint32_t arr1 = TIM1_BASE->ARR;
+    EXPECT_EQ(arr1, tim1.get_clock_frequency() / 20000);
+    EXPECT_EQ(static_cast<uint32_t>(TIM8_BASE->ARR), tim8.get_clock_frequency() / 20000);
+    EXPECT_EQ(static_cast<uint32_t>(TIM4_BASE->ARR), tim4.get_clock_frequency() / 20000);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CCR1), tim1.percent_to_counts(50.0f));
+    EXPECT_EQ(static_cast<uint32_t>(TIM8_BASE->CCR1), tim8.percent_to_counts(25.0f));
+    EXPECT_EQ(static_cast<uint32_t>(TIM4_BASE->CCR1), tim4.percent_to_counts(75.0f));
+    for (TIM_TypeDef* tim : {TIM1_BASE, TIM8_BASE, TIM4_BASE}) {
+        EXPECT_EQ(tim->CR1 & TIM_CR1_UDIS, 0U);
+        EXPECT_EQ(tim->CR1 & TIM_CR1_ARPE, TIM_CR1_ARPE);
+    }
+}
+
+TEST_F(TimerWrapperTests, PWMGroupFrequencyChangeKeepsThePhases) {
+    for (TIM_TypeDef* tim : {TIM1_BASE, TIM8_BASE, TIM4_BASE})
+        reset_group_timer(tim);
+    ST_LIB::TimerWrapper<tim1_decl> tim1(&tim1_inst);
+    ST_LIB::TimerWrapper<tim8_decl> tim8(&tim8_inst);
+    ST_LIB::TimerWrapper<tim4_decl> tim4(&tim4_inst);
+    LegGroup group(tim1, tim8, tim4);
+    group.set_phase(0, 120.0f);
+    group.set_phase(1, 240.0f);
+    group.start();
+    TIM8_BASE->CNT = TIM8_BASE->CNT + 100;
+
+    group.set_frequency<ST_LIB::PWM_Frequency_Mode::SPEED>(20000);
+
+    const uint32_t period = TIM8_BASE->ARR + 1;
+    EXPECT_NE(period, 1000U);
+    EXPECT_EQ(static_cast<uint32_t>(TIM1_BASE->CNT), 0U);
+    EXPECT_EQ(static_cast<uint32_t>(TIM8_BASE->CNT), (uint32_t)(240.0f * (float)period / 360.0f));
+    EXPECT_EQ(
+        static_cast<uint32_t>(TIM4_BASE->CNT),
+        (uint32_t)(120.0f * (float)(TIM4_BASE->ARR + 1) / 360.0f)
+    );
+    EXPECT_EQ(TIM1_BASE->CR1 & TIM_CR1_CEN, TIM_CR1_CEN);
+    EXPECT_EQ(TIM8_BASE->CR1 & TIM_CR1_CEN, 0U);
+}
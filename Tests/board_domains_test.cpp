@@ -0,0 +1,207 @@
+#include <array>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "HALAL/Models/Packets/PacketDomain.hpp"
+#include "Protections/ProtectionDomain.hpp"
+
+using ST_LIB::PacketDomain;
+using ST_LIB::ProtectionDomain;
+using namespace Protections;
+
+namespace {
+
+/* Collects the entries of one domain the way BuildCtx does */
+template <typename Domain, size_t Max = 8> struct DomainCtx {
+    std::array<typename Domain::Entry, Max> entries{};
+    size_t size = 0;
+
+    template <typename D, typename Owner>
+    consteval size_t add(typename D::Entry entry, [[maybe_unused]] const Owner* owner) {
+        entries[size] = entry;
+        return size++;
+    }
+};
+
+template <typename Domain, size_t N> consteval auto build_domain(const auto&... devices) {
+    DomainCtx<Domain> ctx;
+    (devices.inscribe(ctx), ...);
+    using Entry = typename Domain::Entry;
+    return Domain::template build<N>(std::span<const Entry>(ctx.entries.data(), N));
+}
+
+float speed = 0.0f;
+uint8_t state = 0;
+double position = 0.0;
+int16_t command = 0;
+
+constexpr ST_LIB::Telemetry speed_packet{300, &speed, &state, &position};
+constexpr ST_LIB::Telemetry command_packet{120, &command};
+constexpr ST_LIB::Telemetry heartbeat{5};
+
+constexpr auto packet_cfgs = build_domain<PacketDomain, 3>(speed_packet, command_packet, heartbeat);
+static_assert(packet_cfgs[0].size == 2 + 4 + 1 + 8);
+static_assert(packet_cfgs[1].offset == packet_cfgs[0].size);
+static_assert(packet_cfgs[2].size == 2);
+
+/* Sorted by id for the lookup: heartbeat, command, speed */
+static_assert(packet_cfgs[0].by_id == 2 && packet_cfgs[1].by_id == 1 && packet_cfgs[2].by_id == 0);
+static_assert(PacketDomain::arena_size(packet_cfgs) == 15 + 4 + 2);
+
+using Packets = PacketDomain::Init<3, PacketDomain::arena_size(packet_cfgs)>;
+
+float current = 0.0f;
+float voltage = 0.0f;
+int32_t errors = 0;
+
+constexpr auto overcurrent = ProtectionDomain::above("current", &current, 150, 120);
+constexpr auto undervoltage = ProtectionDomain::below("undervoltage", &voltage, 300);
+constexpr auto voltage_range = ProtectionDomain::out_of_range("bus", &voltage, 250, 450, 280, 420);
+constexpr auto no_errors = ProtectionDomain::not_equals("errors", &errors, 0);
+
+constexpr auto protection_cfgs = build_domain<ProtectionDomain, 4>(
+    overcurrent,
+    undervoltage,
+    voltage_range,
+    no_errors
+);
+static_assert(protection_cfgs[0].type == ABOVE && protection_cfgs[0].warning_upper == 120.0);
+static_assert(ProtectionDomain::evaluate(protection_cfgs[2], 260.0) == WARNING);
+static_assert(ProtectionDomain::evaluate(protection_cfgs[2], 500.0) == FAULT);
+static_assert(ProtectionDomain::evaluate(protection_cfgs[3], 0.0) == OK);
+
+using Board = ProtectionDomain::Init<4>;
+
+} // namespace
+
+TEST(PacketDomain, BuildsPacketsInTheStaticArena) {
+    Packets::init(packet_cfgs);
+    speed = 12.5f;
+    state = 3;
+    position = -1.25;
+
+    std::span<const uint8_t> packet = Packets::instances[0].build();
+    ASSERT_EQ(packet.size(), 15u);
+    EXPECT_GE(packet.data(), Packets::arena.data());
+    EXPECT_LE(packet.data() + packet.size(), Packets::arena.data() + Packets::arena.size());
+
+    uint16_t id;
+    float speed_out;
+    double position_out;
+    std::memcpy(&id, packet.data(), 2);
+    std::memcpy(&speed_out, packet.data() + 2, 4);
+    std::memcpy(&position_out, packet.data() + 7, 8);
+    EXPECT_EQ(id, 300);
+    EXPECT_EQ(speed_out, 12.5f);
+    EXPECT_EQ(packet[6], 3);
+    EXPECT_EQ(position_out, -1.25);
+
+    /* Packets don't overlap */
+    EXPECT_EQ(Packets::instances[2].build().size(), 2u);
+    EXPECT_EQ(Packets::instances[0].build()[0], 300 & 0xFF);
+}
+
+TEST(PacketDomain, ParsesIntoTheDeclaredVariables) {
+    Packets::init(packet_cfgs);
+    std::vector<uint8_t> data(4);
+    uint16_t id = 120;
+    int16_t value = -42;
+    std::memcpy(data.data(), &id, 2);
+    std::memcpy(data.data() + 2, &value, 2);
+
+    EXPECT_TRUE(PacketDomain::parse(data.data(), data.size()));
+    EXPECT_EQ(command, -42);
+
+    /* Too short for its layout, or an id the board doesn't declare */
+    EXPECT_FALSE(PacketDomain::parse(data.data(), 3));
+    id = 121;
+    std::memcpy(data.data(), &id, 2);
+    EXPECT_FALSE(PacketDomain::parse(data.data(), data.size()));
+    EXPECT_EQ(Packets::find(5), &Packets::instances[2]);
+    EXPECT_EQ(Packets::find(300), &Packets::instances[0]);
+}
+
+TEST(ProtectionDomain, ChecksEveryProtectionAndReportsChanges) {
+    Board::init(protection_cfgs);
+    current = 10.0f;
+    voltage = 400.0f;
+    errors = 0;
+    EXPECT_EQ(Board::check(), OK);
+
+    std::vector<size_t> changed;
+    auto record = [&](size_t index, const ProtectionDomain::Instance&) {
+        changed.push_back(index);
+    };
+    current = 130.0f;
+    EXPECT_EQ(Board::check(record), WARNING);
+    EXPECT_EQ(changed, std::vector<size_t>{0});
+
+    /* The worst state wins, only the new change is reported */
+    voltage = 200.0f;
+    changed.clear();
+    EXPECT_EQ(Board::check(record), FAULT);
+    EXPECT_EQ(changed, (std::vector<size_t>{1, 2}));
+    EXPECT_EQ(Board::instances[1].value, 200.0);
+
+    errors = 3;
+    voltage = 400.0f;
+    current = 0.0f;
+    EXPECT_EQ(Board::check(), FAULT);
+    EXPECT_EQ(Board::instances[3].state, FAULT);
+    EXPECT_EQ(Board::instances[0].state, OK);
+}
+
+TEST(ProtectionDomain, InternsNamesInDomainOrder) {
+    struct Names {
+        std::vector<const char*> names;
+        uint16_t intern(const char* name) {
+            names.push_back(name);
+            return static_cast<uint16_t>(names.size() - 1);
+        }
+    } names;
+    Board::init(protection_cfgs);
+    Board::intern(names);
+    ASSERT_EQ(names.names.size(), 4u);
+    EXPECT_STREQ(names.names[0], "current");
+    EXPECT_STREQ(names.names[2], "bus");
+}
+
+TEST(ProtectionDomain, RegistersTheBoardAndKeepsTheReportIds) {
+    struct Reports {
+        std::vector<const char*> names;
+        std::vector<std::pair<uint16_t, FaultType>> records;
+        uint16_t intern(const char* name) {
+            names.push_back(name);
+            return static_cast<uint16_t>(names.size() - 1);
+        }
+    } reports;
+    /* Ids taken by protections interned before the board ones */
+    reports.intern("error_handler");
+    reports.intern("info_warning");
+
+    Board::init(protection_cfgs);
+    ASSERT_EQ(ProtectionDomain::board.size(), 4u);
+    EXPECT_EQ(ProtectionDomain::board.data(), Board::instances.data());
+    ProtectionDomain::intern(ProtectionDomain::board, reports);
+    EXPECT_EQ(Board::instances[0].report_id, 2u);
+    EXPECT_STREQ(reports.names[Board::instances[2].report_id], "bus");
+
+    current = 10.0f;
+    voltage = 400.0f;
+    errors = 0;
+    auto record = [&](size_t, const ProtectionDomain::Instance& protection) {
+        reports.records.emplace_back(protection.report_id, protection.state);
+    };
+    EXPECT_EQ(ProtectionDomain::check(ProtectionDomain::board, record), OK);
+    EXPECT_TRUE(reports.records.empty());
+
+    errors = 1;
+    EXPECT_EQ(ProtectionDomain::check(ProtectionDomain::board, record), FAULT);
+    ASSERT_EQ(reports.records.size(), 1u);
+    EXPECT_EQ(reports.records[0].first, Board::instances[3].report_id);
+    EXPECT_EQ(reports.records[0].second, FAULT);
+}
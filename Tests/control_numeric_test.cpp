@@ -0,0 +1,228 @@
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "Control/Blocks/Derivator.hpp"
+#include "Control/Blocks/Integrator.hpp"
+#include "Control/Blocks/MeanCalculator.hpp"
+#include "Control/Blocks/MovingAverage.hpp"
+#include "Control/Blocks/PI.hpp"
+#include "Control/Blocks/PID.hpp"
+#include "Control/FixedPoint.hpp"
+
+namespace {
+
+constexpr int STEPS = 2000;
+constexpr double PERIOD = 1e-3;
+
+/* 5 Hz sine plus a 60 Hz ripple, peaks below 0.5 so Q15 keeps some headroom */
+double sample(int step) {
+    double t = step * PERIOD;
+    return 0.4 * std::sin(2 * std::numbers::pi * 5 * t) +
+           0.05 * std::sin(2 * std::numbers::pi * 60 * t);
+}
+
+/* Largest distance between a block over T and the same block over double, fed the same input */
+template <typename Reference, typename Block> double max_error(Reference& reference, Block& block) {
+    using T = typename Block::Input;
+    double error = 0.0;
+    for (int step = 0; step < STEPS; step++) {
+        double input = sample(step);
+        reference.input(input);
+        reference.execute();
+        block.input(static_cast<T>(input));
+        block.execute();
+        double output = static_cast<double>(block.output_value);
+        error = std::max(error, std::abs(output - reference.output_value));
+    }
+    return error;
+}
+
+template <typename T> double pid_error(double kp, double ki, double kd) {
+    PID<IntegratorType::Trapezoidal, FilterDerivatorType::None> reference(kp, ki, kd, PERIOD);
+    BasicPID<T, IntegratorType::Trapezoidal, FilterDerivatorType::None> pid(kp, ki, kd, PERIOD);
+    double error = 0.0;
+    for (int step = 0; step < STEPS; step++) {
+        double expected = reference.execute(sample(step));
+        double output = static_cast<double>(pid.execute(static_cast<T>(sample(step))));
+        error = std::max(error, std::abs(output - expected));
+    }
+    return error;
+}
+
+void report(const char* block, const char* numeric, double error) {
+    printf("[ ACCURACY ] %s<%s>: max error %.3g\n", block, numeric, error);
+}
+
+} // namespace
+
+TEST(FixedPoint, ConvertsWithRoundingAndSaturation) {
+    EXPECT_EQ(Q15(0.5).raw, 16384);
+    EXPECT_EQ(Q15(-1.0).raw, -32768);
+    EXPECT_EQ(Q15(1.0).raw, 32767);
+    EXPECT_EQ(Q15(3.0e-5).raw, 1);
+    EXPECT_EQ(Q15(-3.0e-5).raw, -1);
+    EXPECT_EQ(Q31(-2.0).raw, INT32_MIN);
+    EXPECT_EQ(Q16(1.5).raw, 98304);
+    EXPECT_DOUBLE_EQ(static_cast<double>(Q31(0.25)), 0.25);
+    EXPECT_DOUBLE_EQ(Q15::resolution(), 1.0 / 32768);
+}
+
+TEST(FixedPoint, SaturatesInsteadOfWrapping) {
+    EXPECT_EQ(Q15(0.75) + Q15(0.75), Q15::max());
+    EXPECT_EQ(Q15(-0.75) - Q15(0.75), Q15::min());
+    EXPECT_EQ(Q15(-1.0) * Q15(-1.0), Q15::max());
+    EXPECT_EQ(-Q15::min(), Q15::max());
+    EXPECT_EQ(Q31(0.75) + Q31(0.75), Q31::max());
+    EXPECT_EQ(Q31(-1.0) * Q31(-1.0), Q31::max());
+    EXPECT_EQ(Q31(0.5) / Q31(0.25), Q31::max());
+    EXPECT_EQ(Q16(-3.0) / Q16(0.0), Q16::min());
+
+    EXPECT_EQ(Q15(0.5) * Q15(0.5), Q15(0.25));
+    EXPECT_EQ(Q31(0.25) / Q31(0.5), Q31(0.5));
+    EXPECT_EQ(Q16(3.0) / 4, Q16(0.75));
+    EXPECT_LT(Q15(-0.5), Q15(0.25));
+
+    static_assert((Q15(0.75) + Q15(0.75)) == Q15::max(), "usable in constant expressions");
+}
+
+TEST(ControlNumeric, DoubleApiIsUnchanged) {
+    static_assert(std::is_same_v<
+                  PID<IntegratorType::Trapezoidal, FilterDerivatorType::None>,
+                  BasicPID<double, IntegratorType::Trapezoidal, FilterDerivatorType::None>>);
+    static_assert(std::is_same_v<MovingAverage<8>, MovingAverage<8, double>>);
+    static_assert(std::is_same_v<FloatMovingAverage<8>, MovingAverage<8, float>>);
+    static_assert(std::is_same_v<
+                  FloatIntegrator<IntegratorType::Trapezoidal>,
+                  Integrator<IntegratorType::Trapezoidal, float>>);
+    static_assert(std::is_same_v<SimpleFloatDerivator, BasicSimpleDerivator<float>>);
+
+    /* Same operations in the same order as the hand written double integrator */
+    Integrator<IntegratorType::Trapezoidal> integrator(PERIOD, 3.0);
+    double integral = 0.0;
+    double previous = 0.0;
+    for (int step = 0; step < 100; step++) {
+        double input = sample(step);
+        integrator.input(input);
+        integrator.execute();
+        if (step > 0) {
+            integral += 3.0 * PERIOD * (input + previous) / 2.0;
+        }
+        previous = input;
+        EXPECT_EQ(integrator.output_value, integral);
+    }
+}
+
+TEST(ControlNumeric, IntegratorMatchesDoubleReference) {
+    constexpr double ki = 20.0;
+    Integrator<IntegratorType::Trapezoidal> reference(PERIOD, ki);
+
+    Integrator<IntegratorType::Trapezoidal, float> single(PERIOD, ki);
+    double error = max_error(reference, single);
+    report("Integrator", "float", error);
+    EXPECT_LT(error, 1e-5);
+
+    reference.reset();
+    Integrator<IntegratorType::Trapezoidal, Q31> q31(PERIOD, ki);
+    error = max_error(reference, q31);
+    report("Integrator", "Q31", error);
+    EXPECT_LT(error, 1e-5);
+
+    reference.reset();
+    Integrator<IntegratorType::Trapezoidal, Q15> q15(PERIOD, ki);
+    error = max_error(reference, q15);
+    report("Integrator", "Q15", error);
+    EXPECT_LT(error, 5e-3);
+
+    Integrator<IntegratorType::ForwardEuler> forward(PERIOD, ki);
+    Integrator<IntegratorType::ForwardEuler, Q31> forward_q31(PERIOD, ki);
+    EXPECT_LT(max_error(forward, forward_q31), 1e-5);
+    Integrator<IntegratorType::BackwardEuler> backward(PERIOD, ki);
+    Integrator<IntegratorType::BackwardEuler, float> backward_float(PERIOD, ki);
+    EXPECT_LT(max_error(backward, backward_float), 1e-5);
+}
+
+TEST(ControlNumeric, FixedPointIntegratorClampsInsteadOfWrapping) {
+    Integrator<IntegratorType::BackwardEuler, Q15> integrator(PERIOD, 100.0);
+    for (int step = 0; step < 50; step++) {
+        integrator.input(Q15(0.9));
+        integrator.execute();
+    }
+    EXPECT_EQ(integrator.output_value, Q15::max());
+}
+
+TEST(ControlNumeric, MovingAverageMatchesDoubleReference) {
+    MovingAverage<16> reference;
+
+    MovingAverage<16, float> single;
+    double error = max_error(reference, single);
+    report("MovingAverage", "float", error);
+    EXPECT_LT(error, 1e-5);
+
+    reference.reset();
+    MovingAverage<16, Q31> q31;
+    error = max_error(reference, q31);
+    report("MovingAverage", "Q31", error);
+    EXPECT_LT(error, 1e-6);
+
+    reference.reset();
+    MovingAverage<16, Q15> q15;
+    error = max_error(reference, q15);
+    report("MovingAverage", "Q15", error);
+    EXPECT_LT(error, 2e-3);
+}
+
+TEST(ControlNumeric, MeanCalculatorMatchesDoubleReference) {
+    MeanCalculator<100> reference;
+    MeanCalculator<100, Q31> q31;
+    MeanCalculator<100, float> single;
+    for (int step = 0; step < 100; step++) {
+        reference.input(sample(step));
+        reference.execute();
+        q31.input(Q31(sample(step)));
+        q31.execute();
+        single.input(static_cast<float>(sample(step)));
+        single.execute();
+    }
+    EXPECT_NEAR(static_cast<double>(q31.output_value), reference.output_value, 1e-6);
+    EXPECT_NEAR(single.output_value, reference.output_value, 1e-6);
+}
+
+TEST(ControlNumeric, DerivatorMatchesDoubleReference) {
+    SimpleDerivator reference(PERIOD);
+
+    SimpleFloatDerivator single(PERIOD);
+    double error = max_error(reference, single);
+    report("SimpleDerivator", "float", error);
+    EXPECT_LT(error, 1e-3);
+
+    /* 1 / period doesn't fit in Q15/Q31, the rate needs integer bits */
+    reference.reset();
+    BasicSimpleDerivator<Q16> q16(PERIOD);
+    error = max_error(reference, q16);
+    report("SimpleDerivator", "Q16", error);
+    EXPECT_LT(error, 5e-2);
+
+    BDFDerivator<3> bdf(PERIOD, {1.5, -0.5});
+    BDFDerivator<3, float> bdf_float(PERIOD, {1.5, -0.5});
+    EXPECT_LT(max_error(bdf, bdf_float), 1e-3);
+}
+
+TEST(ControlNumeric, PIAndPIDMatchDoubleReference) {
+    PI<IntegratorType::Trapezoidal> reference(0.8, 20.0, PERIOD);
+    PI<IntegratorType::Trapezoidal, Q31> q31(0.8, 20.0, PERIOD);
+    double error = max_error(reference, q31);
+    report("PI", "Q31", error);
+    EXPECT_LT(error, 1e-5);
+
+    error = pid_error<float>(2.0, 20.0, 0.01);
+    report("PID", "float", error);
+    EXPECT_LT(error, 1e-4);
+
+    error = pid_error<Q16>(2.0, 20.0, 0.01);
+    report("PID", "Q16", error);
+    EXPECT_LT(error, 2e-3);
+}
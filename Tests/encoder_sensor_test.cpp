@@ -0,0 +1,207 @@
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "HALAL/Services/Encoder/EncoderEdgeCapture.hpp"
+#include "HALAL/Services/Time/TimerWrapper.hpp"
+#include "Sensors/EncoderSensor/EncoderCaptureSensor.hpp"
+
+namespace {
+
+struct FakeEncoder {
+    uint32_t counter = UINT32_MAX / 2;
+    bool forward = true;
+
+    void turn_on() {}
+    void turn_off() {}
+    void reset() { counter = UINT32_MAX / 2; }
+    uint32_t get_counter() const { return counter; }
+    bool get_direction() const { return forward; }
+};
+
+struct FakeCapture {
+    struct Edge {
+        uint32_t count;
+        uint32_t ticks;
+    };
+
+    static inline Edge edge{};
+    static inline uint32_t ticks = 0;
+
+    static Edge read_last_edge() { return edge; }
+    static uint32_t now() { return ticks; }
+    static uint32_t get_clock_frequency() { return 1'000'000; }
+};
+
+using Sensor = ST_LIB::EncoderCaptureSensor<FakeEncoder, FakeCapture>;
+
+// 1 mm per count, 1 kHz sampling, 1 MHz capture clock
+constexpr Sensor::Config sensor_config{
+    .counter_distance_m = 1e-3f,
+    .sample_time_s = 1e-3f,
+};
+
+class EncoderCaptureSensorTest : public ::testing::Test {
+protected:
+    FakeEncoder encoder{};
+    Sensor::Direction direction{};
+    float position = 0.0f;
+    float speed = 0.0f;
+    float acceleration = 0.0f;
+
+    void SetUp() override {
+        FakeCapture::edge = {UINT32_MAX / 2, 0};
+        FakeCapture::ticks = 0;
+    }
+
+    Sensor make_sensor() {
+        return Sensor(encoder, sensor_config, &direction, &position, &speed, &acceleration);
+    }
+};
+
+constexpr ST_LIB::TimerDomain::Timer enc_tim3_decl{{
+    .request = ST_LIB::TimerRequest::GeneralPurpose_3,
+}};
+constexpr ST_LIB::TimerDomain::Timer clock_tim2_decl{{
+    .request = ST_LIB::TimerRequest::GeneralPurpose32bit_2,
+}};
+ST_LIB::TimerDomain::Instance enc_tim3_inst{
+    .tim = TIM3_BASE,
+    .hal_tim = 0,
+    .timer_idx = 1,
+};
+ST_LIB::TimerDomain::Instance clock_tim2_inst{
+    .tim = TIM2_BASE,
+    .hal_tim = 0,
+    .timer_idx = 0,
+};
+
+} // namespace
+
+TEST(EncoderEdgeCapture, RoutesEncoderCapturePulseToClockTimer) {
+    using Capture = ST_LIB::EncoderEdgeCapture<enc_tim3_decl, clock_tim2_decl>;
+    for (TIM_TypeDef* tim : {TIM2_BASE, TIM3_BASE}) {
+        tim->CR1 = 0;
+        tim->CR2 = 0;
+        tim->SMCR = 0;
+        tim->CCMR1 = 0;
+        tim->CCER = 0;
+    }
+    ST_LIB::TimerWrapper<enc_tim3_decl> encoder(&enc_tim3_inst);
+    ST_LIB::TimerWrapper<clock_tim2_decl> clock(&clock_tim2_inst);
+
+    Capture::init(&encoder, &clock);
+
+    EXPECT_EQ(TIM3_BASE->CR2 & TIM_CR2_MMS, TIM_CR2_MMS_0 | TIM_CR2_MMS_1);
+    EXPECT_EQ(TIM3_BASE->CCER & TIM_CCER_CC1E, TIM_CCER_CC1E);
+    // TIM3 TRGO reaches TIM2 on ITR2
+    EXPECT_EQ(TIM2_BASE->SMCR & TIM_SMCR_TS, 2U << TIM_SMCR_TS_Pos);
+    EXPECT_EQ(TIM2_BASE->SMCR & TIM_SMCR_SMS, 0U);
+    EXPECT_EQ(TIM2_BASE->CCMR1 & TIM_CCMR1_CC1S, TIM_CCMR1_CC1S);
+    EXPECT_EQ(TIM2_BASE->CCER & TIM_CCER_CC1E, TIM_CCER_CC1E);
+    EXPECT_EQ(static_cast<uint32_t>(TIM2_BASE->ARR), UINT32_MAX);
+    EXPECT_EQ(TIM2_BASE->CR1 & TIM_CR1_CEN, TIM_CR1_CEN);
+    EXPECT_EQ(Capture::get_clock_frequency(), clock.get_clock_frequency());
+
+    TIM3_BASE->CCR1 = 1234;
+    TIM2_BASE->CCR1 = 987654;
+    const auto edge = Capture::read_last_edge();
+    EXPECT_EQ(edge.count, 1234U);
+    EXPECT_EQ(edge.ticks, 987654U);
+}
+
+TEST_F(EncoderCaptureSensorTest, LowSpeedUsesEdgePeriod) {
+    Sensor sensor = make_sensor();
+
+    // One edge (4 counts) every 40 ms = 0.1 m/s. The counter difference alone would read
+    // 0 m/s on most samples and 4 m/s on the one that sees the edge
+    int edges = 0;
+    for (uint32_t sample = 1; sample <= 400; sample++) {
+        FakeCapture::ticks = sample * 1000;
+        if (sample % 40 == 0) {
+            encoder.counter += 4;
+            FakeCapture::edge = {encoder.counter, sample * 1000 - 500};
+            edges++;
+        }
+        sensor.read();
+        if (edges >= 2) {
+            EXPECT_NEAR(speed, 0.1f, 1e-5f) << "sample " << sample;
+        }
+    }
+    EXPECT_NEAR(position, 0.040f, 1e-6f);
+    EXPECT_EQ(direction, Sensor::FORWARD);
+}
+
+TEST_F(EncoderCaptureSensorTest, HighSpeedUsesCounterDifference) {
+    Sensor sensor = make_sensor();
+
+    for (uint32_t sample = 1; sample <= 20; sample++) {
+        FakeCapture::ticks = sample * 1000;
+        encoder.counter += 20;
+        // the capture only keeps the last of the 5 edges of every sample
+        FakeCapture::edge = {encoder.counter, sample * 1000 - 10};
+        sensor.read();
+    }
+    EXPECT_NEAR(speed, 20.0f, 1e-4f);
+    EXPECT_NEAR(acceleration, 0.0f, 1e-1f);
+}
+
+TEST_F(EncoderCaptureSensorTest, MidSpeedBlendsBothEstimates) {
+    Sensor sensor = make_sensor();
+    FakeCapture::ticks = 1000;
+    sensor.read();
+
+    // edges say 4 counts in 1 ms (4 m/s), the counter moved 5 counts in the sample (5 m/s).
+    // 4 counts per sample is a third of the way between the default 2 and 8 count thresholds
+    encoder.counter += 5;
+    FakeCapture::ticks = 2000;
+    FakeCapture::edge = {UINT32_MAX / 2 + 4, 1000};
+    sensor.read();
+
+    EXPECT_NEAR(speed, 4.0f + 1.0f / 3.0f, 1e-4f);
+    EXPECT_NEAR(acceleration, 4333.333f, 0.5f);
+}
+
+TEST_F(EncoderCaptureSensorTest, SpeedDecaysWithoutEdgesAndStopsAtStandstill) {
+    Sensor sensor = make_sensor();
+
+    FakeCapture::ticks = 1000;
+    sensor.read();
+    encoder.counter += 4;
+    FakeCapture::edge = {encoder.counter, 10'000};
+    FakeCapture::ticks = 11'000;
+    sensor.read();
+    EXPECT_NEAR(speed, 0.4f, 1e-5f);
+
+    // no more edges: 4 counts over 20 ms since the last edge bound the speed to 0.2 m/s
+    FakeCapture::ticks = 30'000;
+    sensor.read();
+    EXPECT_NEAR(speed, 0.2f, 1e-5f);
+
+    FakeCapture::ticks = 10'000 + 100'000;
+    sensor.read();
+    EXPECT_EQ(speed, 0.0f);
+}
+
+TEST_F(EncoderCaptureSensorTest, UpdateClockKeepsTheConfiguredStandstillTime) {
+    Sensor::Config config = sensor_config;
+    config.standstill_time_s = 0.5f;
+    Sensor sensor(encoder, config, &direction, &position, &speed, &acceleration);
+    sensor.update_clock();
+
+    FakeCapture::ticks = 1000;
+    sensor.read();
+    encoder.counter += 4;
+    FakeCapture::edge = {encoder.counter, 10'000};
+    FakeCapture::ticks = 11'000;
+    sensor.read();
+
+    // 200 ms without edges is past the default 0.1 s but not the configured 0.5 s
+    FakeCapture::ticks = 10'000 + 200'000;
+    sensor.read();
+    EXPECT_NEAR(speed, 0.02f, 1e-5f);
+
+    FakeCapture::ticks = 10'000 + 500'000;
+    sensor.read();
+    EXPECT_EQ(speed, 0.0f);
+}
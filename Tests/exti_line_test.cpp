@@ -0,0 +1,123 @@
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "C++Utilities/SPSCQueue.hpp"
+#include "HALAL/Services/EXTI/EXTILine.hpp"
+
+using ST_LIB::EXTILine;
+
+namespace {
+
+int action_calls = 0;
+void count_action() { action_calls++; }
+void ignore_event(const EXTILine::Event&) {}
+
+class EXTILineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        action_calls = 0;
+        dropped = 0;
+    }
+
+    void edge_at(uint8_t number, uint32_t timestamp, bool pin_high = true) {
+        line.handle(number, timestamp, [pin_high] { return pin_high; }, events, dropped);
+    }
+
+    EXTILine line{.is_on = true, .action = count_action};
+    SPSCQueue<EXTILine::Event, 2> events;
+    uint32_t dropped = 0;
+};
+
+} // namespace
+
+TEST_F(EXTILineTest, DebounceDropsEdgesInsideTheWindow) {
+    line.debounce_cycles = 100;
+
+    edge_at(3, 1'000);
+    edge_at(3, 1'050);
+    edge_at(3, 1'099);
+    edge_at(3, 1'100);
+    edge_at(3, 1'150);
+
+    EXPECT_EQ(action_calls, 2);
+    EXPECT_EQ(line.last_accepted, 1'100U);
+}
+
+TEST_F(EXTILineTest, DebounceWindowSpansTheCounterWrap) {
+    line.debounce_cycles = 100;
+
+    EXPECT_TRUE(line.debounce(0xFFFF'FFC0U));
+    EXPECT_FALSE(line.debounce(0x10U));
+    EXPECT_TRUE(line.debounce(0x24U));
+}
+
+TEST_F(EXTILineTest, ZeroDebounceTakesEveryEdge) {
+    for (uint32_t i = 0; i < 5; i++) {
+        edge_at(3, 1'000);
+    }
+
+    EXPECT_EQ(action_calls, 5);
+}
+
+TEST_F(EXTILineTest, OffLineIgnoresItsEdges) {
+    line.is_on = false;
+    line.debounce_cycles = 100;
+
+    edge_at(3, 1'000);
+
+    EXPECT_EQ(action_calls, 0);
+    EXPECT_FALSE(line.has_accepted);
+}
+
+TEST_F(EXTILineTest, EventHandlerQueuesEventsInsteadOfRunningTheAction) {
+    line.event_handler = ignore_event;
+
+    edge_at(7, 1'000, true);
+    edge_at(7, 2'000, false);
+    edge_at(7, 3'000, true);
+
+    EXPECT_EQ(action_calls, 0);
+    EXPECT_EQ(dropped, 1U);
+    EXTILine::Event event{};
+    ASSERT_TRUE(events.pop(event));
+    EXPECT_EQ(event.timestamp, 1'000U);
+    EXPECT_EQ(event.line, 7U);
+    EXPECT_EQ(event.edge, EXTILine::Edge::RISING);
+    ASSERT_TRUE(events.pop(event));
+    EXPECT_EQ(event.edge, EXTILine::Edge::FALLING);
+    EXPECT_FALSE(events.pop(event));
+}
+
+TEST_F(EXTILineTest, SingleEdgeTriggerRecordsItsEdgeWithoutReadingThePin) {
+    line.both_edges = false;
+    line.single_edge = EXTILine::Edge::FALLING;
+    bool pin_read = false;
+
+    const auto edge = line.edge([&pin_read] {
+        pin_read = true;
+        return true;
+    });
+
+    EXPECT_EQ(edge, EXTILine::Edge::FALLING);
+    EXPECT_FALSE(pin_read);
+}
+
+TEST(EXTILineDispatch, PendingLinesGoHighestFirst) {
+    std::vector<uint8_t> order;
+
+    EXTILine::for_each_pending((1U << 15) | (1U << 10) | (1U << 12) | 1U, [&order](uint8_t line) {
+        order.push_back(line);
+    });
+
+    EXPECT_EQ(order, (std::vector<uint8_t>{15, 12, 10, 0}));
+}
+
+TEST(EXTILineDispatch, NothingPendingCallsNothing) {
+    int calls = 0;
+
+    EXTILine::for_each_pending(0, [&calls](uint8_t) { calls++; });
+
+    EXPECT_EQ(calls, 0);
+}
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "Control/Blocks/FastPID.hpp"
+#include "Control/Blocks/PID.hpp"
+
+namespace {
+
+constexpr double PERIOD = 1e-3;
+constexpr double UNLIMITED = 1e9;
+
+/* y' = (u - y) / tau, integrated exactly over a period */
+struct FirstOrderPlant {
+    double tau;
+    double y = 0.0;
+
+    double step(double u) {
+        double decay = std::exp(-PERIOD / tau);
+        y = u + (y - u) * decay;
+        return y;
+    }
+};
+
+/**
+ * Setpoint 2 for a second, out of reach with the output limited to 1, then 0.5. Returns how long
+ * the plant takes to settle within 2% of 0.5 after the change.
+ */
+template <typename Controller> double settling_after_saturation(Controller&& control) {
+    FirstOrderPlant plant{0.1};
+    double u = 0.0;
+    int settled_at = -1;
+    for (int step = 0; step < 4000; step++) {
+        double setpoint = step < 1000 ? 2.0 : 0.5;
+        u = control(setpoint, plant.y);
+        plant.step(u);
+        bool inside = std::abs(plant.y - 0.5) < 0.01;
+        if (step >= 1000 && inside && settled_at < 0) {
+            settled_at = step;
+        } else if (!inside) {
+            settled_at = -1;
+        }
+    }
+    return settled_at < 0 ? 1e9 : (settled_at - 1000) * PERIOD;
+}
+
+} // namespace
+
+TEST(FastPID, ProportionalAndIntegralTermsMatchTheirSums) {
+    FastPID<double> pid({.kp = 2.0, .ki = 10.0}, PERIOD, -UNLIMITED, UNLIMITED);
+    for (int step = 0; step < 10; step++) {
+        double output = pid.execute(1.0, 0.5);
+        EXPECT_NEAR(output, 2.0 * 0.5 + 10.0 * PERIOD * 0.5 * step, 1e-12) << "step " << step;
+    }
+
+    FastPID<double> weighted(
+        {.kp = 2.0, .ki = 0.0, .setpoint_weight = 0.5},
+        PERIOD,
+        -UNLIMITED,
+        UNLIMITED
+    );
+    EXPECT_NEAR(weighted.execute(1.0, 0.2), 2.0 * (0.5 * 1.0 - 0.2), 1e-12);
+}
+
+TEST(FastPID, DerivativeActsOnTheMeasurementOnly) {
+    FastPID<double> pid({.kd = 0.1}, PERIOD, -UNLIMITED, UNLIMITED);
+    for (int step = 0; step < 10; step++) {
+        EXPECT_EQ(pid.execute(step < 5 ? 0.0 : 1.0, 0.3), 0.0);
+    }
+
+    /* Measurement ramping at 2 units per second */
+    double slope = 2.0;
+    pid.reset();
+    for (int step = 0; step < 10; step++) {
+        double output = pid.execute(1.0, slope * step * PERIOD);
+        EXPECT_NEAR(output, step == 0 ? 0.0 : -0.1 * slope, 1e-9) << "step " << step;
+    }
+
+    FastPID<double> filtered({.kd = 0.1, .derivative_filter = 0.01}, PERIOD, -1e9, 1e9);
+    double first = 0.0;
+    double output = 0.0;
+    for (int step = 0; step < 200; step++) {
+        output = filtered.execute(0.0, slope * step * PERIOD);
+        if (step == 1) {
+            first = output;
+        }
+    }
+    EXPECT_GT(first, -0.1 * slope * 0.2);
+    EXPECT_NEAR(output, -0.1 * slope, 1e-5);
+}
+
+TEST(FastPID, AntiWindupRecoversFromSaturationQuickly) {
+    /* Zero on the plant pole, 20 ms closed loop time constant */
+    PIDGains gains{.kp = 5.0, .ki = 50.0};
+    FastPID<double, AntiWindup::BackCalculation> back_calculation(gains, PERIOD, -1.0, 1.0);
+    FastPID<double, AntiWindup::ConditionalIntegration> conditional(gains, PERIOD, -1.0, 1.0);
+    /* The old way, a PID followed by a Saturator it doesn't know about */
+    PID<IntegratorType::BackwardEuler, FilterDerivatorType::None> plain(5.0, 50.0, 0.0, PERIOD);
+
+    double back_calculation_time = settling_after_saturation([&](double r, double y) {
+        return back_calculation.execute(r, y);
+    });
+    double conditional_time = settling_after_saturation([&](double r, double y) {
+        return conditional.execute(r, y);
+    });
+    double plain_time = settling_after_saturation([&](double r, double y) {
+        return std::clamp(plain.execute(r - y), -1.0, 1.0);
+    });
+
+    /* Conditional integration restarts from the integral it froze, back calculation tracks u */
+    EXPECT_LT(back_calculation_time, 0.1);
+    EXPECT_LT(conditional_time, 0.5);
+    EXPECT_GT(plain_time, 3 * std::max(back_calculation_time, conditional_time));
+    EXPECT_LE(std::abs(back_calculation.output_value), 1.0);
+}
+
+TEST(FastPID, GainChangesAreBumpless) {
+    FastPID<double> pid({.kp = 2.0, .ki = 20.0, .kd = 0.01}, PERIOD, -UNLIMITED, UNLIMITED);
+    FirstOrderPlant plant{0.1};
+
+    /* A ramping setpoint keeps a steady error, so the proportional term is not zero */
+    double previous = 0.0;
+    double largest_step = 0.0;
+    double kick = 0.0;
+    double unabsorbed = 0.0;
+    for (int step = 0; step < 2000; step++) {
+        double setpoint = 0.5 * step * PERIOD;
+        if (step == 1000) {
+            pid.set_gains({.kp = 6.0, .ki = 40.0, .kd = 0.02, .setpoint_weight = 0.7});
+            /* What the proportional and derivative terms alone would have jumped */
+            unabsorbed = std::abs((6.0 * 0.7 - 2.0) * setpoint - (6.0 - 2.0) * plant.y +
+                                  (0.02 - 0.01) * pid.rate);
+        }
+        double output = pid.execute(setpoint, plant.y);
+        plant.step(output);
+        if (step == 1000) {
+            kick = std::abs(output - previous);
+        } else if (step > 500) {
+            largest_step = std::max(largest_step, std::abs(output - previous));
+        }
+        previous = output;
+    }
+    EXPECT_EQ(pid.gains().kp, 6.0);
+    EXPECT_LT(kick, 2 * largest_step);
+    EXPECT_GT(unabsorbed, 20 * kick);
+}
+
+TEST(FastPID, FixedPointFollowsFloat) {
+    PIDGains gains{.kp = 2.0, .ki = 20.0};
+    FastPID<float> reference(gains, PERIOD, -1.0, 1.0);
+    FastPID<Q16> fixed(gains, PERIOD, -1.0, 1.0);
+    FirstOrderPlant reference_plant{0.1};
+    FirstOrderPlant fixed_plant{0.1};
+
+    double difference = 0.0;
+    for (int step = 0; step < 2000; step++) {
+        double setpoint = step < 1000 ? 0.8 : 0.3;
+        reference_plant.step(reference.execute(float(setpoint), float(reference_plant.y)));
+        fixed_plant.step(double(fixed.execute(Q16(setpoint), Q16(fixed_plant.y))));
+        difference = std::max(difference, std::abs(reference_plant.y - fixed_plant.y));
+    }
+    EXPECT_LT(difference, 5e-3);
+    EXPECT_NEAR(fixed_plant.y, 0.3, 1e-3);
+}
@@ -0,0 +1,134 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "Control/Blocks/FilterBank.hpp"
+#include "Control/Blocks/MovingAverage.hpp"
+
+namespace {
+
+constexpr double SAMPLE_RATE = 10'000.0;
+
+/* 13 channels leaves a tail after the vector lanes */
+constexpr size_t CHANNELS = 13;
+
+template <size_t N> void fill_random(std::array<float, N>& values) {
+    static uint32_t lcg = 777;
+    for (float& value : values) {
+        lcg = lcg * 1'664'525U + 1'013'904'223U;
+        value = static_cast<float>(lcg >> 8) / static_cast<float>(1U << 24) * 4.0f - 2.0f;
+    }
+}
+
+template <size_t N> bool same_bits(const std::array<float, N>& a, const std::array<float, N>& b) {
+    return std::memcmp(a.data(), b.data(), sizeof(float) * N) == 0;
+}
+
+/* Amplitude of a sine at frequency after it went through the first channel of bank */
+template <typename Bank> float gain_at(Bank& bank, double frequency) {
+    bank.reset();
+    float peak = 0.0f;
+    for (int n = 0; n < 4000; n++) {
+        bank.input_value.fill(static_cast<float>(std::sin(2 * M_PI * frequency * n / SAMPLE_RATE)));
+        bank.execute();
+        if (n >= 3000) {
+            peak = std::max(peak, std::abs(bank.output_value[0]));
+        }
+    }
+    return peak;
+}
+
+} // namespace
+
+TEST(FilterDesign, BiquadCoefficientsAreDesignedAtCompileTime) {
+    constexpr BiquadCoefficients lowpass = FilterDesign::lowpass(SAMPLE_RATE, 500.0);
+    static_assert(lowpass.b0 == lowpass.b2 && lowpass.b1 == 2 * lowpass.b0);
+
+    double k = std::tan(M_PI * 500.0 / SAMPLE_RATE);
+    double q = FilterDesign::butterworth_q;
+    double norm = 1.0 / (1.0 + k / q + k * k);
+    EXPECT_NEAR(lowpass.b0, k * k * norm, 1e-7);
+    EXPECT_NEAR(lowpass.a1, 2.0 * (k * k - 1.0) * norm, 1e-7);
+    EXPECT_NEAR(lowpass.a2, (1.0 - k / q + k * k) * norm, 1e-7);
+
+    constexpr auto taps = FilterDesign::fir_lowpass<15>(SAMPLE_RATE, 1'000.0);
+    float sum = 0.0f;
+    for (size_t n = 0; n < taps.size(); n++) {
+        EXPECT_FLOAT_EQ(taps[n], taps[taps.size() - 1 - n]);
+        sum += taps[n];
+    }
+    EXPECT_NEAR(sum, 1.0f, 1e-6f);
+}
+
+TEST(FilterBank, BiquadVectorAndScalarPathsAreBitIdentical) {
+    constexpr std::array<BiquadCoefficients, 3> stages{
+        FilterDesign::lowpass(SAMPLE_RATE, 800.0),
+        FilterDesign::highpass(SAMPLE_RATE, 20.0),
+        FilterDesign::bandpass(SAMPLE_RATE, 300.0, 2.0)
+    };
+    BiquadBank<CHANNELS, 3> vector(stages);
+    BiquadBank<CHANNELS, 3> scalar(stages);
+#if defined(__SSE__) || defined(__ARM_NEON)
+    static_assert(BiquadBank<CHANNELS, 3>::vectorized);
+#endif
+
+    for (int n = 0; n < 1000; n++) {
+        fill_random(vector.input_value);
+        scalar.input_value = vector.input_value;
+        vector.execute();
+        scalar.execute_scalar();
+        ASSERT_TRUE(same_bits(vector.output_value, scalar.output_value)) << "sample " << n;
+    }
+}
+
+TEST(FilterBank, FirVectorAndScalarPathsAreBitIdentical) {
+    constexpr auto taps = FilterDesign::fir_lowpass<31>(SAMPLE_RATE, 1'500.0);
+    FirBank<CHANNELS, 31> vector(taps);
+    FirBank<CHANNELS, 31> scalar(taps);
+
+    for (int n = 0; n < 1000; n++) {
+        fill_random(vector.input_value);
+        scalar.input_value = vector.input_value;
+        vector.execute();
+        scalar.execute_scalar();
+        ASSERT_TRUE(same_bits(vector.output_value, scalar.output_value)) << "sample " << n;
+    }
+}
+
+TEST(FilterBank, LowpassPassesDcAndRejectsHighFrequencies) {
+    BiquadBank<4, 2> bank({
+        FilterDesign::lowpass(SAMPLE_RATE, 200.0),
+        FilterDesign::lowpass(SAMPLE_RATE, 200.0),
+    });
+    EXPECT_NEAR(gain_at(bank, 10.0), 1.0f, 1e-2f);
+    EXPECT_LT(gain_at(bank, 2'000.0), 1e-2f);
+
+    bank.reset();
+    for (int n = 0; n < 2000; n++) {
+        bank.input_value = {1.0f, -2.0f, 0.5f, 0.0f};
+        bank.execute();
+    }
+    EXPECT_NEAR(bank.output_value[0], 1.0f, 1e-4f);
+    EXPECT_NEAR(bank.output_value[1], -2.0f, 1e-4f);
+    EXPECT_NEAR(bank.output_value[2], 0.5f, 1e-4f);
+    EXPECT_EQ(bank.output_value[3], 0.0f);
+}
+
+TEST(FilterBank, MovingAverageTapsMatchMovingAverage) {
+    FirBank<CHANNELS, 8> bank(FilterDesign::fir_moving_average<8>());
+    std::array<MovingAverage<8, float>, CHANNELS> averages;
+
+    for (int n = 0; n < 200; n++) {
+        fill_random(bank.input_value);
+        bank.execute();
+        for (size_t channel = 0; channel < CHANNELS; channel++) {
+            float expected = averages[channel].compute(bank.input_value[channel]);
+            if (n >= 8) {
+                EXPECT_NEAR(bank.output_value[channel], expected, 1e-5f);
+            }
+        }
+    }
+}
@@ -0,0 +1,268 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "Control/Blocks/FOC.hpp"
+
+namespace {
+
+constexpr double PERIOD = 1e-4;
+constexpr uint32_t PERIOD_COUNTS = 27'500;
+
+/* Per unit bases of the drive */
+constexpr double BUS_VOLTAGE = 48.0;
+constexpr double BASE_VOLTAGE = BUS_VOLTAGE / 1.7320508075688772;
+constexpr double BASE_CURRENT = 20.0;
+
+int32_t to_angle(double radians) {
+    double turns = std::fmod(radians / (2 * M_PI), 1.0);
+    return static_cast<int32_t>(static_cast<uint32_t>(std::llround(turns * 4294967296.0)));
+}
+
+/**
+ * Surface PMSM in the rotor frame, spun at a constant electrical speed by a dynamometer. The
+ * inverter is ideal, the leg duties hold for the whole period, which is also what the loop sees as
+ * its one period of delay.
+ */
+struct MotorPlant {
+    static constexpr double RESISTANCE = 0.1;
+    static constexpr double INDUCTANCE = 200e-6;
+    static constexpr double FLUX = 0.01;
+    static constexpr int SUBSTEPS = 20;
+
+    double speed;
+    double theta = 0.3;
+    double id = 0.0;
+    double iq = 0.0;
+
+    explicit MotorPlant(double speed) : speed(speed) {}
+
+    template <typename T> void apply(const std::array<T, 3>& duties) {
+        double d[3];
+        for (size_t leg = 0; leg < 3; leg++) {
+            d[leg] = static_cast<double>(duties[leg]);
+        }
+        double mean = (d[0] + d[1] + d[2]) / 3.0;
+        double va = BUS_VOLTAGE * (d[0] - mean);
+        double vb = BUS_VOLTAGE * (d[1] - mean);
+        double alpha = va;
+        double beta = (va + 2.0 * vb) / std::sqrt(3.0);
+
+        double dt = PERIOD / SUBSTEPS;
+        for (int step = 0; step < SUBSTEPS; step++) {
+            double vd = alpha * std::cos(theta) + beta * std::sin(theta);
+            double vq = beta * std::cos(theta) - alpha * std::sin(theta);
+            double did = (vd - RESISTANCE * id + speed * INDUCTANCE * iq) / INDUCTANCE;
+            double diq = (vq - RESISTANCE * iq - speed * INDUCTANCE * id - speed * FLUX) /
+                         INDUCTANCE;
+            id += did * dt;
+            iq += diq * dt;
+            theta += speed * dt;
+        }
+    }
+
+    /* Phase currents a and b in per unit and the angle, as the ADC and encoder would see them */
+    template <typename T> FOC::Sample<T> sample() const {
+        double alpha = id * std::cos(theta) - iq * std::sin(theta);
+        double beta = id * std::sin(theta) + iq * std::cos(theta);
+        double ib = -0.5 * alpha + 0.5 * std::sqrt(3.0) * beta;
+        return {T(alpha / BASE_CURRENT), T(ib / BASE_CURRENT), to_angle(theta)};
+    }
+};
+
+/* Current loop tuned for 400 Hz of bandwidth, the PI zero cancelling the winding pole */
+template <typename T> FieldOrientedControl<T, FOC::SoftwareSinCos> make_foc(double max = 1.0) {
+    constexpr double bandwidth = 2 * M_PI * 400.0;
+    constexpr double scale = BASE_CURRENT / BASE_VOLTAGE;
+    return FieldOrientedControl<T, FOC::SoftwareSinCos>(
+        MotorPlant::INDUCTANCE * bandwidth * scale,
+        MotorPlant::RESISTANCE * bandwidth * scale,
+        PERIOD,
+        PERIOD_COUNTS,
+        max
+    );
+}
+
+template <typename T>
+void run(FieldOrientedControl<T, FOC::SoftwareSinCos>& foc, MotorPlant& motor, int steps) {
+    for (int step = 0; step < steps; step++) {
+        foc.input(motor.sample<T>());
+        foc.execute();
+        motor.apply(foc.output_value);
+    }
+}
+
+struct MockTimer {
+    std::array<uint32_t, 3> compares{};
+    int writes = 0;
+
+    template <size_t N> void set_capture_compares(const std::array<uint32_t, N>& counts) {
+        static_assert(N == 3);
+        compares = counts;
+        writes++;
+    }
+};
+
+} // namespace
+
+TEST(FOC, TransformsRecoverTheCurrentVector) {
+    for (double theta = -3.0; theta < 3.0; theta += 0.37) {
+        double phi = 0.8;
+        double amplitude = 0.7;
+        double ia = amplitude * std::cos(theta + phi);
+        double ib = amplitude * std::cos(theta + phi - 2 * M_PI / 3);
+
+        auto rotation = FOC::SoftwareSinCos::compute<float>(to_angle(theta));
+        auto dq = FOC::park(FOC::clarke(float(ia), float(ib)), rotation);
+        EXPECT_NEAR(dq.d, amplitude * std::cos(phi), 1e-5);
+        EXPECT_NEAR(dq.q, amplitude * std::sin(phi), 1e-5);
+
+        auto rotation_q31 = FOC::SoftwareSinCos::compute<Q31>(to_angle(theta));
+        auto dq_q31 = FOC::park(FOC::clarke(Q31(ia), Q31(ib)), rotation_q31);
+        EXPECT_NEAR(double(dq_q31.d), amplitude * std::cos(phi), 1e-6);
+        EXPECT_NEAR(double(dq_q31.q), amplitude * std::sin(phi), 1e-6);
+
+        auto back = FOC::inverse_park(dq, rotation);
+        EXPECT_NEAR(back.alpha, ia, 1e-5);
+    }
+}
+
+TEST(FOC, SvpwmSynthesizesTheVectorInsideTheRange) {
+    for (double magnitude : {0.3, 1.0}) {
+        double top = 0.0;
+        for (double theta = 0.0; theta < 2 * M_PI; theta += 0.05) {
+            FOC::AlphaBeta<float> v{
+                float(magnitude * std::cos(theta)),
+                float(magnitude * std::sin(theta))
+            };
+            std::array<float, 3> duties = FOC::svpwm(v);
+            double mean = (duties[0] + duties[1] + duties[2]) / 3.0;
+            /* Phase voltages in per unit of Vdc / sqrt(3) */
+            double va = std::sqrt(3.0) * (duties[0] - mean);
+            double vb = std::sqrt(3.0) * (duties[1] - mean);
+            EXPECT_NEAR(va, v.alpha, 1e-5);
+            EXPECT_NEAR((va + 2 * vb) / std::sqrt(3.0), v.beta, 1e-5);
+            for (float duty : duties) {
+                EXPECT_GE(duty, -1e-6f);
+                EXPECT_LE(duty, 1.0f + 1e-6f);
+                top = std::max(top, double(duty));
+            }
+
+            std::array<Q31, 3> fixed = FOC::svpwm(FOC::AlphaBeta<Q31>{Q31(v.alpha), Q31(v.beta)});
+            for (size_t leg = 0; leg < 3; leg++) {
+                EXPECT_NEAR(double(fixed[leg]), duties[leg], 1e-6);
+                EXPECT_NEAR(
+                    FOC::duty_to_counts(fixed[leg], PERIOD_COUNTS),
+                    FOC::duty_to_counts(duties[leg], PERIOD_COUNTS),
+                    1.0
+                );
+            }
+        }
+        if (magnitude == 1.0) {
+            EXPECT_NEAR(top, 1.0, 1e-3);
+        }
+    }
+}
+
+TEST(FOC, FixedPointGainsAndSquareRoot) {
+    FOC::Gain<Q31> gain(5.0);
+    EXPECT_NEAR(gain.value(), 5.0, 1e-8);
+    EXPECT_NEAR(double(gain * Q31(0.1)), 0.5, 1e-8);
+    EXPECT_EQ(gain * Q31(0.5), Q31::max());
+    EXPECT_EQ(gain * Q31(-0.5), Q31::min());
+    EXPECT_NEAR(double(FOC::Gain<Q31>(-0.25) * Q31(0.5)), -0.125, 1e-9);
+
+    for (double x : {0.0, 1e-6, 0.09, 0.5, 0.999}) {
+        EXPECT_NEAR(double(FOC::square_root(Q31(x))), std::sqrt(double(Q31(x))), 1e-9);
+    }
+    EXPECT_EQ(FOC::square_root(Q31(-0.2)), Q31{});
+
+    FOC::CurrentSense<Q31> sense(32'768, 1.0 / 20'000.0);
+    EXPECT_NEAR(double(sense(32'768 + 4'000)), 0.2, 1e-8);
+    EXPECT_NEAR(double(sense(32'768 - 10'000)), -0.5, 1e-8);
+    EXPECT_NEAR(FOC::CurrentSense<float>(2'048, 1e-3)(2'000), -0.048f, 1e-6f);
+}
+
+TEST(FOC, ClosedLoopTracksTheCurrentReference) {
+    /* 2000 rpm with four pole pairs */
+    constexpr double speed = 2000.0 / 60.0 * 2 * M_PI * 4;
+    MotorPlant motor(speed);
+    MotorPlant motor_q31(speed);
+    auto foc = make_foc<float>();
+    auto foc_q31 = make_foc<Q31>();
+
+    foc.reference = {0.0f, 0.5f};
+    foc_q31.reference = {Q31(0.0), Q31(0.5)};
+    double difference = 0.0;
+    for (int step = 0; step < 400; step++) {
+        run(foc, motor, 1);
+        run(foc_q31, motor_q31, 1);
+        difference = std::max(difference, std::abs(motor.iq - motor_q31.iq) / BASE_CURRENT);
+    }
+    EXPECT_NEAR(motor.iq / BASE_CURRENT, 0.5, 0.005);
+    EXPECT_NEAR(motor.id / BASE_CURRENT, 0.0, 0.005);
+    EXPECT_NEAR(motor_q31.iq / BASE_CURRENT, 0.5, 0.005);
+    EXPECT_NEAR(motor_q31.id / BASE_CURRENT, 0.0, 0.005);
+    EXPECT_LT(difference, 1e-3);
+
+    /* The loop estimate agrees with the plant */
+    EXPECT_NEAR(foc.current.q, 0.5f, 0.005f);
+    EXPECT_NEAR(double(foc_q31.current.q), 0.5, 0.005);
+}
+
+TEST(FOC, AntiWindupRecoversFromVoltageSaturation) {
+    /* 5000 rpm, the back EMF leaves too little voltage for 0.9 per unit under a 0.8 limit */
+    constexpr double speed = 5000.0 / 60.0 * 2 * M_PI * 4;
+    constexpr double limit = 0.8;
+    MotorPlant motor(speed);
+    auto foc = make_foc<Q31>(limit);
+
+    foc.reference = {Q31(0.0), Q31(0.9)};
+    for (int step = 0; step < 500; step++) {
+        run(foc, motor, 1);
+        double vd = double(foc.voltage.d);
+        double vq = double(foc.voltage.q);
+        ASSERT_LE(std::sqrt(vd * vd + vq * vq), limit + 1e-6) << "step " << step;
+    }
+    EXPECT_LT(motor.iq / BASE_CURRENT, 0.85);
+    EXPECT_LE(std::abs(double(foc.q_axis.integral)), limit + 1e-9);
+
+    /* Back to a reachable reference, no wound up integrator to unwind into an overshoot */
+    foc.reference.q = Q31(0.3);
+    double peak = 0.0;
+    bool settled_below = false;
+    for (int step = 0; step < 200; step++) {
+        run(foc, motor, 1);
+        settled_below = settled_below || motor.iq / BASE_CURRENT < 0.3;
+        if (settled_below) {
+            peak = std::max(peak, motor.iq / BASE_CURRENT);
+        }
+    }
+    EXPECT_LT(peak, 0.31);
+    EXPECT_NEAR(motor.iq / BASE_CURRENT, 0.3, 0.005);
+    EXPECT_NEAR(motor.id / BASE_CURRENT, 0.0, 0.005);
+}
+
+TEST(FOC, OnSampleConvertsAndWritesTheCompareRegisters) {
+    auto foc = make_foc<Q31>();
+    foc.sense_a = FOC::CurrentSense<Q31>(32'768, 1.0 / 16'384.0);
+    foc.sense_b = FOC::CurrentSense<Q31>(32'768, 1.0 / 16'384.0);
+    auto reference = make_foc<Q31>();
+    MockTimer timer;
+
+    EXPECT_EQ(foc.compare_counts[0], PERIOD_COUNTS / 2);
+    foc.reference = reference.reference = {Q31(0.1), Q31(0.2)};
+    foc.on_sample(timer, 32'768 + 1'638, 32'768 - 819, to_angle(1.0));
+    reference.on_sample(Q31(1'638 / 16'384.0), Q31(-819 / 16'384.0), to_angle(1.0));
+
+    EXPECT_EQ(timer.writes, 1);
+    EXPECT_EQ(timer.compares, foc.compare_counts);
+    EXPECT_NEAR(double(foc.current.d), double(reference.current.d), 1e-8);
+    EXPECT_NEAR(double(foc.current.q), double(reference.current.q), 1e-8);
+    for (size_t leg = 0; leg < 3; leg++) {
+        EXPECT_NEAR(timer.compares[leg], reference.compare_counts[leg], 1.0);
+        EXPECT_LE(timer.compares[leg], PERIOD_COUNTS);
+    }
+}
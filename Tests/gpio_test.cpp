@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "HALAL/Models/GPIO.hpp"
+#include "ST-LIB_LOW/DigitalInput2.hpp"
+#include "ST-LIB_LOW/DigitalOutput2.hpp"
+
+using ST_LIB::GPIODomain;
+
+namespace {
+
+constexpr GPIODomain::Pin test_pb0{GPIODomain::Port::B, GPIO_PIN_0, 0};
+constexpr GPIODomain::Pin test_pb3{GPIODomain::Port::B, GPIO_PIN_3, 0};
+constexpr GPIODomain::Pin test_pb7{GPIODomain::Port::B, GPIO_PIN_7, 0};
+constexpr GPIODomain::Pin test_pc13{GPIODomain::Port::C, GPIO_PIN_13, 0};
+
+constexpr ST_LIB::DigitalOutputDomain::DigitalOutput test_out{test_pb7};
+constexpr ST_LIB::DigitalInputDomain::DigitalInput test_in{test_pc13};
+
+class GPIOFastPathTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (GPIO_TypeDef* port : {GPIOB, GPIOC}) {
+            port->ODR = 0;
+            port->IDR = 0;
+            port->BSRR = 0;
+        }
+    }
+};
+
+} // namespace
+
+TEST_F(GPIOFastPathTest, FastPinIsSingleBSRRWrite) {
+    using Led = GPIODomain::FastPin<test_pb3>;
+
+    Led::turn_on();
+    EXPECT_EQ(GPIOB->BSRR, GPIO_PIN_3);
+    Led::turn_off();
+    EXPECT_EQ(GPIOB->BSRR, GPIO_PIN_3 << 16);
+
+    GPIOB->ODR = GPIO_PIN_3;
+    Led::toggle();
+    EXPECT_EQ(GPIOB->BSRR, GPIO_PIN_3 << 16);
+    GPIOB->ODR = 0;
+    Led::toggle();
+    EXPECT_EQ(GPIOB->BSRR, GPIO_PIN_3);
+
+    GPIOB->IDR = GPIO_PIN_3 | GPIO_PIN_0;
+    EXPECT_EQ(Led::read(), GPIO_PIN_SET);
+    GPIOB->IDR = GPIO_PIN_0;
+    EXPECT_EQ(Led::read(), GPIO_PIN_RESET);
+}
+
+TEST_F(GPIOFastPathTest, PinGroupWritesAndReadsPortAtOnce) {
+    using Bus = GPIODomain::PinGroup<test_pb0, test_pb3, test_pb7>;
+    static_assert(std::is_same_v<Bus, GPIODomain::PortPins<GPIODomain::Port::B, 0x89U>>);
+
+    Bus::set();
+    EXPECT_EQ(GPIOB->BSRR, GPIO_PIN_0 | GPIO_PIN_3 | GPIO_PIN_7);
+    Bus::clear();
+    EXPECT_EQ(GPIOB->BSRR, (GPIO_PIN_0 | GPIO_PIN_3 | GPIO_PIN_7) << 16);
+
+    // bits outside the group are ignored, pins of the group not set are reset
+    Bus::write(GPIO_PIN_3 | GPIO_PIN_1);
+    EXPECT_EQ(GPIOB->BSRR, GPIO_PIN_3 | ((GPIO_PIN_0 | GPIO_PIN_7) << 16));
+
+    GPIOB->ODR = GPIO_PIN_0 | GPIO_PIN_5;
+    Bus::toggle();
+    EXPECT_EQ(GPIOB->BSRR, (GPIO_PIN_0 << 16) | GPIO_PIN_3 | GPIO_PIN_7);
+
+    GPIOB->IDR = 0xFFFF;
+    EXPECT_EQ(Bus::read(), GPIO_PIN_0 | GPIO_PIN_3 | GPIO_PIN_7);
+}
+
+TEST_F(GPIOFastPathTest, DigitalDomainsExposeFastAccess) {
+    using Out = ST_LIB::DigitalOutputDomain::FastOutput<test_out>;
+    using In = ST_LIB::DigitalInputDomain::FastInput<test_in>;
+
+    Out::turn_on();
+    EXPECT_EQ(GPIOB->BSRR, GPIO_PIN_7);
+
+    GPIOC->IDR = GPIO_PIN_13;
+    EXPECT_EQ(In::read(), GPIO_PIN_SET);
+}
@@ -0,0 +1,161 @@
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "C++Utilities/HeapGuard.hpp"
+#include "Protections/IsrProtection.hpp"
+
+using namespace Protections;
+
+namespace {
+
+/* Trips and notifications the main loop would have done, in the order it did them */
+std::vector<std::string> service_main_loop() {
+    std::vector<std::string> notified;
+    if (FaultLatch::take_pending()) {
+        FaultLatch::for_each_unreported([&](IsrProtectionBase& protection) {
+            std::array<char, IsrProtectionBase::DESCRIPTION_SIZE> text;
+            notified.emplace_back(protection.describe(text));
+        });
+    }
+    return notified;
+}
+
+class IsrProtectionTest : public ::testing::Test {
+protected:
+    void SetUp() override { FaultLatch::clear(); }
+    void TearDown() override { FaultLatch::clear(); }
+};
+
+} // namespace
+
+TEST_F(IsrProtectionTest, BoundsMatchBoundarySemantics) {
+    IsrProtection<float, BELOW> below("below", 10.0f);
+    IsrProtection<float, ABOVE> above("above", 10.0f);
+    IsrProtection<int, EQUALS> equals("equals", 3);
+    IsrProtection<int, NOT_EQUALS> not_equals("not_equals", 3);
+    IsrProtection<uint16_t, OUT_OF_RANGE> range("range", 100, 200);
+
+    EXPECT_EQ(below.check(10.0f), OK);
+    EXPECT_EQ(below.check(9.9f), FAULT);
+    EXPECT_EQ(above.check(10.0f), OK);
+    EXPECT_EQ(above.check(10.1f), FAULT);
+    EXPECT_EQ(equals.check(2), OK);
+    EXPECT_EQ(equals.check(3), FAULT);
+    EXPECT_EQ(not_equals.check(3), OK);
+    EXPECT_EQ(not_equals.check(4), FAULT);
+    EXPECT_EQ(range.check(100), OK);
+    EXPECT_EQ(range.check(200), OK);
+    EXPECT_EQ(range.check(99), FAULT);
+    EXPECT_EQ(range.check(201), FAULT);
+}
+
+TEST_F(IsrProtectionTest, LatchesTheFirstValueUntilCleared) {
+    IsrProtection<float, ABOVE> overcurrent("phase_current", 150.0f);
+    EXPECT_FALSE(FaultLatch::is_latched());
+
+    overcurrent.check(100.0f);
+    EXPECT_FALSE(overcurrent.is_tripped());
+    overcurrent.check(180.0f);
+    overcurrent.check(250.0f);
+    overcurrent.check(20.0f);
+    EXPECT_TRUE(overcurrent.is_tripped());
+    EXPECT_TRUE(FaultLatch::is_latched());
+    EXPECT_EQ(overcurrent.frozen_value(), 180.0f);
+
+    FaultLatch::clear();
+    EXPECT_FALSE(FaultLatch::is_latched());
+    EXPECT_FALSE(overcurrent.is_tripped());
+    overcurrent.check(160.0f);
+    EXPECT_EQ(overcurrent.frozen_value(), 160.0f);
+}
+
+TEST_F(IsrProtectionTest, MainLoopIsNotifiedOncePerProtection) {
+    IsrProtection<float, ABOVE> overcurrent("phase_current", 150.0f);
+    IsrProtection<float, OUT_OF_RANGE> bus("bus_voltage", 300.0f, 450.0f);
+
+    EXPECT_TRUE(service_main_loop().empty());
+
+    overcurrent.check(151.0f);
+    overcurrent.check(152.0f);
+    std::vector<std::string> notified = service_main_loop();
+    ASSERT_EQ(notified.size(), 1u);
+    EXPECT_EQ(notified[0], "phase_current above 150: 151");
+    EXPECT_TRUE(service_main_loop().empty());
+
+    /* Still latched, a second protection is reported on its own */
+    overcurrent.check(153.0f);
+    bus.check(500.0f);
+    notified = service_main_loop();
+    ASSERT_EQ(notified.size(), 1u);
+    EXPECT_EQ(notified[0], "bus_voltage out of range [300, 450]: 500");
+
+    FaultLatch::clear();
+    overcurrent.check(151.0f);
+    EXPECT_EQ(service_main_loop().size(), 1u);
+}
+
+TEST_F(IsrProtectionTest, DescribesIntoTheCallerBuffer) {
+    IsrProtection<float, OUT_OF_RANGE> bus("bus_voltage", 300.0f, 450.0f);
+    bus.check(500.0f);
+
+    std::array<char, IsrProtectionBase::DESCRIPTION_SIZE> text;
+    std::array<char, 12> short_text;
+    const uint32_t blocked_before = HeapGuard::blocked_allocations();
+    HeapGuard::set_handler([](std::size_t) {});
+    HeapGuard::lock();
+    const std::string_view description = bus.describe(text);
+    const std::string_view truncated = bus.describe(short_text);
+    HeapGuard::unlock();
+    HeapGuard::set_handler(nullptr);
+
+    EXPECT_EQ(HeapGuard::blocked_allocations(), blocked_before);
+    EXPECT_EQ(description, "bus_voltage out of range [300, 450]: 500");
+    EXPECT_EQ(truncated, "bus_voltage");
+    EXPECT_EQ(short_text.back(), '\0');
+}
+
+TEST_F(IsrProtectionTest, TripRaisesASoftwareBreak) {
+    static TIM_TypeDef break_timer{nullptr, TIM1_UP_IRQn};
+    static bool added = FaultLatch::add_break_output(&break_timer);
+    ASSERT_TRUE(added);
+
+    IsrProtection<int32_t, BELOW> undervoltage("dc_link", 200);
+    SET_BIT(break_timer.BDTR, TIM_BDTR_MOE);
+    break_timer.EGR = 0;
+    undervoltage.check(250);
+    EXPECT_EQ(static_cast<uint32_t>(break_timer.EGR), 0u);
+    undervoltage.check(150);
+    /* The break event clears MOE in hardware, BDTR itself is never written */
+    EXPECT_EQ(static_cast<uint32_t>(break_timer.EGR), TIM_EGR_BG);
+    EXPECT_TRUE(READ_BIT(break_timer.BDTR, TIM_BDTR_MOE));
+}
+
+TEST_F(IsrProtectionTest, ConcurrentTripsAreNeverLost) {
+    IsrProtection<uint32_t, ABOVE> overcurrent("phase_current", 1000);
+    for (int round = 0; round < 50; round++) {
+        FaultLatch::clear();
+        std::atomic<bool> done{false};
+        /* Stands in for the ADC interrupt, the first violation is sample 5000 + round */
+        std::thread isr([&] {
+            for (uint32_t sample = 0; sample < 10'000; sample++) {
+                overcurrent.check(sample < 5000 + round ? 0 : sample);
+            }
+            done.store(true);
+        });
+
+        size_t notifications = 0;
+        while (!done.load()) {
+            notifications += service_main_loop().size();
+        }
+        isr.join();
+        notifications += service_main_loop().size();
+
+        ASSERT_EQ(notifications, 1u) << "round " << round;
+        ASSERT_EQ(overcurrent.frozen_value(), 5000u + round) << "round " << round;
+    }
+}
@@ -0,0 +1,101 @@
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "C++Utilities/MPSCQueue.hpp"
+
+TEST(MPSCQueue, KeepsFifoOrderAndRejectsWhenFull) {
+    MPSCQueue<uint32_t, 4> queue;
+    uint32_t value = 0;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(value));
+    for (uint32_t lap = 0; lap < 3; lap++) {
+        for (uint32_t i = 0; i < 4; i++) {
+            EXPECT_TRUE(queue.push(lap * 4 + i));
+        }
+        EXPECT_FALSE(queue.push(99));
+        for (uint32_t i = 0; i < 4; i++) {
+            ASSERT_TRUE(queue.pop(value));
+            EXPECT_EQ(value, lap * 4 + i);
+        }
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(MPSCQueue, BatchPushIsAllOrNothing) {
+    MPSCQueue<uint32_t, 8> queue;
+    const std::array<uint32_t, 5> batch{1, 2, 3, 4, 5};
+
+    EXPECT_TRUE(queue.push(batch));
+    EXPECT_FALSE(queue.push(batch));
+    EXPECT_EQ(queue.size(), 5U);
+    EXPECT_TRUE(queue.push(std::span<const uint32_t>(batch).first(3)));
+    EXPECT_FALSE(queue.push(0));
+
+    std::array<uint32_t, 16> out{};
+    ASSERT_EQ(queue.pop(out), 8U);
+    EXPECT_EQ(out[4], 5U);
+    EXPECT_EQ(out[7], 3U);
+
+    /* wrapping around the end of the buffer */
+    EXPECT_TRUE(queue.push(batch));
+    ASSERT_EQ(queue.pop(out), 5U);
+    EXPECT_EQ(out[0], 1U);
+    EXPECT_EQ(out[4], 5U);
+}
+
+TEST(MPSCQueue, ProducerThreadsKeepTheirOwnOrderAndBatchesTogether) {
+    static MPSCQueue<uint64_t, 128> queue;
+    constexpr uint32_t producers = 4;
+    constexpr uint32_t batches = 20'000;
+    constexpr uint32_t batch_size = 3;
+
+    /* item = producer << 32 | sequence, each producer pushes batches of consecutive sequences */
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < producers; p++) {
+        threads.emplace_back([p] {
+            for (uint32_t b = 0; b < batches; b++) {
+                std::array<uint64_t, batch_size> batch{};
+                for (uint32_t i = 0; i < batch_size; i++) {
+                    batch[i] = (uint64_t{p} << 32) | (b * batch_size + i);
+                }
+                while (!queue.push(batch)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::array<uint32_t, producers> next{};
+    uint64_t received = 0;
+    uint64_t value = 0;
+    while (received < uint64_t{producers} * batches * batch_size) {
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const auto producer = static_cast<uint32_t>(value >> 32);
+        const auto sequence = static_cast<uint32_t>(value);
+        ASSERT_LT(producer, producers);
+        ASSERT_EQ(sequence, next[producer]);
+        next[producer]++;
+        received++;
+        /* the rest of the batch follows right away */
+        for (uint32_t i = sequence % batch_size + 1; i < batch_size; i++) {
+            while (!queue.pop(value)) {
+                std::this_thread::yield();
+            }
+            ASSERT_EQ(value, (uint64_t{producer} << 32) | next[producer]);
+            next[producer]++;
+            received++;
+        }
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
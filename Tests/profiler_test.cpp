@@ -0,0 +1,151 @@
+#include <array>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "HALAL/Benchmarking_toolkit/Profiler/Profiler.hpp"
+
+using ST_LIB::Profiler;
+
+namespace {
+
+/* The mocked CYCCNT only moves when written, so every zone takes a known number of cycles */
+void advance(uint32_t cycles) { DWT->CYCCNT = DWT->CYCCNT + cycles; }
+
+void inner_step() {
+    ST_LIB_PROFILE_ZONE("test.inner");
+    advance(100);
+}
+
+void outer_step() {
+    ST_LIB_PROFILE_ZONE("test.outer");
+    advance(50);
+    inner_step();
+    advance(20);
+    inner_step();
+    advance(30);
+}
+
+uint8_t id_of(const char* name) {
+    for (uint8_t id = 0; id < Profiler::zones(); id++) {
+        if (std::strcmp(Profiler::name(id), name) == 0) {
+            return id;
+        }
+    }
+    return Profiler::NO_ZONE;
+}
+
+class ProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        DWT->CTRL = 0;
+        DWT->CYCCNT = 1'000;
+        Profiler::start();
+    }
+};
+
+} // namespace
+
+TEST_F(ProfilerTest, StartKeepsTheCounterRunning) {
+    EXPECT_TRUE(DataWatchpointTrace::is_running());
+    EXPECT_EQ(DWT->CYCCNT, 1'000U);
+    EXPECT_NE(CoreDebug->DEMCR & DEMCR_TRCENA, 0U);
+}
+
+TEST_F(ProfilerTest, CountHelpersNeitherResetNorStopTheCounter) {
+    const uint32_t begin = DataWatchpointTrace::start_count();
+    advance(250);
+    const uint32_t end = DataWatchpointTrace::stop_count();
+
+    EXPECT_EQ(begin, 1'000U);
+    EXPECT_EQ(DataWatchpointTrace::elapsed(begin, end), 250U);
+    DataWatchpointTrace::start();
+    EXPECT_TRUE(DataWatchpointTrace::is_running());
+    EXPECT_EQ(DWT->CYCCNT, 1'250U);
+}
+
+TEST_F(ProfilerTest, NestedZonesKeepTotalSelfAndParent) {
+    outer_step();
+    outer_step();
+
+    const uint8_t outer = id_of("test.outer");
+    const uint8_t inner = id_of("test.inner");
+    ASSERT_NE(outer, Profiler::NO_ZONE);
+    ASSERT_NE(inner, Profiler::NO_ZONE);
+
+    const auto& o = Profiler::zone_stats(outer);
+    EXPECT_EQ(o.count, 2U);
+    EXPECT_EQ(o.total, 2U * 300U);
+    EXPECT_EQ(o.self, 2U * 100U);
+    EXPECT_EQ(o.min, 300U);
+    EXPECT_EQ(o.max, 300U);
+    EXPECT_EQ(o.parent, Profiler::NO_ZONE);
+
+    const auto& i = Profiler::zone_stats(inner);
+    EXPECT_EQ(i.count, 4U);
+    EXPECT_EQ(i.total, 400U);
+    EXPECT_EQ(i.self, 400U);
+    EXPECT_EQ(i.parent, outer);
+    EXPECT_EQ(Profiler::hash(inner), ST_LIB::ProfileZoneName("test.inner").hash);
+}
+
+TEST_F(ProfilerTest, CountsAcrossTheCounterWrap) {
+    DWT->CYCCNT = 0xFFFF'FF00U;
+    inner_step();
+    advance(0x200);
+    inner_step();
+
+    const auto& i = Profiler::zone_stats(id_of("test.inner"));
+    EXPECT_EQ(i.count, 2U);
+    EXPECT_EQ(i.total, 200U);
+    EXPECT_EQ(i.max, 100U);
+}
+
+TEST_F(ProfilerTest, DeepNestingIsDroppedNotCorrupted) {
+    for (std::size_t i = 0; i < Profiler::kMaxDepth + 3; i++) {
+        Profiler::enter(Profiler::NO_ZONE);
+    }
+    inner_step();
+    for (std::size_t i = 0; i < Profiler::kMaxDepth + 3; i++) {
+        Profiler::leave();
+    }
+    EXPECT_EQ(Profiler::dropped_zones(), 4U);
+    EXPECT_EQ(Profiler::zone_stats(id_of("test.inner")).count, 0U);
+
+    outer_step();
+    EXPECT_EQ(Profiler::zone_stats(id_of("test.outer")).parent, Profiler::NO_ZONE);
+    EXPECT_EQ(Profiler::zone_stats(id_of("test.inner")).count, 2U);
+}
+
+TEST_F(ProfilerTest, RingKeepsTheLastSamplesInOrder) {
+    static_assert(Profiler::kRingSize >= 4);
+    for (std::size_t i = 0; i < Profiler::kRingSize; i++) {
+        outer_step();
+    }
+
+    std::array<Profiler::Sample, 3> last{};
+    ASSERT_EQ(Profiler::copy_samples(last), 3U);
+    EXPECT_EQ(last[0].zone, id_of("test.inner"));
+    EXPECT_EQ(last[0].depth, 1U);
+    EXPECT_EQ(last[1].zone, id_of("test.inner"));
+    EXPECT_EQ(last[1].start, last[0].start + 120U);
+    EXPECT_EQ(last[2].zone, id_of("test.outer"));
+    EXPECT_EQ(last[2].cycles, 300U);
+}
+
+TEST_F(ProfilerTest, SnapshotFillsThePacketReport) {
+    outer_step();
+    const Profiler::Report& report = Profiler::snapshot();
+    const uint8_t outer = id_of("test.outer");
+    const uint8_t inner = id_of("test.inner");
+
+    EXPECT_EQ(report.zone_count, Profiler::zones());
+    EXPECT_EQ(report.timestamp, DWT->CYCCNT);
+    EXPECT_EQ(report.hash[outer], Profiler::hash(outer));
+    EXPECT_EQ(report.count[inner], 2U);
+    EXPECT_EQ(report.parent[inner], outer);
+    EXPECT_EQ(report.total[outer], 300U);
+    EXPECT_EQ(report.self[outer], 100U);
+    EXPECT_EQ(report.min[inner], 100U);
+    EXPECT_EQ(sizeof(Profiler::Report), 9U + Profiler::kMaxZones * 33U);
+}
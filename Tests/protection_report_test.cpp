@@ -0,0 +1,298 @@
+#include <array>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Protections/ReportAggregator.hpp"
+
+using namespace Protections;
+
+namespace {
+
+struct Socket {
+    std::vector<std::vector<uint8_t>> received;
+    bool accepting = true;
+};
+
+using Aggregator = ReportAggregator<Socket, 64, 4, 4>;
+
+constexpr uint64_t MS = 1'000'000;
+
+struct Entry {
+    uint16_t id;
+    uint8_t type;
+    uint8_t state;
+    uint16_t repeats;
+    float value;
+};
+
+struct Report {
+    uint16_t packet_id;
+    uint16_t sequence;
+    uint64_t timestamp;
+    uint8_t flags;
+    std::vector<Entry> entries;
+};
+
+template <typename Value> Value take(const uint8_t*& data) {
+    Value value;
+    std::memcpy(&value, data, sizeof(value));
+    data += sizeof(value);
+    return value;
+}
+
+Report decode_report(const std::vector<uint8_t>& packet) {
+    const uint8_t* data = packet.data();
+    Report report;
+    report.packet_id = take<uint16_t>(data);
+    report.sequence = take<uint16_t>(data);
+    report.timestamp = take<uint64_t>(data);
+    uint8_t count = take<uint8_t>(data);
+    report.flags = take<uint8_t>(data);
+    for (uint8_t i = 0; i < count; i++) {
+        Entry entry;
+        entry.id = take<uint16_t>(data);
+        entry.type = take<uint8_t>(data);
+        entry.state = take<uint8_t>(data);
+        entry.repeats = take<uint16_t>(data);
+        entry.value = take<float>(data);
+        report.entries.push_back(entry);
+    }
+    EXPECT_EQ(data, packet.data() + packet.size());
+    return report;
+}
+
+std::vector<std::string> decode_names(const std::vector<uint8_t>& packet, uint16_t& first) {
+    const uint8_t* data = packet.data();
+    EXPECT_EQ(take<uint16_t>(data), 4001);
+    first = take<uint16_t>(data);
+    uint8_t count = take<uint8_t>(data);
+    std::vector<std::string> names;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t length = take<uint8_t>(data);
+        names.emplace_back(reinterpret_cast<const char*>(data), length);
+        data += length;
+    }
+    EXPECT_EQ(data, packet.data() + packet.size());
+    return names;
+}
+
+bool flush(Aggregator& aggregator, Socket& socket, uint64_t now) {
+    return aggregator.flush(&socket, now, [&](std::span<const uint8_t> packet) {
+        if (socket.accepting) {
+            socket.received.emplace_back(packet.begin(), packet.end());
+        }
+        return socket.accepting;
+    });
+}
+
+/* Sends the whole name table so the next packets are reports */
+void connect(Aggregator& aggregator, Socket& socket, uint64_t now) {
+    ASSERT_TRUE(flush(aggregator, socket, now));
+    while (flush(aggregator, socket, now)) {
+    }
+    for (const std::vector<uint8_t>& packet : socket.received) {
+        const uint8_t* data = packet.data();
+        ASSERT_EQ(take<uint16_t>(data), 4001);
+    }
+    socket.received.clear();
+}
+
+} // namespace
+
+TEST(ReportAggregator, SendsTheNameTableFirst) {
+    Aggregator aggregator({.reports_per_second = 1000, .burst = 10});
+    EXPECT_EQ(aggregator.intern("current"), 0);
+    EXPECT_EQ(aggregator.intern("current"), 1);
+    EXPECT_EQ(aggregator.intern("temperature"), 2);
+    EXPECT_STREQ(aggregator.name(2), "temperature");
+
+    Socket socket;
+    ASSERT_TRUE(flush(aggregator, socket, 0));
+    uint16_t first = 0;
+    EXPECT_EQ(
+        decode_names(socket.received[0], first),
+        (std::vector<std::string>{"current", "current", "temperature"})
+    );
+    EXPECT_EQ(first, 0);
+    EXPECT_FALSE(flush(aggregator, socket, MS));
+
+    /* Boundaries added later are named later */
+    aggregator.intern("speed");
+    ASSERT_TRUE(flush(aggregator, socket, 2 * MS));
+    EXPECT_EQ(decode_names(socket.received[1], first), (std::vector<std::string>{"speed"}));
+    EXPECT_EQ(first, 3);
+}
+
+TEST(ReportAggregator, CoalescesRepeatsIntoOneEntry) {
+    Aggregator aggregator({.reports_per_second = 1000, .burst = 10});
+    uint16_t current = aggregator.intern("current");
+    uint16_t voltage = aggregator.intern("voltage");
+    Socket socket;
+    connect(aggregator, socket, 0);
+
+    for (int i = 0; i < 5; i++) {
+        aggregator.record(current, ABOVE, FAULT, 100.0f + i, MS);
+    }
+    aggregator.record(voltage, BELOW, OK, 400.0f, MS);
+    ASSERT_TRUE(flush(aggregator, socket, MS));
+
+    Report report = decode_report(socket.received[0]);
+    EXPECT_EQ(report.packet_id, 4000);
+    EXPECT_EQ(report.timestamp, MS);
+    EXPECT_EQ(report.flags, 0);
+    ASSERT_EQ(report.entries.size(), 1u);
+    EXPECT_EQ(report.entries[0].id, current);
+    EXPECT_EQ(report.entries[0].type, ABOVE);
+    EXPECT_EQ(report.entries[0].state, FAULT);
+    EXPECT_EQ(report.entries[0].repeats, 5);
+    EXPECT_EQ(report.entries[0].value, 104.0f);
+
+    /* Still in fault, nothing new until the refresh period */
+    aggregator.record(current, ABOVE, FAULT, 90.0f, 2 * MS);
+    EXPECT_FALSE(flush(aggregator, socket, 2 * MS));
+    aggregator.record(current, ABOVE, FAULT, 95.0f, 2'000 * MS + MS);
+    ASSERT_TRUE(flush(aggregator, socket, 2'000 * MS + MS));
+    report = decode_report(socket.received[1]);
+    EXPECT_EQ(report.sequence, 1);
+    ASSERT_EQ(report.entries.size(), 1u);
+    EXPECT_EQ(report.entries[0].repeats, 7);
+
+    aggregator.record(current, ABOVE, OK, 20.0f, 2'001 * MS);
+    ASSERT_TRUE(flush(aggregator, socket, 2'001 * MS));
+    report = decode_report(socket.received[2]);
+    ASSERT_EQ(report.entries.size(), 1u);
+    EXPECT_EQ(report.entries[0].state, OK);
+    EXPECT_EQ(report.entries[0].repeats, 1);
+}
+
+TEST(ReportAggregator, RespectsTheRateBudgetWithoutLosingState) {
+    Aggregator aggregator({.reports_per_second = 10, .burst = 3});
+    uint16_t current = aggregator.intern("current");
+    Socket socket;
+    socket.received.reserve(64);
+
+    /* A storm: the boundary flips every millisecond for a second */
+    FaultType state = OK;
+    for (uint64_t ms = 0; ms < 1000; ms++) {
+        state = state == FAULT ? WARNING : FAULT;
+        aggregator.record(current, ABOVE, state, static_cast<float>(ms), ms * MS);
+        flush(aggregator, socket, ms * MS);
+    }
+    /* The name table and the burst at once, then one every 100 ms */
+    EXPECT_LE(socket.received.size(), 3u + 10u);
+    EXPECT_GE(socket.received.size(), 3u + 9u);
+
+    /* Once the storm is over the last state gets through */
+    aggregator.record(current, ABOVE, OK, 1.0f, 1000 * MS);
+    for (uint64_t ms = 1000; ms < 1200; ms++) {
+        flush(aggregator, socket, ms * MS);
+    }
+    Report last = decode_report(socket.received.back());
+    ASSERT_EQ(last.entries.size(), 1u);
+    EXPECT_EQ(last.entries[0].state, OK);
+    EXPECT_EQ(last.entries[0].value, 1.0f);
+    EXPECT_EQ(aggregator.pending(&socket), 0u);
+}
+
+TEST(ReportAggregator, FailedSendsAreRetried) {
+    Aggregator aggregator({.reports_per_second = 10, .burst = 1});
+    uint16_t current = aggregator.intern("current");
+    Socket socket;
+    connect(aggregator, socket, 0);
+
+    aggregator.record(current, ABOVE, FAULT, 200.0f, 100 * MS);
+    socket.accepting = false;
+    EXPECT_FALSE(flush(aggregator, socket, 100 * MS));
+    EXPECT_EQ(aggregator.pending(&socket), 1u);
+
+    /* Not charged, so it can go right away */
+    socket.accepting = true;
+    ASSERT_TRUE(flush(aggregator, socket, 101 * MS));
+    Report report = decode_report(socket.received[0]);
+    EXPECT_EQ(report.sequence, 0);
+    EXPECT_EQ(report.entries[0].value, 200.0f);
+}
+
+TEST(ReportAggregator, FaultsGoFirstWhenThePacketIsFull) {
+    Aggregator aggregator({.reports_per_second = 1000, .burst = 10});
+    std::vector<uint16_t> ids;
+    for (int i = 0; i < 8; i++) {
+        ids.push_back(aggregator.intern("boundary"));
+    }
+    Socket socket;
+    connect(aggregator, socket, 0);
+
+    for (int i = 0; i < 6; i++) {
+        aggregator.record(ids[i], ABOVE, WARNING, 1.0f, MS);
+    }
+    aggregator.record(ids[6], ABOVE, FAULT, 2.0f, MS);
+    aggregator.record(ids[7], ABOVE, FAULT, 3.0f, MS);
+
+    ASSERT_TRUE(flush(aggregator, socket, MS));
+    Report report = decode_report(socket.received[0]);
+    ASSERT_EQ(report.entries.size(), 4u);
+    EXPECT_EQ(report.entries[0].id, ids[6]);
+    EXPECT_EQ(report.entries[1].id, ids[7]);
+    EXPECT_EQ(report.entries[2].state, WARNING);
+    EXPECT_EQ(report.flags, Aggregator::MORE_PENDING);
+
+    ASSERT_TRUE(flush(aggregator, socket, 2 * MS));
+    report = decode_report(socket.received[1]);
+    EXPECT_EQ(report.entries.size(), 4u);
+    EXPECT_EQ(report.flags, 0);
+}
+
+TEST(ReportAggregator, SocketsHaveTheirOwnBudget) {
+    Aggregator aggregator({.reports_per_second = 10, .burst = 2});
+    uint16_t current = aggregator.intern("current");
+    Socket first, second;
+    connect(aggregator, first, 0);
+
+    aggregator.record(current, ABOVE, FAULT, 5.0f, MS);
+    ASSERT_TRUE(flush(aggregator, first, MS));
+    aggregator.record(current, ABOVE, WARNING, 4.0f, 2 * MS);
+    EXPECT_FALSE(flush(aggregator, first, 2 * MS));
+
+    /* A socket that connects late gets the name table, then the current state */
+    ASSERT_TRUE(flush(aggregator, second, 2 * MS));
+    ASSERT_TRUE(flush(aggregator, second, 3 * MS));
+    Report report = decode_report(second.received[1]);
+    ASSERT_EQ(report.entries.size(), 1u);
+    EXPECT_EQ(report.entries[0].state, WARNING);
+    EXPECT_EQ(aggregator.pending(&first), 1u);
+    EXPECT_EQ(aggregator.pending(&second), 0u);
+}
+
+TEST(ReportAggregator, LiveSocketsKeepTheirPlace) {
+    Aggregator aggregator({.reports_per_second = 10, .burst = 2, .sink_timeout_ns = 1000 * MS});
+    uint16_t current = aggregator.intern("current");
+    std::array<Socket, 5> sockets;
+    for (size_t i = 0; i < 4; i++) {
+        connect(aggregator, sockets[i], 0);
+    }
+
+    /* A fifth socket doesn't push out one that is still being flushed */
+    EXPECT_FALSE(flush(aggregator, sockets[4], 10 * MS));
+    EXPECT_EQ(aggregator.overflows(), 1u);
+    aggregator.record(current, ABOVE, FAULT, 5.0f, 500 * MS);
+    for (size_t i = 0; i < 4; i++) {
+        ASSERT_TRUE(flush(aggregator, sockets[i], 500 * MS)) << "socket " << i;
+        EXPECT_EQ(decode_report(sockets[i].received[0]).packet_id, 4000);
+    }
+    EXPECT_FALSE(flush(aggregator, sockets[4], 600 * MS));
+    EXPECT_EQ(aggregator.overflows(), 2u);
+
+    /* Once one has been quiet for sink_timeout_ns, its place goes to the new socket */
+    for (size_t i = 1; i < 4; i++) {
+        flush(aggregator, sockets[i], 1400 * MS);
+    }
+    ASSERT_TRUE(flush(aggregator, sockets[4], 1600 * MS));
+    uint16_t first = 0;
+    EXPECT_EQ(decode_names(sockets[4].received[0], first), (std::vector<std::string>{"current"}));
+    EXPECT_EQ(aggregator.overflows(), 2u);
+    EXPECT_EQ(aggregator.pending(&sockets[0]), 0u);
+}
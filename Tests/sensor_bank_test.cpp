@@ -0,0 +1,178 @@
+#include <array>
+
+#include <gtest/gtest.h>
+
+#include "MockedDrivers/mocked_hal_adc.hpp"
+#include "Sensors/Common/PT100.hpp"
+#include "Sensors/LinearSensor/FilteredLinearSensor.hpp"
+#include "Sensors/LinearSensor/LinearSensor.hpp"
+#include "Sensors/LookupSensor/LookupSensor.hpp"
+#include "Sensors/NTC/NTC.hpp"
+#include "Sensors/SensorBank/SensorBank.hpp"
+
+namespace ST_LIB::TestErrorHandler {
+void reset();
+void set_fail_on_error(bool enabled);
+extern int call_count;
+} // namespace ST_LIB::TestErrorHandler
+
+using ST_LIB::ADCDomain;
+
+namespace {
+
+constexpr std::size_t sensor_count = 64;
+constexpr std::size_t linear_count = 48;
+constexpr std::size_t pt100_count = 8;
+constexpr std::size_t channel_count = 20;
+
+constexpr std::array<ADCDomain::Channel, channel_count> channels{
+    ADCDomain::Channel::CH0,  ADCDomain::Channel::CH1,  ADCDomain::Channel::CH2,
+    ADCDomain::Channel::CH3,  ADCDomain::Channel::CH4,  ADCDomain::Channel::CH5,
+    ADCDomain::Channel::CH6,  ADCDomain::Channel::CH7,  ADCDomain::Channel::CH8,
+    ADCDomain::Channel::CH9,  ADCDomain::Channel::CH10, ADCDomain::Channel::CH11,
+    ADCDomain::Channel::CH12, ADCDomain::Channel::CH13, ADCDomain::Channel::CH14,
+    ADCDomain::Channel::CH15, ADCDomain::Channel::CH16, ADCDomain::Channel::CH17,
+    ADCDomain::Channel::CH18, ADCDomain::Channel::CH19,
+};
+
+using Instances = ADCDomain::Init<sensor_count>;
+constexpr std::size_t ntc_count = sensor_count - linear_count - pt100_count;
+using Bank = ST_LIB::SensorBank<linear_count, pt100_count, ntc_count>;
+
+uint16_t channel_of(std::size_t sensor) { return static_cast<uint16_t>(sensor % channel_count); }
+
+float slope_of(std::size_t sensor) { return 1.0f + 0.25f * static_cast<float>(sensor); }
+
+float offset_of(std::size_t sensor) { return -2.0f + 0.5f * static_cast<float>(sensor); }
+
+class SensorBankTest : public ::testing::Test {
+protected:
+    std::array<uint16_t, channel_count> raw{};
+
+    void SetUp() override {
+        ST_LIB::MockedHAL::adc_reset();
+        ST_LIB::TestErrorHandler::reset();
+
+        std::array<ADCDomain::Config, sensor_count> cfgs{};
+        for (std::size_t i = 0; i < sensor_count; i++) {
+            cfgs[i] = {
+                .gpio_idx = 0,
+                .peripheral = ADCDomain::Peripheral::ADC_1,
+                .channel = channels[channel_of(i)],
+                .resolution = ADCDomain::Resolution::BITS_12,
+                .sample_time = ADCDomain::SampleTime::CYCLES_8_5,
+                .prescaler = ADCDomain::ClockPrescaler::DIV1,
+                .sample_rate_hz = 0,
+                .output = nullptr,
+            };
+        }
+        Instances::init(cfgs);
+
+        for (std::size_t c = 0; c < channel_count; c++) {
+            raw[c] = static_cast<uint16_t>(300 + 180 * c);
+            ST_LIB::MockedHAL::adc_set_channel_raw(
+                ADC1,
+                static_cast<uint32_t>(channels[c]),
+                raw[c]
+            );
+        }
+    }
+
+    void fill(Bank& bank, std::array<float, sensor_count>& out) {
+        for (std::size_t i = 0; i < sensor_count; i++) {
+            if (i < linear_count) {
+                bank.add_linear(channel_of(i), slope_of(i), offset_of(i), &out[i]);
+            } else if (i < linear_count + pt100_count) {
+                bank.add_inverse(channel_of(i), PT100<1>::k, PT100<1>::offset, &out[i]);
+            } else {
+                bank.add_table<NTC::Table>(channel_of(i), &out[i]);
+            }
+        }
+    }
+};
+
+} // namespace
+
+TEST_F(SensorBankTest, MatchesPerObjectReadForEveryKind) {
+    std::array<float, sensor_count> object_out{};
+    std::array<float, sensor_count> bank_out{};
+
+    for (std::size_t i = 0; i < sensor_count; i++) {
+        auto& adc = Instances::instances[i];
+        if (i < linear_count) {
+            LinearSensor<float>(adc, slope_of(i), offset_of(i), &object_out[i]).read();
+        } else if (i < linear_count + pt100_count) {
+            PT100<1>(adc, &object_out[i]).read();
+        } else {
+            TableLookupSensor<NTC::Table>(adc, &object_out[i]).read();
+        }
+    }
+
+    Bank bank;
+    fill(bank, bank_out);
+    bank.update(raw);
+
+    for (std::size_t i = 0; i < sensor_count; i++) {
+        EXPECT_NEAR(bank_out[i], object_out[i], 1e-4f * std::abs(object_out[i]) + 1e-4f) << i;
+    }
+    EXPECT_EQ(bank.size(), sensor_count);
+    EXPECT_EQ(bank.linear_values()[3], bank_out[3]);
+    EXPECT_EQ(bank.table_values().size(), ntc_count);
+}
+
+TEST_F(SensorBankTest, RejectsRawBlockMissingChannels) {
+    ST_LIB::SensorBank<2> bank;
+    float out = -1.0f;
+    bank.add_linear(5, 1.0f, 0.0f, &out);
+
+    ST_LIB::TestErrorHandler::set_fail_on_error(false);
+    bank.update(std::span<const uint16_t>(raw.data(), 5));
+    EXPECT_EQ(ST_LIB::TestErrorHandler::call_count, 1);
+    EXPECT_EQ(out, -1.0f);
+
+    EXPECT_TRUE(bank.add_linear(0, 1.0f, 0.0f, nullptr));
+    EXPECT_FALSE(bank.add_linear(0, 1.0f, 0.0f, nullptr));
+    EXPECT_EQ(ST_LIB::TestErrorHandler::call_count, 2);
+}
+
+TEST_F(SensorBankTest, FilteredSensorsAverageLikeFilteredLinearSensor) {
+    constexpr std::size_t window = 4;
+    constexpr std::size_t filtered_count = 3;
+    ST_LIB::SensorBank<0, 0, 0, filtered_count, window> bank;
+    std::array<MovingAverage<window>, filtered_count> filters{};
+    std::array<float, filtered_count> object_out{};
+    std::array<float, filtered_count> bank_out{};
+    for (std::size_t i = 0; i < filtered_count; i++) {
+        ASSERT_TRUE(
+            bank.add_filtered_linear(channel_of(i), slope_of(i), offset_of(i), &bank_out[i])
+        );
+    }
+
+    for (uint16_t update = 0; update < 3 * window; update++) {
+        for (std::size_t c = 0; c < filtered_count; c++) {
+            raw[c] = static_cast<uint16_t>(500 + 37 * update * (c + 1));
+            ST_LIB::MockedHAL::adc_set_channel_raw(
+                ADC1,
+                static_cast<uint32_t>(channels[c]),
+                raw[c]
+            );
+        }
+        for (std::size_t i = 0; i < filtered_count; i++) {
+            FilteredLinearSensor<float, window>(
+                Instances::instances[i],
+                slope_of(i),
+                offset_of(i),
+                &object_out[i],
+                filters[i]
+            )
+                .read();
+        }
+        bank.update(raw);
+        for (std::size_t i = 0; i < filtered_count; i++) {
+            EXPECT_NEAR(bank_out[i], object_out[i], 1e-4f * std::abs(object_out[i]) + 1e-4f)
+                << "update " << update << " sensor " << i;
+        }
+    }
+    EXPECT_EQ(bank.filtered_values().size(), filtered_count);
+    EXPECT_NE(bank_out[0], 0.0f);
+}
@@ -0,0 +1,98 @@
+#include <cmath>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "Sensors/LookupSensor/SensorTable.hpp"
+
+namespace {
+
+constexpr ST_LIB::BetaNTC ntc{
+    .r25_ohm = 10e3,
+    .beta = 3976.0,
+    .divider = {.fixed_ohm = 10e3},
+    .min_celsius = -90.0,
+    .max_celsius = 620.0,
+};
+using NTCTable = ST_LIB::SensorTable<ntc, 12, 0.05>;
+
+double ntc_reference(uint32_t raw) {
+    const double ratio = raw / 4096.0;
+    const double r = 10e3 * ratio / (1.0 - ratio);
+    const double t = 1.0 / (1.0 / 298.15 + std::log(r / 10e3) / 3976.0) - 273.15;
+    return std::fmin(std::fmax(t, -90.0), 620.0);
+}
+
+/* PT1000 under a 1k pull-up */
+constexpr ST_LIB::CallendarVanDusenRTD pt1000{
+    .r0_ohm = 1000.0,
+    .divider = {.fixed_ohm = 1000.0},
+    .min_celsius = -100.0,
+    .max_celsius = 400.0,
+};
+
+constexpr ST_LIB::CalibrationCurve<3> pressure_curve{
+    .vref = 3.3,
+    .points = {{{0.33, 0.0}, {1.65, 5.0}, {2.97, 20.0}}},
+};
+
+} // namespace
+
+TEST(SensorTable, NTCTableStaysWithinBoundAtEveryCode) {
+    static_assert(NTCTable::size < 200);
+    static_assert(NTCTable::flash_bytes < 4096 * sizeof(int) / 8);
+
+    for (uint32_t raw = 1; raw < 4096; raw++) {
+        ASSERT_NEAR(NTCTable::lookup(raw), ntc_reference(raw), 0.05 + 1e-4) << "raw " << raw;
+    }
+}
+
+TEST(SensorTable, NTCTableMatchesLegacyTable) {
+    // values from the 4096 entry table NTC used to embed, in tenths of a degree
+    EXPECT_NEAR(NTCTable::lookup(100), 139.0, 0.1);
+    EXPECT_NEAR(NTCTable::lookup(1000), 52.6, 0.1);
+    EXPECT_NEAR(NTCTable::lookup(2047), 25.0, 0.1);
+    EXPECT_NEAR(NTCTable::lookup(3500), -9.9, 0.1);
+    EXPECT_NEAR(NTCTable::lookup(4094), -83.5, 0.1);
+}
+
+TEST(SensorTable, FixedPointTableInterpolatesInIntegers) {
+    using Fixed = ST_LIB::SensorTable<ntc, 12, 0.1, int16_t, 10>;
+    static_assert(std::is_same_v<decltype(Fixed::lookup_scaled(0)), int16_t>);
+
+    for (uint32_t raw = 1; raw < 4096; raw++) {
+        ASSERT_NEAR(Fixed::lookup_scaled(raw) / 10.0, ntc_reference(raw), 0.1 + 1e-9);
+    }
+    EXPECT_NEAR(Fixed::lookup(2047), ntc_reference(2047), 0.1 + 1e-4);
+}
+
+TEST(SensorTable, CallendarVanDusenInvertsTheRTDCurve) {
+    using RTDTable = ST_LIB::SensorTable<pt1000, 16, 0.02>;
+
+    for (double celsius : {-80.0, -20.0, 0.0, 25.0, 100.0, 350.0}) {
+        const double r = pt1000.resistance(celsius);
+        const uint32_t raw = static_cast<uint32_t>(std::lround(r / (r + 1000.0) * 65536.0));
+        // one code is ~0.05 ºC around these temperatures
+        EXPECT_NEAR(RTDTable::lookup(raw), celsius, 0.1) << celsius;
+    }
+}
+
+TEST(SensorTable, CalibrationPointsAreExactAndHeldOutside) {
+    using Pressure = ST_LIB::SensorTable<pressure_curve, 12, 0.01>;
+    constexpr auto code = [](double volts) {
+        return static_cast<uint32_t>(volts / 3.3 * 4096.0);
+    };
+
+    EXPECT_NEAR(Pressure::lookup(code(1.65)), 5.0, 0.01);
+    EXPECT_NEAR(Pressure::lookup(code(2.31)), 12.5, 0.02);
+    EXPECT_NEAR(Pressure::lookup(0), 0.0, 0.01);
+    EXPECT_NEAR(Pressure::lookup(4095), 20.0, 0.01);
+    // two straight lines between three points
+    EXPECT_LE(Pressure::size, 6U);
+}
+
+TEST(SensorTable, RescalesCodesOfOtherResolutions) {
+    EXPECT_EQ(NTCTable::code_from_raw(2047, 4095), 2047U);
+    EXPECT_EQ(NTCTable::code_from_raw(65535, 65535), 4095U);
+    EXPECT_EQ(NTCTable::code_from_raw(511, 1023), 2045U);
+}
@@ -0,0 +1,112 @@
+#include <cmath>
+#include <cstdint>
+#include <deque>
+
+#include <gtest/gtest.h>
+
+#include "Protections/SlidingWindow.hpp"
+
+using namespace Protections;
+
+namespace {
+
+double noise() {
+    static uint32_t lcg = 1234;
+    lcg = lcg * 1'664'525U + 1'013'904'223U;
+    return static_cast<double>(lcg >> 8) / static_cast<double>(1U << 24);
+}
+
+/* Exact mean of the last window samples, zeros before the first one */
+struct ExactWindow {
+    size_t window;
+    std::deque<double> samples = std::deque<double>(window, 0.0);
+    double sum = 0.0;
+
+    double input(double value) {
+        sum += value - samples.front();
+        samples.pop_front();
+        samples.push_back(value);
+        return sum / static_cast<double>(window);
+    }
+};
+
+/* First sample at which the mean goes over limit, -1 if it never does */
+template <typename Window> long trip_sample(Window& window, double value, double limit) {
+    for (long sample = 0; sample < 100'000; sample++) {
+        if (window.input(value) > limit) {
+            return sample;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+TEST(BucketWindow, StaysWithinOneBucketOfTheExactMean) {
+    for (size_t length : {32u, 100u, 1000u, 4096u}) {
+        BucketWindow<double> window(length);
+        ExactWindow exact{window.samples()};
+        double largest_error = 0.0;
+        for (int sample = 0; sample < 20'000; sample++) {
+            /* A slow swing between 0 and 2 plus noise, the input range is 3 */
+            double value = 1.0 + std::sin(sample * 1e-3) + noise();
+            double approximate = window.input(value);
+            largest_error = std::max(largest_error, std::abs(approximate - exact.input(value)));
+        }
+        EXPECT_LE(largest_error, 3.0 / 32) << "window " << length;
+    }
+
+    /* The memory doesn't depend on the window */
+    static_assert(sizeof(BucketWindow<double>) < 64 * sizeof(double));
+    EXPECT_EQ(BucketWindow<float>(10).samples(), 32u);
+    EXPECT_EQ(BucketWindow<float>(1000).samples(), 32u * 32u);
+}
+
+TEST(BucketWindow, ConstantInputIsExact) {
+    BucketWindow<float> window(3200);
+    for (int sample = 0; sample < 3200 * 3; sample++) {
+        window.input(2.5f);
+    }
+    EXPECT_FLOAT_EQ(window.mean(), 2.5f);
+    window.reset();
+    EXPECT_EQ(window.mean(), 0.0f);
+
+    /* Summed from the buckets on every bucket, no drift after millions of inputs */
+    BucketWindow<float> long_run(64);
+    for (int sample = 0; sample < 5'000'000; sample++) {
+        long_run.input(sample % 2 ? 1e3f : 1e-3f);
+    }
+    EXPECT_NEAR(long_run.mean(), (1e3f + 1e-3f) / 2, 1e-2f);
+}
+
+TEST(ExponentialWindow, FollowsTheFirstOrderResponse) {
+    const size_t length = 1000;
+    ExponentialWindow<double> window(length);
+    for (size_t sample = 1; sample <= 3 * length; sample++) {
+        double mean = window.input(1.0);
+        ASSERT_NEAR(mean, 1.0 - std::exp(-static_cast<double>(sample) / length), 1e-9);
+    }
+    static_assert(sizeof(ExponentialWindow<float>) <= 2 * sizeof(size_t) + 2 * sizeof(float));
+}
+
+TEST(SlidingWindow, TripTimesAgreeWithTheExactWindow) {
+    /* A step well above the limit trips after limit / value windows on every engine */
+    const size_t length = 2000;
+    const double limit = 1.0;
+    for (double value : {5.0, 10.0, 50.0}) {
+        ExactWindow exact{length};
+        BucketWindow<double> buckets(length);
+        ExponentialWindow<double> exponential(length);
+        double expected = limit / value * length;
+        EXPECT_NEAR(trip_sample(exact, value, limit), expected, 1.0);
+        /* Rounded up to a whole number of buckets, 2016 samples */
+        EXPECT_NEAR(trip_sample(buckets, value, limit), limit / value * buckets.samples(), 1.0);
+        EXPECT_NEAR(trip_sample(exponential, value, limit), expected, 0.15 * expected);
+    }
+
+    /* And none of them trips on a value under the limit */
+    BucketWindow<double> buckets(length);
+    ExponentialWindow<double> exponential(length);
+    EXPECT_EQ(trip_sample(buckets, 0.99, limit), -1);
+    EXPECT_EQ(trip_sample(exponential, 0.99, limit), -1);
+}
@@ -0,0 +1,160 @@
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "C++Utilities/Snapshot.hpp"
+#include "HALAL/Models/Packets/PacketDomain.hpp"
+
+namespace {
+
+/* Everything a control cycle writes, each field derived from the cycle number */
+struct Frame {
+    uint32_t cycle = 0;
+    float current = 0.0f;
+    double position = 0.0;
+    std::array<uint32_t, 28> samples{};
+    uint64_t energy = 0;
+};
+
+Frame make_frame(uint32_t cycle) {
+    Frame frame;
+    frame.cycle = cycle;
+    frame.current = static_cast<float>(cycle % 4096);
+    frame.position = cycle * 0.5;
+    frame.samples.fill(cycle);
+    frame.energy = static_cast<uint64_t>(cycle) * cycle;
+    return frame;
+}
+
+::testing::AssertionResult consistent(const Frame& frame) {
+    Frame expected = make_frame(frame.cycle);
+    if (std::memcmp(&expected, &frame, sizeof(Frame)) != 0) {
+        return ::testing::AssertionFailure() << "torn frame at cycle " << frame.cycle;
+    }
+    return ::testing::AssertionSuccess();
+}
+
+/* Stands in for the control interrupt, publishing as fast as it can until told to stop */
+class Writer {
+public:
+    explicit Writer(Snapshot<Frame>& snapshot)
+        : thread([this, &snapshot] {
+              for (uint32_t cycle = 1; !stop.load(std::memory_order_relaxed); cycle++) {
+                  snapshot.publish(make_frame(cycle));
+              }
+          }) {}
+
+    ~Writer() {
+        stop.store(true, std::memory_order_relaxed);
+        thread.join();
+    }
+
+private:
+    std::atomic<bool> stop{false};
+    std::thread thread;
+};
+
+Snapshot<Frame> control_frames;
+
+constexpr ST_LIB::Telemetry frame_packet{
+    400,
+    &control_frames.view().cycle,
+    &control_frames.view().current,
+    &control_frames.view().position,
+    &control_frames.view().energy,
+};
+
+/* Takes the single packet entry the way BuildCtx does */
+struct PacketCtx {
+    std::array<ST_LIB::PacketDomain::Entry, 1> entries{};
+
+    template <typename D, typename Owner>
+    consteval size_t add(ST_LIB::PacketDomain::Entry entry, [[maybe_unused]] const Owner* owner) {
+        entries[0] = entry;
+        return 0;
+    }
+};
+
+consteval auto build_frame_packet() {
+    PacketCtx ctx;
+    frame_packet.inscribe(ctx);
+    return ST_LIB::PacketDomain::build<1>(ctx.entries);
+}
+
+constexpr auto frame_cfgs = build_frame_packet();
+
+} // namespace
+
+TEST(Snapshot, ReadsTheLatestPublish) {
+    Snapshot<Frame> snapshot(make_frame(7));
+    EXPECT_EQ(snapshot.read().cycle, 7u);
+    EXPECT_EQ(snapshot.sequence(), 0u);
+    EXPECT_FALSE(snapshot.refresh());
+    EXPECT_EQ(snapshot.view().cycle, 7u);
+
+    snapshot.publish(make_frame(8));
+    snapshot.publish(make_frame(9));
+    Frame frame;
+    ASSERT_TRUE(snapshot.try_read(frame));
+    EXPECT_TRUE(consistent(frame));
+    EXPECT_EQ(frame.cycle, 9u);
+    EXPECT_EQ(snapshot.sequence(), 2u);
+
+    EXPECT_TRUE(snapshot.refresh());
+    EXPECT_EQ(snapshot.view().cycle, 9u);
+    EXPECT_FALSE(snapshot.refresh());
+}
+
+TEST(Snapshot, ConcurrentReadsNeverTear) {
+    Snapshot<Frame> snapshot(make_frame(0));
+    size_t retries = 0;
+    uint32_t last_cycle = 0;
+    {
+        Writer writer(snapshot);
+        Frame frame;
+        for (int i = 0; i < 300'000; i++) {
+            if (!snapshot.try_read(frame)) {
+                retries++;
+                continue;
+            }
+            ASSERT_TRUE(consistent(frame));
+            /* Never goes back to an older cycle */
+            ASSERT_GE(frame.cycle, last_cycle);
+            last_cycle = frame.cycle;
+        }
+        for (int i = 0; i < 100'000; i++) {
+            ASSERT_TRUE(consistent(snapshot.read()));
+        }
+    }
+    EXPECT_GT(last_cycle, 0u);
+    RecordProperty("retries", static_cast<int>(retries));
+}
+
+TEST(Snapshot, PacketsBuildFromASingleCycle) {
+    using Packets = ST_LIB::PacketDomain::Init<1, ST_LIB::PacketDomain::arena_size(frame_cfgs)>;
+    Packets::init(frame_cfgs);
+
+    Writer writer(control_frames);
+    for (int i = 0; i < 200'000; i++) {
+        control_frames.refresh();
+        std::span<const uint8_t> packet = Packets::instances[0].build();
+
+        uint32_t cycle;
+        float current;
+        double position;
+        uint64_t energy;
+        const uint8_t* data = packet.data() + sizeof(uint16_t);
+        std::memcpy(&cycle, data, sizeof(cycle));
+        std::memcpy(&current, data + 4, sizeof(current));
+        std::memcpy(&position, data + 8, sizeof(position));
+        std::memcpy(&energy, data + 16, sizeof(energy));
+        Frame expected = make_frame(cycle);
+        ASSERT_EQ(current, expected.current);
+        ASSERT_EQ(position, expected.position);
+        ASSERT_EQ(energy, expected.energy);
+    }
+}
@@ -4,7 +4,9 @@
 
 #include "HALAL/Models/DMA/DMA2.hpp"
 #include "HALAL/Models/SPI/SPI2.hpp"
+#include "HALAL/Services/Communication/SPI/SPIAcquisition.hpp"
 #include "MockedDrivers/NVIC.hpp"
+#include "MockedDrivers/VirtualClock.hpp"
 #include "MockedDrivers/mocked_hal_dma.hpp"
 #include "MockedDrivers/mocked_hal_spi.hpp"
 
@@ -94,6 +96,7 @@ class SPI2Test : public ::testing::Test {
 protected:
     void SetUp() override {
         SystemCoreClock = 64'000'000U;
+        ST_LIB::MockedHAL::VirtualClock::reset();
         ST_LIB::MockedHAL::spi_reset();
         ST_LIB::MockedHAL::dma_reset();
         ST_LIB::TestErrorHandler::reset();
@@ -416,3 +419,302 @@ TEST_F(SPI2Test, BusyStatusReturnsFalseInBlockingAndDMAPaths) {
     EXPECT_FALSE(spi.receive_DMA(std::span<uint8_t, 4>{rx}));
     EXPECT_FALSE(spi.transceive_DMA(std::span<uint8_t, 4>{tx}, std::span<uint8_t, 4>{rx}));
 }
+
+namespace {
+
+struct QueueLog {
+    std::array<int, 16> order{};
+    std::size_t count = 0;
+    std::size_t failures = 0;
+    GPIO_TypeDef* nss_port = nullptr;
+    std::array<bool, 16> nss_high_in_callback{};
+};
+
+struct QueueTag {
+    QueueLog* log;
+    int id;
+};
+
+void record_completion(void* context, bool success) {
+    auto* tag = static_cast<QueueTag*>(context);
+    auto* log = tag->log;
+    if (!success) {
+        log->failures++;
+    }
+    if (log->nss_port != nullptr) {
+        log->nss_high_in_callback[log->count] = (log->nss_port->ODR & GPIO_PIN_0) != 0U;
+    }
+    log->order[log->count++] = tag->id;
+}
+
+} // namespace
+
+TEST_F(SPI2Test, QueuedTransactionsChainFromCompletionInterruptByPriority) {
+    auto& instance =
+        init_spi<ST_LIB::SPIDomain::SPIMode::MASTER, ST_LIB::SPIConfigTypes::DataSize::SIZE_8BIT>(
+            20'000'000U
+        );
+    ST_LIB::SPIDomain::SPIWrapper<master8_request> spi(instance);
+
+    GPIO_TypeDef port{};
+    port.ODR = GPIO_PIN_0;
+    ST_LIB::GPIODomain::Instance nss(&port, GPIO_PIN_0);
+
+    QueueLog log{};
+    log.nss_port = &port;
+    std::array<QueueTag, 4> tags{{{&log, 0}, {&log, 1}, {&log, 2}, {&log, 3}}};
+    std::array<uint8_t, 4> tx{1, 2, 3, 4};
+    std::array<uint8_t, 4> rx{};
+
+    using Span = std::span<uint8_t, 4>;
+    EXPECT_TRUE(spi.queue_transceive_DMA(Span{tx}, Span{rx}, record_completion, &tags[0], 0, &nss));
+    EXPECT_TRUE(spi.transaction_in_progress());
+    EXPECT_EQ(port.ODR & GPIO_PIN_0, 0U);
+
+    // Queued behind the active one, started by priority then FIFO
+    EXPECT_TRUE(spi.queue_send_DMA(Span{tx}, record_completion, &tags[1], 1, &nss));
+    EXPECT_TRUE(spi.queue_receive_DMA(Span{rx}, record_completion, &tags[2], 5, &nss));
+    EXPECT_TRUE(spi.queue_send_DMA(Span{tx}, record_completion, &tags[3], 1, &nss));
+    EXPECT_EQ(spi.queued_transactions(), 3U);
+    EXPECT_EQ(NVIC_GetEnableIRQ(SPI2_IRQn), 1U);
+
+    EXPECT_EQ(ST_LIB::MockedHAL::spi_run_dma_until_idle(16), 4U);
+    EXPECT_FALSE(spi.transaction_in_progress());
+    EXPECT_EQ(spi.queued_transactions(), 0U);
+    ASSERT_EQ(log.count, 4U);
+    EXPECT_EQ(log.order[0], 0);
+    EXPECT_EQ(log.order[1], 2);
+    EXPECT_EQ(log.order[2], 1);
+    EXPECT_EQ(log.order[3], 3);
+    EXPECT_EQ(log.failures, 0U);
+
+    // NSS is released before the next transfer asserts it again
+    EXPECT_FALSE(log.nss_high_in_callback[0]);
+    EXPECT_TRUE(log.nss_high_in_callback[3]);
+    EXPECT_NE(port.ODR & GPIO_PIN_0, 0U);
+
+    EXPECT_EQ(
+        ST_LIB::MockedHAL::spi_get_call_count(ST_LIB::MockedHAL::SPIOperation::TransmitReceiveDMA),
+        1U
+    );
+    EXPECT_EQ(
+        ST_LIB::MockedHAL::spi_get_call_count(ST_LIB::MockedHAL::SPIOperation::TransmitDMA),
+        2U
+    );
+    EXPECT_EQ(
+        ST_LIB::MockedHAL::spi_get_call_count(ST_LIB::MockedHAL::SPIOperation::ReceiveDMA),
+        1U
+    );
+}
+
+TEST_F(SPI2Test, QueueRejectsWhenFullAndReportsFailedStarts) {
+    auto& instance =
+        init_spi<ST_LIB::SPIDomain::SPIMode::MASTER, ST_LIB::SPIConfigTypes::DataSize::SIZE_8BIT>(
+            20'000'000U
+        );
+    ST_LIB::SPIDomain::SPIWrapper<master8_request> spi(instance);
+
+    QueueLog log{};
+    QueueTag tag{&log, 7};
+    std::array<uint8_t, 4> tx{1, 2, 3, 4};
+    using Span = std::span<uint8_t, 4>;
+    // The error count lives on the shared instance, earlier tests may have left it non-zero
+    const uint32_t errors_before = spi.get_error_count();
+
+    EXPECT_TRUE(spi.queue_send_DMA(Span{tx}, record_completion, &tag));
+    for (std::size_t i = 0; i < ST_LIB::SPIDomain::transaction_queue_capacity; i++) {
+        EXPECT_TRUE(spi.queue_send_DMA(Span{tx}, record_completion, &tag));
+    }
+    EXPECT_FALSE(spi.queue_send_DMA(Span{tx}, record_completion, &tag));
+
+    // Every queued transfer fails to start, all of them are reported and the queue drains
+    ST_LIB::MockedHAL::spi_set_busy(true);
+    EXPECT_TRUE(ST_LIB::MockedHAL::spi_complete_dma());
+    EXPECT_FALSE(spi.transaction_in_progress());
+    EXPECT_EQ(spi.queued_transactions(), 0U);
+    EXPECT_EQ(log.count, 1U + ST_LIB::SPIDomain::transaction_queue_capacity);
+    EXPECT_EQ(log.failures, ST_LIB::SPIDomain::transaction_queue_capacity);
+    EXPECT_EQ(
+        spi.get_error_count() - errors_before,
+        ST_LIB::SPIDomain::transaction_queue_capacity
+    );
+}
+
+TEST_F(SPI2Test, ErrorCallbackFailsActiveTransactionAndContinuesQueue) {
+    ST_LIB::TestErrorHandler::set_fail_on_error(false);
+    auto& instance =
+        init_spi<ST_LIB::SPIDomain::SPIMode::MASTER, ST_LIB::SPIConfigTypes::DataSize::SIZE_8BIT>(
+            20'000'000U
+        );
+    ST_LIB::SPIDomain::SPIWrapper<master8_request> spi(instance);
+
+    QueueLog log{};
+    std::array<QueueTag, 2> tags{{{&log, 0}, {&log, 1}}};
+    std::array<uint8_t, 4> tx{1, 2, 3, 4};
+    using Span = std::span<uint8_t, 4>;
+
+    EXPECT_TRUE(spi.queue_send_DMA(Span{tx}, record_completion, &tags[0]));
+    EXPECT_TRUE(spi.queue_send_DMA(Span{tx}, record_completion, &tags[1]));
+
+    HAL_SPI_ErrorCallback(ST_LIB::MockedHAL::spi_get_last_handle());
+    ASSERT_EQ(log.count, 1U);
+    EXPECT_EQ(log.failures, 1U);
+    EXPECT_TRUE(spi.transaction_in_progress());
+
+    EXPECT_EQ(ST_LIB::MockedHAL::spi_run_dma_until_idle(4), 1U);
+    ASSERT_EQ(log.count, 2U);
+    EXPECT_EQ(log.order[1], 1);
+    EXPECT_EQ(log.failures, 1U);
+    EXPECT_EQ(ST_LIB::TestErrorHandler::call_count, 0);
+}
+
+TEST_F(SPI2Test, QueueChainingSustainsBusThroughputWithoutGaps) {
+    auto& instance =
+        init_spi<ST_LIB::SPIDomain::SPIMode::MASTER, ST_LIB::SPIConfigTypes::DataSize::SIZE_8BIT>(
+            20'000'000U
+        );
+    ST_LIB::SPIDomain::SPIWrapper<master8_request> spi(instance);
+    constexpr uint32_t bit_rate = 8'000'000U;
+    constexpr uint64_t main_loop_latency_ns = 5'000U;
+    ST_LIB::MockedHAL::spi_set_bit_rate(bit_rate);
+
+    std::array<uint8_t, 32> tx{};
+    std::array<uint8_t, 32> rx{};
+    using Span = std::span<uint8_t, 32>;
+
+    // Main loop driven: every transfer is started after polling the completion flag
+    volatile bool done = false;
+    for (int i = 0; i < 8; i++) {
+        done = false;
+        ASSERT_TRUE(spi.transceive_DMA(Span{tx}, Span{rx}, &done));
+        ASSERT_TRUE(ST_LIB::MockedHAL::spi_complete_dma());
+        ASSERT_TRUE(done);
+        ST_LIB::MockedHAL::VirtualClock::run_for(main_loop_latency_ns);
+    }
+    const double polled_throughput = ST_LIB::MockedHAL::spi_get_sustained_throughput_bytes_per_s();
+    EXPECT_DOUBLE_EQ(ST_LIB::MockedHAL::spi_get_mean_gap_ns(), main_loop_latency_ns);
+
+    // Queue driven: the completion interrupt starts the next transfer
+    ST_LIB::MockedHAL::spi_reset();
+    ST_LIB::MockedHAL::spi_set_bit_rate(bit_rate);
+    for (std::size_t i = 0; i < ST_LIB::SPIDomain::transaction_queue_capacity; i++) {
+        ASSERT_TRUE(spi.queue_transceive_DMA(Span{tx}, Span{rx}));
+    }
+    EXPECT_EQ(
+        ST_LIB::MockedHAL::spi_run_dma_until_idle(32),
+        ST_LIB::SPIDomain::transaction_queue_capacity
+    );
+
+    const auto& stats = ST_LIB::MockedHAL::spi_get_bus_stats();
+    EXPECT_EQ(stats.transfers, ST_LIB::SPIDomain::transaction_queue_capacity);
+    EXPECT_EQ(stats.bytes, ST_LIB::SPIDomain::transaction_queue_capacity * tx.size());
+    EXPECT_EQ(stats.max_gap_ns, 0U);
+    const double queued_throughput = ST_LIB::MockedHAL::spi_get_sustained_throughput_bytes_per_s();
+    EXPECT_DOUBLE_EQ(queued_throughput, bit_rate / 8.0);
+    EXPECT_GT(queued_throughput, polled_throughput);
+}
+
+namespace {
+
+struct AcquisitionFrame {
+    std::array<uint8_t, 4> bytes;
+};
+
+struct AcquisitionLog {
+    std::array<uint64_t, 8> timestamps{};
+    std::array<uint8_t, 8> first_byte{};
+    uint32_t last_sequence = 0;
+    std::size_t count = 0;
+};
+
+void record_sample(
+    void* context,
+    const AcquisitionFrame& sample,
+    uint64_t timestamp_us,
+    uint32_t sequence
+) {
+    auto* log = static_cast<AcquisitionLog*>(context);
+    log->timestamps[log->count] = timestamp_us;
+    log->first_byte[log->count] = sample.bytes[0];
+    log->last_sequence = sequence;
+    log->count++;
+}
+
+constexpr ST_LIB::TimerDomain::Timer acquisition_timer_decl{{
+    .request = ST_LIB::TimerRequest::GeneralPurpose32bit_5,
+}};
+
+} // namespace
+
+TEST_F(SPI2Test, TimerTriggeredAcquisitionDoubleBuffersSamplesWithTimestamps) {
+    auto& instance =
+        init_spi<ST_LIB::SPIDomain::SPIMode::MASTER, ST_LIB::SPIConfigTypes::DataSize::SIZE_8BIT>(
+            20'000'000U
+        );
+    ST_LIB::SPIDomain::SPIWrapper<master8_request> spi(instance);
+
+    ST_LIB::TimerDomain::Instance tim_inst{
+        .tim = TIM5_BASE,
+        .hal_tim = nullptr,
+        .timer_idx = ST_LIB::timer_idxmap[5],
+    };
+    ST_LIB::TimerWrapper<acquisition_timer_decl> timer(&tim_inst);
+    TIM5_BASE->PSC = 63; // 1 MHz timer clock at 64 MHz
+
+    ST_LIB::SPIAcquisitionBuffer<AcquisitionFrame> buffer{};
+    const AcquisitionFrame command{{0x80, 0, 0, 0}};
+    ST_LIB::SPIAcquisition<master8_request, AcquisitionFrame, AcquisitionFrame> acquisition(
+        spi,
+        buffer,
+        command
+    );
+
+    AcquisitionLog log{};
+    acquisition.start(timer, 99, record_sample, &log);
+    EXPECT_EQ(acquisition.get_period_ns(), 100'000U);
+    EXPECT_EQ(TIM5_BASE->ARR, 99U);
+    EXPECT_NE(TIM5_BASE->DIER & TIM_DIER_UIE, 0U);
+    EXPECT_EQ(NVIC_GetEnableIRQ(TIM5_IRQn), 1U);
+
+    std::array<uint8_t, 1> pattern{0x11};
+    ST_LIB::MockedHAL::spi_set_rx_pattern(pattern);
+    TIM5_IRQHandler();
+    EXPECT_TRUE(spi.transaction_in_progress());
+    ASSERT_EQ(ST_LIB::MockedHAL::spi_get_last_tx_size_bytes(), 4U);
+    EXPECT_EQ(ST_LIB::MockedHAL::spi_get_last_tx_data()[0], 0x80);
+    EXPECT_EQ(
+        ST_LIB::MockedHAL::spi_get_last_tx_source(),
+        reinterpret_cast<const uint8_t*>(&buffer.command)
+    );
+    EXPECT_TRUE(ST_LIB::MockedHAL::spi_complete_dma());
+
+    pattern[0] = 0x22;
+    ST_LIB::MockedHAL::spi_set_rx_pattern(pattern);
+    TIM5_IRQHandler();
+    EXPECT_TRUE(ST_LIB::MockedHAL::spi_complete_dma());
+
+    ASSERT_EQ(log.count, 2U);
+    EXPECT_EQ(log.timestamps[0], 100U);
+    EXPECT_EQ(log.timestamps[1], 200U);
+    EXPECT_EQ(log.first_byte[0], 0x11);
+    EXPECT_EQ(log.first_byte[1], 0x22);
+    EXPECT_EQ(log.last_sequence, 2U);
+
+    // Both slots are used in turn, the older sample stays intact
+    EXPECT_EQ(acquisition.latest().bytes[0], 0x22);
+    EXPECT_EQ(buffer.slots[0].bytes[0], 0x22);
+    EXPECT_EQ(buffer.slots[1].bytes[0], 0x11);
+
+    // A trigger while the previous transfer is still on the bus is dropped, time keeps running
+    TIM5_IRQHandler();
+    TIM5_IRQHandler();
+    EXPECT_EQ(acquisition.get_overruns(), 1U);
+    EXPECT_TRUE(ST_LIB::MockedHAL::spi_complete_dma());
+    ASSERT_EQ(log.count, 3U);
+    EXPECT_EQ(log.timestamps[2], 300U);
+    EXPECT_FALSE(ST_LIB::MockedHAL::spi_dma_pending());
+
+    acquisition.stop(timer);
+    EXPECT_EQ(TIM5_BASE->DIER & TIM_DIER_UIE, 0U);
+    EXPECT_EQ(TIM5_BASE->CR1 & TIM_CR1_CEN, 0U);
+}
@@ -0,0 +1,162 @@
+#include <array>
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "C++Utilities/SPSCQueue.hpp"
+
+TEST(SPSCQueue, KeepsFifoOrderAndRejectsWhenFull) {
+    SPSCQueue<uint32_t, 4> queue;
+    uint32_t value = 0;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(value));
+
+    for (uint32_t i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.push(i));
+    }
+    EXPECT_FALSE(queue.push(99));
+    EXPECT_EQ(queue.size(), 4U);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueue, WrapsAroundWithFreeRunningIndices) {
+    SPSCQueue<uint32_t, 8> queue;
+    uint32_t value = 0;
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        ASSERT_TRUE(queue.push(i));
+        ASSERT_TRUE(queue.push(i + 1));
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i + 1);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueue, ProducerAndConsumerThreadsSeeEveryItemInOrder) {
+    static SPSCQueue<uint64_t, 64> queue;
+    constexpr uint64_t items = 200'000;
+
+    std::thread producer([] {
+        for (uint64_t i = 0; i < items;) {
+            if (queue.push(i)) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t value = 0;
+    while (expected < items) {
+        if (queue.pop(value)) {
+            ASSERT_EQ(value, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueue, BatchPushAndPopStopAtCapacity) {
+    SPSCQueue<uint32_t, 8> queue;
+    const std::array<uint32_t, 6> first{0, 1, 2, 3, 4, 5};
+    const std::array<uint32_t, 6> second{6, 7, 8, 9, 10, 11};
+    std::array<uint32_t, 5> out{};
+
+    EXPECT_EQ(queue.push(first), 6U);
+    EXPECT_EQ(queue.push(second), 2U);
+    EXPECT_EQ(queue.size(), 8U);
+
+    ASSERT_EQ(queue.pop(out), 5U);
+    EXPECT_EQ(out, (std::array<uint32_t, 5>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(queue.push(std::span<const uint32_t>(second).subspan(2)), 4U);
+
+    std::array<uint32_t, 16> rest{};
+    ASSERT_EQ(queue.pop(rest), 7U);
+    for (uint32_t i = 0; i < 7; i++) {
+        EXPECT_EQ(rest[i], i + 5);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueue, ClaimedRegionsAreContiguousUpToTheBufferEnd) {
+    SPSCQueue<uint8_t, 8> queue;
+    for (uint8_t i = 0; i < 6; i++) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    uint8_t value = 0;
+    for (int i = 0; i < 5; i++) {
+        ASSERT_TRUE(queue.pop(value));
+    }
+
+    /* head at 6: two slots before the end, five more free after wrapping */
+    std::span<uint8_t> region = queue.claim_write();
+    ASSERT_EQ(region.size(), 2U);
+    region[0] = 6;
+    region[1] = 7;
+    queue.commit_write(2);
+    region = queue.claim_write();
+    ASSERT_EQ(region.size(), 5U);
+    region[0] = 8;
+    queue.commit_write(1);
+
+    std::span<uint8_t> stored = queue.claim_read();
+    ASSERT_EQ(stored.size(), 3U);
+    EXPECT_EQ(stored[0], 5U);
+    EXPECT_EQ(stored[2], 7U);
+    queue.commit_read(3);
+    stored = queue.claim_read();
+    ASSERT_EQ(stored.size(), 1U);
+    EXPECT_EQ(stored[0], 8U);
+    queue.commit_read(1);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.claim_read().size(), 0U);
+}
+
+TEST(SPSCQueue, ClaimCommitThreadsSeeEveryItemInOrder) {
+    static SPSCQueue<uint32_t, 256> queue;
+    constexpr uint32_t items = 200'000;
+
+    /* producer fills regions as a DMA would, consumer drains in batches */
+    std::thread producer([] {
+        uint32_t next = 0;
+        while (next < items) {
+            std::span<uint32_t> region = queue.claim_write();
+            size_t n = 0;
+            for (; n < region.size() && next < items; n++) {
+                region[n] = next++;
+            }
+            queue.commit_write(n);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::array<uint32_t, 48> batch{};
+    uint32_t expected = 0;
+    while (expected < items) {
+        const size_t n = queue.pop(batch);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < n; i++) {
+            ASSERT_EQ(batch[i], expected);
+            expected++;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,210 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "Control/Blocks/KalmanFilter.hpp"
+#include "Control/Blocks/MatrixMultiplier.hpp"
+#include "Control/Blocks/StateSpace.hpp"
+#include "Control/Matrix.hpp"
+
+namespace {
+
+constexpr double PERIOD = 1e-4;
+
+/* Mass on a rail, position and speed, pushed by a force */
+constexpr Matrix<2, 2, double> RAIL_A{1.0, PERIOD, 0.0, 1.0};
+constexpr Matrix<2, 1, double> RAIL_B{0.5 * PERIOD * PERIOD, PERIOD};
+
+float noise() {
+    static uint32_t lcg = 4242;
+    lcg = lcg * 1'664'525U + 1'013'904'223U;
+    return static_cast<float>(lcg >> 8) / static_cast<float>(1U << 24) - 0.5f;
+}
+
+template <size_t R, size_t C> Matrix<R, C> random_matrix() {
+    Matrix<R, C> result;
+    for (float& value : result.data) {
+        value = noise();
+    }
+    return result;
+}
+
+/* Plain triple loop, the reference for the unrolled kernels */
+template <size_t R, size_t C, size_t K>
+Matrix<R, K> reference_product(const Matrix<R, C>& a, const Matrix<C, K>& b) {
+    Matrix<R, K> result;
+    for (size_t i = 0; i < R; i++) {
+        for (size_t j = 0; j < K; j++) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < C; k++) {
+                sum += a(i, k) * b(k, j);
+            }
+            result(i, j) = sum;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(Matrix, ProductMatchesReferenceLoops) {
+    Matrix<4, 3> a = random_matrix<4, 3>();
+    Matrix<3, 5> b = random_matrix<3, 5>();
+    Matrix<4, 5> product = a * b;
+    Matrix<4, 5> expected = reference_product(a, b);
+    for (size_t i = 0; i < product.data.size(); i++) {
+        EXPECT_FLOAT_EQ(product.data[i], expected.data[i]);
+    }
+
+    float A[4][4], B[4][4], result[4][4];
+    Matrix<4, 4> m = random_matrix<4, 4>();
+    Matrix<4, 4> n = random_matrix<4, 4>();
+    for (size_t i = 0; i < 4; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            A[i][j] = m(i, j);
+            B[i][j] = n(i, j);
+        }
+    }
+    MatrixMultiplier multiplier(A, B, result);
+    multiplier.execute();
+    Matrix<4, 4> mn = m * n;
+    for (size_t i = 0; i < 4; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            EXPECT_FLOAT_EQ(mn(i, j), result[i][j]);
+        }
+    }
+}
+
+TEST(Matrix, WorksAtCompileTime) {
+    constexpr Matrix<2, 3, int> a{1, 2, 3, 4, 5, 6};
+    constexpr Matrix<3, 2, int> b = a.transpose();
+    static_assert(a * b == Matrix<2, 2, int>{14, 32, 32, 77});
+    static_assert(a + a == 2 * a);
+    static_assert((Matrix<2, 2, double>::identity() - Matrix<2, 2, double>::identity()) ==
+                  Matrix<2, 2, double>::zero());
+
+    constexpr Matrix<3, 3, double> m{4.0, 7.0, 2.0, 3.0, 6.0, 1.0, 2.0, 5.0, 3.0};
+    constexpr auto inverse = m.inverse();
+    static_assert(inverse.has_value());
+    static_assert((m * *inverse).max_difference(Matrix<3, 3, double>::identity()) < 1e-12);
+    static_assert(!Matrix<2, 2, double>{1.0, 2.0, 2.0, 4.0}.inverse().has_value());
+}
+
+TEST(StateSpace, MatchesReferenceRecursion) {
+    constexpr Matrix<3, 3> A{0.9f, 0.1f, 0.0f, -0.1f, 0.9f, 0.05f, 0.0f, 0.0f, 0.95f};
+    constexpr Matrix<3, 2> B{0.1f, 0.0f, 0.0f, 0.2f, 0.05f, 0.05f};
+    constexpr Matrix<2, 3> C{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f};
+    constexpr Matrix<2, 2> D{0.01f, 0.0f, 0.0f, 0.02f};
+    StateSpace<3, 2, 2> system(A, B, C, D);
+
+    std::array<double, 3> x{};
+    for (int step = 0; step < 1000; step++) {
+        Vector<2> u{noise(), noise()};
+        system.input(u);
+        system.execute();
+
+        std::array<double, 2> y{};
+        std::array<double, 3> next{};
+        for (size_t i = 0; i < 2; i++) {
+            for (size_t k = 0; k < 3; k++) {
+                y[i] += C(i, k) * x[k];
+            }
+            for (size_t k = 0; k < 2; k++) {
+                y[i] += D(i, k) * u[k];
+            }
+        }
+        for (size_t i = 0; i < 3; i++) {
+            for (size_t k = 0; k < 3; k++) {
+                next[i] += A(i, k) * x[k];
+            }
+            for (size_t k = 0; k < 2; k++) {
+                next[i] += B(i, k) * u[k];
+            }
+        }
+        x = next;
+        ASSERT_NEAR(system.output_value[0], y[0], 1e-5) << "step " << step;
+        ASSERT_NEAR(system.output_value[1], y[1], 1e-5) << "step " << step;
+    }
+}
+
+TEST(StateSpace, LqrGainStabilizesTheRail) {
+    static constexpr Matrix<2, 2, double> Q{100.0, 0.0, 0.0, 1.0};
+    static constexpr Matrix<1, 1, double> R{0.01};
+    static constexpr Matrix<1, 2> K = lqr_gain(RAIL_A, RAIL_B, Q, R).cast<float>();
+
+    /* Reference: iterate the Riccati recursion itself until it settles */
+    Matrix<2, 2, double> P = Q;
+    Matrix<1, 2, double> reference{};
+    for (int i = 0; i < 200'000; i++) {
+        double s = (R + RAIL_B.transpose() * P * RAIL_B)[0];
+        reference = (1.0 / s) * (RAIL_B.transpose() * P * RAIL_A);
+        P = Q + RAIL_A.transpose() * P * RAIL_A -
+            (RAIL_A.transpose() * P * RAIL_B) * reference;
+    }
+    EXPECT_NEAR(K[0], reference[0], 1e-4 * reference[0]);
+    EXPECT_NEAR(K[1], reference[1], 1e-4 * reference[1]);
+
+    Matrix<2, 2, double> closed_loop = RAIL_A - RAIL_B * K.cast<double>();
+
+    Vector<2, double> x{0.01, 0.0};
+    for (int step = 0; step < 200'000; step++) {
+        x = closed_loop * x;
+    }
+    EXPECT_LT(std::abs(x[0]), 1e-6);
+    EXPECT_LT(std::abs(x[1]), 1e-6);
+}
+
+TEST(KalmanFilter, ScalarFilterMatchesClosedForm) {
+    constexpr float q = 1e-4f, r = 1e-2f;
+    KalmanFilter<1, 1> filter({{1.0f}, {0.0f}, {1.0f}, {q}, {r}}, Matrix<1, 1>{1.0f});
+
+    double x = 0.0, p = 1.0;
+    for (int step = 0; step < 500; step++) {
+        float z = 1.0f + noise();
+        filter.input(Vector<1>{z});
+        filter.execute();
+
+        p += q;
+        double k = p / (p + r);
+        x += k * (z - x);
+        p *= 1.0 - k;
+        ASSERT_NEAR(filter.output_value[0], x, 1e-5) << "step " << step;
+        ASSERT_NEAR(filter.covariance()[0], p, 1e-6) << "step " << step;
+    }
+}
+
+TEST(KalmanFilter, SteadyStateGainIsWhereTheFilterConverges) {
+    using Filter = KalmanFilter<2, 1>;
+    static constexpr KalmanModel<2, 1, 1, double> rail{
+        RAIL_A,
+        RAIL_B,
+        {1.0, 0.0},
+        {1e-10, 0.0, 0.0, 1e-6},
+        {1e-4}
+    };
+    static constexpr Matrix<2, 1> K = Filter::steady_state_gain(rail).cast<float>();
+
+    Filter steady = Filter::fixed_gain(rail.cast<float>(), K);
+    Filter varying(rail.cast<float>());
+
+    /* Mass moving at 0.5 m/s, position measured with noise */
+    double position = 0.0;
+    double error = 0.0;
+    for (int step = 0; step < 20'000; step++) {
+        position += 0.5 * PERIOD;
+        Vector<1> z{static_cast<float>(position) + 0.02f * noise()};
+        steady.input(z);
+        steady.execute();
+        varying.input(z);
+        varying.execute();
+        if (step >= 19'000) {
+            error = std::max(error, std::abs(steady.output_value[0] - position));
+        }
+    }
+    EXPECT_NEAR(varying.gain()[0], K[0], 1e-3 * K[0]);
+    EXPECT_NEAR(varying.gain()[1], K[1], 1e-2 * K[1]);
+    EXPECT_NEAR(steady.output_value[1], 0.5f, 0.05f);
+    EXPECT_LT(error, 0.005);
+}
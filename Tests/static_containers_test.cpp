@@ -0,0 +1,228 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "C++Utilities/HeapGuard.hpp"
+#include "C++Utilities/InlineString.hpp"
+#include "C++Utilities/IntrusiveList.hpp"
+#include "C++Utilities/StaticFlatMap.hpp"
+#include "C++Utilities/StaticQueue.hpp"
+#include "ErrorHandler/ErrorHandler.hpp"
+#include "HALAL/Models/Packets/PacketValue.hpp"
+
+namespace ST_LIB::TestErrorHandler {
+void reset();
+void set_fail_on_error(bool enabled);
+extern int call_count;
+} // namespace ST_LIB::TestErrorHandler
+
+namespace {
+
+std::size_t last_blocked_size = 0;
+void record_allocation(std::size_t size) { last_blocked_size = size; }
+
+/* Locks the heap for the lifetime of the scope, allocations are recorded instead of trapping */
+struct HeapLocked {
+    uint32_t before = HeapGuard::blocked_allocations();
+    HeapLocked() {
+        HeapGuard::set_handler(record_allocation);
+        HeapGuard::lock();
+    }
+    ~HeapLocked() {
+        HeapGuard::unlock();
+        HeapGuard::set_handler(nullptr);
+    }
+    uint32_t allocations() const { return HeapGuard::blocked_allocations() - before; }
+};
+
+struct Task : IntrusiveListNode<Task> {
+    int id;
+    explicit Task(int id) : id(id) {}
+};
+
+} // namespace
+
+TEST(StaticFlatMap, KeepsKeysSortedAndFindsThem) {
+    StaticFlatMap<uint16_t, int, 8> map;
+    for (uint16_t key : {40, 10, 30, 20}) {
+        map[key] = key * 2;
+    }
+    EXPECT_EQ(map.size(), 4U);
+    EXPECT_TRUE(map.contains(30));
+    EXPECT_FALSE(map.contains(35));
+    EXPECT_EQ(map.find(20)->second, 40);
+    EXPECT_EQ(map.find(25), map.end());
+
+    uint16_t previous = 0;
+    for (const auto& [key, value] : map) {
+        EXPECT_GT(key, previous);
+        EXPECT_EQ(value, key * 2);
+        previous = key;
+    }
+
+    EXPECT_TRUE(map.erase(10));
+    EXPECT_FALSE(map.erase(10));
+    EXPECT_EQ(map.begin()->first, 20);
+    EXPECT_TRUE(map.insert_or_assign(20, 1));
+    EXPECT_EQ(map[20], 1);
+    EXPECT_EQ(map.size(), 3U);
+}
+
+TEST(StaticFlatMap, FullMapRejectsNewKeys) {
+    StaticFlatMap<uint8_t, int, 2> map;
+    EXPECT_TRUE(map.insert_or_assign(1, 10));
+    EXPECT_TRUE(map.insert_or_assign(2, 20));
+    EXPECT_FALSE(map.insert_or_assign(3, 30));
+    EXPECT_TRUE(map.insert_or_assign(2, 21));
+
+    map[3] = 30;
+    EXPECT_EQ(map.dropped(), 1U);
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_EQ(map[2], 21);
+}
+
+TEST(StaticQueue, IsFifoAndWrapsAround) {
+    StaticQueue<int, 3> queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop());
+
+    for (int lap = 0; lap < 4; lap++) {
+        EXPECT_TRUE(queue.push(lap * 10 + 1));
+        EXPECT_TRUE(queue.push(lap * 10 + 2));
+        EXPECT_TRUE(queue.push(lap * 10 + 3));
+        EXPECT_FALSE(queue.push(99));
+        EXPECT_TRUE(queue.full());
+        EXPECT_EQ(queue.back(), lap * 10 + 3);
+        for (int i = 1; i <= 3; i++) {
+            EXPECT_EQ(queue.front(), lap * 10 + i);
+            EXPECT_TRUE(queue.pop());
+        }
+        EXPECT_TRUE(queue.push(0));
+        EXPECT_TRUE(queue.pop());
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(InlineString, TruncatesAndStaysTerminated) {
+    InlineString<8> name("speed");
+    EXPECT_EQ(name.size(), 5U);
+    EXPECT_STREQ(name.c_str(), "speed");
+    EXPECT_TRUE(name == "speed");
+
+    EXPECT_FALSE(name.append("_limit"));
+    EXPECT_EQ(name.size(), 8U);
+    EXPECT_STREQ(name.c_str(), "speed_li");
+
+    name = "dc_link";
+    EXPECT_EQ(std::string_view(name), "dc_link");
+    EXPECT_FALSE(name.assign("a_long_variable_name"));
+    EXPECT_EQ(name.size(), name.capacity());
+    name.clear();
+    EXPECT_TRUE(name.empty());
+    EXPECT_STREQ(name.c_str(), "");
+}
+
+TEST(InlineString, TravelsInPacketsLikeString) {
+    InlineString<16> sent("voltage");
+    PacketValue<InlineString<16>> out(&sent);
+    std::array<uint8_t, 32> wire{};
+    ASSERT_EQ(out.get_size(), 8U);
+    out.copy_to(wire.data());
+    EXPECT_STREQ(reinterpret_cast<const char*>(wire.data()), "voltage");
+
+    InlineString<16> received;
+    PacketValue<InlineString<16>> in(&received);
+    in.parse(wire.data());
+    EXPECT_TRUE(received == "voltage");
+}
+
+TEST(IntrusiveList, LinksAndUnlinksInPlace) {
+    Task a(1), b(2), c(3);
+    IntrusiveList<Task> list;
+
+    EXPECT_TRUE(list.push_back(a));
+    EXPECT_TRUE(list.push_back(b));
+    EXPECT_TRUE(list.push_front(c));
+    EXPECT_FALSE(list.push_back(a));
+    EXPECT_EQ(list.size(), 3U);
+
+    std::array<int, 3> order{};
+    std::size_t i = 0;
+    for (Task& task : list) {
+        order[i++] = task.id;
+    }
+    EXPECT_EQ(order, (std::array<int, 3>{3, 1, 2}));
+
+    EXPECT_TRUE(list.remove(a));
+    EXPECT_FALSE(a.is_linked());
+    EXPECT_FALSE(list.remove(a));
+    EXPECT_EQ(list.front(), &c);
+    EXPECT_EQ(list.back(), &b);
+    EXPECT_EQ(list.pop_front(), &c);
+    EXPECT_EQ(list.pop_front(), &b);
+    EXPECT_EQ(list.pop_front(), nullptr);
+    EXPECT_TRUE(list.empty());
+}
+
+TEST(HeapGuard, ReportsAllocationsWhileLocked) {
+    uint32_t allocations = 0;
+    {
+        HeapLocked locked;
+        int* value = new int(7);
+        allocations = locked.allocations();
+        delete value;
+    }
+    EXPECT_EQ(allocations, 1U);
+    EXPECT_EQ(last_blocked_size, sizeof(int));
+    EXPECT_FALSE(HeapGuard::is_locked());
+}
+
+TEST(HeapGuard, ContainersDoNotAllocate) {
+    static StaticFlatMap<uint16_t, int, 16> map;
+    static StaticQueue<uint32_t, 16> queue;
+    static InlineString<32> text;
+    static std::array<Task, 4> tasks{Task(0), Task(1), Task(2), Task(3)};
+    static IntrusiveList<Task> list;
+
+    uint32_t allocations = 0;
+    {
+        HeapLocked locked;
+        for (uint16_t i = 0; i < 16; i++) {
+            map[static_cast<uint16_t>(i * 7 % 16)] = i;
+            queue.push(i);
+            text.append("x");
+        }
+        for (Task& task : tasks) {
+            list.push_back(task);
+        }
+        while (!queue.empty()) {
+            queue.pop();
+        }
+        map.erase(3);
+        list.remove(tasks[2]);
+        allocations = locked.allocations();
+    }
+    EXPECT_EQ(allocations, 0U);
+    EXPECT_EQ(map.size(), 15U);
+    EXPECT_EQ(text.size(), 16U);
+    EXPECT_EQ(list.size(), 3U);
+}
+
+TEST(HeapGuard, ErrorHandlerReleasesTheGuardBeforeBuildingTheMessage) {
+    ST_LIB::TestErrorHandler::reset();
+    ST_LIB::TestErrorHandler::set_fail_on_error(false);
+
+    uint32_t allocations = 0;
+    {
+        HeapLocked locked;
+        ErrorHandler("Sensor %d out of range, a message longer than any small string", 3);
+        EXPECT_FALSE(HeapGuard::is_locked());
+        allocations = locked.allocations();
+    }
+    EXPECT_EQ(allocations, 0U);
+    EXPECT_EQ(ST_LIB::TestErrorHandler::call_count, 1);
+    ST_LIB::TestErrorHandler::reset();
+}
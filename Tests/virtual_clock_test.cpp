@@ -0,0 +1,278 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "HALAL/Services/Time/Scheduler.hpp"
+#include "MockedDrivers/NVIC.hpp"
+#include "MockedDrivers/VirtualClock.hpp"
+#include "MockedDrivers/mocked_hal_adc.hpp"
+#include "MockedDrivers/mocked_hal_dma.hpp"
+
+using ST_LIB::MockedHAL::VirtualClock;
+
+namespace {
+
+constexpr uint64_t us = 1'000;
+constexpr uint64_t ms = 1'000'000;
+
+std::vector<int> trace;
+std::vector<uint64_t> trace_time;
+
+void record(int what) {
+    trace.push_back(what);
+    trace_time.push_back(VirtualClock::now_ns());
+}
+
+/* IRQ numbers with no ST-LIB handler behind in the tests */
+constexpr IRQn_Type low_irq = TIM15_IRQn;
+constexpr IRQn_Type high_irq = TIM16_IRQn;
+
+void low_handler() {
+    record(1);
+    NVIC_SetPendingIRQ(high_irq);
+    record(-1);
+}
+void high_handler() { record(2); }
+
+void reset_timer(TIM_TypeDef* tim) {
+    tim->CR1 = 0;
+    tim->DIER = 0;
+    tim->SR = 0;
+    tim->EGR = 0;
+    tim->CNT = 0;
+    tim->PSC = 0;
+    tim->ARR = 0;
+    tim->RCR = 0;
+    tim->generate_update();
+}
+
+int timer_updates = 0;
+void timer_handler() {
+    TIM3_BASE->SR &= ~1U;
+    timer_updates++;
+}
+
+DMA_HandleTypeDef hdma{};
+int dma_completed = 0;
+void dma_handler() { HAL_DMA_IRQHandler(&hdma); }
+
+ADC_HandleTypeDef hadc_it{};
+void adc_handler() {
+    record(static_cast<int>(HAL_ADC_GetValue(&hadc_it)));
+    HAL_ADC_IRQHandler(&hadc_it);
+}
+
+int scheduler_fast_count = 0;
+int scheduler_slow_count = 0;
+void scheduler_fast_task() { scheduler_fast_count++; }
+void scheduler_slow_task() { scheduler_slow_count++; }
+
+class VirtualClockTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        VirtualClock::reset();
+        ST_LIB::MockedHAL::nvic_reset();
+        trace.clear();
+        trace_time.clear();
+    }
+
+    void TearDown() override {
+        VirtualClock::reset();
+        ST_LIB::MockedHAL::nvic_reset();
+    }
+};
+
+} // namespace
+
+TEST_F(VirtualClockTest, EventsRunInTimeOrderThenSchedulingOrder) {
+    VirtualClock::schedule_at(30 * us, [](void*) { record(3); });
+    VirtualClock::schedule_at(10 * us, [](void*) { record(1); });
+    VirtualClock::schedule_at(10 * us, [](void*) { record(2); });
+    const uint8_t cancelled = VirtualClock::schedule_at(20 * us, [](void*) { record(9); });
+    EXPECT_TRUE(VirtualClock::cancel(cancelled));
+    EXPECT_FALSE(VirtualClock::cancel(cancelled));
+
+    EXPECT_EQ(VirtualClock::next_event_ns(), 10 * us);
+    EXPECT_EQ(VirtualClock::run_until(25 * us), 1U);
+    EXPECT_EQ(VirtualClock::now_ns(), 25 * us);
+    EXPECT_TRUE(VirtualClock::step());
+    EXPECT_FALSE(VirtualClock::step());
+
+    EXPECT_EQ(trace, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(trace_time, (std::vector<uint64_t>{10 * us, 10 * us, 30 * us}));
+}
+
+TEST_F(VirtualClockTest, InterruptsOfAnInstantRunByPriority) {
+    NVIC_SetVector(low_irq, reinterpret_cast<uintptr_t>(&low_handler));
+    NVIC_SetVector(high_irq, reinterpret_cast<uintptr_t>(&high_handler));
+    NVIC_SetPriority(low_irq, 5);
+    NVIC_SetPriority(high_irq, 2);
+    NVIC_EnableIRQ(low_irq);
+    NVIC_EnableIRQ(high_irq);
+
+    /* raised together, the higher priority one first although it was scheduled last */
+    VirtualClock::schedule_irq_at(5 * us, low_irq);
+    VirtualClock::schedule_irq_at(5 * us, high_irq);
+    VirtualClock::run_for(10 * us);
+    EXPECT_EQ(trace, (std::vector<int>{2, 1, 2, -1}));
+
+    /* pended from the low priority handler, the high priority one preempts it */
+    trace.clear();
+    NVIC_SetPendingIRQ(low_irq);
+    EXPECT_EQ(trace, (std::vector<int>{1, 2, -1}));
+
+    /* the other way around it waits for the handler to return */
+    trace.clear();
+    NVIC_SetPriority(high_irq, 8);
+    NVIC_SetPendingIRQ(low_irq);
+    EXPECT_EQ(trace, (std::vector<int>{1, -1, 2}));
+
+    /* disabled interrupts stay pending */
+    trace.clear();
+    NVIC_DisableIRQ(high_irq);
+    NVIC_SetPendingIRQ(high_irq);
+    EXPECT_TRUE(trace.empty());
+    EXPECT_EQ(NVIC_GetPendingIRQ(high_irq), 1U);
+    NVIC_EnableIRQ(high_irq);
+    EXPECT_EQ(trace, (std::vector<int>{2}));
+}
+
+TEST_F(VirtualClockTest, TimerUpdatesWithoutCountingEveryTick) {
+    timer_updates = 0;
+    reset_timer(TIM3_BASE);
+    NVIC_SetVector(TIM3_IRQn, reinterpret_cast<uintptr_t>(&timer_handler));
+    ASSERT_TRUE(VirtualClock::attach_timer(TIM3_BASE, 100'000'000));
+
+    TIM3_BASE->PSC = 99; // 1 MHz counter
+    TIM3_BASE->ARR = 999;
+    TIM3_BASE->DIER |= 1U;
+    TIM3_BASE->CR1 |= 1U;
+    NVIC_EnableIRQ(TIM3_IRQn);
+
+    /* counter between events */
+    VirtualClock::run_for(250 * us);
+    EXPECT_EQ(TIM3_BASE->CNT, 250U);
+    EXPECT_EQ(timer_updates, 0);
+
+    VirtualClock::run_until(10'000 * ms + 250 * us);
+    EXPECT_EQ(timer_updates, 10'000);
+    EXPECT_EQ(TIM3_BASE->CNT, 250U);
+
+    /* repetition counter, ARR change at the next update */
+    TIM3_BASE->RCR = 1;
+    TIM3_BASE->EGR |= 1U;
+    EXPECT_TRUE(VirtualClock::step());
+    EXPECT_EQ(timer_updates, 10'001);
+    EXPECT_EQ(TIM3_BASE->CNT, 0U);
+    VirtualClock::run_for(10 * ms);
+    EXPECT_EQ(timer_updates, 10'006);
+
+    /* stopped counter, nothing to do */
+    TIM3_BASE->CR1 &= ~1U;
+    EXPECT_EQ(VirtualClock::next_event_ns(), VirtualClock::NEVER);
+    reset_timer(TIM3_BASE);
+}
+
+TEST_F(VirtualClockTest, DMACompletionAndADCConversionTakeTime) {
+    dma_completed = 0;
+    hdma = {};
+    hdma.Instance = DMA1_Stream3;
+    hdma.XferCpltCallback = [](DMA_HandleTypeDef*) { record(dma_completed++); };
+    NVIC_SetVector(DMA1_Stream3_IRQn, reinterpret_cast<uintptr_t>(&dma_handler));
+    NVIC_EnableIRQ(DMA1_Stream3_IRQn);
+
+    ST_LIB::MockedHAL::dma_reset();
+    ST_LIB::MockedHAL::dma_set_transfer_time_ns(40 * us);
+    ASSERT_EQ(HAL_DMA_Start_IT(&hdma, 0, 0, 16), HAL_OK);
+    VirtualClock::run_for(39 * us);
+    EXPECT_EQ(dma_completed, 0);
+    VirtualClock::run_for(1 * us);
+    EXPECT_EQ(dma_completed, 1);
+    EXPECT_EQ(trace_time, (std::vector<uint64_t>{40 * us}));
+    ST_LIB::MockedHAL::dma_reset();
+
+    ADC_HandleTypeDef hadc{};
+    hadc.Instance = ADC2;
+    ADC_ChannelConfTypeDef channel{};
+    channel.Channel = ADC_CHANNEL_3;
+    ST_LIB::MockedHAL::adc_reset();
+    ST_LIB::MockedHAL::adc_set_conversion_time_ns(ADC2, 2 * us);
+    ASSERT_EQ(HAL_ADC_Init(&hadc), HAL_OK);
+    ASSERT_EQ(HAL_ADC_ConfigChannel(&hadc, &channel), HAL_OK);
+    ASSERT_EQ(HAL_ADC_Start(&hadc), HAL_OK);
+    ASSERT_EQ(HAL_ADC_PollForConversion(&hadc, 1), HAL_OK);
+    EXPECT_EQ(VirtualClock::now_ns(), 42 * us);
+    ST_LIB::MockedHAL::adc_reset();
+}
+
+TEST_F(VirtualClockTest, ADCEndOfConversionRaisesItsInterrupt) {
+    hadc_it = {};
+    hadc_it.Instance = ADC1;
+    hadc_it.Init.ContinuousConvMode = ENABLE;
+    ADC_ChannelConfTypeDef channel{};
+    channel.Channel = ADC_CHANNEL_5;
+    NVIC_SetVector(ADC_IRQn, reinterpret_cast<uintptr_t>(&adc_handler));
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    ST_LIB::MockedHAL::adc_reset();
+    ST_LIB::MockedHAL::adc_set_conversion_time_ns(ADC1, 3 * us);
+    ST_LIB::MockedHAL::adc_set_channel_raw(ADC1, ADC_CHANNEL_5, 1234);
+    ASSERT_EQ(HAL_ADC_Init(&hadc_it), HAL_OK);
+    ASSERT_EQ(HAL_ADC_ConfigChannel(&hadc_it, &channel), HAL_OK);
+    ASSERT_EQ(HAL_ADC_Start_IT(&hadc_it), HAL_OK);
+    VirtualClock::run_for(2 * us);
+    EXPECT_TRUE(trace.empty());
+
+    /* Continuous mode, every conversion raises its own interrupt with its own result */
+    VirtualClock::run_for(1 * us);
+    ST_LIB::MockedHAL::adc_set_channel_raw(ADC1, ADC_CHANNEL_5, 99);
+    VirtualClock::run_for(3 * us);
+    EXPECT_EQ(trace, (std::vector<int>{1234, 99}));
+    EXPECT_EQ(trace_time, (std::vector<uint64_t>{3 * us, 6 * us}));
+
+    /* A stopped ADC leaves nothing on the clock */
+    ASSERT_EQ(HAL_ADC_Stop(&hadc_it), HAL_OK);
+    VirtualClock::run_for(10 * us);
+    EXPECT_EQ(trace.size(), 2U);
+
+    /* Single conversion, the ADC is free again once it ends */
+    hadc_it.Init.ContinuousConvMode = DISABLE;
+    ASSERT_EQ(HAL_ADC_Start_IT(&hadc_it), HAL_OK);
+    VirtualClock::run_for(3 * us);
+    EXPECT_EQ(trace.size(), 3U);
+    EXPECT_FALSE(ST_LIB::MockedHAL::adc_is_running(ADC1));
+    EXPECT_EQ(VirtualClock::next_event_ns(), VirtualClock::NEVER);
+    ST_LIB::MockedHAL::adc_reset();
+}
+
+TEST_F(VirtualClockTest, SchedulerRunsSecondsOfFirmwareTime) {
+    Scheduler::active_task_count_ = 0;
+    Scheduler::free_bitmap_ = 0xFFFF'FFFF;
+    Scheduler::ready_bitmap_ = 0;
+    Scheduler::sorted_task_ids_ = 0;
+    Scheduler::global_tick_us_ = 0;
+    Scheduler::current_interval_us_ = 0;
+    scheduler_fast_count = 0;
+    scheduler_slow_count = 0;
+    reset_timer(TIM2_BASE);
+    TIM2_BASE->internal_psc_cnt = 0;
+
+    /* Scheduler::start() derives its prescaler from a kernel clock of 2 x SystemCoreClock */
+    ASSERT_TRUE(VirtualClock::attach_timer(TIM2_BASE, 2 * SystemCoreClock));
+    const uint16_t fast = Scheduler::register_task(250, &scheduler_fast_task);
+    const uint16_t slow = Scheduler::register_task(1'000, &scheduler_slow_task);
+    Scheduler::start();
+
+    constexpr uint64_t firmware_time = 5'000 * ms;
+    while (VirtualClock::step(firmware_time)) {
+        Scheduler::update();
+    }
+
+    EXPECT_EQ(scheduler_fast_count, 20'000);
+    EXPECT_EQ(scheduler_slow_count, 5'000);
+    EXPECT_EQ(Scheduler::global_tick_us_, 5'000'000U);
+
+    Scheduler::unregister_task(fast);
+    Scheduler::unregister_task(slow);
+    reset_timer(TIM2_BASE);
+}